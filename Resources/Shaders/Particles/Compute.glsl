@@ -0,0 +1,10 @@
+// A particle as the compute passes store it, a particle with no life is a free slot.
+struct Particle {
+	vec4 positionLife;
+	vec4 velocityElapsed;
+	// Stage cycles, rotation, scale and gravity effect.
+	vec4 parameters;
+};
+
+// The seconds a particle takes to fade out at the end of its life, as in ParticlePool.
+const float FADE_TIME = 1.0f;
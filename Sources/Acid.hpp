@@ -1,24 +1,37 @@
 #pragma once
 
 #include "Animations/AnimatedMesh.hpp"
+#include "Animations/AnimatedModel.hpp"
 #include "Animations/Animation/Animation.hpp"
 #include "Animations/Animation/AnimationLoader.hpp"
+#include "Animations/Animation/AnimationPose.hpp"
+#include "Animations/Animation/AnimationTrack.hpp"
 #include "Animations/Animation/JointTransform.hpp"
 #include "Animations/Animation/Keyframe.hpp"
+#include "Animations/AnimationLayer.hpp"
+#include "Animations/Animations.hpp"
 #include "Animations/Animator.hpp"
+#include "Animations/CrowdEvaluator.hpp"
 #include "Animations/Geometry/GeometryLoader.hpp"
 #include "Animations/Geometry/VertexAnimated.hpp"
 #include "Animations/Skeleton/Joint.hpp"
+#include "Animations/Skeleton/Skeleton.hpp"
 #include "Animations/Skeleton/SkeletonLoader.hpp"
 #include "Animations/Skin/SkinLoader.hpp"
+#include "Animations/Skin/Skinning.hpp"
 #include "Animations/Skin/VertexWeights.hpp"
 #include "Audio/Audio.hpp"
 #include "Audio/Flac/FlacSoundBuffer.hpp"
+#include "Audio/Mixer/AudioDevice.hpp"
+#include "Audio/Mixer/Mixer.hpp"
+#include "Audio/Mixer/NullAudioDevice.hpp"
+#include "Audio/Mixer/OpenAlAudioDevice.hpp"
 #include "Audio/Mp3/Mp3SoundBuffer.hpp"
 #include "Audio/Ogg/OggSoundBuffer.hpp"
-#include "Audio/Opus/OpusSoundBuffer.hpp"
 #include "Audio/Sound.hpp"
 #include "Audio/SoundBuffer.hpp"
+#include "Audio/SoundDecoder.hpp"
+#include "Audio/SoundStream.hpp"
 #include "Audio/Wave/WaveSoundBuffer.hpp"
 #include "Bitmaps/Bitmap.hpp"
 #include "Bitmaps/Dng/DngBitmap.hpp"
@@ -152,12 +165,14 @@
 #include "Network/Tcp/TcpListener.hpp"
 #include "Network/Tcp/TcpSocket.hpp"
 #include "Network/Udp/UdpSocket.hpp"
+#include "Particles/BitonicSort.hpp"
 #include "Particles/Emitters/CircleEmitter.hpp"
 #include "Particles/Emitters/Emitter.hpp"
 #include "Particles/Emitters/LineEmitter.hpp"
 #include "Particles/Emitters/PointEmitter.hpp"
 #include "Particles/Emitters/SphereEmitter.hpp"
 #include "Particles/Particle.hpp"
+#include "Particles/ParticleCompute.hpp"
 #include "Particles/Particles.hpp"
 #include "Particles/ParticlesSubrender.hpp"
 #include "Particles/ParticleSystem.hpp"
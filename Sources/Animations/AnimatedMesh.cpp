@@ -1,66 +1,24 @@
 #include "AnimatedMesh.hpp"
 
-#include "Maths/Maths.hpp"
-#include "Files/Xml/Xml.hpp"
-#include "Files/File.hpp"
-#include "Maths/Matrix4.hpp"
+#include "Engine/Engine.hpp"
 #include "Scenes/Entity.hpp"
-#include "Animation/AnimationLoader.hpp"
-#include "Skeleton/SkeletonLoader.hpp"
-#include "Skin/SkinLoader.hpp"
-#include "Geometry/GeometryLoader.hpp"
+#include "Scenes/Scenes.hpp"
 #include "Maths/Transform.hpp"
+#include "Animations.hpp"
 
 namespace acid {
 AnimatedMesh::AnimatedMesh(std::filesystem::path filename, std::unique_ptr<Material> &&material) :
 	material(std::move(material)),
-	filename(std::move(filename)) {
+	filename(std::move(filename)),
+	jointMatrices(MaxJoints) {
 }
 
 void AnimatedMesh::Start() {
 	if (material)
 		material->CreatePipeline(GetVertexInput(), true);
 
-	if (filename.empty())
-		return;
-
-	File file(filename, std::make_unique<Xml>());
-	file.Load();
-	auto fileNode = file.GetNode()["COLLADA"];
-
-	// Because in Blender z is up, but Acid is y up. A correction must be applied to positions and normals.
-	static const auto Correction = Matrix4().Rotate(Maths::Radians(-90.0f), Vector3f::Right);
-
-	SkinLoader skinLoader(fileNode["library_controllers"], MaxWeights);
-	SkeletonLoader skeletonLoader(fileNode["library_visual_scenes"], skinLoader.GetJointOrder(), Correction);
-	GeometryLoader geometryLoader(fileNode["library_geometries"], skinLoader.GetVertexWeights(), Correction);
-
-	model = std::make_shared<Model>(geometryLoader.GetVertices(), geometryLoader.GetIndices());
-	headJoint = skeletonLoader.GetHeadJoint();
-
-	AnimationLoader animationLoader(fileNode["library_animations"], fileNode["library_visual_scenes"], Correction);
-
-	animation = std::make_unique<Animation>(animationLoader.GetLengthSeconds(), animationLoader.GetKeyframes());
-	animator.DoAnimation(animation.get());
-
-/*#ifdef ACID_DEBUG
-	{
-		File fileModel("Animation/Model.json", std::make_unique<Json>());
-		fileModel.GetNode()["vertices"] = model->GetVertices<VertexAnimated>();
-		fileModel.GetNode()["indices"] = model->GetIndices();
-		fileModel.Write(NodeFormat::Beautified);
-	}
-	{
-		File fileJoints("Animation/Joints.json", std::make_unique<Json>());
-		fileJoints.GetNode() = headJoint;
-		fileJoints.Write(NodeFormat::Beautified);
-	}
-	{
-		File fileAnimation0("Animation/Animation0.json", std::make_unique<Json>());
-		fileAnimation0.GetNode() = *animation;
-		fileAnimation0.Write(NodeFormat::Beautified);
-	}
-#endif*/
+	if (!filename.empty() && !model)
+		model = AnimatedModel::LoadAsync(filename);
 }
 
 void AnimatedMesh::Update() {
@@ -68,21 +26,33 @@ void AnimatedMesh::Update() {
 		auto transform = GetEntity()->GetComponent<Transform>();
 		material->PushUniforms(uniformObject, transform);
 	}
+
+	if (!model || !model->IsLoaded())
+		return;
+
+	if (!animator.GetCurrentAnimation())
+		animator.DoAnimation(model->GetAnimation());
 	
-	std::vector<Matrix4> jointMatrices(MaxJoints);
-	animator.Update(headJoint, jointMatrices);
+	// The animations system calculates the poses of every animated mesh together before entities are updated.
+	if (!Scenes::Get()->GetScene()->HasSystem<Animations>())
+		animator.Update(Engine::Get()->GetDelta(), model->GetSkeleton(), jointMatrices);
+	model->GetSkinning().CalculateBounds(jointMatrices, minExtents, maxExtents);
 	storageAnimation.Push(jointMatrices.data(), sizeof(Matrix4) * jointMatrices.size());
 }
 
 bool AnimatedMesh::CmdRender(const CommandBuffer &commandBuffer, UniformHandler &uniformScene, const Pipeline::Stage &pipelineStage) {
-	if (!model || !material)
+	if (!model || !model->IsLoaded() || !material)
 		return false;
 
-	// Checks if the mesh is in view.
-	/*if (auto rigidbody = GetEntity()->GetComponent<Rigidbody>()) {
-		if (!rigidbody->InFrustum(Scenes::Get()->GetScene()->GetCamera()->GetViewFrustum()))
+	// Checks if the skinned bounds of the mesh are in view.
+	if (auto transform = GetEntity()->GetComponent<Transform>(); transform && model->GetSkinning().GetVertexCount() != 0) {
+		auto worldMin = minExtents;
+		auto worldMax = maxExtents;
+		Skinning::TransformBounds(transform->GetWorldMatrix(), worldMin, worldMax);
+
+		if (!Scenes::Get()->GetScene()->GetCamera()->GetViewFrustum().CubeInFrustum(worldMin, worldMax))
 			return false;
-	}*/
+	}
 
 	// Check if we are in the correct pipeline stage.
 	auto materialPipeline = material->GetPipelineMaterial();
@@ -110,6 +80,14 @@ bool AnimatedMesh::CmdRender(const CommandBuffer &commandBuffer, UniformHandler
 	return model->CmdRender(commandBuffer);
 }
 
+void AnimatedMesh::SetModel(const std::shared_ptr<AnimatedModel> &model) {
+	// Animations of the previous model may be destroyed with it.
+	for (std::size_t i = 0; i < animator.GetLayers().size(); i++)
+		animator.GetLayer(i).Play(nullptr);
+	this->model = model;
+	filename = model ? model->GetFilename() : "";
+}
+
 void AnimatedMesh::SetMaterial(std::unique_ptr<Material> &&material) {
 	this->material = std::move(material);
 	this->material->CreatePipeline(GetVertexInput(), true);
@@ -1,15 +1,16 @@
 #pragma once
 
 #include "Materials/Material.hpp"
-#include "Models/Model.hpp"
 #include "Scenes/Component.hpp"
 #include "Graphics/Buffers/StorageHandler.hpp"
-#include "Geometry/VertexAnimated.hpp"
+#include "AnimatedModel.hpp"
 #include "Animator.hpp"
 
 namespace acid {
 /**
  * @brief Class that represents an animated armature with a skin mesh.
+ * The model, skeleton and animation are loaded asynchronously into a {@link AnimatedModel} shared by every mesh playing the same file,
+ * the mesh only holds the state of its animator and its pose.
  */
 class ACID_EXPORT AnimatedMesh : public Component::Registrar<AnimatedMesh> {
 	inline static const bool Registered = Register("animatedMesh");
@@ -28,12 +29,30 @@ public:
 
 	static Shader::VertexInput GetVertexInput(uint32_t binding = 0) { return VertexAnimated::GetVertexInput(binding); }
 
-	const std::shared_ptr<Model> &GetModel() const { return model; }
-	void SetModel(const std::shared_ptr<Model> &model) { this->model = model; }
+	const std::shared_ptr<AnimatedModel> &GetModel() const { return model; }
+	/**
+	 * Sets the model of the mesh, every layer of the animator is stopped and the animation of the model is played once it has loaded.
+	 * @param model The animated model.
+	 */
+	void SetModel(const std::shared_ptr<AnimatedModel> &model);
 
 	const std::unique_ptr<Material> &GetMaterial() const { return material; }
 	void SetMaterial(std::unique_ptr<Material> &&material);
 
+	Animator &GetAnimator() { return animator; }
+	std::vector<Matrix4> &GetJointMatrices() { return jointMatrices; }
+
+	/**
+	 * Gets the min point of the box containing the skinned model in its current pose, in model-space.
+	 * @return The min point of the skinned bounds.
+	 */
+	const Vector3f &GetMinExtents() const { return minExtents; }
+	/**
+	 * Gets the max point of the box containing the skinned model in its current pose, in model-space.
+	 * @return The max point of the skinned bounds.
+	 */
+	const Vector3f &GetMaxExtents() const { return maxExtents; }
+
 	StorageHandler &GetStorageAnimation() { return storageAnimation; }
 
 	friend const Node &operator>>(const Node &node, AnimatedMesh &animatedMesh);
@@ -43,14 +62,15 @@ public:
 	constexpr static uint32_t MaxWeights = 3;
 
 private:
-	std::shared_ptr<Model> model;
+	std::shared_ptr<AnimatedModel> model;
 	std::unique_ptr<Material> material;
 	
 	std::filesystem::path filename;
 	Animator animator;
-	Joint headJoint;
-	
-	std::unique_ptr<Animation> animation;
+	std::vector<Matrix4> jointMatrices;
+
+	Vector3f minExtents;
+	Vector3f maxExtents;
 
 	DescriptorsHandler descriptorSet;
 	UniformHandler uniformObject;
@@ -0,0 +1,115 @@
+#include "AnimatedMeshData.hpp"
+
+#include "Files/BinaryStream.hpp"
+#include "Files/File.hpp"
+#include "Files/Files.hpp"
+#include "Files/Xml/Xml.hpp"
+#include "Maths/Maths.hpp"
+#include "Animation/AnimationLoader.hpp"
+#include "Geometry/GeometryLoader.hpp"
+#include "Skeleton/SkeletonLoader.hpp"
+#include "Skin/SkinLoader.hpp"
+
+namespace acid {
+static constexpr uint32_t AnimatedMeshMagic = 0x4D494E41; // "ANIM"
+static constexpr uint32_t AnimatedMeshVersion = 1;
+
+static void WriteJoint(BinaryWriter &writer, const Joint &joint) {
+	writer.Write(joint.GetIndex());
+	writer.Write(joint.GetName());
+	writer.Write(joint.GetLocalBindTransform());
+	writer.Write(static_cast<uint32_t>(joint.GetChildren().size()));
+	for (const auto &child : joint.GetChildren())
+		WriteJoint(writer, child);
+}
+
+static Joint ReadJoint(BinaryReader &reader) {
+	auto index = reader.Read<uint32_t>();
+	auto name = reader.ReadString();
+	auto localBindTransform = reader.Read<Matrix4>();
+	Joint joint(index, std::move(name), localBindTransform);
+
+	auto childCount = reader.Read<uint32_t>();
+	for (uint32_t i = 0; i < childCount; i++)
+		joint.AddChild(ReadJoint(reader));
+	return joint;
+}
+
+AnimatedMeshData AnimatedMeshData::LoadCollada(const std::filesystem::path &filename, uint32_t maxWeights) {
+	File file(filename, std::make_unique<Xml>());
+	file.Load();
+	auto fileNode = file.GetNode()["COLLADA"];
+
+	// Because in Blender z is up, but Acid is y up. A correction must be applied to positions and normals.
+	static const auto Correction = Matrix4().Rotate(Maths::Radians(-90.0f), Vector3f::Right);
+
+	SkinLoader skinLoader(fileNode["library_controllers"], maxWeights);
+	SkeletonLoader skeletonLoader(fileNode["library_visual_scenes"], skinLoader.GetJointOrder(), Correction);
+	GeometryLoader geometryLoader(fileNode["library_geometries"], skinLoader.GetVertexWeights(), Correction);
+	AnimationLoader animationLoader(fileNode["library_animations"], fileNode["library_visual_scenes"], Correction);
+
+	AnimatedMeshData data;
+	data.vertices = geometryLoader.GetVertices();
+	data.indices = geometryLoader.GetIndices();
+	data.headJoint = skeletonLoader.GetHeadJoint();
+	data.length = animationLoader.GetLengthSeconds();
+	data.keyframes = animationLoader.GetKeyframes();
+	return data;
+}
+
+AnimatedMeshData AnimatedMeshData::Read(const std::filesystem::path &filename) {
+	auto fileLoaded = Files::ReadView(filename);
+	if (!fileLoaded)
+		throw std::runtime_error("Animated mesh could not be loaded: " + filename.string());
+
+	BinaryReader reader(fileLoaded->GetBytes());
+	if (reader.Read<uint32_t>() != AnimatedMeshMagic || reader.Read<uint32_t>() != AnimatedMeshVersion ||
+		reader.Read<uint32_t>() != sizeof(VertexAnimated))
+		throw std::runtime_error("Animated mesh has a unsupported format: " + filename.string());
+
+	AnimatedMeshData data;
+	reader.Read(data.vertices);
+	reader.Read(data.indices);
+	data.headJoint = ReadJoint(reader);
+	data.headJoint.CalculateInverseBindTransform({});
+	data.length = Time::Microseconds(reader.Read<int64_t>());
+
+	data.keyframes.resize(reader.Read<uint32_t>());
+	for (auto &keyframe : data.keyframes) {
+		auto timeStamp = Time::Microseconds(reader.Read<int64_t>());
+		std::map<std::string, JointTransform> pose;
+		auto poseCount = reader.Read<uint32_t>();
+		for (uint32_t i = 0; i < poseCount; i++) {
+			auto name = reader.ReadString();
+			auto position = reader.Read<Vector3f>();
+			auto rotation = reader.Read<Quaternion>();
+			pose.emplace(std::move(name), JointTransform(position, rotation));
+		}
+		keyframe = Keyframe(timeStamp, std::move(pose));
+	}
+	return data;
+}
+
+void AnimatedMeshData::Write(const std::filesystem::path &filename) const {
+	BinaryWriter writer;
+	writer.Write(AnimatedMeshMagic);
+	writer.Write(AnimatedMeshVersion);
+	writer.Write(static_cast<uint32_t>(sizeof(VertexAnimated)));
+	writer.Write<VertexAnimated>(vertices);
+	writer.Write<uint32_t>(indices);
+	WriteJoint(writer, headJoint);
+	writer.Write(length.AsMicroseconds<int64_t>());
+
+	writer.Write(static_cast<uint32_t>(keyframes.size()));
+	for (const auto &keyframe : keyframes) {
+		writer.Write(keyframe.GetTimeStamp().AsMicroseconds<int64_t>());
+		writer.Write(static_cast<uint32_t>(keyframe.GetPose().size()));
+		for (const auto &[name, jointTransform] : keyframe.GetPose()) {
+			writer.Write(name);
+			writer.Write(jointTransform.GetPosition());
+			writer.Write(jointTransform.GetRotation());
+		}
+	}
+	writer.Save(filename);
+}
+}
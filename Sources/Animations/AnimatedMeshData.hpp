@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Animation/Animation.hpp"
+#include "Geometry/VertexAnimated.hpp"
+#include "Skeleton/Joint.hpp"
+
+namespace acid {
+/**
+ * @brief The skinned geometry, skeleton and animation of a animated mesh. Loaded from a COLLADA file,
+ * or from the binary file AcidCooker writes next to it so the XML does not have to be parsed at runtime.
+ */
+class ACID_EXPORT AnimatedMeshData {
+public:
+	/// The extension appended to a source filename to name its cooked animated mesh.
+	inline static const std::string Extension = ".anim";
+
+	/**
+	 * Parses a animated mesh from a COLLADA file.
+	 * @param filename The file to parse.
+	 * @param maxWeights The max number of joints that can affect a vertex.
+	 * @return The animated mesh data.
+	 */
+	static AnimatedMeshData LoadCollada(const std::filesystem::path &filename, uint32_t maxWeights);
+
+	/**
+	 * Reads a animated mesh written by {@link AnimatedMeshData#Write}.
+	 * @param filename The file to read from.
+	 * @return The animated mesh data.
+	 */
+	static AnimatedMeshData Read(const std::filesystem::path &filename);
+
+	/**
+	 * Writes the animated mesh to a file on disk.
+	 * @param filename The real path to write to.
+	 */
+	void Write(const std::filesystem::path &filename) const;
+
+	/**
+	 * Gets the filename of the cooked animated mesh for a COLLADA file.
+	 * @param filename The COLLADA filename.
+	 * @return The cooked animated mesh filename.
+	 */
+	static std::filesystem::path GetCookedFilename(std::filesystem::path filename) { return filename += Extension; }
+
+	std::vector<VertexAnimated> vertices;
+	std::vector<uint32_t> indices;
+	Joint headJoint;
+	Time length;
+	std::vector<Keyframe> keyframes;
+};
+}
@@ -0,0 +1,96 @@
+#include "AnimatedModel.hpp"
+
+#include "Files/Files.hpp"
+#include "Resources/Resources.hpp"
+#include "AnimatedMesh.hpp"
+#include "AnimatedMeshData.hpp"
+
+namespace acid {
+std::shared_ptr<AnimatedModel> AnimatedModel::Create(const Node &node) {
+	if (auto resource = Resources::Get()->Find<AnimatedModel>(node))
+		return resource;
+
+	auto result = std::make_shared<AnimatedModel>("");
+	Resources::Get()->Add(node, std::dynamic_pointer_cast<Resource>(result));
+	node >> *result;
+	result->Load();
+	return result;
+}
+
+std::shared_ptr<AnimatedModel> AnimatedModel::Create(const std::filesystem::path &filename) {
+	AnimatedModel temp(filename, false);
+	Node node;
+	node << temp;
+	return Create(node);
+}
+
+std::shared_ptr<AnimatedModel> AnimatedModel::LoadAsync(const std::filesystem::path &filename) {
+	AnimatedModel temp(filename, false);
+	Node node;
+	node << temp;
+	return Resources::Get()->LoadAsync<AnimatedModel>(node);
+}
+
+AnimatedModel::AnimatedModel(std::filesystem::path filename, bool load) :
+	filename(std::move(filename)) {
+	if (load) {
+		Load();
+	}
+}
+
+std::size_t AnimatedModel::GetCpuMemoryUsage() const {
+	auto size = skinning.GetMemorySize() + skeleton.GetJointCount() * 2 * sizeof(Matrix4);
+	if (animation)
+		size += animation->GetMemorySize();
+	return size;
+}
+
+const Node &operator>>(const Node &node, AnimatedModel &model) {
+	node["filename"].Get(model.filename);
+	return node;
+}
+
+Node &operator<<(Node &node, const AnimatedModel &model) {
+	node["filename"].Set(model.filename);
+	return node;
+}
+
+void AnimatedModel::Load() {
+	Decode();
+	Upload();
+}
+
+void AnimatedModel::Decode() {
+	if (filename.empty()) {
+		return;
+	}
+
+#if defined(ACID_DEBUG)
+	auto debugStart = Time::Now();
+#endif
+
+	// A animated mesh cooked by AcidCooker is used in place of the COLLADA source.
+	auto cookedFilename = AnimatedMeshData::GetCookedFilename(filename);
+	auto data = Files::ExistsInPath(cookedFilename) ? AnimatedMeshData::Read(cookedFilename) : AnimatedMeshData::LoadCollada(filename, AnimatedMesh::MaxWeights);
+
+	skeleton = Skeleton(data.headJoint);
+	animation = std::make_unique<Animation>(data.length, data.keyframes, skeleton);
+	animation->Compress(MaxPositionError, MaxRotationError);
+	skinning = Skinning(data.vertices);
+	decodedVertices = std::move(data.vertices);
+	decodedIndices = std::move(data.indices);
+
+#if defined(ACID_DEBUG)
+	Log::Out("Animated model ", filename, " loaded in ", (Time::Now() - debugStart).AsMilliseconds<float>(), "ms\n");
+#endif
+}
+
+void AnimatedModel::Upload() {
+	if (decodedVertices.empty())
+		return;
+
+	Initialize(decodedVertices, decodedIndices);
+	decodedVertices = {};
+	decodedIndices = {};
+}
+}
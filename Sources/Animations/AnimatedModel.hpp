@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Models/Model.hpp"
+#include "Animation/Animation.hpp"
+#include "Geometry/VertexAnimated.hpp"
+#include "Skin/Skinning.hpp"
+
+namespace acid {
+/**
+ * @brief Resource that represents the skinned model, skeleton and animation of a animated mesh file.
+ * Nothing in it changes once loaded, so every {@link AnimatedMesh} playing the same file shares one copy and only keeps its own animator state.
+ */
+class ACID_EXPORT AnimatedModel : public Model::Registrar<AnimatedModel> {
+	inline static const bool Registered = Register("animated");
+public:
+	/**
+	 * Creates a new animated model, or finds one with the same values.
+	 * @param node The node to decode values from.
+	 * @return The animated model with the requested values.
+	 */
+	static std::shared_ptr<AnimatedModel> Create(const Node &node);
+
+	/**
+	 * Creates a new animated model, or finds one with the same values.
+	 * @param filename The file to load the animated model from.
+	 * @return The animated model with the requested values.
+	 */
+	static std::shared_ptr<AnimatedModel> Create(const std::filesystem::path &filename);
+
+	/**
+	 * Loads a animated model on the resource thread pool, or finds one with the same values.
+	 * @param filename The file to load the animated model from.
+	 * @return The animated model with the requested values, empty until {@link Resource#IsLoaded}.
+	 */
+	static std::shared_ptr<AnimatedModel> LoadAsync(const std::filesystem::path &filename);
+
+	/**
+	 * Creates a new animated model.
+	 * @param filename The file to load the animated model from.
+	 * @param load If this resource will be loaded immediately, otherwise {@link AnimatedModel#Load} can be called later.
+	 */
+	explicit AnimatedModel(std::filesystem::path filename, bool load = true);
+
+	std::size_t GetCpuMemoryUsage() const override;
+
+	const std::filesystem::path &GetFilename() const { return filename; }
+	const Skeleton &GetSkeleton() const { return skeleton; }
+	/**
+	 * Gets the animation of the model, compiled for its skeleton.
+	 * @return The animation, or nullptr if the model has not loaded.
+	 */
+	const Animation *GetAnimation() const { return animation.get(); }
+	const Skinning &GetSkinning() const { return skinning; }
+
+	friend const Node &operator>>(const Node &node, AnimatedModel &model);
+	friend Node &operator<<(Node &node, const AnimatedModel &model);
+
+	/// The max position and rotation error in radians allowed when compressing loaded animations.
+	constexpr static float MaxPositionError = 0.0001f;
+	constexpr static float MaxRotationError = 0.0005f;
+
+protected:
+	void Decode() override;
+	void Upload() override;
+
+private:
+	void Load();
+
+	std::filesystem::path filename;
+	Skeleton skeleton;
+	std::unique_ptr<Animation> animation;
+	Skinning skinning;
+
+	std::vector<VertexAnimated> decodedVertices;
+	std::vector<uint32_t> decodedIndices;
+};
+}
@@ -1,20 +1,64 @@
 #include "Animation.hpp"
 
 namespace acid {
-Animation::Animation(const Time &length, std::vector<Keyframe> keyframes) :
+Animation::Animation(const Time &length, std::vector<AnimationTrack> tracks) :
 	length(length),
-	keyframes(std::move(keyframes)) {
+	tracks(std::move(tracks)) {
+}
+
+Animation::Animation(const Time &length, const std::vector<Keyframe> &keyframes, const Skeleton &skeleton) :
+	length(length) {
+	tracks.reserve(skeleton.GetJointCount());
+
+	for (const auto &name : skeleton.GetNames()) {
+		std::vector<float> times;
+		std::vector<Vector3f> positions;
+		std::vector<Quaternion> rotations;
+
+		for (const auto &keyframe : keyframes) {
+			auto it = keyframe.GetPose().find(name);
+			if (it == keyframe.GetPose().end())
+				continue;
+
+			times.emplace_back(keyframe.GetTimeStamp().AsSeconds());
+			positions.emplace_back(it->second.GetPosition());
+			rotations.emplace_back(it->second.GetRotation());
+		}
+
+		tracks.emplace_back(std::move(times), std::move(positions), std::move(rotations));
+	}
+}
+
+void Animation::Sample(float time, const Skeleton &skeleton, std::vector<AnimationTrack::Cursor> &cursors, AnimationPose &pose) const {
+	const auto &bindPose = skeleton.GetBindPose();
+	cursors.resize(tracks.size());
+	pose.Resize(skeleton.GetJointCount());
+
+	for (uint32_t i = 0; i < skeleton.GetJointCount(); i++)
+		pose.SetJoint(i, i < tracks.size() && !tracks[i].IsEmpty() ? tracks[i].Sample(time, cursors[i], bindPose.GetJoint(i)) : bindPose.GetJoint(i));
+}
+
+void Animation::Compress(float positionError, float rotationError, bool packRotations) {
+	for (auto &track : tracks)
+		track.Compress(positionError, rotationError, packRotations);
+}
+
+std::size_t Animation::GetMemorySize() const {
+	std::size_t size = 0;
+	for (const auto &track : tracks)
+		size += track.GetMemorySize();
+	return size;
 }
 
 const Node &operator>>(const Node &node, Animation &animation) {
 	node["length"].Get(animation.length);
-	node["keyframes"].Get(animation.keyframes);
+	node["tracks"].Get(animation.tracks);
 	return node;
 }
 
 Node &operator<<(Node &node, const Animation &animation) {
 	node["length"].Set(animation.length);
-	node["keyframes"].Set(animation.keyframes);
+	node["tracks"].Set(animation.tracks);
 	return node;
 }
 }
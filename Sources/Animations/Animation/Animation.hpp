@@ -1,21 +1,32 @@
 #pragma once
 
 #include "Maths/Time.hpp"
+#include "Animations/Skeleton/Skeleton.hpp"
+#include "AnimationTrack.hpp"
 #include "Keyframe.hpp"
 
 namespace acid {
 /**
  * @brief Class that represents an animation that can be carried out by an animated entity.
- * It contains the length of the animation in seconds, and a list of {@link Keyframe}s.
+ * It contains the length of the animation in seconds, and a {@link AnimationTrack} for every joint of the skeleton it was compiled for.
  */
 class ACID_EXPORT Animation {
 public:
 	/**
 	 * Creates a new animation.
 	 * @param length The length of the animation.
+	 * @param tracks The track of each joint, in the order of the joints in the skeleton.
+	 */
+	Animation(const Time &length, std::vector<AnimationTrack> tracks);
+
+	/**
+	 * Creates a new animation by compiling keyframes into a track per joint of a skeleton.
+	 * Joint names are only looked up here, joints with no transforms in the keyframes are given empty tracks.
+	 * @param length The length of the animation.
 	 * @param keyframes All the keyframes for the animation, ordered by time of appearance in the animation.
+	 * @param skeleton The skeleton the animation will be applied to.
 	 */
-	Animation(const Time &length, std::vector<Keyframe> keyframes);
+	Animation(const Time &length, const std::vector<Keyframe> &keyframes, const Skeleton &skeleton);
 
 	/**
 	 * Gets the length of the animation.
@@ -24,16 +35,39 @@ public:
 	const Time &GetLength() const { return length; }
 
 	/**
-	 * Gets an array of the animation's keyframes. The array is ordered based on the order of the keyframes in the animation.
-	 * @return The array of the animation's keyframes.
+	 * Gets the tracks of the animation, indexed the same as the joints of the skeleton.
+	 * @return The tracks of the animation.
+	 */
+	const std::vector<AnimationTrack> &GetTracks() const { return tracks; }
+
+	/**
+	 * Samples the local-space transform of every joint at a time, joints with empty tracks are given their bind transform.
+	 * @param time The time in seconds.
+	 * @param skeleton The skeleton the animation was compiled for.
+	 * @param cursors The keys each track was last sampled at, resized to the amount of tracks and updated to the keys used.
+	 * @param pose The pose to write into, resized to the amount of joints.
+	 */
+	void Sample(float time, const Skeleton &skeleton, std::vector<AnimationTrack::Cursor> &cursors, AnimationPose &pose) const;
+
+	/**
+	 * Compresses every track of the animation, see {@link AnimationTrack#Compress}.
+	 * @param positionError The max distance a rebuilt position may be from a removed key.
+	 * @param rotationError The max angle in radians a rebuilt rotation may be from a removed key.
+	 * @param packRotations If rotations are stored with the smallest three encoding.
+	 */
+	void Compress(float positionError, float rotationError, bool packRotations = true);
+
+	/**
+	 * Gets the amount of memory the keys of every track use.
+	 * @return The size in bytes.
 	 */
-	const std::vector<Keyframe> &GetKeyframes() const { return keyframes; }
+	std::size_t GetMemorySize() const;
 
 	friend const Node &operator>>(const Node &node, Animation &animation);
 	friend Node &operator<<(Node &node, const Animation &animation);
 
 private:
 	Time length;
-	std::vector<Keyframe> keyframes;
+	std::vector<AnimationTrack> tracks;
 };
 }
@@ -0,0 +1,153 @@
+#include "AnimationPose.hpp"
+
+#include <algorithm>
+
+namespace acid {
+/**
+ * Gets one over the length of a quaternion from its squared length, which must be between 0.5 and 1.
+ * Blending unit quaternions along the shorter path never gives anything shorter, so Newton's method converges to float precision from a linear guess
+ * in three steps. std::sqrt may set errno, which keeps the compiler from vectorizing loops that call it.
+ * @param lengthSquared The squared length.
+ * @return The inverse length.
+ */
+static float InverseLength(float lengthSquared) {
+	auto result = 1.79f - 0.8f * lengthSquared;
+	result *= 1.5f - 0.5f * lengthSquared * result * result;
+	result *= 1.5f - 0.5f * lengthSquared * result * result;
+	result *= 1.5f - 0.5f * lengthSquared * result * result;
+	return result;
+}
+
+// The kernels take restricted pointers so the compiler knows the arrays never overlap and can vectorize the loops without runtime aliasing checks.
+static void Lerp(std::size_t count, const float *__restrict weights, float *__restrict a, const float *__restrict b) {
+	for (std::size_t i = 0; i < count; i++)
+		a[i] += (b[i] - a[i]) * weights[i];
+}
+
+static void Nlerp(std::size_t count, const float *__restrict weights, float *__restrict ax, float *__restrict ay, float *__restrict az,
+	float *__restrict aw, const float *__restrict bx, const float *__restrict by, const float *__restrict bz, const float *__restrict bw) {
+	for (std::size_t i = 0; i < count; i++) {
+		// A quaternion and its negation are the same rotation, the one closer to the first rotation is blended towards.
+		auto dot = ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i] + aw[i] * bw[i];
+		auto weightA = 1.0f - weights[i];
+		auto weightB = dot < 0.0f ? -weights[i] : weights[i];
+
+		auto x = ax[i] * weightA + bx[i] * weightB;
+		auto y = ay[i] * weightA + by[i] * weightB;
+		auto z = az[i] * weightA + bz[i] * weightB;
+		auto w = aw[i] * weightA + bw[i] * weightB;
+		auto inverseLength = InverseLength(x * x + y * y + z * z + w * w);
+
+		ax[i] = x * inverseLength;
+		ay[i] = y * inverseLength;
+		az[i] = z * inverseLength;
+		aw[i] = w * inverseLength;
+	}
+}
+
+static void SubtractValues(std::size_t count, float *__restrict a, const float *__restrict b) {
+	for (std::size_t i = 0; i < count; i++)
+		a[i] -= b[i];
+}
+
+static void SubtractRotations(std::size_t count, float *__restrict ax, float *__restrict ay, float *__restrict az, float *__restrict aw,
+	const float *__restrict rx, const float *__restrict ry, const float *__restrict rz, const float *__restrict rw) {
+	// The conjugate of the reference rotation multiplied with the rotation.
+	for (std::size_t i = 0; i < count; i++) {
+		auto x = rw[i] * ax[i] - rx[i] * aw[i] - ry[i] * az[i] + rz[i] * ay[i];
+		auto y = rw[i] * ay[i] - ry[i] * aw[i] - rz[i] * ax[i] + rx[i] * az[i];
+		auto z = rw[i] * az[i] - rz[i] * aw[i] - rx[i] * ay[i] + ry[i] * ax[i];
+		auto w = rw[i] * aw[i] + rx[i] * ax[i] + ry[i] * ay[i] + rz[i] * az[i];
+
+		ax[i] = x;
+		ay[i] = y;
+		az[i] = z;
+		aw[i] = w;
+	}
+}
+
+static void MultiplyAdd(std::size_t count, const float *__restrict weights, float *__restrict a, const float *__restrict b) {
+	for (std::size_t i = 0; i < count; i++)
+		a[i] += b[i] * weights[i];
+}
+
+static void AddRotations(std::size_t count, const float *__restrict weights, float *__restrict ax, float *__restrict ay, float *__restrict az,
+	float *__restrict aw, const float *__restrict dx, const float *__restrict dy, const float *__restrict dz, const float *__restrict dw) {
+	for (std::size_t i = 0; i < count; i++) {
+		// Blends from no rotation towards the difference, then applies the result after the rotation.
+		auto weightD = dw[i] < 0.0f ? -weights[i] : weights[i];
+		auto nx = dx[i] * weightD;
+		auto ny = dy[i] * weightD;
+		auto nz = dz[i] * weightD;
+		auto nw = 1.0f - weights[i] + dw[i] * weightD;
+		auto inverseLength = InverseLength(nx * nx + ny * ny + nz * nz + nw * nw);
+		nx *= inverseLength;
+		ny *= inverseLength;
+		nz *= inverseLength;
+		nw *= inverseLength;
+
+		auto x = ax[i] * nw + aw[i] * nx + ay[i] * nz - az[i] * ny;
+		auto y = ay[i] * nw + aw[i] * ny + az[i] * nx - ax[i] * nz;
+		auto z = az[i] * nw + aw[i] * nz + ax[i] * ny - ay[i] * nx;
+		auto w = aw[i] * nw - ax[i] * nx - ay[i] * ny - az[i] * nz;
+
+		ax[i] = x;
+		ay[i] = y;
+		az[i] = z;
+		aw[i] = w;
+	}
+}
+
+AnimationPose::AnimationPose(uint32_t jointCount) {
+	Resize(jointCount);
+}
+
+void AnimationPose::Resize(uint32_t jointCount) {
+	for (auto values : {&positionX, &positionY, &positionZ, &rotationX, &rotationY, &rotationZ})
+		values->resize(jointCount, 0.0f);
+	rotationW.resize(jointCount, 1.0f);
+}
+
+JointTransform AnimationPose::GetJoint(uint32_t index) const {
+	return {{positionX[index], positionY[index], positionZ[index]}, {rotationX[index], rotationY[index], rotationZ[index], rotationW[index]}};
+}
+
+void AnimationPose::SetJoint(uint32_t index, const JointTransform &transform) {
+	const auto &position = transform.GetPosition();
+	const auto &rotation = transform.GetRotation();
+	positionX[index] = position.x;
+	positionY[index] = position.y;
+	positionZ[index] = position.z;
+	rotationX[index] = rotation.x;
+	rotationY[index] = rotation.y;
+	rotationZ[index] = rotation.z;
+	rotationW[index] = rotation.w;
+}
+
+void AnimationPose::Blend(const AnimationPose &other, Span<const float> weights) {
+	auto count = std::min<std::size_t>(GetJointCount(), weights.size());
+	Lerp(count, weights.data(), positionX.data(), other.positionX.data());
+	Lerp(count, weights.data(), positionY.data(), other.positionY.data());
+	Lerp(count, weights.data(), positionZ.data(), other.positionZ.data());
+	Nlerp(count, weights.data(), rotationX.data(), rotationY.data(), rotationZ.data(), rotationW.data(), other.rotationX.data(), other.rotationY.data(),
+		other.rotationZ.data(), other.rotationW.data());
+}
+
+void AnimationPose::Subtract(const AnimationPose &reference) {
+	auto count = GetJointCount();
+	SubtractValues(count, positionX.data(), reference.positionX.data());
+	SubtractValues(count, positionY.data(), reference.positionY.data());
+	SubtractValues(count, positionZ.data(), reference.positionZ.data());
+	SubtractRotations(count, rotationX.data(), rotationY.data(), rotationZ.data(), rotationW.data(), reference.rotationX.data(), reference.rotationY.data(),
+		reference.rotationZ.data(), reference.rotationW.data());
+}
+
+void AnimationPose::Add(const AnimationPose &difference, Span<const float> weights) {
+	auto count = std::min<std::size_t>(GetJointCount(), weights.size());
+	MultiplyAdd(count, weights.data(), positionX.data(), difference.positionX.data());
+	MultiplyAdd(count, weights.data(), positionY.data(), difference.positionY.data());
+	MultiplyAdd(count, weights.data(), positionZ.data(), difference.positionZ.data());
+	AddRotations(count, weights.data(), rotationX.data(), rotationY.data(), rotationZ.data(), rotationW.data(), difference.rotationX.data(),
+		difference.rotationY.data(), difference.rotationZ.data(), difference.rotationW.data());
+}
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Utils/Span.hpp"
+#include "JointTransform.hpp"
+
+namespace acid {
+/**
+ * @brief Class that represents the local-space transform of every joint of a skeleton, indexed the same as the joints of the skeleton.
+ * Each component is stored in its own array so blending poses runs as branchless loops over whole arrays, which the compiler vectorizes.
+ * Rotations are blended with normalized linear interpolation, which for the small angles between poses is close to slerp and much cheaper.
+ */
+class ACID_EXPORT AnimationPose {
+public:
+	/**
+	 * Creates a new empty pose.
+	 */
+	AnimationPose() = default;
+
+	/**
+	 * Creates a new pose with every joint at the origin with no rotation.
+	 * @param jointCount The amount of joints.
+	 */
+	explicit AnimationPose(uint32_t jointCount);
+
+	/**
+	 * Changes the amount of joints in the pose, added joints are at the origin with no rotation.
+	 * @param jointCount The amount of joints.
+	 */
+	void Resize(uint32_t jointCount);
+
+	uint32_t GetJointCount() const { return static_cast<uint32_t>(positionX.size()); }
+
+	JointTransform GetJoint(uint32_t index) const;
+	void SetJoint(uint32_t index, const JointTransform &transform);
+
+	/**
+	 * Blends each joint of this pose towards the joint in another pose, the rotations in both poses must be unit quaternions.
+	 * @param other The pose to blend towards, with the same amount of joints.
+	 * @param weights How far to blend each joint, from 0 keeping this pose to 1 taking the other pose.
+	 */
+	void Blend(const AnimationPose &other, Span<const float> weights);
+
+	/**
+	 * Turns this pose into its difference from a reference pose, so it can be added on top of other poses with {@link AnimationPose#Add}.
+	 * @param reference The pose the difference is taken from, with the same amount of joints.
+	 */
+	void Subtract(const AnimationPose &reference);
+
+	/**
+	 * Adds a difference made by {@link AnimationPose#Subtract} on top of this pose, the difference rotation is applied after the rotation of this pose.
+	 * @param difference The difference to add, with the same amount of joints.
+	 * @param weights How much of the difference to add to each joint, from 0 to 1.
+	 */
+	void Add(const AnimationPose &difference, Span<const float> weights);
+
+private:
+	std::vector<float> positionX, positionY, positionZ;
+	std::vector<float> rotationX, rotationY, rotationZ, rotationW;
+};
+}
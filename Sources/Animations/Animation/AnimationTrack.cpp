@@ -0,0 +1,212 @@
+#include "AnimationTrack.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace acid {
+static constexpr float PackedRange = 0.70710678f; // The smallest three components of a unit quaternion are within 1 / sqrt(2).
+static constexpr float PackedSteps = 32767.0f;
+
+PackedQuaternion::PackedQuaternion(const Quaternion &quaternion) {
+	uint32_t largest = 0;
+	for (uint32_t i = 1; i < 4; i++) {
+		if (std::abs(quaternion[i]) > std::abs(quaternion[largest]))
+			largest = i;
+	}
+
+	// A quaternion and its negation are the same rotation, flipping it makes the dropped component positive.
+	auto sign = quaternion[largest] < 0.0f ? -1.0f : 1.0f;
+	for (uint32_t i = 0, j = 0; i < 4; i++) {
+		if (i == largest)
+			continue;
+
+		auto normalized = std::clamp(sign * quaternion[i] / PackedRange, -1.0f, 1.0f);
+		values[j++] = static_cast<uint16_t>(std::lround((normalized * 0.5f + 0.5f) * PackedSteps));
+	}
+
+	values[0] |= static_cast<uint16_t>((largest & 1) << 15);
+	values[1] |= static_cast<uint16_t>((largest >> 1) << 15);
+}
+
+Quaternion PackedQuaternion::Unpack() const {
+	auto largest = (values[0] >> 15) | ((values[1] >> 15) << 1);
+
+	Quaternion result;
+	auto sumSquared = 0.0f;
+	for (uint32_t i = 0, j = 0; i < 4; i++) {
+		if (i == static_cast<uint32_t>(largest))
+			continue;
+
+		auto component = (static_cast<float>(values[j++] & 0x7FFF) / PackedSteps * 2.0f - 1.0f) * PackedRange;
+		result[i] = component;
+		sumSquared += component * component;
+	}
+
+	result[largest] = std::sqrt(std::max(1.0f - sumSquared, 0.0f));
+	return result;
+}
+
+/**
+ * Finds the key at or before a time, and how far the time is towards the key after it.
+ * @param times The key times.
+ * @param time The time in seconds.
+ * @param cursor The key found last time, updated to the key found.
+ * @return The progression towards the next key, zero when the cursor is the last key.
+ */
+static float FindKey(const std::vector<float> &times, float time, uint32_t &cursor) {
+	auto count = static_cast<uint32_t>(times.size());
+	auto contains = [&](uint32_t key) {
+		return key < count && times[key] <= time && (key + 1 == count || time < times[key + 1]);
+	};
+
+	// Playback stays between the same keys or moves on to the next ones, so those are checked before searching.
+	if (contains(cursor + 1)) {
+		cursor++;
+	} else if (!contains(cursor)) {
+		auto next = static_cast<uint32_t>(std::upper_bound(times.begin(), times.end(), time) - times.begin());
+		cursor = next == 0 ? 0 : next - 1;
+	}
+
+	if (cursor + 1 >= count)
+		return 0.0f;
+	return std::clamp((time - times[cursor]) / (times[cursor + 1] - times[cursor]), 0.0f, 1.0f);
+}
+
+/**
+ * Removes the keys of a channel that interpolating between the kept keys around them rebuilds within an error.
+ * @tparam T The value type.
+ * @tparam Interpolate The function interpolating two values.
+ * @tparam Error The function measuring the error between two values.
+ */
+template<typename T, typename Interpolate, typename Error>
+static void ReduceKeys(std::vector<float> &times, std::vector<T> &values, float maxError, const Interpolate &interpolate, const Error &error) {
+	if (times.size() < 2)
+		return;
+
+	std::vector<uint32_t> kept = {0};
+	uint32_t anchor = 0;
+
+	for (uint32_t candidate = 2; candidate < times.size(); candidate++) {
+		// Tries to span from the anchor to the candidate, every original key in between must be rebuilt within the error.
+		auto fits = true;
+		for (auto key = anchor + 1; key < candidate && fits; key++) {
+			auto progression = (times[key] - times[anchor]) / (times[candidate] - times[anchor]);
+			fits = error(interpolate(values[anchor], values[candidate], progression), values[key]) <= maxError;
+		}
+
+		if (!fits) {
+			anchor = candidate - 1;
+			kept.emplace_back(anchor);
+		}
+	}
+
+	// A channel that never changes is kept as a single key.
+	auto last = static_cast<uint32_t>(times.size() - 1);
+	if (kept.size() > 1 || error(values[0], values[last]) > maxError)
+		kept.emplace_back(last);
+
+	for (uint32_t i = 0; i < kept.size(); i++) {
+		times[i] = times[kept[i]];
+		values[i] = values[kept[i]];
+	}
+
+	times.resize(kept.size());
+	values.resize(kept.size());
+	times.shrink_to_fit();
+	values.shrink_to_fit();
+}
+
+AnimationTrack::AnimationTrack(std::vector<float> times, std::vector<Vector3f> positions, std::vector<Quaternion> rotations) :
+	positionTimes(times),
+	positions(std::move(positions)),
+	rotationTimes(std::move(times)),
+	rotations(std::move(rotations)) {
+}
+
+JointTransform AnimationTrack::Sample(float time, const JointTransform &bindTransform) const {
+	Cursor cursor;
+	return Sample(time, cursor, bindTransform);
+}
+
+JointTransform AnimationTrack::Sample(float time, Cursor &cursor, const JointTransform &bindTransform) const {
+	return {SamplePosition(time, cursor.position, bindTransform.GetPosition()), SampleRotation(time, cursor.rotation, bindTransform.GetRotation())};
+}
+
+void AnimationTrack::Compress(float positionError, float rotationError, bool packRotations) {
+	ReduceKeys(positionTimes, positions, positionError, [](const Vector3f &a, const Vector3f &b, float progression) {
+		return JointTransform::Interpolate(a, b, progression);
+	}, [](const Vector3f &a, const Vector3f &b) {
+		return a.Distance(b);
+	});
+
+	if (IsPacked()) {
+		rotations.resize(packedRotations.size());
+		std::transform(packedRotations.begin(), packedRotations.end(), rotations.begin(), [](const PackedQuaternion &packed) {
+			return packed.Unpack();
+		});
+		packedRotations.clear();
+	}
+
+	ReduceKeys(rotationTimes, rotations, rotationError, [](const Quaternion &a, const Quaternion &b, float progression) {
+		return a.Slerp(b, progression);
+	}, [](const Quaternion &a, const Quaternion &b) {
+		return 2.0f * std::acos(std::min(std::abs(a.Normalize().Dot(b.Normalize())), 1.0f));
+	});
+
+	if (packRotations) {
+		packedRotations.resize(rotations.size());
+		std::transform(rotations.begin(), rotations.end(), packedRotations.begin(), [](const Quaternion &rotation) {
+			return PackedQuaternion(rotation);
+		});
+		rotations.clear();
+		rotations.shrink_to_fit();
+	}
+}
+
+std::size_t AnimationTrack::GetMemorySize() const {
+	return sizeof(float) * (positionTimes.size() + rotationTimes.size()) + sizeof(Vector3f) * positions.size() + sizeof(Quaternion) * rotations.size() +
+		sizeof(PackedQuaternion) * packedRotations.size();
+}
+
+Vector3f AnimationTrack::SamplePosition(float time, uint32_t &cursor, const Vector3f &bindPosition) const {
+	if (positionTimes.empty())
+		return bindPosition;
+
+	auto progression = FindKey(positionTimes, time, cursor);
+	if (progression == 0.0f)
+		return positions[cursor];
+	return JointTransform::Interpolate(positions[cursor], positions[cursor + 1], progression);
+}
+
+Quaternion AnimationTrack::SampleRotation(float time, uint32_t &cursor, const Quaternion &bindRotation) const {
+	if (rotationTimes.empty())
+		return bindRotation;
+
+	auto progression = FindKey(rotationTimes, time, cursor);
+	if (progression == 0.0f)
+		return GetRotation(cursor);
+	return GetRotation(cursor).Slerp(GetRotation(cursor + 1), progression);
+}
+
+const Node &operator>>(const Node &node, AnimationTrack &track) {
+	node["positionTimes"].Get(track.positionTimes);
+	node["positions"].Get(track.positions);
+	node["rotationTimes"].Get(track.rotationTimes);
+	node["rotations"].Get(track.rotations);
+	track.packedRotations.clear();
+	return node;
+}
+
+Node &operator<<(Node &node, const AnimationTrack &track) {
+	// Packed rotations are written unpacked, tracks can be compressed again after being read.
+	std::vector<Quaternion> rotations(track.rotationTimes.size());
+	for (std::size_t i = 0; i < rotations.size(); i++)
+		rotations[i] = track.GetRotation(i);
+
+	node["positionTimes"].Set(track.positionTimes);
+	node["positions"].Set(track.positions);
+	node["rotationTimes"].Set(track.rotationTimes);
+	node["rotations"].Set(rotations);
+	return node;
+}
+}
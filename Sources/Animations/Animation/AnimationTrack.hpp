@@ -0,0 +1,103 @@
+#pragma once
+
+#include "JointTransform.hpp"
+
+namespace acid {
+/**
+ * @brief A unit quaternion packed into 48 bits with the smallest three encoding. The largest component is dropped and rebuilt from the other three,
+ * which are each stored in 15 bits, the index of the dropped component is kept in the remaining two bits.
+ */
+class ACID_EXPORT PackedQuaternion {
+public:
+	PackedQuaternion() = default;
+	explicit PackedQuaternion(const Quaternion &quaternion);
+
+	Quaternion Unpack() const;
+
+private:
+	uint16_t values[3] = {};
+};
+
+/**
+ * @brief Class that represents the keys of one joint over an animation. Positions and rotations are separate channels with their own key times,
+ * so each channel can drop the keys it does not need. Times and values are stored in separate arrays, so sampling a track only touches the values of that joint.
+ */
+class ACID_EXPORT AnimationTrack {
+public:
+	/**
+	 * @brief The keys a track was last sampled at, kept by the caller so playback does not search for keys each frame.
+	 */
+	class Cursor {
+	public:
+		uint32_t position = 0;
+		uint32_t rotation = 0;
+	};
+
+	/**
+	 * Creates a new empty track, joints without keys keep their bind transform.
+	 */
+	AnimationTrack() = default;
+
+	/**
+	 * Creates a new track where both channels share key times.
+	 * @param times The time in seconds of each key, in increasing order.
+	 * @param positions The local-space position of the joint at each key.
+	 * @param rotations The local-space rotation of the joint at each key.
+	 */
+	AnimationTrack(std::vector<float> times, std::vector<Vector3f> positions, std::vector<Quaternion> rotations);
+
+	/**
+	 * Interpolates the joint transform between the keys before and after a time, times outside of the keys are clamped to the first or last key.
+	 * @param time The time in seconds.
+	 * @param bindTransform The transform a channel without keys keeps.
+	 * @return The local-space transform of the joint.
+	 */
+	JointTransform Sample(float time, const JointTransform &bindTransform = {}) const;
+
+	/**
+	 * Interpolates the joint transform at a time, starting the key search from where the cursor was left.
+	 * The keys at the cursor and after it are checked first, a binary search is only used when the time has jumped, such as after a seek or a loop.
+	 * @param time The time in seconds.
+	 * @param cursor The keys last sampled, updated to the keys used for this time.
+	 * @param bindTransform The transform a channel without keys keeps.
+	 * @return The local-space transform of the joint.
+	 */
+	JointTransform Sample(float time, Cursor &cursor, const JointTransform &bindTransform = {}) const;
+
+	/**
+	 * Removes keys that interpolating between their neighbours rebuilds within an error, and optionally packs rotations into 48 bits each.
+	 * Errors are measured on this joint alone, they grow along a chain of joints so bounds should be kept small.
+	 * @param positionError The max distance a rebuilt position may be from the removed key.
+	 * @param rotationError The max angle in radians a rebuilt rotation may be from the removed key.
+	 * @param packRotations If rotations are stored with the smallest three encoding, adding up to about 1e-4 radians of error.
+	 */
+	void Compress(float positionError, float rotationError, bool packRotations = true);
+
+	/**
+	 * Gets the amount of memory the keys of this track use.
+	 * @return The size in bytes.
+	 */
+	std::size_t GetMemorySize() const;
+
+	bool IsEmpty() const { return positionTimes.empty() && rotationTimes.empty(); }
+	bool IsPacked() const { return !packedRotations.empty(); }
+
+	const std::vector<float> &GetPositionTimes() const { return positionTimes; }
+	const std::vector<Vector3f> &GetPositions() const { return positions; }
+	const std::vector<float> &GetRotationTimes() const { return rotationTimes; }
+	Quaternion GetRotation(std::size_t index) const { return IsPacked() ? packedRotations[index].Unpack() : rotations[index]; }
+
+	friend const Node &operator>>(const Node &node, AnimationTrack &track);
+	friend Node &operator<<(Node &node, const AnimationTrack &track);
+
+private:
+	Vector3f SamplePosition(float time, uint32_t &cursor, const Vector3f &bindPosition) const;
+	Quaternion SampleRotation(float time, uint32_t &cursor, const Quaternion &bindRotation) const;
+
+	std::vector<float> positionTimes;
+	std::vector<Vector3f> positions;
+	std::vector<float> rotationTimes;
+	std::vector<Quaternion> rotations;
+	std::vector<PackedQuaternion> packedRotations;
+};
+}
@@ -0,0 +1,98 @@
+#include "AnimationLayer.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace acid {
+AnimationLayer::AnimationLayer(Mode mode, float weight) :
+	mode(mode),
+	weight(weight) {
+}
+
+void AnimationLayer::Play(const Animation *animation, const Time &fadeTime) {
+	if (animation && current.animation && fadeTime > 0s) {
+		// Swapping keeps the storage of both playbacks, a fade already running is cut off.
+		std::swap(previous, current);
+		this->fadeTime = fadeTime;
+		fadeElapsed = 0s;
+	} else {
+		previous.animation = nullptr;
+	}
+
+	current.animation = animation;
+	current.time = 0s;
+	current.cursors.clear();
+	current.reference.Resize(0);
+}
+
+void AnimationLayer::IncreaseTime(const Time &delta) {
+	current.IncreaseTime(delta);
+
+	if (previous.animation) {
+		previous.IncreaseTime(delta);
+		fadeElapsed += delta;
+
+		if (fadeElapsed >= fadeTime)
+			previous.animation = nullptr;
+	}
+}
+
+void AnimationLayer::Sample(const Skeleton &skeleton, AnimationPose &pose) {
+	if (!IsFading()) {
+		current.Sample(mode, skeleton, pose);
+		return;
+	}
+
+	previous.Sample(mode, skeleton, pose);
+	current.Sample(mode, skeleton, fadePose);
+	fadeWeights.assign(skeleton.GetJointCount(), static_cast<float>(fadeElapsed / fadeTime));
+	pose.Blend(fadePose, fadeWeights);
+}
+
+void AnimationLayer::CalculateWeights(uint32_t jointCount, std::vector<float> &weights) const {
+	weights.assign(jointCount, weight);
+
+	for (std::size_t i = 0; i < std::min<std::size_t>(jointCount, mask.size()); i++)
+		weights[i] *= mask[i];
+}
+
+std::vector<float> AnimationLayer::CreateMask(const Skeleton &skeleton, uint32_t joint, float weight) {
+	const auto &parents = skeleton.GetParents();
+	std::vector<float> mask(skeleton.GetJointCount(), 0.0f);
+
+	// Joints are stored depth first, so the branch runs from the joint until a joint whose parent comes before it.
+	mask[joint] = weight;
+	for (auto i = joint + 1; i < skeleton.GetJointCount() && parents[i] >= static_cast<int32_t>(joint); i++)
+		mask[i] = weight;
+
+	return mask;
+}
+
+void AnimationLayer::Playback::IncreaseTime(const Time &delta) {
+	if (!animation) return;
+
+	// A animation without length has a single pose, wrapping by its length would make the time NaN.
+	if (animation->GetLength() <= Time()) {
+		time = Time();
+		return;
+	}
+
+	time += delta;
+
+	if (time > animation->GetLength())
+		time = Time::Seconds(std::fmod(time.AsSeconds(), animation->GetLength().AsSeconds()));
+}
+
+void AnimationLayer::Playback::Sample(Mode mode, const Skeleton &skeleton, AnimationPose &pose) {
+	animation->Sample(time.AsSeconds(), skeleton, cursors, pose);
+
+	if (mode == Mode::Additive) {
+		if (reference.GetJointCount() != skeleton.GetJointCount()) {
+			std::vector<AnimationTrack::Cursor> referenceCursors;
+			animation->Sample(0.0f, skeleton, referenceCursors, reference);
+		}
+
+		pose.Subtract(reference);
+	}
+}
+}
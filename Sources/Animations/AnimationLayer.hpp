@@ -0,0 +1,116 @@
+#pragma once
+
+#include "Maths/Time.hpp"
+#include "Animation/Animation.hpp"
+
+namespace acid {
+/**
+ * @brief Class that represents one layer of animation played by an {@link Animator}, layers are applied over each other in order.
+ * An override layer blends its pose over the layers below it, an additive layer adds the difference of its pose from the first frame of its animation.
+ * The weight of a layer can be masked per joint, so a layer can for instance only move the upper body.
+ * Changing the animation of a layer can cross-fade from the animation that was playing.
+ */
+class ACID_EXPORT AnimationLayer {
+public:
+	enum class Mode {
+		Override, Additive
+	};
+
+	/**
+	 * Creates a new animation layer.
+	 * @param mode How the pose of the layer is applied over the layers below it.
+	 * @param weight How much of the pose of the layer is applied, from 0 to 1.
+	 */
+	explicit AnimationLayer(Mode mode = Mode::Override, float weight = 1.0f);
+
+	/**
+	 * Starts playing an animation from the beginning.
+	 * @param animation The animation to play, or nullptr to stop the layer.
+	 * @param fadeTime The time to cross-fade from the animation playing before, the change is instant when either animation is nullptr.
+	 */
+	void Play(const Animation *animation, const Time &fadeTime = 0s);
+
+	/**
+	 * Increases the time of the animation playing, and of the animation being faded out. Animations reaching their end loop back to the start.
+	 * @param delta The time to increase by.
+	 */
+	void IncreaseTime(const Time &delta);
+
+	/**
+	 * Samples the pose of the layer, cross-faded if a fade is running. Additive layers give the difference from the first frame of their animation.
+	 * @param skeleton The skeleton the animations were compiled for.
+	 * @param pose The pose to write into.
+	 */
+	void Sample(const Skeleton &skeleton, AnimationPose &pose);
+
+	/**
+	 * Calculates the weight the layer is applied with to each joint, from the weight of the layer and its mask.
+	 * @param jointCount The amount of joints.
+	 * @param weights The weights to write into, resized to the amount of joints.
+	 */
+	void CalculateWeights(uint32_t jointCount, std::vector<float> &weights) const;
+
+	/**
+	 * Creates a mask that includes a joint and every joint below it.
+	 * @param skeleton The skeleton the mask is for.
+	 * @param joint The index of the joint at the top of the masked branch.
+	 * @param weight The weight of joints in the branch, joints outside of it are given 0.
+	 * @return The mask.
+	 */
+	static std::vector<float> CreateMask(const Skeleton &skeleton, uint32_t joint, float weight = 1.0f);
+
+	const Animation *GetAnimation() const { return current.animation; }
+
+	const Time &GetTime() const { return current.time; }
+	void SetTime(const Time &time) { current.time = time; }
+
+	bool IsFading() const { return previous.animation != nullptr; }
+
+	/**
+	 * Gets if the layer replaces the pose below it entirely, so the pose below does not need to be evaluated.
+	 * @return If the layer is a full weight override layer without a mask.
+	 */
+	bool IsOpaque() const { return mode == Mode::Override && weight >= 1.0f && mask.empty(); }
+
+	Mode GetMode() const { return mode; }
+	void SetMode(Mode mode) { this->mode = mode; }
+
+	float GetWeight() const { return weight; }
+	void SetWeight(float weight) { this->weight = weight; }
+
+	/**
+	 * Gets the weight of each joint, multiplied with the weight of the layer. Joints are indexed the same as the skeleton, joints past the end of the mask are given 1.
+	 * @return The mask, empty if every joint is weighted the same.
+	 */
+	const std::vector<float> &GetMask() const { return mask; }
+	void SetMask(std::vector<float> mask) { this->mask = std::move(mask); }
+
+private:
+	/**
+	 * @brief An animation playing on the layer, with the keys it was last sampled at.
+	 */
+	class Playback {
+	public:
+		void IncreaseTime(const Time &delta);
+		void Sample(Mode mode, const Skeleton &skeleton, AnimationPose &pose);
+
+		const Animation *animation = nullptr;
+		Time time;
+		std::vector<AnimationTrack::Cursor> cursors;
+		// The first frame of the animation, additive layers add the difference from it.
+		AnimationPose reference;
+	};
+
+	Mode mode;
+	float weight;
+	std::vector<float> mask;
+
+	Playback current;
+	Playback previous;
+	Time fadeTime;
+	Time fadeElapsed;
+
+	AnimationPose fadePose;
+	std::vector<float> fadeWeights;
+};
+}
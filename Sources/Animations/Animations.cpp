@@ -0,0 +1,22 @@
+#include "Animations.hpp"
+
+#include "Scenes/Scenes.hpp"
+#include "AnimatedMesh.hpp"
+
+namespace acid {
+Animations::Animations() {
+}
+
+void Animations::Update() {
+	if (Scenes::Get()->GetScene()->IsPaused()) return;
+
+	instances.clear();
+	for (auto animatedMesh : Scenes::Get()->GetScene()->QueryComponents<AnimatedMesh>()) {
+		// Meshes share the skeleton of their model, so meshes of the same model playing in step evaluate one pose.
+		if (const auto &model = animatedMesh->GetModel(); model && model->IsLoaded())
+			instances.push_back({&animatedMesh->GetAnimator(), &model->GetSkeleton(), animatedMesh->GetJointMatrices()});
+	}
+
+	evaluator.Evaluate(Engine::Get()->GetDelta(), instances, &Engine::Get()->GetThreadPool());
+}
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Scenes/System.hpp"
+#include "CrowdEvaluator.hpp"
+
+namespace acid {
+/**
+ * @brief A system that gathers every animated mesh in the scene each update and calculates their poses together with a {@link CrowdEvaluator}.
+ * Animated meshes in a scene without this system calculate their own pose as they update.
+ */
+class ACID_EXPORT Animations : public System {
+public:
+	Animations();
+
+	void Update() override;
+
+	const CrowdEvaluator &GetEvaluator() const { return evaluator; }
+
+private:
+	CrowdEvaluator evaluator;
+	std::vector<CrowdEvaluator::Instance> instances;
+};
+}
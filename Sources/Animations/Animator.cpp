@@ -1,81 +1,74 @@
 #include "Animator.hpp"
 
-#include "Engine/Engine.hpp"
-#include "Utils/Enumerate.hpp"
+#include <algorithm>
 
 namespace acid {
-void Animator::Update(const Joint &rootJoint, std::vector<Matrix4> &jointMatrices) {
-	if (!currentAnimation) return;
-
-	IncreaseAnimationTime();
-	auto currentPose = CalculateCurrentAnimationPose();
-	CalculateJointPose(currentPose, rootJoint, {}, jointMatrices);
+Animator::Animator() :
+	layers(1) {
 }
 
-void Animator::IncreaseAnimationTime() {
-	animationTime += Engine::Get()->GetDelta();
-
-	if (animationTime > currentAnimation->GetLength())
-		animationTime = Time::Seconds(std::fmod(animationTime.AsSeconds(), currentAnimation->GetLength().AsSeconds()));
+void Animator::Update(const Time &delta, const Skeleton &skeleton, Span<Matrix4> jointMatrices) {
+	IncreaseAnimationTime(delta);
+	CalculateCurrentAnimationPose(skeleton, jointMatrices);
 }
 
-std::map<std::string, Matrix4> Animator::CalculateCurrentAnimationPose() const {
-	auto [frame0, frame1] = GetPreviousAndNextFrames();
-	auto progression = CalculateProgression(frame0, frame1);
-	return InterpolatePoses(frame0, frame1, progression);
+void Animator::IncreaseAnimationTime(const Time &delta) {
+	for (auto &layer : layers)
+		layer.IncreaseTime(delta);
 }
 
-std::pair<Keyframe, Keyframe> Animator::GetPreviousAndNextFrames() const {
-	const auto &allFrames = currentAnimation->GetKeyframes();
-	const Keyframe *previousFrame = nullptr;
-	const Keyframe *nextFrame = nullptr;
+void Animator::CalculateCurrentAnimationPose(const Skeleton &skeleton, Span<Matrix4> jointMatrices) {
+	auto playing = [](const AnimationLayer &layer) {
+		return layer.GetAnimation() != nullptr;
+	};
 
-	for (const auto [i, frame] : Enumerate(allFrames)) {
-		nextFrame = &frame;
-		if (frame.GetTimeStamp() > animationTime)
-			break;
+	if (std::none_of(layers.begin(), layers.end(), playing)) return;
 
-		previousFrame = &frame;
-	}
+	// Layers under the last opaque layer would be overwritten, so evaluation starts at it or at the bind pose.
+	auto first = std::find_if(layers.rbegin(), layers.rend(), [&](const AnimationLayer &layer) {
+		return playing(layer) && layer.IsOpaque();
+	});
 
-	return {*previousFrame, *nextFrame};
-}
+	if (first == layers.rend())
+		pose = skeleton.GetBindPose();
 
-float Animator::CalculateProgression(const Keyframe &previousFrame, const Keyframe &nextFrame) const {
-	auto totalTime = nextFrame.GetTimeStamp() - previousFrame.GetTimeStamp();
-	auto currentTime = animationTime - previousFrame.GetTimeStamp();
-	return static_cast<float>(currentTime / totalTime);
-}
+	for (auto it = first == layers.rend() ? layers.begin() : first.base() - 1; it != layers.end(); ++it) {
+		if (!playing(*it)) continue;
 
-std::map<std::string, Matrix4> Animator::InterpolatePoses(const Keyframe &previousFrame, const Keyframe &nextFrame, float progression) const {
-	std::map<std::string, Matrix4> currentPose;
-	auto where = currentPose.end();
+		if (it->IsOpaque()) {
+			it->Sample(skeleton, pose);
+			continue;
+		}
 
-	for (const auto &[name, joint] : previousFrame.GetPose()) {
-		auto previousTransform = previousFrame.GetPose().find(name)->second;
-		auto nextTransform = nextFrame.GetPose().find(name)->second;
-		auto currentTransform = JointTransform::Interpolate(previousTransform, nextTransform, progression);
-		where = currentPose.insert(where, {name, currentTransform.GetLocalTransform()});
+		it->Sample(skeleton, layerPose);
+		it->CalculateWeights(skeleton.GetJointCount(), weights);
+
+		if (it->GetMode() == AnimationLayer::Mode::Override)
+			pose.Blend(layerPose, weights);
+		else
+			pose.Add(layerPose, weights);
 	}
 
-	return currentPose;
+	skeleton.CalculateJointMatrices(pose, modelTransforms, jointMatrices);
 }
 
-void Animator::CalculateJointPose(const std::map<std::string, Matrix4> &currentPose, const Joint &joint, const Matrix4 &parentTransform, std::vector<Matrix4> &jointMatrices) {
-	auto currentLocalTransform = currentPose.find(joint.GetName())->second;
-	auto currentTransform = parentTransform * currentLocalTransform;
-
-	for (const auto &childJoint : joint.GetChildren())
-		CalculateJointPose(currentPose, childJoint, currentTransform, jointMatrices);
+bool Animator::IsPlayingSingleAnimation() const {
+	const auto &base = layers.front();
+	return layers.size() == 1 && base.GetAnimation() && base.IsOpaque() && !base.IsFading();
+}
 
-	currentTransform = currentTransform * joint.GetInverseBindTransform();
+void Animator::DoAnimation(const Animation *animation, const Time &fadeTime) {
+	layers.front().Play(animation, fadeTime);
+}
 
-	if (joint.GetIndex() < jointMatrices.size())
-		jointMatrices[joint.GetIndex()] = currentTransform;
+AnimationLayer &Animator::AddLayer(AnimationLayer::Mode mode, float weight) {
+	return layers.emplace_back(mode, weight);
 }
 
-void Animator::DoAnimation(Animation *animation) {
-	animationTime = 0s;
-	currentAnimation = animation;
+void Animator::RemoveLayer(std::size_t index) {
+	if (index == 0 || index >= layers.size())
+		return;
+
+	layers.erase(layers.begin() + static_cast<std::ptrdiff_t>(index));
 }
 }
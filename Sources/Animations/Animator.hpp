@@ -1,122 +1,93 @@
 #pragma once
 
-#include "Maths/Time.hpp"
-#include "Animation/Animation.hpp"
-#include "Skeleton/Joint.hpp"
+#include "Utils/Span.hpp"
+#include "AnimationLayer.hpp"
 
 namespace acid {
 /**
- * @brief Class that contains all the functionality to apply an animation to an animated entity.
+ * @brief Class that contains all the functionality to apply animations to an animated entity.
  * An Animator instance is associated with just one animated entity.
- * It also keeps track of the running time (in seconds) of the current animation,
- * along with a reference to the currently playing animation for the corresponding entity.
+ * It plays a stack of {@link AnimationLayer}, the first layer is the base layer changed with {@link Animator#DoAnimation},
+ * the layers added after it are blended or added over the layers below them.
  *
  * An Animator instance needs to be updated every frame, in order for it to keep updating the animation pose of the associated entity.
- * The currently playing animation can be changed at any time using {@link Animator#DoAnimation}.
- * The Animator will keep looping the current animation until a new animation is chosen.
- * The Animator calculates the desired current animation pose by interpolating between the previous and next keyframes of the animation
- * (based on the current animation time). The Animator then updates the transforms all of the joints each frame to match the current desired animation pose.
+ * The Animator will keep looping the animation of each layer until a new animation is chosen.
+ * Layers sample the track of every joint, continuing from the keys used last frame, and the pose is built walking the skeleton from the root joint
+ * to the leaves in one pass, since every parent joint is stored before its children. No allocations or name lookups are made once the first pose is built.
  */
 class ACID_EXPORT Animator {
 public:
+	Animator();
+
 	/**
-	 * This method should be called each frame to update the animation currently being played. This increases the animation time (and loops it back to zero if necessary),
-	 * finds the pose that the entity should be in at that time of the animation, and then applied that pose to all the entity's joints.
-	 * @param rootJoint The root joint of the joint hierarchy which makes up the "skeleton" of the entity.
+	 * This method should be called each frame to update the animations being played. This increases the animation times (and loops them back to zero if necessary),
+	 * and then calculates the pose of the skeleton at those times.
+	 * @param delta The time passed since the last update.
+	 * @param skeleton The skeleton of the entity, the animations must have been compiled for it.
 	 * @param jointMatrices The transforms that get loaded up to the shader and is used to deform the vertices of the "skin".
 	 */
-	void Update(const Joint &rootJoint, std::vector<Matrix4> &jointMatrices);
+	void Update(const Time &delta, const Skeleton &skeleton, Span<Matrix4> jointMatrices);
 
 	/**
-	 * Increases the current animation time which allows the animation to progress. If the current animation has reached the end then the timer is reset, causing the animation to loop.
+	 * Increases the time of every layer which allows the animations to progress. Animations that reached their end are reset, causing them to loop.
+	 * @param delta The time to increase the animation times by.
 	 */
-	void IncreaseAnimationTime();
+	void IncreaseAnimationTime(const Time &delta);
 
 	/**
-	 * This method returns the current animation pose of the entity. It returns
-	 * the desired local-space transforms for all the joints in a map, indexed
-	 * by the name of the joint that they correspond to.
-	 *
-	 * The pose is calculated based on the previous and next keyframes in the
-	 * current animation. Each keyframe provides the desired pose at a certain
-	 * time in the animation, so the animated pose for the current time can be
-	 * calculated by interpolating between the previous and next keyframe.
+	 * Calculates the pose of the skeleton at the current animation times.
 	 *
-	 * This method first finds the previous and next keyframe, calculates how far
-	 * between the two the current animation is, and then calculated the pose
-	 * for the current animation time by interpolating between the transforms at
-	 * those keyframes.
-	 *
-	 * @return The current pose as a map of the desired local-space transforms for all the joints.
-	 * The transforms are indexed by the name ID of the joint that they should be applied to. </returns>
+	 * The layers are applied over the bind pose from the first to the last, layers below a full weight override layer are skipped.
+	 * The local-space pose is then turned into the transforms loaded up to the vertex shader by {@link Skeleton#CalculateJointMatrices}.
+	 * Nothing is written when no layer is playing an animation.
+	 * @param skeleton The skeleton of the entity, the animations must have been compiled for it.
+	 * @param jointMatrices The transforms that get loaded up to the shader, joints with a matrix index outside of the span are skipped.
 	 */
-	std::map<std::string, Matrix4> CalculateCurrentAnimationPose() const;
+	void CalculateCurrentAnimationPose(const Skeleton &skeleton, Span<Matrix4> jointMatrices);
 
 	/**
-	 * Finds the previous keyframe in the animation and the next keyframe in the animation, and returns them in an array of length 2.
-	 * If there is no  previous frame (perhaps current animation time is 0.5 and the first keyframe is at time 1.5)
-	 * then the next keyframe is used as both the previous and next keyframe. The reverse happens if there is no next keyframe.
-	 * @return The previous and next keyframes, in an array which therefore will always have a length of 2.
+	 * Gets if the pose only depends on the animation of the base layer and its time, so animators playing the same animation at the same time on the same skeleton
+	 * calculate the same pose.
+	 * @return If a single animation is playing at full weight.
 	 */
-	std::pair<Keyframe, Keyframe> GetPreviousAndNextFrames() const;
+	bool IsPlayingSingleAnimation() const;
 
-	/**
-	 * Calculates how far between the previous and next keyframe the current animation time is, and returns it as a value between 0 and 1.
-	 * @param previousFrame The previous keyframe in the animation.
-	 * @param nextFrame The next keyframe in the animation.
-	 * </param>
-	 * @return A number between 0 and 1 indicating how far between the two keyframes the current animation time is.
-	 */
-	float CalculateProgression(const Keyframe &previousFrame, const Keyframe &nextFrame) const;
+	const Animation *GetCurrentAnimation() const { return layers.front().GetAnimation(); }
+
+	const Time &GetAnimationTime() const { return layers.front().GetTime(); }
+	void SetAnimationTime(const Time &animationTime) { layers.front().SetTime(animationTime); }
 
 	/**
-	 * Calculates all the local-space joint transforms for the desired current pose by interpolating between
-	 * the transforms at the previous and next keyframes.
-	 * @param previousFrame The previous keyframe in the animation.
-	 * @param nextFrame The next keyframe in the animation.
-	 * @param progression A number between 0 and 1 indicating how far between the previous and next keyframes the current animation time is.
-	 * </param>
-	 * @return The local-space transforms for all the joints for the desired current pose.
-	 * They are returned in a map, indexed by the name of the joint to which they should be applied. </returns>
+	 * Indicates that the entity should carry out the given animation on the base layer. The new animation starts from the beginning.
+	 * @param animation The new animation to carry out.
+	 * @param fadeTime The time to cross-fade from the animation playing before.
 	 */
-	std::map<std::string, Matrix4> InterpolatePoses(const Keyframe &previousFrame, const Keyframe &nextFrame, float progression) const;
+	void DoAnimation(const Animation *animation, const Time &fadeTime = 0s);
 
 	/**
-	 * This method applies the current pose to a given joint, and all of its descendants.
-	 * It does this by getting the desired local-transform for the
-	 * current joint, before applying it to the joint. Before applying the
-	 * transformations it needs to be converted from local-space to model-space
-	 * (so that they are relative to the model's origin, rather than relative to
-	 * the parent joint). This can be done by multiplying the local-transform of
-	 * the joint with the model-space transform of the parent joint.
-	 *
-	 * The same thing is then done to all the child joints.
-	 *
-	 * Finally the inverse of the joint's bind transform is multiplied with the
-	 * model-space transform of the joint. This basically "subtracts" the
-	 * joint's original bind (no animation applied) transform from the desired
-	 * pose transform. The result of this is then the transform required to move
-	 * the joint from its original model-space transform to it's desired
-	 * model-space posed transform. This is the transform that needs to be
-	 * loaded up to the vertex shader and used to transform the vertices into
-	 * the current pose.
-	 * @param currentPose A map of the local-space transforms for all the joints for the desired pose. The map is indexed by the name of the joint which the transform corresponds to.
-	 * @param joint The current joint which the pose should be applied to.
-	 * @param parentTransform The desired model-space transform of the parent joint for the pose.
-	 * @param jointMatrices The transforms that get loaded up to the shader and is used to deform the vertices of the "skin".
+	 * Adds a layer over the layers already added, references to layers are invalidated when layers are added or removed.
+	 * @param mode How the pose of the layer is applied over the layers below it.
+	 * @param weight How much of the pose of the layer is applied, from 0 to 1.
+	 * @return The layer.
 	 */
-	static void CalculateJointPose(const std::map<std::string, Matrix4> &currentPose, const Joint &joint, const Matrix4 &parentTransform, std::vector<Matrix4> &jointMatrices);
-
-	const Animation *GetCurrentAnimation() const { return currentAnimation; }
+	AnimationLayer &AddLayer(AnimationLayer::Mode mode = AnimationLayer::Mode::Override, float weight = 1.0f);
 
 	/**
-	 * Indicates that the entity should carry out the given animation. Resets the animation time so that the new animation starts from the beginning.
-	 * @param animation The new animation to carry out.
+	 * Removes a layer, the base layer can not be removed.
+	 * @param index The index of the layer.
 	 */
-	void DoAnimation(Animation *animation);
+	void RemoveLayer(std::size_t index);
+
+	const std::vector<AnimationLayer> &GetLayers() const { return layers; }
+	AnimationLayer &GetLayer(std::size_t index) { return layers[index]; }
 
 private:
-	Time animationTime;
-	Animation *currentAnimation = nullptr;
+	std::vector<AnimationLayer> layers;
+
+	// Storage reused between frames for the pose being built, the pose of each layer, and the model-space transform of each joint.
+	AnimationPose pose;
+	AnimationPose layerPose;
+	std::vector<float> weights;
+	std::vector<Matrix4> modelTransforms;
 };
 }
@@ -0,0 +1,64 @@
+#include "CrowdEvaluator.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+
+#include "Utils/ThreadPool.hpp"
+
+namespace acid {
+void CrowdEvaluator::Evaluate(const Time &delta, Span<const Instance> instances, ThreadPool *threadPool) {
+	for (const auto &instance : instances)
+		instance.animator->IncreaseAnimationTime(delta);
+
+	// Groups animators playing one animation by skeleton, animation and time, the first of each group calculates the pose for the rest.
+	auto key = [&instances](uint32_t index) {
+		const auto &instance = instances[index];
+		return std::make_tuple(instance.skeleton, instance.animator->GetCurrentAnimation(), instance.animator->GetAnimationTime());
+	};
+
+	sources.resize(instances.size());
+	std::iota(sources.begin(), sources.end(), 0);
+	order.clear();
+
+	for (uint32_t i = 0; i < instances.size(); i++) {
+		if (instances[i].animator->IsPlayingSingleAnimation())
+			order.emplace_back(i);
+	}
+
+	std::sort(order.begin(), order.end(), [&key](uint32_t a, uint32_t b) {
+		return key(a) < key(b);
+	});
+
+	sharedCount = 0;
+	for (std::size_t i = 1; i < order.size(); i++) {
+		auto source = sources[order[i - 1]];
+		if (key(order[i]) == key(source) && instances[order[i]].jointMatrices.size() == instances[source].jointMatrices.size()) {
+			sources[order[i]] = source;
+			sharedCount++;
+		}
+	}
+
+	auto calculate = [&](std::size_t begin, std::size_t end) {
+		for (auto i = begin; i < end; i++) {
+			if (sources[i] == i)
+				instances[i].animator->CalculateCurrentAnimationPose(*instances[i].skeleton, instances[i].jointMatrices);
+		}
+	};
+	auto copy = [&](std::size_t begin, std::size_t end) {
+		for (auto i = begin; i < end; i++) {
+			if (sources[i] != i)
+				std::copy(instances[sources[i]].jointMatrices.begin(), instances[sources[i]].jointMatrices.end(), instances[i].jointMatrices.begin());
+		}
+	};
+
+	if (threadPool) {
+		threadPool->ParallelFor(instances.size(), GrainSize, calculate);
+		if (sharedCount != 0)
+			threadPool->ParallelFor(instances.size(), GrainSize * 4, copy);
+	} else {
+		calculate(0, instances.size());
+		copy(0, instances.size());
+	}
+}
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Animator.hpp"
+
+namespace acid {
+class ThreadPool;
+
+/**
+ * @brief Class that updates the animators of many animated entities at once, spreading the poses over a thread pool.
+ * Animators playing a single animation on the same skeleton at the same time calculate the same pose,
+ * so it is calculated once and copied to the others.
+ */
+class ACID_EXPORT CrowdEvaluator {
+public:
+	/**
+	 * @brief An animator along with the skeleton it animates and the transforms its pose is written to.
+	 */
+	class Instance {
+	public:
+		Animator *animator;
+		const Skeleton *skeleton;
+		Span<Matrix4> jointMatrices;
+	};
+
+	/**
+	 * Increases the animation time of every animator and calculates their poses.
+	 * @param delta The time passed since the last update.
+	 * @param instances The animators to update, each animator may only be given once.
+	 * @param threadPool The pool to spread the poses over, or nullptr to calculate them on the calling thread.
+	 */
+	void Evaluate(const Time &delta, Span<const Instance> instances, ThreadPool *threadPool = nullptr);
+
+	/**
+	 * Gets the amount of instances given their pose from another instance in the last evaluation.
+	 * @return The amount of shared poses.
+	 */
+	std::size_t GetSharedCount() const { return sharedCount; }
+
+	/// The amount of instances each chunk of work calculates.
+	constexpr static std::size_t GrainSize = 8;
+
+private:
+	// The instance each instance copies its pose from, instances calculating their own pose point to themselves.
+	std::vector<uint32_t> sources;
+	std::vector<uint32_t> order;
+	std::size_t sharedCount = 0;
+};
+}
@@ -0,0 +1,44 @@
+#include "Skeleton.hpp"
+
+namespace acid {
+Skeleton::Skeleton(const Joint &headJoint) {
+	AddJoint(headJoint, -1, {});
+}
+
+std::optional<uint32_t> Skeleton::FindJoint(const std::string &name) const {
+	for (uint32_t i = 0; i < names.size(); i++) {
+		if (names[i] == name)
+			return i;
+	}
+
+	return std::nullopt;
+}
+
+void Skeleton::CalculateJointMatrices(const AnimationPose &pose, std::vector<Matrix4> &modelTransforms, Span<Matrix4> jointMatrices) const {
+	modelTransforms.resize(GetJointCount());
+
+	for (uint32_t i = 0; i < GetJointCount(); i++) {
+		auto localTransform = pose.GetJoint(i).GetLocalTransform();
+		modelTransforms[i] = parents[i] < 0 ? localTransform : modelTransforms[parents[i]] * localTransform;
+
+		if (matrixIndices[i] < jointMatrices.size())
+			jointMatrices[matrixIndices[i]] = modelTransforms[i] * inverseBindTransforms[i];
+	}
+}
+
+void Skeleton::AddJoint(const Joint &joint, int32_t parent, const Matrix4 &parentBindTransform) {
+	auto index = static_cast<int32_t>(parents.size());
+	auto bindTransform = parentBindTransform * joint.GetLocalBindTransform();
+
+	names.emplace_back(joint.GetName());
+	parents.emplace_back(parent);
+	matrixIndices.emplace_back(joint.GetIndex());
+	localBindTransforms.emplace_back(joint.GetLocalBindTransform());
+	inverseBindTransforms.emplace_back(bindTransform.Inverse());
+	bindPose.Resize(index + 1);
+	bindPose.SetJoint(index, JointTransform(joint.GetLocalBindTransform()));
+
+	for (const auto &child : joint.GetChildren())
+		AddJoint(child, index, bindTransform);
+}
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <optional>
+
+#include "Animations/Animation/AnimationPose.hpp"
+#include "Joint.hpp"
+
+namespace acid {
+/**
+ * @brief Class that represents a joint hierarchy compiled into flat arrays, used to evaluate poses without recursion or name lookups.
+ * Joints are stored depth first, so every parent comes before its children and a pose can be built in one pass from the first joint to the last.
+ */
+class ACID_EXPORT Skeleton {
+public:
+	/**
+	 * Creates a new empty skeleton.
+	 */
+	Skeleton() = default;
+
+	/**
+	 * Creates a new skeleton by flattening a joint hierarchy.
+	 * @param headJoint The root joint of the hierarchy.
+	 */
+	explicit Skeleton(const Joint &headJoint);
+
+	/**
+	 * Finds a joint by name, this is only intended for binding animations at load time.
+	 * @param name The name of the joint.
+	 * @return The index of the joint in this skeleton, or nullopt if no joint has the name.
+	 */
+	std::optional<uint32_t> FindJoint(const std::string &name) const;
+
+	/**
+	 * Calculates the transforms loaded up to the shader from a pose, walking the joints from the root to the leaves.
+	 * The local-space transform of each joint is multiplied with the model-space transform of its parent, then with the inverse of the joint's bind transform.
+	 * @param pose The local-space pose of every joint.
+	 * @param modelTransforms Storage for the model-space transform of each joint, reused between calls.
+	 * @param jointMatrices The transforms that get loaded up to the shader, joints with a matrix index outside of the span are skipped.
+	 */
+	void CalculateJointMatrices(const AnimationPose &pose, std::vector<Matrix4> &modelTransforms, Span<Matrix4> jointMatrices) const;
+
+	uint32_t GetJointCount() const { return static_cast<uint32_t>(parents.size()); }
+
+	const std::vector<std::string> &GetNames() const { return names; }
+	/**
+	 * Gets the index of the parent of each joint, the root joint has no parent and is given -1.
+	 * @return The parent indices.
+	 */
+	const std::vector<int32_t> &GetParents() const { return parents; }
+	/**
+	 * Gets the index each joint is written to in the joint matrices loaded up to the shader.
+	 * @return The joint matrix indices.
+	 */
+	const std::vector<uint32_t> &GetMatrixIndices() const { return matrixIndices; }
+	const std::vector<Matrix4> &GetLocalBindTransforms() const { return localBindTransforms; }
+	const std::vector<Matrix4> &GetInverseBindTransforms() const { return inverseBindTransforms; }
+	/**
+	 * Gets the local bind transforms as a pose, used for joints no animation moves and as the pose layers are blended over.
+	 * @return The bind pose.
+	 */
+	const AnimationPose &GetBindPose() const { return bindPose; }
+
+private:
+	void AddJoint(const Joint &joint, int32_t parent, const Matrix4 &parentBindTransform);
+
+	std::vector<std::string> names;
+	std::vector<int32_t> parents;
+	std::vector<uint32_t> matrixIndices;
+	std::vector<Matrix4> localBindTransforms;
+	std::vector<Matrix4> inverseBindTransforms;
+	AnimationPose bindPose;
+};
+}
@@ -0,0 +1,227 @@
+#include "Skinning.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Animations/Geometry/VertexAnimated.hpp"
+#include "Maths/Quaternion.hpp"
+#include "Utils/ThreadPool.hpp"
+
+namespace acid {
+// The kernels take restricted pointers offset to the first vertex of the range, so the compiler knows the arrays never overlap.
+// Gathering the joints of each vertex is the only indexed load, which the compiler vectorizes with gather instructions where they exist.
+// Results are written to separate arrays too, interleaving them into vectors in the same loop keeps it from being vectorized.
+template<bool Normals>
+static void SkinLinear(std::size_t count, const float *__restrict joints, const uint32_t *__restrict joint0, const uint32_t *__restrict joint1,
+	const uint32_t *__restrict joint2, const float *__restrict weight0, const float *__restrict weight1, const float *__restrict weight2,
+	const float *__restrict px, const float *__restrict py, const float *__restrict pz, const float *__restrict nx, const float *__restrict ny,
+	const float *__restrict nz, float *__restrict ox, float *__restrict oy, float *__restrict oz, float *__restrict onx, float *__restrict ony,
+	float *__restrict onz) {
+	for (std::size_t i = 0; i < count; i++) {
+		// Each joint is the first three rows of its matrix, stored by column.
+		auto a = joints + 12 * joint0[i], b = joints + 12 * joint1[i], c = joints + 12 * joint2[i];
+		float m[12];
+		for (std::size_t e = 0; e < 12; e++)
+			m[e] = a[e] * weight0[i] + b[e] * weight1[i] + c[e] * weight2[i];
+
+		ox[i] = m[0] * px[i] + m[3] * py[i] + m[6] * pz[i] + m[9];
+		oy[i] = m[1] * px[i] + m[4] * py[i] + m[7] * pz[i] + m[10];
+		oz[i] = m[2] * px[i] + m[5] * py[i] + m[8] * pz[i] + m[11];
+
+		if constexpr (Normals) {
+			onx[i] = m[0] * nx[i] + m[3] * ny[i] + m[6] * nz[i];
+			ony[i] = m[1] * nx[i] + m[4] * ny[i] + m[7] * nz[i];
+			onz[i] = m[2] * nx[i] + m[5] * ny[i] + m[8] * nz[i];
+		}
+	}
+}
+
+/**
+ * Negates the weights of joints on the other side of the quaternion sphere to the first joint of each vertex, or blending them would cancel out.
+ * Kept apart from the kernel, the compiler does not vectorize loops that sum gathered values together.
+ */
+static void AlignWeights(std::size_t count, const float *__restrict joints, const uint32_t *__restrict joint0, const uint32_t *__restrict joint1,
+	const uint32_t *__restrict joint2, const float *__restrict weight1, const float *__restrict weight2, float *__restrict signedWeight1,
+	float *__restrict signedWeight2) {
+	for (std::size_t i = 0; i < count; i++) {
+		auto a = joints + 8 * joint0[i], b = joints + 8 * joint1[i], c = joints + 8 * joint2[i];
+		signedWeight1[i] = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3] < 0.0f ? -weight1[i] : weight1[i];
+		signedWeight2[i] = a[0] * c[0] + a[1] * c[1] + a[2] * c[2] + a[3] * c[3] < 0.0f ? -weight2[i] : weight2[i];
+	}
+}
+
+template<bool Normals>
+static void SkinDualQuaternion(std::size_t count, const float *__restrict joints, const uint32_t *__restrict joint0, const uint32_t *__restrict joint1,
+	const uint32_t *__restrict joint2, const float *__restrict weight0, const float *__restrict weight1, const float *__restrict weight2,
+	const float *__restrict px, const float *__restrict py, const float *__restrict pz, const float *__restrict nx, const float *__restrict ny,
+	const float *__restrict nz, float *__restrict ox, float *__restrict oy, float *__restrict oz, float *__restrict onx, float *__restrict ony,
+	float *__restrict onz) {
+	for (std::size_t i = 0; i < count; i++) {
+		// Each joint is a rotation quaternion followed by its dual part, the weights have been signed by AlignWeights.
+		auto a = joints + 8 * joint0[i], b = joints + 8 * joint1[i], c = joints + 8 * joint2[i];
+		float q[8];
+		for (std::size_t e = 0; e < 8; e++)
+			q[e] = a[e] * weight0[i] + b[e] * weight1[i] + c[e] * weight2[i];
+
+		// The blend is not normalized, rotating by a quaternion scales by its squared length, which the result is divided by instead.
+		auto ux = q[0], uy = q[1], uz = q[2], s = q[3];
+		auto inverseLengthSquared = 1.0f / (ux * ux + uy * uy + uz * uz + s * s);
+		auto scale = s * s - ux * ux - uy * uy - uz * uz;
+
+		// The translation is twice the vector part of the dual part multiplied with the conjugate rotation.
+		auto tx = 2.0f * (s * q[4] - q[7] * ux + uy * q[6] - uz * q[5]);
+		auto ty = 2.0f * (s * q[5] - q[7] * uy + uz * q[4] - ux * q[6]);
+		auto tz = 2.0f * (s * q[6] - q[7] * uz + ux * q[5] - uy * q[4]);
+
+		auto dot = ux * px[i] + uy * py[i] + uz * pz[i];
+		ox[i] = (scale * px[i] + 2.0f * dot * ux + 2.0f * s * (uy * pz[i] - uz * py[i]) + tx) * inverseLengthSquared;
+		oy[i] = (scale * py[i] + 2.0f * dot * uy + 2.0f * s * (uz * px[i] - ux * pz[i]) + ty) * inverseLengthSquared;
+		oz[i] = (scale * pz[i] + 2.0f * dot * uz + 2.0f * s * (ux * py[i] - uy * px[i]) + tz) * inverseLengthSquared;
+
+		if constexpr (Normals) {
+			auto dotNormal = ux * nx[i] + uy * ny[i] + uz * nz[i];
+			onx[i] = (scale * nx[i] + 2.0f * dotNormal * ux + 2.0f * s * (uy * nz[i] - uz * ny[i])) * inverseLengthSquared;
+			ony[i] = (scale * ny[i] + 2.0f * dotNormal * uy + 2.0f * s * (uz * nx[i] - ux * nz[i])) * inverseLengthSquared;
+			onz[i] = (scale * nz[i] + 2.0f * dotNormal * uz + 2.0f * s * (ux * ny[i] - uy * nx[i])) * inverseLengthSquared;
+		}
+	}
+}
+
+Skinning::Skinning(const std::vector<VertexAnimated> &vertices) {
+	for (auto values : {&positionX, &positionY, &positionZ, &normalX, &normalY, &normalZ, &weights[0], &weights[1], &weights[2]})
+		values->reserve(vertices.size());
+	for (auto &ids : jointIds)
+		ids.reserve(vertices.size());
+
+	for (const auto &vertex : vertices) {
+		positionX.emplace_back(vertex.position.x);
+		positionY.emplace_back(vertex.position.y);
+		positionZ.emplace_back(vertex.position.z);
+		normalX.emplace_back(vertex.normal.x);
+		normalY.emplace_back(vertex.normal.y);
+		normalZ.emplace_back(vertex.normal.z);
+
+		for (uint32_t k = 0; k < 3; k++) {
+			auto joint = vertex.jointId[k];
+			jointIds[k].emplace_back(joint);
+			weights[k].emplace_back(vertex.vertexWeight[k]);
+
+			// Joints given no weight are still gathered from, so every index is given a transform.
+			if (joint >= jointMinExtents.size()) {
+				jointMinExtents.resize(joint + 1, Vector3f::Infinity);
+				jointMaxExtents.resize(joint + 1, -Vector3f::Infinity);
+			}
+
+			if (vertex.vertexWeight[k] == 0.0f)
+				continue;
+
+			jointMinExtents[joint] = jointMinExtents[joint].Min(vertex.position);
+			jointMaxExtents[joint] = jointMaxExtents[joint].Max(vertex.position);
+		}
+	}
+}
+
+void Skinning::Skin(Span<const Matrix4> jointMatrices, Span<Vector3f> positions, Span<Vector3f> normals, Method method, ThreadPool *threadPool) const {
+	auto jointCount = jointMinExtents.size();
+	auto stride = method == Method::Linear ? 12 : 8;
+	// The joint transforms of the pose, packed for the kernels.
+	std::vector<float> packedJoints(jointCount * stride);
+
+	for (std::size_t j = 0; j < jointCount; j++) {
+		auto matrix = j < jointMatrices.size() ? jointMatrices[j] : Matrix4();
+		auto packed = &packedJoints[j * stride];
+
+		if (method == Method::Linear) {
+			for (uint32_t column = 0; column < 4; column++) {
+				for (uint32_t row = 0; row < 3; row++)
+					packed[column * 3 + row] = matrix[column][row];
+			}
+		} else {
+			// Quaternion(Matrix4) gives the inverse of the rotation the matrix applies to column vectors, so it is conjugated.
+			// The dual part is half the translation multiplied with the rotation.
+			Quaternion rotation(matrix);
+			rotation = {-rotation.x, -rotation.y, -rotation.z, rotation.w};
+			Vector3f translation(matrix[3]);
+			Quaternion dual = Quaternion(translation.x, translation.y, translation.z, 0.0f) * rotation * 0.5f;
+			for (uint32_t e = 0; e < 4; e++) {
+				packed[e] = rotation[e];
+				packed[4 + e] = dual[e];
+			}
+		}
+	}
+
+	auto skinNormals = !normals.empty();
+	auto kernel = method == Method::Linear ? (skinNormals ? SkinLinear<true> : SkinLinear<false>) :
+		(skinNormals ? SkinDualQuaternion<true> : SkinDualQuaternion<false>);
+	auto skin = [&](std::size_t begin, std::size_t end) {
+		float x[BlockSize], y[BlockSize], z[BlockSize], nx[BlockSize], ny[BlockSize], nz[BlockSize];
+		float signedWeight1[BlockSize], signedWeight2[BlockSize];
+
+		for (auto block = begin; block < end; block += BlockSize) {
+			auto count = std::min(BlockSize, end - block);
+			auto weight1 = &weights[1][block], weight2 = &weights[2][block];
+
+			if (method == Method::DualQuaternion) {
+				AlignWeights(count, packedJoints.data(), &jointIds[0][block], &jointIds[1][block], &jointIds[2][block], weight1, weight2, signedWeight1,
+					signedWeight2);
+				weight1 = signedWeight1;
+				weight2 = signedWeight2;
+			}
+
+			kernel(count, packedJoints.data(), &jointIds[0][block], &jointIds[1][block], &jointIds[2][block], &weights[0][block], weight1, weight2,
+				&positionX[block], &positionY[block], &positionZ[block], &normalX[block], &normalY[block], &normalZ[block], x, y, z, nx, ny, nz);
+
+			for (std::size_t i = 0; i < count; i++)
+				positions[block + i] = {x[i], y[i], z[i]};
+			if (skinNormals) {
+				for (std::size_t i = 0; i < count; i++)
+					normals[block + i] = {nx[i], ny[i], nz[i]};
+			}
+		}
+	};
+
+	if (threadPool)
+		threadPool->ParallelFor(GetVertexCount(), GrainSize, skin);
+	else if (GetVertexCount() != 0)
+		skin(0, GetVertexCount());
+}
+
+void Skinning::CalculateBounds(Span<const Matrix4> jointMatrices, Vector3f &minExtents, Vector3f &maxExtents) const {
+	minExtents = Vector3f::Infinity;
+	maxExtents = -Vector3f::Infinity;
+
+	for (std::size_t j = 0; j < jointMinExtents.size(); j++) {
+		auto jointMin = jointMinExtents[j];
+		auto jointMax = jointMaxExtents[j];
+		if (jointMin.x > jointMax.x)
+			continue;
+
+		if (j < jointMatrices.size())
+			TransformBounds(jointMatrices[j], jointMin, jointMax);
+
+		minExtents = minExtents.Min(jointMin);
+		maxExtents = maxExtents.Max(jointMax);
+	}
+}
+
+void Skinning::TransformBounds(const Matrix4 &transform, Vector3f &minExtents, Vector3f &maxExtents) {
+	// Each axis of the transformed box extends by the absolute projection of the half extents onto it.
+	auto center = (minExtents + maxExtents) * 0.5f;
+	auto halfExtents = (maxExtents - minExtents) * 0.5f;
+	Vector3f transformedCenter(transform.Transform(Vector4f(center, 1.0f)));
+	Vector3f transformedHalfExtents;
+
+	for (uint32_t row = 0; row < 3; row++) {
+		transformedHalfExtents[row] = std::abs(transform[0][row]) * halfExtents.x + std::abs(transform[1][row]) * halfExtents.y +
+			std::abs(transform[2][row]) * halfExtents.z;
+	}
+
+	minExtents = transformedCenter - transformedHalfExtents;
+	maxExtents = transformedCenter + transformedHalfExtents;
+}
+
+std::size_t Skinning::GetMemorySize() const {
+	auto vertexSize = 6 * sizeof(float) + 3 * sizeof(uint32_t) + 3 * sizeof(float);
+	return GetVertexCount() * vertexSize + 2 * jointMinExtents.size() * sizeof(Vector3f);
+}
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "Maths/Matrix4.hpp"
+#include "Utils/Span.hpp"
+
+namespace acid {
+class ThreadPool;
+class VertexAnimated;
+
+/**
+ * @brief Class that deforms the vertices of a skin by the joint matrices of a pose on the CPU, the same way the animated vertex shader does.
+ * Vertex components are stored in separate arrays so the kernels run as branchless loops that the compiler vectorizes.
+ * Used where skinned vertices are needed without rendering, such as for hit testing, and to bound a skin for culling.
+ * Skinning does not change the skin, so one skin can be shared by every instance of a model and skinned from many threads.
+ */
+class ACID_EXPORT Skinning {
+public:
+	enum class Method {
+		/// Blends the joint matrices of a vertex, matching the vertex shader.
+		Linear,
+		/// Blends the joints as dual quaternions, which keeps volume around twisting joints. The joint matrices must not be scaled.
+		DualQuaternion
+	};
+
+	/**
+	 * Creates a new empty skin.
+	 */
+	Skinning() = default;
+
+	/**
+	 * Creates a new skin from the vertices of an animated model.
+	 * @param vertices The vertices in their bind pose.
+	 */
+	explicit Skinning(const std::vector<VertexAnimated> &vertices);
+
+	/**
+	 * Calculates the skinned position and normal of every vertex.
+	 * Linear blended normals are not normalized, like in the vertex shader, dual quaternion blended normals keep their length.
+	 * @param jointMatrices The transforms of the pose, as loaded up to the shader. Joints outside of the span are not moved.
+	 * @param positions The positions to write into, with a size of at least the amount of vertices.
+	 * @param normals The normals to write into, with a size of at least the amount of vertices, or empty to only calculate positions.
+	 * @param method How the joints of each vertex are blended.
+	 * @param threadPool The pool to spread the vertices over, or nullptr to skin them on the calling thread.
+	 */
+	void Skin(Span<const Matrix4> jointMatrices, Span<Vector3f> positions, Span<Vector3f> normals = {}, Method method = Method::Linear,
+		ThreadPool *threadPool = nullptr) const;
+
+	/**
+	 * Calculates a box containing the linear blend skinned vertices without skinning them, from the bind pose bounds of the vertices each joint moves.
+	 * Every skinned vertex is a weighted average of its joints moving it, so it lies inside the box of those joints moved by their matrices.
+	 * @param jointMatrices The transforms of the pose, as loaded up to the shader. Joints outside of the span are not moved.
+	 * @param minExtents The min point of the box.
+	 * @param maxExtents The max point of the box.
+	 */
+	void CalculateBounds(Span<const Matrix4> jointMatrices, Vector3f &minExtents, Vector3f &maxExtents) const;
+
+	/**
+	 * Transforms a box, giving the box that contains the transformed box.
+	 * @param transform The affine transform.
+	 * @param minExtents The min point of the box, changed to the min point of the transformed box.
+	 * @param maxExtents The max point of the box, changed to the max point of the transformed box.
+	 */
+	static void TransformBounds(const Matrix4 &transform, Vector3f &minExtents, Vector3f &maxExtents);
+
+	std::size_t GetVertexCount() const { return positionX.size(); }
+
+	/**
+	 * Gets the amount of memory the vertices and joint bounds of the skin use.
+	 * @return The size in bytes.
+	 */
+	std::size_t GetMemorySize() const;
+
+	/// The amount of vertices each chunk of work skins.
+	constexpr static std::size_t GrainSize = 2048;
+
+private:
+	/// The amount of vertices skinned into arrays on the stack before being written out.
+	constexpr static std::size_t BlockSize = 256;
+
+	std::vector<float> positionX, positionY, positionZ;
+	std::vector<float> normalX, normalY, normalZ;
+	std::vector<uint32_t> jointIds[3];
+	std::vector<float> weights[3];
+
+	// The bind pose bounds of the vertices each joint moves, joints moving no vertices have an inverted box.
+	std::vector<Vector3f> jointMinExtents;
+	std::vector<Vector3f> jointMaxExtents;
+};
+}
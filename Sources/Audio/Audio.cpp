@@ -18,7 +18,8 @@ struct Audio::_intern {
 };
 
 Audio::Audio() :
-	impl(std::make_unique<_intern>()) {
+	impl(std::make_unique<_intern>()),
+	threadPool(1) {
 	impl->device = alcOpenDevice(nullptr);
 	impl->context = alcCreateContext(impl->device, nullptr);
 	alcMakeContextCurrent(impl->context);
@@ -41,12 +42,20 @@ Audio::Audio() :
 }
 
 Audio::~Audio() {
+	// The device may hold OpenAL objects, so it goes before the context.
+	mixer = nullptr;
+	device = nullptr;
 	alcMakeContextCurrent(nullptr);
 	alcDestroyContext(impl->context);
 	alcCloseDevice(impl->device);
 }
 
 void Audio::Update() {
+	if (mixer) {
+		UpdateMixer();
+		return;
+	}
+
 	auto scene = Scenes::Get()->GetScene();
 
 	if (!scene) return;
@@ -74,6 +83,35 @@ void Audio::Update() {
 	//CheckAl(alGetError());
 }
 
+void Audio::SetDevice(std::unique_ptr<AudioDevice> &&device) {
+	// Sounds keep the ids of their voices, a new mixer would leave them pointing at voices it does not have.
+	if (mixer && mixer->GetVoiceCount() != 0) {
+		Log::Warning("Audio device can not be changed while ", mixer->GetVoiceCount(), " sounds are using the mixer\n");
+		return;
+	}
+
+	this->device = std::move(device);
+	mixer = this->device ? std::make_unique<Mixer>(this->device->GetSampleRate()) : nullptr;
+}
+
+void Audio::UpdateMixer() {
+	mixer->SetGain(GetGain(Type::Master));
+
+	if (auto scene = Scenes::Get()->GetScene()) {
+		if (auto camera = scene->GetCamera())
+			mixer->SetListener(camera->GetPosition(), camera->GetViewRay().GetCurrentRay(), Vector3f::Up);
+	}
+
+	// Mixes as far ahead as the device will take, which keeps it a few blocks ahead of what it is playing.
+	auto frameCount = device->GetWritableFrames();
+	if (frameCount == 0)
+		return;
+
+	mixFrames.resize(2 * static_cast<std::size_t>(frameCount));
+	mixer->Mix(mixFrames);
+	device->Write(mixFrames);
+}
+
 std::string Audio::StringifyResultAl(int32_t result) {
 	switch (result) {
 	case AL_NO_ERROR:
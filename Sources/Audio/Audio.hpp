@@ -3,6 +3,9 @@
 #include <rocket.hpp>
 
 #include "Engine/Engine.hpp"
+#include "Utils/ThreadPool.hpp"
+#include "Mixer/AudioDevice.hpp"
+#include "Mixer/Mixer.hpp"
 
 namespace acid {
 /**
@@ -32,7 +35,37 @@ public:
 	 */
 	rocket::signal<void(Type, float)> &OnGain() { return onGain; }
 
+	/**
+	 * Gets the thread pool streaming sounds are decoded on.
+	 * @return The audio thread pool.
+	 */
+	ThreadPool &GetThreadPool() { return threadPool; }
+
+	/**
+	 * Sets the device sounds are mixed to in software, in place of playing each sound on its own OpenAL source.
+	 * This must be set before any sounds are loaded, sounds loaded for one way of playing can not be played the other way.
+	 * The device is left as it was while sounds hold voices of the current mixer.
+	 * @param device The device to mix to, or nullptr to play sounds through OpenAL sources.
+	 */
+	void SetDevice(std::unique_ptr<AudioDevice> &&device);
+	AudioDevice *GetDevice() const { return device.get(); }
+
+	/**
+	 * Gets the software mixer sounds are played through.
+	 * @return The mixer, or nullptr if sounds are played through OpenAL sources.
+	 */
+	Mixer *GetMixer() const { return mixer.get(); }
+
+	/**
+	 * Gets the directory decoded sounds are cached in, so later launches load them without decoding.
+	 * @return The real path of the cache directory, empty if decoded sounds are not cached.
+	 */
+	const std::filesystem::path &GetCacheDirectory() const { return cacheDirectory; }
+	void SetCacheDirectory(const std::filesystem::path &cacheDirectory) { this->cacheDirectory = cacheDirectory; }
+
 private:
+	void UpdateMixer();
+
 	// TODO: Only using p-impl because of signature differences from OpenAL and OpenALSoft.
 	struct _intern;
 	std::unique_ptr<_intern> impl;
@@ -40,5 +73,13 @@ private:
 	std::map<Type, float> gains;
 
 	rocket::signal<void(Type, float)> onGain;
+
+	ThreadPool threadPool;
+
+	std::unique_ptr<AudioDevice> device;
+	std::unique_ptr<Mixer> mixer;
+	std::vector<float> mixFrames;
+
+	std::filesystem::path cacheDirectory;
 };
 }
@@ -1,33 +1,49 @@
 #include "FlacSoundBuffer.hpp"
 
-#ifdef ACID_BUILD_MACOS
-#include <OpenAL/al.h>
-#else
-#include <al.h>
-#endif
 #include <dr_flac.h>
 
 #include "Files/Files.hpp"
 #include "Maths/Time.hpp"
 
 namespace acid {
-void FlacSoundBuffer::Load(SoundBuffer &soundBuffer, const std::filesystem::path &filename) {
-#ifdef ACID_DEBUG
-	auto debugStart = Time::Now();
-#endif
+class FlacSoundDecoder : public SoundDecoder {
+public:
+	explicit FlacSoundDecoder(std::string &&data) :
+		data(std::move(data)) {
+		flac = drflac_open_memory(this->data.data(), this->data.size(), nullptr);
+		if (!flac)
+			return;
+
+		channels = flac->channels;
+		sampleRate = flac->sampleRate;
+		frameCount = flac->totalPCMFrameCount;
+	}
 
-	auto fileLoaded = Files::Read(filename);
+	~FlacSoundDecoder() {
+		if (flac)
+			drflac_close(flac);
+	}
 
-	if (!fileLoaded) {
-		Log::Error("SoundBuffer could not be loaded: ", filename, '\n');
-		return;
+	uint64_t Read(int16_t *samples, uint64_t frameCount) override {
+		return drflac_read_pcm_frames_s16(flac, frameCount, samples);
 	}
 
-	//soundBuffer->SetBuffer(buffer);
+	bool Seek(uint64_t frame) override {
+		return drflac_seek_to_pcm_frame(flac, frame);
+	}
 
-#ifdef ACID_DEBUG
-	Log::Out("SoundBuffer ", filename, " loaded in ", (Time::Now() - debugStart).AsMilliseconds<float>(), "ms\n");
-#endif
+	bool IsOpen() const { return flac != nullptr; }
+
+private:
+	std::string data;
+	drflac *flac = nullptr;
+};
+
+std::unique_ptr<SoundDecoder> FlacSoundBuffer::Open(std::string &&data) {
+	auto decoder = std::make_unique<FlacSoundDecoder>(std::move(data));
+	if (!decoder->IsOpen())
+		return nullptr;
+	return decoder;
 }
 
 void FlacSoundBuffer::Write(const SoundBuffer &soundBuffer, const std::filesystem::path &filename) {
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Utils/Span.hpp"
+#include "Export.hpp"
+
+namespace acid {
+/**
+ * @brief Interface for an output the {@link Mixer} writes interleaved stereo frames to.
+ */
+class ACID_EXPORT AudioDevice {
+public:
+	explicit AudioDevice(uint32_t sampleRate) :
+		sampleRate(sampleRate) {
+	}
+
+	virtual ~AudioDevice() = default;
+
+	/**
+	 * Gets how many frames can be written without blocking, the mixer mixes this many frames each update.
+	 * @return The amount of writable frames.
+	 */
+	virtual uint32_t GetWritableFrames() = 0;
+
+	/**
+	 * Writes mixed frames to the output.
+	 * @param frames The interleaved stereo samples, at most {@link AudioDevice#GetWritableFrames} frames.
+	 */
+	virtual void Write(Span<const float> frames) = 0;
+
+	uint32_t GetSampleRate() const { return sampleRate; }
+
+protected:
+	uint32_t sampleRate;
+};
+}
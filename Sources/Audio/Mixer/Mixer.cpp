@@ -0,0 +1,275 @@
+#include "Mixer.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Maths/Maths.hpp"
+
+namespace acid {
+static constexpr float SampleScale = 1.0f / 32768.0f;
+
+// The kernels take restricted pointers so the compiler knows the arrays never overlap and can vectorize the loops without runtime aliasing checks.
+static void Convert(std::size_t count, const int16_t *__restrict samples, float *__restrict output) {
+	for (std::size_t i = 0; i < count; i++)
+		output[i] = samples[i] * SampleScale;
+}
+
+static void Deinterleave(std::size_t count, const int16_t *__restrict samples, float *__restrict output0, float *__restrict output1) {
+	for (std::size_t i = 0; i < count; i++) {
+		output0[i] = samples[2 * i] * SampleScale;
+		output1[i] = samples[2 * i + 1] * SampleScale;
+	}
+}
+
+static void Resample(std::size_t count, double cursor, double step, uint32_t channels, const int16_t *__restrict samples, float *__restrict output) {
+	for (std::size_t i = 0; i < count; i++) {
+		auto position = cursor + step * static_cast<double>(i);
+		auto index = static_cast<std::size_t>(position);
+		auto t = static_cast<float>(position - static_cast<double>(index));
+		float a = samples[index * channels];
+		float b = samples[(index + 1) * channels];
+		output[i] = (a + (b - a) * t) * SampleScale;
+	}
+}
+
+static void Interleave(uint32_t count, float gain, const float *__restrict input0, const float *__restrict input1, float *__restrict output) {
+	for (uint32_t i = 0; i < count; i++) {
+		output[2 * i] = input0[i] * gain;
+		output[2 * i + 1] = input1[i] * gain;
+	}
+}
+
+static void MixRamp(uint32_t count, float gain, float gainStep, const float *__restrict source, float *__restrict output) {
+	// The gain is worked out from a signed index each frame, rather than accumulated, so the frames do not depend on each other.
+	for (uint32_t i = 0; i < count; i++)
+		output[i] += source[i] * (gain + gainStep * static_cast<float>(static_cast<int32_t>(i)));
+}
+
+void Mixer::Voice::Seek(uint64_t frame) {
+	chunk.clear();
+	if (stream) {
+		stream->Seek(frame);
+		stream->Fill(1);
+		cursor = 0.0;
+	} else {
+		cursor = static_cast<double>(frame);
+	}
+}
+
+Mixer::Mixer(uint32_t sampleRate, uint32_t maxVoices) :
+	sampleRate(sampleRate),
+	maxVoices(maxVoices) {
+}
+
+Mixer::VoiceId Mixer::CreateVoice() {
+	VoiceId id;
+	if (!freeVoices.empty()) {
+		id = freeVoices.back();
+		freeVoices.pop_back();
+	} else {
+		id = static_cast<VoiceId>(voices.size());
+		voices.emplace_back();
+	}
+
+	voices[id] = Voice();
+	voices[id].used = true;
+	return id;
+}
+
+void Mixer::DestroyVoice(VoiceId id) {
+	voices[id] = Voice();
+	freeVoices.emplace_back(id);
+}
+
+void Mixer::SetListener(const Vector3f &position, const Vector3f &forward, const Vector3f &up) {
+	listenerPosition = position;
+	listenerRight = forward.Cross(up).Normalize();
+}
+
+void Mixer::Mix(Span<float> output) {
+	auto frameCount = static_cast<uint32_t>(output.size() / 2);
+	left.assign(frameCount, 0.0f);
+	right.assign(frameCount, 0.0f);
+	channel0.resize(frameCount);
+	channel1.resize(frameCount);
+
+	Prioritize();
+
+	for (auto id : order) {
+		auto &voice = voices[id];
+
+		// A voice made virtual is mixed for one more block while it fades out, after that it only moves on through its sound.
+		if (!voice.real && voice.gains[0] == 0.0f && voice.gains[1] == 0.0f) {
+			Advance(voice, frameCount);
+			continue;
+		}
+
+		auto read = Fetch(voice, frameCount, channel0.data(), channel1.data());
+		auto secondChannel = voice.channels == 2 ? channel1.data() : channel0.data();
+
+		// Gains ramp across the block from the gains of the last block, so changes in gain do not click.
+		auto gainStep0 = (voice.targetGains[0] - voice.gains[0]) / static_cast<float>(frameCount);
+		auto gainStep1 = (voice.targetGains[1] - voice.gains[1]) / static_cast<float>(frameCount);
+		MixRamp(read, voice.gains[0], gainStep0, channel0.data(), left.data());
+		MixRamp(read, voice.gains[1], gainStep1, secondChannel, right.data());
+		voice.gains[0] = voice.targetGains[0];
+		voice.gains[1] = voice.targetGains[1];
+	}
+
+	Interleave(frameCount, gain, left.data(), right.data(), output.data());
+}
+
+void Mixer::Prioritize() {
+	order.clear();
+	for (VoiceId id = 0; id < voices.size(); id++) {
+		auto &voice = voices[id];
+		if (!voice.used || voice.state != Voice::State::Playing) {
+			voice.started = false;
+			voice.real = false;
+			voice.gains[0] = voice.gains[1] = 0.0f;
+			continue;
+		}
+
+		CalculateGains(voice);
+		order.emplace_back(id);
+	}
+
+	// Ties keep the order of the voice ids, so voices of equal importance do not swap between being real and virtual from one mix to the next.
+	std::stable_sort(order.begin(), order.end(), [this](VoiceId a, VoiceId b) {
+		const auto &voiceA = voices[a];
+		const auto &voiceB = voices[b];
+		if (voiceA.priority != voiceB.priority)
+			return voiceA.priority > voiceB.priority;
+		return voiceA.audibility > voiceB.audibility;
+	});
+
+	realVoiceCount = 0;
+	for (auto id : order) {
+		auto &voice = voices[id];
+		voice.real = realVoiceCount < maxVoices && voice.audibility >= audibleThreshold;
+		if (voice.real) {
+			realVoiceCount++;
+		} else {
+			voice.targetGains[0] = voice.targetGains[1] = 0.0f;
+		}
+
+		// A voice that has just started playing starts at its gains, fading it in would soften its attack.
+		if (!voice.started) {
+			voice.gains[0] = voice.targetGains[0];
+			voice.gains[1] = voice.targetGains[1];
+			voice.started = true;
+		}
+	}
+
+	virtualVoiceCount = static_cast<uint32_t>(order.size()) - realVoiceCount;
+}
+
+void Mixer::CalculateGains(Voice &voice) const {
+	auto voiceGain = voice.gain;
+	auto pan = 0.0f;
+
+	if (voice.spatial) {
+		auto direction = voice.position - listenerPosition;
+		auto distance = direction.Length();
+
+		// The clamped inverse distance model, the default model of OpenAL.
+		auto clampedDistance = std::clamp(distance, voice.referenceDistance, voice.maxDistance);
+		voiceGain *= voice.referenceDistance / (voice.referenceDistance + voice.rolloffFactor * (clampedDistance - voice.referenceDistance));
+
+		if (distance > 0.0f)
+			pan = direction.Dot(listenerRight) / distance;
+	}
+
+	voice.audibility = voiceGain;
+
+	// Stereo sounds and sounds that are not spatial keep their own balance.
+	if (!voice.spatial || voice.channels == 2) {
+		voice.targetGains[0] = voice.targetGains[1] = voiceGain;
+		return;
+	}
+
+	// Constant power panning, a voice keeps its loudness as it moves across the listener.
+	auto angle = (pan + 1.0f) * 0.25f * Maths::PI<float>;
+	voice.targetGains[0] = voiceGain * std::cos(angle);
+	voice.targetGains[1] = voiceGain * std::sin(angle);
+}
+
+uint32_t Mixer::Fetch(Voice &voice, uint32_t frameCount, float *channel0, float *channel1) {
+	auto step = static_cast<double>(voice.pitch) * voice.sampleRate / sampleRate;
+	uint32_t read = 0;
+
+	while (read < frameCount) {
+		const auto &samples = voice.stream ? voice.chunk : *voice.samples;
+		auto length = samples.size() / voice.channels;
+
+		if (voice.cursor >= static_cast<double>(length)) {
+			if (!NextSamples(voice, length))
+				break;
+			continue;
+		}
+
+		auto index = static_cast<std::size_t>(voice.cursor);
+		std::size_t count;
+
+		if (step == 1.0 && voice.cursor == static_cast<double>(index) && voice.channels <= 2) {
+			count = std::min<std::size_t>(frameCount - read, length - index);
+			if (voice.channels == 1)
+				Convert(count, &samples[index], channel0 + read);
+			else
+				Deinterleave(count, &samples[2 * index], channel0 + read, channel1 + read);
+		} else if (index + 1 < length) {
+			// Frames are interpolated up to the last frame of the samples, so the frame after each one is in range.
+			auto remaining = std::ceil((static_cast<double>(length - 1) - voice.cursor) / step);
+			count = static_cast<std::size_t>(std::min<double>(frameCount - read, remaining));
+			Resample(count, voice.cursor, step, voice.channels, samples.data(), channel0 + read);
+			if (voice.channels == 2)
+				Resample(count, voice.cursor, step, voice.channels, samples.data() + 1, channel1 + read);
+		} else {
+			// The last frame is held, rather than blended into the next chunk or the start of the loop.
+			count = 1;
+			channel0[read] = samples[index * voice.channels] * SampleScale;
+			if (voice.channels == 2)
+				channel1[read] = samples[index * voice.channels + 1] * SampleScale;
+		}
+
+		voice.cursor += step * static_cast<double>(count);
+		read += static_cast<uint32_t>(count);
+	}
+
+	return read;
+}
+
+void Mixer::Advance(Voice &voice, uint32_t frameCount) {
+	auto step = static_cast<double>(voice.pitch) * voice.sampleRate / sampleRate;
+	voice.cursor += step * frameCount;
+
+	while (true) {
+		auto length = (voice.stream ? voice.chunk.size() : voice.samples->size()) / voice.channels;
+		if (voice.cursor < static_cast<double>(length) || !NextSamples(voice, length))
+			break;
+	}
+}
+
+bool Mixer::NextSamples(Voice &voice, std::size_t length) {
+	if (voice.stream) {
+		// The next chunk carries on from where the last chunk ended.
+		if (voice.stream->Pop(voice.chunk)) {
+			voice.cursor -= static_cast<double>(length);
+			return true;
+		}
+
+		// Otherwise decoding has fallen behind, and the voice is silent until it catches up.
+		if (voice.stream->IsEnded())
+			voice.state = Voice::State::Stopped;
+		return false;
+	}
+
+	if (!voice.looping || length == 0) {
+		voice.state = Voice::State::Stopped;
+		return false;
+	}
+
+	voice.cursor = std::fmod(voice.cursor, static_cast<double>(length));
+	return true;
+}
+}
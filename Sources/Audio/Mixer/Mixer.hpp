@@ -0,0 +1,166 @@
+#pragma once
+
+#include <limits>
+#include <memory>
+
+#include "Maths/Vector3.hpp"
+#include "Utils/Span.hpp"
+#include "Audio/SoundStream.hpp"
+
+namespace acid {
+/**
+ * @brief Class that mixes many voices into one stereo output in software, used in place of a OpenAL source for each sound.
+ * Voices are attenuated by their distance from the listener like OpenAL's clamped inverse distance model, and panned by their direction.
+ * Only the most important audible voices are mixed, the rest are virtual: they keep their place in the sound without being heard, and are mixed again once they are important enough.
+ * The voices are accumulated into separate left and right arrays with branchless loops the compiler vectorizes, then interleaved once.
+ */
+class ACID_EXPORT Mixer {
+public:
+	using VoiceId = uint32_t;
+
+	/**
+	 * @brief A sound playing in the mixer.
+	 */
+	class ACID_EXPORT Voice {
+		friend class Mixer;
+	public:
+		enum class State {
+			Stopped, Playing, Paused
+		};
+
+		/**
+		 * Moves playback to a frame of the sound. A streamed voice seeks its stream, dropping the chunks decoded ahead.
+		 * @param frame The frame, at the sample rate of the sound.
+		 */
+		void Seek(uint64_t frame);
+
+		/// The interleaved samples of the sound, when it is not streamed.
+		std::shared_ptr<const std::vector<int16_t>> samples;
+		/// The stream of the sound, when it is streamed. Streams loop themselves.
+		std::shared_ptr<SoundStream> stream;
+		uint32_t channels = 1;
+		uint32_t sampleRate = 48000;
+
+		State state = State::Stopped;
+		bool looping = false;
+		float gain = 1.0f;
+		float pitch = 1.0f;
+		/// Voices with a higher priority are mixed before voices with a lower priority, however loud they are.
+		int32_t priority = 0;
+
+		/// If the voice is attenuated and panned by its position, otherwise it plays as it is.
+		bool spatial = true;
+		Vector3f position;
+		float referenceDistance = 1.0f;
+		float maxDistance = std::numeric_limits<float>::max();
+		float rolloffFactor = 1.0f;
+
+	private:
+		bool used = false;
+		// The frame playback is at in the sound, or in the current chunk of a stream, fractional when resampled.
+		double cursor = 0.0;
+		std::vector<int16_t> chunk;
+
+		float audibility = 0.0f;
+		bool real = false;
+		// If the voice was playing in the last mix, so its gains ramp from the gains it was mixed with.
+		bool started = false;
+		float targetGains[2] = {};
+		float gains[2] = {};
+	};
+
+	/**
+	 * Creates a new mixer.
+	 * @param sampleRate The sample rate of the output.
+	 * @param maxVoices The max amount of voices mixed at a time.
+	 */
+	explicit Mixer(uint32_t sampleRate = 48000, uint32_t maxVoices = 32);
+
+	/**
+	 * Creates a stopped voice.
+	 * @return The id of the voice.
+	 */
+	VoiceId CreateVoice();
+
+	/**
+	 * Destroys a voice, its id may be given to a voice created later.
+	 * @param id The id of the voice.
+	 */
+	void DestroyVoice(VoiceId id);
+
+	Voice &GetVoice(VoiceId id) { return voices[id]; }
+
+	/**
+	 * Gets the amount of voices that have been created and not yet destroyed.
+	 * @return The amount of voices in use.
+	 */
+	uint32_t GetVoiceCount() const { return static_cast<uint32_t>(voices.size() - freeVoices.size()); }
+
+	/**
+	 * Sets where the voices are heard from.
+	 * @param position The position of the listener.
+	 * @param forward The direction the listener is facing.
+	 * @param up The up direction of the listener.
+	 */
+	void SetListener(const Vector3f &position, const Vector3f &forward, const Vector3f &up);
+
+	/**
+	 * Mixes the playing voices into the next frames of the output, and moves playback of every playing voice on.
+	 * @param output The interleaved stereo samples to write into.
+	 */
+	void Mix(Span<float> output);
+
+	uint32_t GetSampleRate() const { return sampleRate; }
+
+	uint32_t GetMaxVoices() const { return maxVoices; }
+	void SetMaxVoices(uint32_t maxVoices) { this->maxVoices = maxVoices; }
+
+	/**
+	 * Gets the gain under which a voice is not heard, and is made virtual.
+	 * @return The audible threshold.
+	 */
+	float GetAudibleThreshold() const { return audibleThreshold; }
+	void SetAudibleThreshold(float audibleThreshold) { this->audibleThreshold = audibleThreshold; }
+
+	float GetGain() const { return gain; }
+	void SetGain(float gain) { this->gain = gain; }
+
+	/**
+	 * Gets the amount of voices mixed in the last call to {@link Mixer#Mix}.
+	 * @return The amount of real voices.
+	 */
+	uint32_t GetRealVoiceCount() const { return realVoiceCount; }
+
+	/**
+	 * Gets the amount of playing voices that were not mixed in the last call to {@link Mixer#Mix}.
+	 * @return The amount of virtual voices.
+	 */
+	uint32_t GetVirtualVoiceCount() const { return virtualVoiceCount; }
+
+private:
+	void Prioritize();
+	void CalculateGains(Voice &voice) const;
+	uint32_t Fetch(Voice &voice, uint32_t frameCount, float *channel0, float *channel1);
+	void Advance(Voice &voice, uint32_t frameCount);
+	bool NextSamples(Voice &voice, std::size_t length);
+
+	uint32_t sampleRate;
+	uint32_t maxVoices;
+	float audibleThreshold = 0.001f;
+	float gain = 1.0f;
+
+	Vector3f listenerPosition;
+	Vector3f listenerRight = Vector3f::Right;
+
+	std::vector<Voice> voices;
+	std::vector<VoiceId> freeVoices;
+
+	// Storage reused between mixes for the order voices are mixed in, the resampled voice being mixed, and the left and right output.
+	std::vector<VoiceId> order;
+	std::vector<float> channel0, channel1;
+	std::vector<float> left, right;
+
+	uint32_t realVoiceCount = 0;
+	uint32_t virtualVoiceCount = 0;
+};
+}
@@ -0,0 +1,31 @@
+#include "NullAudioDevice.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace acid {
+NullAudioDevice::NullAudioDevice(uint32_t sampleRate, uint32_t framesPerUpdate) :
+	AudioDevice(sampleRate),
+	framesPerUpdate(framesPerUpdate),
+	start(Time::Now()) {
+}
+
+uint32_t NullAudioDevice::GetWritableFrames() {
+	if (framesPerUpdate != 0)
+		return framesPerUpdate;
+
+	auto elapsed = static_cast<uint64_t>((Time::Now() - start).AsSeconds<double>() * sampleRate);
+	// After a long stall, like a breakpoint, the frames more than a second behind are skipped rather than mixed all at once.
+	if (elapsed > framesPlayed + sampleRate)
+		framesPlayed = elapsed - sampleRate;
+	return static_cast<uint32_t>(elapsed > framesPlayed ? elapsed - framesPlayed : 0);
+}
+
+void NullAudioDevice::Write(Span<const float> frames) {
+	framesPlayed += frames.size() / 2;
+	framesWritten += frames.size() / 2;
+
+	for (auto sample : frames)
+		peak = std::max(peak, std::abs(sample));
+}
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Maths/Time.hpp"
+#include "AudioDevice.hpp"
+
+namespace acid {
+/**
+ * @brief Audio device that discards what is written to it, so audio can be mixed where there is no sound card, like headless tests and benchmarks.
+ * By default frames are taken as fast as the wall clock plays them, with a fixed amount of frames per update they are taken as fast as the engine runs.
+ */
+class ACID_EXPORT NullAudioDevice : public AudioDevice {
+public:
+	/**
+	 * Creates a new null audio device.
+	 * @param sampleRate The sample rate of the output.
+	 * @param framesPerUpdate The frames taken each update for offline mixing, or 0 to take frames in real time.
+	 */
+	explicit NullAudioDevice(uint32_t sampleRate = 48000, uint32_t framesPerUpdate = 0);
+
+	uint32_t GetWritableFrames() override;
+	void Write(Span<const float> frames) override;
+
+	/**
+	 * Gets the amount of frames written to the device.
+	 * @return The amount of written frames.
+	 */
+	uint64_t GetFramesWritten() const { return framesWritten; }
+
+	/**
+	 * Gets the loudest sample written to the device, used to check sounds were heard.
+	 * @return The peak sample magnitude.
+	 */
+	float GetPeak() const { return peak; }
+	void ResetPeak() { peak = 0.0f; }
+
+private:
+	uint32_t framesPerUpdate;
+	Time start;
+	// The frames the clock has moved past, written or skipped.
+	uint64_t framesPlayed = 0;
+	uint64_t framesWritten = 0;
+	float peak = 0.0f;
+};
+}
@@ -0,0 +1,63 @@
+#include "OpenAlAudioDevice.hpp"
+
+#include <algorithm>
+
+#ifdef ACID_BUILD_MACOS
+#include <OpenAL/al.h>
+#else
+#include <al.h>
+#endif
+#include "Audio/Audio.hpp"
+
+namespace acid {
+OpenAlAudioDevice::OpenAlAudioDevice(uint32_t sampleRate, uint32_t blockFrames, uint32_t blockCount) :
+	AudioDevice(sampleRate),
+	blockFrames(blockFrames),
+	buffers(blockCount) {
+	alGenSources(1, &source);
+	// The mix is already placed around the listener, so the source plays it as it is.
+	alSourcei(source, AL_SOURCE_RELATIVE, AL_TRUE);
+	alGenBuffers(static_cast<ALsizei>(buffers.size()), buffers.data());
+	Audio::CheckAl(alGetError());
+	freeBuffers = buffers;
+}
+
+OpenAlAudioDevice::~OpenAlAudioDevice() {
+	alSourceStop(source);
+	alDeleteSources(1, &source);
+	alDeleteBuffers(static_cast<ALsizei>(buffers.size()), buffers.data());
+}
+
+uint32_t OpenAlAudioDevice::GetWritableFrames() {
+	ALint processed = 0;
+	alGetSourcei(source, AL_BUFFERS_PROCESSED, &processed);
+	for (; processed > 0; processed--) {
+		uint32_t buffer;
+		alSourceUnqueueBuffers(source, 1, &buffer);
+		freeBuffers.emplace_back(buffer);
+	}
+
+	return static_cast<uint32_t>(freeBuffers.size()) * blockFrames;
+}
+
+void OpenAlAudioDevice::Write(Span<const float> frames) {
+	for (std::size_t offset = 0; offset < frames.size() && !freeBuffers.empty(); offset += 2 * blockFrames) {
+		auto count = std::min<std::size_t>(2 * blockFrames, frames.size() - offset);
+		samples.resize(count);
+		for (std::size_t i = 0; i < count; i++)
+			samples[i] = static_cast<int16_t>(std::clamp(frames[offset + i], -1.0f, 1.0f) * 32767.0f);
+
+		auto buffer = freeBuffers.back();
+		freeBuffers.pop_back();
+		alBufferData(buffer, AL_FORMAT_STEREO16, samples.data(), static_cast<ALsizei>(count * sizeof(int16_t)), static_cast<ALsizei>(sampleRate));
+		alSourceQueueBuffers(source, 1, &buffer);
+	}
+
+	// The source stops if it runs dry, so it is started again once there is more to play.
+	ALint state;
+	alGetSourcei(source, AL_SOURCE_STATE, &state);
+	if (state != AL_PLAYING)
+		alSourcePlay(source);
+	Audio::CheckAl(alGetError());
+}
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <vector>
+
+#include "AudioDevice.hpp"
+
+namespace acid {
+/**
+ * @brief Audio device that plays the mix through a single streaming OpenAL source, in place of a source for each sound.
+ * The mix is queued a few blocks ahead of where the source is playing, each block is a trade of latency against the risk of running dry.
+ */
+class ACID_EXPORT OpenAlAudioDevice : public AudioDevice {
+public:
+	/**
+	 * Creates a new OpenAL audio device, the OpenAL context of {@link Audio} must be current.
+	 * @param sampleRate The sample rate of the output.
+	 * @param blockFrames The amount of frames in each queued block.
+	 * @param blockCount The amount of blocks queued ahead.
+	 */
+	explicit OpenAlAudioDevice(uint32_t sampleRate = 48000, uint32_t blockFrames = 1024, uint32_t blockCount = 3);
+	~OpenAlAudioDevice();
+
+	uint32_t GetWritableFrames() override;
+	void Write(Span<const float> frames) override;
+
+private:
+	uint32_t blockFrames;
+	uint32_t source = 0;
+	std::vector<uint32_t> buffers;
+	std::vector<uint32_t> freeBuffers;
+	std::vector<int16_t> samples;
+};
+}
@@ -1,49 +1,50 @@
 #include "Mp3SoundBuffer.hpp"
 
-#ifdef ACID_BUILD_MACOS
-#include <OpenAL/al.h>
-#else
-#include <al.h>
-#endif
 #include <dr_mp3.h>
 
 #include "Files/Files.hpp"
 #include "Maths/Time.hpp"
 
 namespace acid {
-void Mp3SoundBuffer::Load(SoundBuffer &soundBuffer, const std::filesystem::path &filename) {
-#ifdef ACID_DEBUG
-	auto debugStart = Time::Now();
-#endif
-
-	auto fileLoaded = Files::Read(filename);
-
-	if (!fileLoaded) {
-		Log::Error("SoundBuffer could not be loaded: ", filename, '\n');
-		return;
+class Mp3SoundDecoder : public SoundDecoder {
+public:
+	explicit Mp3SoundDecoder(std::string &&data) :
+		data(std::move(data)) {
+		open = drmp3_init_memory(&mp3, this->data.data(), this->data.size(), nullptr);
+		if (!open)
+			return;
+
+		// Counting the frames of a MP3 decodes the whole file, so the length is left unknown.
+		channels = mp3.channels;
+		sampleRate = mp3.sampleRate;
 	}
 
-	drmp3_config config;
-	drmp3_uint64 totalPCMFrameCount;
-	auto sampleData = drmp3_open_memory_and_read_pcm_frames_s16(fileLoaded->data(), fileLoaded->size(), &config, &totalPCMFrameCount, nullptr);
-	if (!sampleData) {
-		Log::Error("Error reading OGG ", filename, ", could not load samples\n");
-		return;
+	~Mp3SoundDecoder() {
+		if (open)
+			drmp3_uninit(&mp3);
 	}
 
-	uint32_t buffer;
-	alGenBuffers(1, &buffer);
-	alBufferData(buffer, (config.channels == 2) ? AL_FORMAT_STEREO16 : AL_FORMAT_MONO16, sampleData, totalPCMFrameCount, config.sampleRate);
+	uint64_t Read(int16_t *samples, uint64_t frameCount) override {
+		return drmp3_read_pcm_frames_s16(&mp3, frameCount, samples);
+	}
 
-	Audio::CheckAl(alGetError());
+	bool Seek(uint64_t frame) override {
+		return drmp3_seek_to_pcm_frame(&mp3, frame);
+	}
 
-	soundBuffer.SetBuffer(buffer);
+	bool IsOpen() const { return open; }
 
-	drmp3_free(sampleData, nullptr);
+private:
+	std::string data;
+	drmp3 mp3 = {};
+	bool open = false;
+};
 
-#ifdef ACID_DEBUG
-	Log::Out("SoundBuffer ", filename, " loaded in ", (Time::Now() - debugStart).AsMilliseconds<float>(), "ms\n");
-#endif
+std::unique_ptr<SoundDecoder> Mp3SoundBuffer::Open(std::string &&data) {
+	auto decoder = std::make_unique<Mp3SoundDecoder>(std::move(data));
+	if (!decoder->IsOpen())
+		return nullptr;
+	return decoder;
 }
 
 void Mp3SoundBuffer::Write(const SoundBuffer &soundBuffer, const std::filesystem::path &filename) {
@@ -1,50 +1,52 @@
 #include "OggSoundBuffer.hpp"
 
-#ifdef ACID_BUILD_MACOS
-#include <OpenAL/al.h>
-#else
-#include <al.h>
-#endif
 #include <stb_vorbis.h>
 
 #include "Files/Files.hpp"
 #include "Maths/Time.hpp"
 
 namespace acid {
-void OggSoundBuffer::Load(SoundBuffer &soundBuffer, const std::filesystem::path &filename) {
-#ifdef ACID_DEBUG
-	auto debugStart = Time::Now();
-#endif
-
-	auto fileLoaded = Files::Read(filename);
+class OggSoundDecoder : public SoundDecoder {
+public:
+	explicit OggSoundDecoder(std::string &&data) :
+		data(std::move(data)) {
+		int32_t error;
+		vorbis = stb_vorbis_open_memory(reinterpret_cast<const uint8_t *>(this->data.data()), static_cast<int32_t>(this->data.size()), &error, nullptr);
+		if (!vorbis)
+			return;
+
+		auto info = stb_vorbis_get_info(vorbis);
+		channels = static_cast<uint32_t>(info.channels);
+		sampleRate = info.sample_rate;
+		frameCount = stb_vorbis_stream_length_in_samples(vorbis);
+	}
 
-	if (!fileLoaded) {
-		Log::Error("SoundBuffer could not be loaded: ", filename, '\n');
-		return;
+	~OggSoundDecoder() {
+		if (vorbis)
+			stb_vorbis_close(vorbis);
 	}
 
-	int32_t channels;
-	int32_t samplesPerSec;
-	int16_t *data;
-	auto size = stb_vorbis_decode_memory(reinterpret_cast<uint8_t *>(fileLoaded->data()), static_cast<uint32_t>(fileLoaded->size()), &channels, &samplesPerSec, &data);
+	uint64_t Read(int16_t *samples, uint64_t frameCount) override {
+		auto sampleCount = static_cast<int32_t>(frameCount * channels);
+		return static_cast<uint64_t>(stb_vorbis_get_samples_short_interleaved(vorbis, static_cast<int32_t>(channels), samples, sampleCount));
+	}
 
-	if (size == -1) {
-		Log::Error("Error reading OGG ", filename, ", could not find size\n");
-		return;
+	bool Seek(uint64_t frame) override {
+		return stb_vorbis_seek(vorbis, static_cast<uint32_t>(frame)) != 0;
 	}
 
-	uint32_t buffer;
-	alGenBuffers(1, &buffer);
-	alBufferData(buffer, (channels == 2) ? AL_FORMAT_STEREO16 : AL_FORMAT_MONO16, data, size, samplesPerSec);
+	bool IsOpen() const { return vorbis != nullptr; }
 
-	Audio::CheckAl(alGetError());
+private:
+	std::string data;
+	stb_vorbis *vorbis = nullptr;
+};
 
-	free(data);
-	soundBuffer.SetBuffer(buffer);
-	
-#ifdef ACID_DEBUG
-	Log::Out("SoundBuffer ", filename, " loaded in ", (Time::Now() - debugStart).AsMilliseconds<float>(), "ms\n");
-#endif
+std::unique_ptr<SoundDecoder> OggSoundBuffer::Open(std::string &&data) {
+	auto decoder = std::make_unique<OggSoundDecoder>(std::move(data));
+	if (!decoder->IsOpen())
+		return nullptr;
+	return decoder;
 }
 
 void OggSoundBuffer::Write(const SoundBuffer &soundBuffer, const std::filesystem::path &filename) {
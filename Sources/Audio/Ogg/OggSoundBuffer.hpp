@@ -6,7 +6,12 @@ namespace acid {
 class ACID_EXPORT OggSoundBuffer : public SoundBuffer::Registrar<OggSoundBuffer> {
 	inline static const bool Registered = Register(".ogg");
 public:
-	static void Load(SoundBuffer &soundBuffer, const std::filesystem::path &filename);
+	/**
+	 * Opens a decoder for the data of a file.
+	 * @param data The data of the file, kept by the decoder.
+	 * @return The decoder, or nullptr if the data could not be decoded.
+	 */
+	static std::unique_ptr<SoundDecoder> Open(std::string &&data);
 	static void Write(const SoundBuffer &soundBuffer, const std::filesystem::path &filename);
 };
 }
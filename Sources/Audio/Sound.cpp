@@ -9,15 +9,48 @@
 #include "Scenes/Entity.hpp"
 
 namespace acid {
-Sound::Sound(const std::string &filename, const Audio::Type &type, bool begin, bool loop, float gain, float pitch) :
-	buffer(SoundBuffer::Create(filename)),
+Sound::Sound(const std::string &filename, const Audio::Type &type, bool begin, bool loop, float gain, float pitch, bool streaming) :
 	type(type),
 	gain(gain),
 	pitch(pitch) {
-	alGenSources(1, &source);
-	alSourcei(source, AL_BUFFER, buffer->GetBuffer());
+	if (auto mixer = Audio::Get()->GetMixer()) {
+		voice = mixer->CreateVoice();
+		auto &mixerVoice = mixer->GetVoice(*voice);
 
-	Audio::CheckAl(alGetError());
+		if (streaming) {
+			if (auto decoder = SoundBuffer::OpenDecoder(filename))
+				stream = std::make_shared<SoundStream>(std::move(decoder));
+		} else {
+			buffer = SoundBuffer::LoadAsync(filename);
+		}
+
+		if (stream) {
+			mixerVoice.stream = stream;
+			mixerVoice.channels = stream->GetChannels();
+			mixerVoice.sampleRate = stream->GetSampleRate();
+		} else {
+			// Until the buffer is loaded, or if the sound could not be loaded, the voice plays nothing.
+			mixerVoice.samples = std::make_shared<const std::vector<int16_t>>();
+		}
+	} else {
+		alGenSources(1, &source);
+
+		if (streaming) {
+			if (auto decoder = SoundBuffer::OpenDecoder(filename)) {
+				stream = std::make_shared<SoundStream>(std::move(decoder));
+				streamBuffers.resize(SoundStream::ChunkCount);
+				alGenBuffers(static_cast<ALsizei>(streamBuffers.size()), streamBuffers.data());
+				unqueuedBuffers = streamBuffers;
+			}
+		} else {
+			buffer = SoundBuffer::LoadAsync(filename);
+		}
+
+		Audio::CheckAl(alGetError());
+	}
+
+	if (buffer && buffer->IsLoaded())
+		AttachBuffer();
 
 	SetGain(gain);
 	SetPitch(pitch);
@@ -32,7 +65,15 @@ Sound::Sound(const std::string &filename, const Audio::Type &type, bool begin, b
 }
 
 Sound::~Sound() {
+	if (voice) {
+		if (auto mixer = Audio::Get()->GetMixer())
+			mixer->DestroyVoice(*voice);
+		return;
+	}
+
 	alDeleteSources(1, &source);
+	if (!streamBuffers.empty())
+		alDeleteBuffers(static_cast<ALsizei>(streamBuffers.size()), streamBuffers.data());
 	Audio::CheckAl(alGetError());
 }
 
@@ -43,10 +84,50 @@ void Sound::Update() {
 	if (auto transform = GetEntity()->GetComponent<Transform>()) {
 		SetPosition(transform->GetPosition());
 	}
+
+	if (buffer && !bufferAttached && buffer->IsLoaded())
+		AttachBuffer();
+
+	if (stream)
+		UpdateStream();
 }
 
 void Sound::Play(bool loop) {
-	alSourcei(source, AL_LOOPING, loop);
+	// Playing is put off until the buffer has been decoded.
+	if (buffer && !bufferAttached) {
+		playOnLoad = loop;
+		loopOnLoad = loop;
+		// Playing starts from the beginning, like it would once loaded.
+		seekOnLoad = std::nullopt;
+		return;
+	}
+
+	if (auto mixerVoice = GetVoice()) {
+		// Streams loop in the decoder, the voice only loops samples it holds whole.
+		if (stream)
+			stream->SetLooping(loop);
+		else
+			mixerVoice->looping = loop;
+		mixerVoice->Seek(0);
+		mixerVoice->state = Mixer::Voice::State::Playing;
+		SetGain(gain);
+		return;
+	}
+
+	if (stream) {
+		// Streams loop in the decoder, looping the source would only repeat the chunks queued on it.
+		stream->SetLooping(loop);
+		alSourceStop(source);
+		ClearStream();
+		stream->Seek(0);
+		// The first chunk is decoded here so playback starts straight away, the rest are decoded on the audio thread pool.
+		stream->Fill(1);
+		QueueStream();
+		streamPlaying = true;
+	} else {
+		alSourcei(source, AL_LOOPING, loop);
+	}
+
 	alSourcePlay(source);
 	Audio::CheckAl(alGetError());
 
@@ -57,7 +138,18 @@ void Sound::Pause() {
 	if (!IsPlaying())
 		return;
 
+	if (playOnLoad) {
+		playOnLoad = std::nullopt;
+		return;
+	}
+
+	if (auto mixerVoice = GetVoice()) {
+		mixerVoice->state = Mixer::Voice::State::Paused;
+		return;
+	}
+
 	alSourcePause(source);
+	streamPlaying = false;
 	Audio::CheckAl(alGetError());
 }
 
@@ -65,7 +157,19 @@ void Sound::Resume() {
 	if (IsPlaying())
 		return;
 
+	if (buffer && !bufferAttached) {
+		playOnLoad = loopOnLoad;
+		return;
+	}
+
+	if (auto mixerVoice = GetVoice()) {
+		mixerVoice->state = Mixer::Voice::State::Playing;
+		SetGain(gain);
+		return;
+	}
+
 	alSourcePlay(source);
+	streamPlaying = stream != nullptr;
 	Audio::CheckAl(alGetError());
 
 	SetGain(gain);
@@ -75,46 +179,218 @@ void Sound::Stop() {
 	if (!IsPlaying())
 		return;
 
+	if (playOnLoad) {
+		playOnLoad = std::nullopt;
+		seekOnLoad = std::nullopt;
+		return;
+	}
+
+	if (auto mixerVoice = GetVoice()) {
+		// Like a stopped source, a stopped voice starts again from the beginning.
+		mixerVoice->state = Mixer::Voice::State::Stopped;
+		mixerVoice->Seek(0);
+		return;
+	}
+
+	alSourceStop(source);
+	streamPlaying = false;
+	if (stream)
+		ClearStream();
+	Audio::CheckAl(alGetError());
+}
+
+void Sound::Seek(const Time &time) {
+	if (buffer && !bufferAttached) {
+		seekOnLoad = time;
+		return;
+	}
+
+	if (auto mixerVoice = GetVoice()) {
+		mixerVoice->Seek(static_cast<uint64_t>(time.AsSeconds<double>() * mixerVoice->sampleRate));
+		return;
+	}
+
+	if (!stream) {
+		alSourcef(source, AL_SEC_OFFSET, time.AsSeconds<float>());
+		Audio::CheckAl(alGetError());
+		return;
+	}
+
+	// The queued chunks are dropped and decoding starts again from the time.
 	alSourceStop(source);
+	ClearStream();
+	stream->Seek(static_cast<uint64_t>(time.AsSeconds<double>() * stream->GetSampleRate()));
+	stream->Fill(1);
+	QueueStream();
+
+	if (streamPlaying)
+		alSourcePlay(source);
 	Audio::CheckAl(alGetError());
 }
 
 bool Sound::IsPlaying() const {
+	if (playOnLoad)
+		return true;
+
+	if (auto mixerVoice = GetVoice())
+		return mixerVoice->state == Mixer::Voice::State::Playing;
+
 	ALenum state;
 	alGetSourcei(source, AL_SOURCE_STATE, &state);
-	return state == AL_PLAYING;
+	// A stream that has run out of decoded chunks is still playing, the source is started again once more are decoded.
+	return state == AL_PLAYING || streamPlaying;
 }
 
 void Sound::SetPosition(const Vector3f &position) {
 	this->position = position;
+	if (auto mixerVoice = GetVoice()) {
+		mixerVoice->position = position;
+		return;
+	}
+
 	alSource3f(source, AL_POSITION, position.x, position.y, position.z);
 	Audio::CheckAl(alGetError());
 }
 
 void Sound::SetDirection(const Vector3f &direction) {
 	this->direction = direction;
+	// The mixer does not model directional sounds.
+	if (voice)
+		return;
+
 	alSource3f(source, AL_DIRECTION, direction.x, direction.y, direction.z);
 	Audio::CheckAl(alGetError());
 }
 
 void Sound::SetVelocity(const Vector3f &velocity) {
 	this->velocity = velocity;
+	// The mixer does not model the Doppler effect.
+	if (voice)
+		return;
+
 	alSource3f(source, AL_VELOCITY, velocity.x, velocity.y, velocity.z);
 	Audio::CheckAl(alGetError());
 }
 
 void Sound::SetGain(float gain) {
 	this->gain = gain;
+	if (auto mixerVoice = GetVoice()) {
+		mixerVoice->gain = gain * Audio::Get()->GetGain(type);
+		return;
+	}
+
 	alSourcef(source, AL_GAIN, gain * Audio::Get()->GetGain(type));
 	Audio::CheckAl(alGetError());
 }
 
 void Sound::SetPitch(float pitch) {
 	this->pitch = pitch;
+	if (auto mixerVoice = GetVoice()) {
+		mixerVoice->pitch = pitch;
+		return;
+	}
+
 	alSourcef(source, AL_PITCH, pitch);
 	Audio::CheckAl(alGetError());
 }
 
+void Sound::AttachBuffer() {
+	bufferAttached = true;
+
+	if (auto mixerVoice = GetVoice()) {
+		if (buffer->GetSamples()) {
+			mixerVoice->samples = buffer->GetSamples();
+			mixerVoice->channels = buffer->GetChannels();
+			mixerVoice->sampleRate = buffer->GetSampleRate();
+		}
+	} else {
+		alSourcei(source, AL_BUFFER, buffer->GetBuffer());
+		Audio::CheckAl(alGetError());
+	}
+
+	// Playing seeks to the beginning, so a seek made before loading is applied after it.
+	auto seek = seekOnLoad;
+	seekOnLoad = std::nullopt;
+
+	if (playOnLoad) {
+		auto loop = *playOnLoad;
+		playOnLoad = std::nullopt;
+		Play(loop);
+	}
+
+	if (seek)
+		Seek(*seek);
+}
+
+void Sound::UpdateStream() {
+	// A voice pops decoded chunks itself, so only decoding ahead is left to do.
+	if (voice) {
+		FillStream();
+		return;
+	}
+
+	// Chunks the source has finished playing are unqueued, and their buffers are filled with the next decoded chunks.
+	ALint processed = 0;
+	alGetSourcei(source, AL_BUFFERS_PROCESSED, &processed);
+	for (; processed > 0; processed--) {
+		uint32_t streamBuffer;
+		alSourceUnqueueBuffers(source, 1, &streamBuffer);
+		unqueuedBuffers.emplace_back(streamBuffer);
+	}
+
+	QueueStream();
+
+	if (!streamPlaying) {
+		Audio::CheckAl(alGetError());
+		return;
+	}
+
+	// The source stops when it runs out of queued chunks, at the end of the sound or when decoding has fallen behind.
+	ALint state, queued;
+	alGetSourcei(source, AL_SOURCE_STATE, &state);
+	alGetSourcei(source, AL_BUFFERS_QUEUED, &queued);
+	if (state != AL_PLAYING && state != AL_PAUSED) {
+		if (queued > 0)
+			alSourcePlay(source);
+		else if (stream->IsEnded())
+			streamPlaying = false;
+	}
+
+	FillStream();
+	Audio::CheckAl(alGetError());
+}
+
+void Sound::FillStream() {
+	if (stream->NeedsFill() && (!streamFill.valid() || streamFill.wait_for(0s) == std::future_status::ready)) {
+		streamFill = Audio::Get()->GetThreadPool().Enqueue([stream = stream] {
+			stream->Fill();
+		});
+	}
+}
+
+void Sound::QueueStream() {
+	while (!unqueuedBuffers.empty() && stream->Pop(streamSamples)) {
+		auto streamBuffer = unqueuedBuffers.back();
+		unqueuedBuffers.pop_back();
+		alBufferData(streamBuffer, SoundBuffer::GetFormat(stream->GetChannels()), streamSamples.data(),
+			static_cast<ALsizei>(streamSamples.size() * sizeof(int16_t)), static_cast<ALsizei>(stream->GetSampleRate()));
+		alSourceQueueBuffers(source, 1, &streamBuffer);
+	}
+}
+
+void Sound::ClearStream() {
+	// Detaching the buffer of a stopped source unqueues every chunk.
+	alSourcei(source, AL_BUFFER, 0);
+	unqueuedBuffers = streamBuffers;
+}
+
+Mixer::Voice *Sound::GetVoice() const {
+	auto mixer = Audio::Get()->GetMixer();
+	if (!voice || !mixer)
+		return nullptr;
+	return &mixer->GetVoice(*voice);
+}
+
 const Node &operator>>(const Node &node, Sound &sound) {
 	node["buffer"].Get(sound.buffer);
 	node["type"].Get(sound.type);
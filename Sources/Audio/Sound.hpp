@@ -1,20 +1,28 @@
 ﻿#pragma once
 
+#include <optional>
+
+#include "Maths/Time.hpp"
 #include "Maths/Vector3.hpp"
 #include "Scenes/Component.hpp"
 #include "SoundBuffer.hpp"
+#include "SoundStream.hpp"
 #include "Audio.hpp"
 
 namespace acid {
 /**
  * @brief Class that represents a playable sound.
+ * A streamed sound is decoded a few chunks ahead of where it is playing on the audio thread pool and queued onto its source,
+ * which suits music and other long sounds, short sounds are decoded whole into a shared {@link SoundBuffer}.
+ * The buffer is loaded asynchronously, a sound played before its buffer has loaded starts playing once it has.
+ * When {@link Audio} has a {@link Mixer} the sound plays on a voice of the mixer rather than on its own source.
  */
 class ACID_EXPORT Sound : public Component::Registrar<Sound> {
 	inline static const bool Registered = Register("sound");
 public:
 	Sound() = default;
 	explicit Sound(const std::string &filename, const Audio::Type &type = Audio::Type::General, bool begin = false,
-		bool loop = false, float gain = 1.0f, float pitch = 1.0f);
+		bool loop = false, float gain = 1.0f, float pitch = 1.0f, bool streaming = false);
 	~Sound();
 
 	void Start() override;
@@ -25,7 +33,14 @@ public:
 	void Resume();
 	void Stop();
 
+	/**
+	 * Moves playback to a time in the sound.
+	 * @param time The time from the start of the sound.
+	 */
+	void Seek(const Time &time);
+
 	bool IsPlaying() const;
+	bool IsStreaming() const { return stream != nullptr; }
 
 	void SetPosition(const Vector3f &position);
 	void SetDirection(const Vector3f &direction);
@@ -44,8 +59,31 @@ public:
 	friend Node &operator<<(Node &node, const Sound &sound);
 
 private:
+	void AttachBuffer();
+	void UpdateStream();
+	void FillStream();
+	void QueueStream();
+	void ClearStream();
+	Mixer::Voice *GetVoice() const;
+
 	std::shared_ptr<SoundBuffer> buffer;
 	uint32_t source = 0;
+	std::optional<Mixer::VoiceId> voice;
+	bool bufferAttached = false;
+	// Set when the sound is played before its buffer has loaded, to if it loops.
+	std::optional<bool> playOnLoad;
+	// If the last play before the buffer loaded loops, kept while it is paused so resuming plays it the same way.
+	bool loopOnLoad = false;
+	// Set when the sound is sought before its buffer has loaded.
+	std::optional<Time> seekOnLoad;
+
+	// Held by the decode task as well, so it outlives the sound if the sound is destroyed while decoding.
+	std::shared_ptr<SoundStream> stream;
+	std::vector<uint32_t> streamBuffers;
+	std::vector<uint32_t> unqueuedBuffers;
+	std::vector<int16_t> streamSamples;
+	std::future<void> streamFill;
+	bool streamPlaying = false;
 
 	Vector3f position;
 	Vector3f direction;
@@ -1,11 +1,16 @@
 #include "SoundBuffer.hpp"
 
+#include <iomanip>
+#include <thread>
+
 #ifdef ACID_BUILD_MACOS
 #include <OpenAL/al.h>
 #else
 #include <al.h>
 #endif
+#include "Files/BinaryStream.hpp"
 #include "Files/Files.hpp"
+#include "Maths/Time.hpp"
 #include "Resources/Resources.hpp"
 
 namespace acid {
@@ -27,6 +32,13 @@ std::shared_ptr<SoundBuffer> SoundBuffer::Create(const std::filesystem::path &fi
 	return Create(node);
 }
 
+std::shared_ptr<SoundBuffer> SoundBuffer::LoadAsync(const std::filesystem::path &filename) {
+	SoundBuffer temp(filename, false);
+	Node node;
+	node << temp;
+	return Resources::Get()->LoadAsync<SoundBuffer>(node);
+}
+
 SoundBuffer::SoundBuffer(std::filesystem::path filename, bool load) :
 	filename(std::move(filename)) {
 	if (load)
@@ -37,6 +49,44 @@ SoundBuffer::~SoundBuffer() {
 	alDeleteBuffers(1, &buffer);
 }
 
+std::size_t SoundBuffer::GetCpuMemoryUsage() const {
+	if (samples)
+		return samples->size() * sizeof(int16_t);
+	if (!buffer)
+		return 0;
+	// OpenAL keeps the PCM data in host memory.
+	ALint size = 0;
+	alGetBufferi(buffer, AL_SIZE, &size);
+	return static_cast<std::size_t>(size);
+}
+
+static std::unique_ptr<SoundDecoder> OpenData(const std::filesystem::path &filename, std::string &&data) {
+	auto it = SoundBuffer::Registry().find(filename.extension().string());
+	if (it == SoundBuffer::Registry().end()) {
+		Log::Error("SoundBuffer has no decoder for: ", filename, '\n');
+		return nullptr;
+	}
+
+	auto decoder = it->second.first(std::move(data));
+	if (!decoder)
+		Log::Error("SoundBuffer could not be decoded: ", filename, '\n');
+	return decoder;
+}
+
+std::unique_ptr<SoundDecoder> SoundBuffer::OpenDecoder(const std::filesystem::path &filename) {
+	auto fileLoaded = Files::Read(filename);
+	if (!fileLoaded) {
+		Log::Error("SoundBuffer could not be loaded: ", filename, '\n');
+		return nullptr;
+	}
+
+	return OpenData(filename, std::move(*fileLoaded));
+}
+
+int32_t SoundBuffer::GetFormat(uint32_t channels) {
+	return channels == 2 ? AL_FORMAT_STEREO16 : AL_FORMAT_MONO16;
+}
+
 void SoundBuffer::SetBuffer(uint32_t buffer) {
 	if (this->buffer)
 		alDeleteBuffers(1, &this->buffer);
@@ -54,9 +104,132 @@ Node &operator<<(Node &node, const SoundBuffer &soundBuffer) {
 }
 
 void SoundBuffer::Load() {
+	Decode();
+	Upload();
+}
+
+static uint64_t HashData(const std::string &data) {
+	uint64_t hash = 14695981039346656037ull;
+	for (auto c : data) {
+		hash ^= static_cast<uint8_t>(c);
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+static constexpr uint32_t CachedSoundMagic = 0x4D435043; // "CPCM"
+static constexpr uint32_t CachedSoundVersion = 1;
+
+static std::filesystem::path GetCachedFilename(uint64_t hash) {
+	std::ostringstream name;
+	name << std::hex << std::setw(16) << std::setfill('0') << hash << ".pcm";
+	return Audio::Get()->GetCacheDirectory() / name.str();
+}
+
+bool SoundBuffer::ReadCachedSamples(const std::filesystem::path &cachedFilename, uint64_t hash, uint64_t size, std::vector<int16_t> &samples,
+	uint32_t &channels, uint32_t &sampleRate) {
+	std::ifstream stream(cachedFilename, std::ios::binary | std::ios::ate);
+	if (!stream)
+		return false;
+
+	std::vector<std::byte> bytes(static_cast<std::size_t>(stream.tellg()));
+	stream.seekg(0);
+	stream.read(reinterpret_cast<char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+	try {
+		BinaryReader reader(bytes);
+		if (reader.Read<uint32_t>() != CachedSoundMagic || reader.Read<uint32_t>() != CachedSoundVersion ||
+			reader.Read<uint64_t>() != hash || reader.Read<uint64_t>() != size)
+			return false;
+		channels = reader.Read<uint32_t>();
+		sampleRate = reader.Read<uint32_t>();
+		reader.Read(samples);
+	} catch (const std::exception &e) {
+		Log::Warning("Cached sound ", cachedFilename, " is invalid: ", e.what(), '\n');
+		return false;
+	}
+	return channels != 0;
+}
+
+void SoundBuffer::WriteCachedSamples(const std::filesystem::path &cachedFilename, uint64_t hash, uint64_t size, const std::vector<int16_t> &samples,
+	uint32_t channels, uint32_t sampleRate) {
+	BinaryWriter writer;
+	writer.Write(CachedSoundMagic);
+	writer.Write(CachedSoundVersion);
+	writer.Write(hash);
+	writer.Write(size);
+	writer.Write(channels);
+	writer.Write(sampleRate);
+	writer.Write<int16_t>(samples);
+
+	// Written beside the cached file and moved over it, so a sound loading at the same time never reads a partial file.
+	auto temporaryFilename = cachedFilename;
+	temporaryFilename += "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+	try {
+		writer.Save(temporaryFilename);
+		std::filesystem::rename(temporaryFilename, cachedFilename);
+	} catch (const std::exception &e) {
+		Log::Warning("Sound could not be cached to ", cachedFilename, ": ", e.what(), '\n');
+		std::error_code ec;
+		std::filesystem::remove(temporaryFilename, ec);
+	}
+}
+
+void SoundBuffer::Decode() {
 	if (filename.empty())
 		return;
 
-	Registry()[filename.extension().string()].first(*this, filename);
+#ifdef ACID_DEBUG
+	auto debugStart = Time::Now();
+#endif
+
+	auto fileLoaded = Files::Read(filename);
+	if (!fileLoaded) {
+		Log::Error("SoundBuffer could not be loaded: ", filename, '\n');
+		return;
+	}
+
+	auto cached = !Audio::Get()->GetCacheDirectory().empty();
+	auto size = static_cast<uint64_t>(fileLoaded->size());
+	auto hash = cached ? HashData(*fileLoaded) : 0;
+	auto cachedFilename = cached ? GetCachedFilename(hash) : std::filesystem::path();
+
+	if (!cached || !ReadCachedSamples(cachedFilename, hash, size, decodedSamples, decodedChannels, decodedSampleRate)) {
+		auto decoder = OpenData(filename, std::move(*fileLoaded));
+		if (!decoder)
+			return;
+
+		decodedSamples = decoder->ReadAll();
+		decodedChannels = decoder->GetChannels();
+		decodedSampleRate = decoder->GetSampleRate();
+
+		if (cached)
+			WriteCachedSamples(cachedFilename, hash, size, decodedSamples, decodedChannels, decodedSampleRate);
+	}
+
+#ifdef ACID_DEBUG
+	Log::Out("SoundBuffer ", filename, " decoded in ", (Time::Now() - debugStart).AsMilliseconds<float>(), "ms\n");
+#endif
+}
+
+void SoundBuffer::Upload() {
+	if (decodedChannels == 0)
+		return;
+
+	channels = decodedChannels;
+	sampleRate = decodedSampleRate;
+
+	// The mixer reads the samples itself, so they are kept rather than given to OpenAL.
+	if (Audio::Get()->GetMixer()) {
+		samples = std::make_shared<const std::vector<int16_t>>(std::move(decodedSamples));
+	} else {
+		uint32_t buffer;
+		alGenBuffers(1, &buffer);
+		alBufferData(buffer, GetFormat(channels), decodedSamples.data(), static_cast<ALsizei>(decodedSamples.size() * sizeof(int16_t)),
+			static_cast<ALsizei>(sampleRate));
+		Audio::CheckAl(alGetError());
+		SetBuffer(buffer);
+	}
+
+	decodedSamples = {};
 }
 }
@@ -4,15 +4,16 @@
 
 #include "Maths/Vector3.hpp"
 #include "Resources/Resource.hpp"
+#include "SoundDecoder.hpp"
 #include "Audio.hpp"
 
 namespace acid {
 template<typename Base>
 class SoundBufferFactory {
 public:
-	using TLoadMethod = std::function<void(Base &, const std::filesystem::path &)>;
+	using TOpenMethod = std::function<std::unique_ptr<SoundDecoder>(std::string &&)>;
 	using TWriteMethod = std::function<void(const Base &, const std::filesystem::path &)>;
-	using TRegistryMap = std::unordered_map<std::string, std::pair<TLoadMethod, TWriteMethod>>;
+	using TRegistryMap = std::unordered_map<std::string, std::pair<TOpenMethod, TWriteMethod>>;
 
 	virtual ~SoundBufferFactory() = default;
 
@@ -27,7 +28,7 @@ public:
 		template<typename ...Args>
 		static bool Register(Args &&... names) {
 			for (std::string &&name : {names...})
-				SoundBufferFactory::Registry()[name] = std::make_pair(&T::Load, &T::Write);
+				SoundBufferFactory::Registry()[name] = std::make_pair(&T::Open, &T::Write);
 			return true;
 		}
 	};
@@ -35,6 +36,8 @@ public:
 
 /**
  * @brief Resource that represents a sound buffer.
+ * Decoded samples are cached on disk by the hash of the sound file when {@link Audio} has a cache directory,
+ * a sound found in the cache is read back without decoding.
  */
 class ACID_EXPORT SoundBuffer : public SoundBufferFactory<SoundBuffer>, public Resource {
 public:
@@ -50,6 +53,13 @@ public:
 	 * @return The sound buffer with the requested values.
 	 */
 	static std::shared_ptr<SoundBuffer> Create(const std::filesystem::path &filename);
+	/**
+	 * Loads a sound buffer asynchronously, or finds one with the same values.
+	 * The sound is decoded on the resource thread pool, and given to OpenAL or the {@link Mixer} in the resource transfer step.
+	 * @param filename The file to load the sound buffer from.
+	 * @return The sound buffer, empty until {@link Resource#IsLoaded}.
+	 */
+	static std::shared_ptr<SoundBuffer> LoadAsync(const std::filesystem::path &filename);
 
 	/**
 	 * Creates a new sound buffer.
@@ -60,18 +70,76 @@ public:
 	~SoundBuffer();
 
 	std::type_index GetTypeIndex() const override { return typeid(SoundBuffer); }
+	std::size_t GetCpuMemoryUsage() const override;
+
+	/**
+	 * Opens a decoder for a sound file, used to stream sounds too long to decode whole.
+	 * @param filename The file to decode.
+	 * @return The decoder, or nullptr if the file could not be read or has no decoder for its type.
+	 */
+	static std::unique_ptr<SoundDecoder> OpenDecoder(const std::filesystem::path &filename);
+
+	/**
+	 * Gets the OpenAL format of 16 bit samples.
+	 * @param channels The amount of channels.
+	 * @return The format.
+	 */
+	ACID_NO_EXPORT static int32_t GetFormat(uint32_t channels);
+
+	/**
+	 * Reads decoded samples from a cache file, if it was written for a sound file with the same contents.
+	 * @param cachedFilename The cache file.
+	 * @param hash The hash of the sound file.
+	 * @param size The size of the sound file, checked to rule out hash collisions between files of different sizes.
+	 * @param samples The samples to read into.
+	 * @param channels The amount of channels read.
+	 * @param sampleRate The sample rate read.
+	 * @return If the samples were read from the cache.
+	 */
+	static bool ReadCachedSamples(const std::filesystem::path &cachedFilename, uint64_t hash, uint64_t size, std::vector<int16_t> &samples,
+		uint32_t &channels, uint32_t &sampleRate);
+	/**
+	 * Writes decoded samples to a cache file, replacing it whole so a sound reading it at the same time never sees a partial file.
+	 * @param cachedFilename The cache file.
+	 * @param hash The hash of the sound file.
+	 * @param size The size of the sound file.
+	 * @param samples The decoded samples.
+	 * @param channels The amount of channels.
+	 * @param sampleRate The sample rate.
+	 */
+	static void WriteCachedSamples(const std::filesystem::path &cachedFilename, uint64_t hash, uint64_t size, const std::vector<int16_t> &samples,
+		uint32_t channels, uint32_t sampleRate);
 
 	const std::filesystem::path &GetFilename() const { return filename; };
 	uint32_t GetBuffer() const { return buffer; }
 	void SetBuffer(uint32_t buffer);
 
+	/**
+	 * Gets the decoded samples, kept in place of a OpenAL buffer when sounds are played through the {@link Mixer}.
+	 * @return The interleaved samples, or nullptr when the sound is in a OpenAL buffer.
+	 */
+	const std::shared_ptr<const std::vector<int16_t>> &GetSamples() const { return samples; }
+	uint32_t GetChannels() const { return channels; }
+	uint32_t GetSampleRate() const { return sampleRate; }
+
 	friend const Node &operator>>(const Node &node, SoundBuffer &soundBuffer);
 	friend Node &operator<<(Node &node, const SoundBuffer &soundBuffer);
 
+protected:
+	void Decode() override;
+	void Upload() override;
+
 private:
 	void Load();
 
 	std::filesystem::path filename;
 	uint32_t buffer = 0;
+	std::shared_ptr<const std::vector<int16_t>> samples;
+	uint32_t channels = 0;
+	uint32_t sampleRate = 0;
+
+	std::vector<int16_t> decodedSamples;
+	uint32_t decodedChannels = 0;
+	uint32_t decodedSampleRate = 0;
 };
 }
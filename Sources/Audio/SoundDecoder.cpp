@@ -0,0 +1,27 @@
+#include "SoundDecoder.hpp"
+
+namespace acid {
+std::vector<int16_t> SoundDecoder::ReadAll() {
+	// Sounds of unknown length are read in pieces that grow the samples as they go.
+	constexpr uint64_t PieceFrames = 16384;
+
+	std::vector<int16_t> samples;
+	if (channels == 0)
+		return samples;
+
+	uint64_t frames = 0;
+	while (true) {
+		auto pieceFrames = frameCount > frames ? frameCount - frames : PieceFrames;
+		samples.resize((frames + pieceFrames) * channels);
+
+		auto read = Read(samples.data() + frames * channels, pieceFrames);
+		frames += read;
+		// A known length is trusted, so the samples are not grown past it looking for more.
+		if (read == 0 || frames == frameCount)
+			break;
+	}
+
+	samples.resize(frames * channels);
+	return samples;
+}
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Utils/NonCopyable.hpp"
+#include "Export.hpp"
+
+namespace acid {
+/**
+ * @brief Class that decodes a sound into interleaved 16 bit samples a piece at a time, so long sounds can be played without decoding them whole.
+ */
+class ACID_EXPORT SoundDecoder : NonCopyable {
+public:
+	virtual ~SoundDecoder() = default;
+
+	/**
+	 * Decodes the next frames of the sound, a frame holds one sample for each channel.
+	 * @param samples The interleaved samples to write into, with room for the amount of frames times the amount of channels.
+	 * @param frameCount The amount of frames to decode.
+	 * @return The amount of frames decoded, 0 once the end of the sound is reached.
+	 */
+	virtual uint64_t Read(int16_t *samples, uint64_t frameCount) = 0;
+
+	/**
+	 * Moves to a frame, the next read decodes from it.
+	 * @param frame The index of the frame.
+	 * @return If the decoder could seek to the frame.
+	 */
+	virtual bool Seek(uint64_t frame) = 0;
+
+	/**
+	 * Decodes every frame left in the sound.
+	 * @return The interleaved samples.
+	 */
+	std::vector<int16_t> ReadAll();
+
+	uint32_t GetChannels() const { return channels; }
+	uint32_t GetSampleRate() const { return sampleRate; }
+
+	/**
+	 * Gets the length of the sound.
+	 * @return The amount of frames, or 0 if the length is not known without decoding the sound.
+	 */
+	uint64_t GetFrameCount() const { return frameCount; }
+
+protected:
+	uint32_t channels = 0;
+	uint32_t sampleRate = 0;
+	uint64_t frameCount = 0;
+};
+}
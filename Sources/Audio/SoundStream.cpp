@@ -0,0 +1,88 @@
+#include "SoundStream.hpp"
+
+namespace acid {
+SoundStream::SoundStream(std::unique_ptr<SoundDecoder> &&decoder, uint32_t chunkFrames, uint32_t chunkCount) :
+	decoder(std::move(decoder)),
+	chunkFrames(chunkFrames),
+	chunkCount(chunkCount) {
+}
+
+void SoundStream::Fill(uint32_t maxChunks) {
+	std::unique_lock<std::mutex> decoderLock(decoderMutex);
+	auto channels = decoder->GetChannels();
+
+	for (uint32_t i = 0; i < maxChunks && !decoderEnded; i++) {
+		std::vector<int16_t> chunk;
+		{
+			std::unique_lock<std::mutex> queueLock(queueMutex);
+			if (chunks.size() >= chunkCount)
+				return;
+			if (!freeChunks.empty()) {
+				chunk = std::move(freeChunks.back());
+				freeChunks.pop_back();
+			}
+		}
+
+		chunk.resize(static_cast<std::size_t>(chunkFrames) * channels);
+		uint64_t frames = 0;
+		// Reading nothing straight after wrapping means the sound is empty, so it can not loop.
+		auto wrapped = false;
+		auto ended = false;
+
+		while (frames < chunkFrames) {
+			auto read = decoder->Read(chunk.data() + frames * channels, chunkFrames - frames);
+			frames += read;
+
+			if (read != 0) {
+				wrapped = false;
+			} else if (looping && !wrapped && decoder->Seek(0)) {
+				wrapped = true;
+			} else {
+				ended = true;
+				break;
+			}
+		}
+
+		chunk.resize(frames * channels);
+		// The end is marked together with queueing the last chunk, so the stream never looks ended with a chunk still to come.
+		std::unique_lock<std::mutex> queueLock(queueMutex);
+		if (frames == 0)
+			freeChunks.emplace_back(std::move(chunk));
+		else
+			chunks.emplace_back(std::move(chunk));
+		decoderEnded = ended;
+	}
+}
+
+bool SoundStream::Pop(std::vector<int16_t> &samples) {
+	std::unique_lock<std::mutex> queueLock(queueMutex);
+	if (chunks.empty())
+		return false;
+
+	std::swap(samples, chunks.front());
+	freeChunks.emplace_back(std::move(chunks.front()));
+	chunks.pop_front();
+	return true;
+}
+
+void SoundStream::Seek(uint64_t frame) {
+	std::unique_lock<std::mutex> decoderLock(decoderMutex);
+	decoder->Seek(frame);
+	decoderEnded = false;
+
+	std::unique_lock<std::mutex> queueLock(queueMutex);
+	for (auto &chunk : chunks)
+		freeChunks.emplace_back(std::move(chunk));
+	chunks.clear();
+}
+
+bool SoundStream::NeedsFill() const {
+	std::unique_lock<std::mutex> queueLock(queueMutex);
+	return !decoderEnded && chunks.size() < chunkCount;
+}
+
+bool SoundStream::IsEnded() const {
+	std::unique_lock<std::mutex> queueLock(queueMutex);
+	return decoderEnded && chunks.empty();
+}
+}
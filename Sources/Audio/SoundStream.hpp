@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+#include "SoundDecoder.hpp"
+
+namespace acid {
+/**
+ * @brief Class that decodes a sound ahead of where it is playing into a small queue of chunks, used to play long sounds without decoding them whole.
+ * Chunks are decoded on a worker thread by {@link SoundStream#Fill} and taken on the audio thread by {@link SoundStream#Pop},
+ * a looping stream wraps back to the start in the middle of a chunk so there is no gap between loops.
+ */
+class ACID_EXPORT SoundStream : NonCopyable {
+public:
+	/**
+	 * Creates a new sound stream.
+	 * @param decoder The decoder of the sound.
+	 * @param chunkFrames The amount of frames decoded into each chunk.
+	 * @param chunkCount The amount of chunks decoded ahead.
+	 */
+	explicit SoundStream(std::unique_ptr<SoundDecoder> &&decoder, uint32_t chunkFrames = ChunkFrames, uint32_t chunkCount = ChunkCount);
+
+	/**
+	 * Decodes chunks until the queue is full or the end of the sound is reached.
+	 * @param maxChunks The max amount of chunks to decode.
+	 */
+	void Fill(uint32_t maxChunks = ChunkCount);
+
+	/**
+	 * Takes the oldest decoded chunk out of the queue.
+	 * @param samples The interleaved samples of the chunk are swapped into this, the storage it held is reused for a later chunk.
+	 * @return If a chunk was taken.
+	 */
+	bool Pop(std::vector<int16_t> &samples);
+
+	/**
+	 * Moves the stream to a frame, every decoded chunk is dropped. Waits for a chunk being decoded to finish.
+	 * @param frame The index of the frame.
+	 */
+	void Seek(uint64_t frame);
+
+	/**
+	 * Gets if the queue has room for another chunk and there is more of the sound to decode.
+	 * @return If the stream needs filling.
+	 */
+	bool NeedsFill() const;
+
+	/**
+	 * Gets if every chunk of the sound has been taken, a looping stream never ends.
+	 * @return If the stream has ended.
+	 */
+	bool IsEnded() const;
+
+	bool IsLooping() const { return looping; }
+	void SetLooping(bool looping) { this->looping = looping; }
+
+	uint32_t GetChannels() const { return decoder->GetChannels(); }
+	uint32_t GetSampleRate() const { return decoder->GetSampleRate(); }
+
+	/// The default amount of frames in a chunk, 16384 frames is a third of a second at 48kHz.
+	constexpr static uint32_t ChunkFrames = 16384;
+	/// The default amount of chunks decoded ahead.
+	constexpr static uint32_t ChunkCount = 4;
+
+private:
+	std::unique_ptr<SoundDecoder> decoder;
+	uint32_t chunkFrames;
+	uint32_t chunkCount;
+	std::atomic<bool> looping = false;
+	std::atomic<bool> decoderEnded = false;
+	// Held while decoding, so seeking waits for the chunk being decoded.
+	std::mutex decoderMutex;
+
+	mutable std::mutex queueMutex;
+	std::deque<std::vector<int16_t>> chunks;
+	// Storage of chunks that have been taken, reused so streaming does not allocate.
+	std::vector<std::vector<int16_t>> freeChunks;
+};
+}
@@ -1,50 +1,50 @@
 #include "WaveSoundBuffer.hpp"
 
-#ifdef ACID_BUILD_MACOS
-#include <OpenAL/al.h>
-#else
-#include <al.h>
-#endif
 #include <dr_wav.h>
 
 #include "Files/Files.hpp"
 #include "Maths/Time.hpp"
 
 namespace acid {
-void WaveSoundBuffer::Load(SoundBuffer &soundBuffer, const std::filesystem::path &filename) {
-#ifdef ACID_DEBUG
-	auto debugStart = Time::Now();
-#endif
-
-	auto fileLoaded = Files::Read(filename);
+class WaveSoundDecoder : public SoundDecoder {
+public:
+	explicit WaveSoundDecoder(std::string &&data) :
+		data(std::move(data)) {
+		open = drwav_init_memory(&wav, this->data.data(), this->data.size(), nullptr);
+		if (!open)
+			return;
+
+		channels = wav.channels;
+		sampleRate = wav.sampleRate;
+		frameCount = wav.totalPCMFrameCount;
+	}
 
-	if (!fileLoaded) {
-		Log::Error("SoundBuffer could not be loaded: ", filename, '\n');
-		return;
+	~WaveSoundDecoder() {
+		if (open)
+			drwav_uninit(&wav);
 	}
 
-	uint32_t channels;
-	uint32_t sampleRate;
-	drwav_uint64 totalPCMFrameCount;
-	auto sampleData = drwav_open_memory_and_read_pcm_frames_s16(fileLoaded->data(), fileLoaded->size(), &channels, &sampleRate, &totalPCMFrameCount, nullptr);
-	if (!sampleData) {
-		Log::Error("Error reading OGG ", filename, ", could not load samples\n");
-		return;
+	uint64_t Read(int16_t *samples, uint64_t frameCount) override {
+		return drwav_read_pcm_frames_s16(&wav, frameCount, samples);
 	}
 
-	uint32_t buffer;
-	alGenBuffers(1, &buffer);
-	alBufferData(buffer, (channels == 2) ? AL_FORMAT_STEREO16 : AL_FORMAT_MONO16, sampleData, totalPCMFrameCount, sampleRate);
+	bool Seek(uint64_t frame) override {
+		return drwav_seek_to_pcm_frame(&wav, frame);
+	}
 
-	Audio::CheckAl(alGetError());
+	bool IsOpen() const { return open; }
 
-	soundBuffer.SetBuffer(buffer);
-	
-	drwav_free(sampleData, nullptr);
+private:
+	std::string data;
+	drwav wav = {};
+	bool open = false;
+};
 
-#ifdef ACID_DEBUG
-	Log::Out("SoundBuffer ", filename, " loaded in ", (Time::Now() - debugStart).AsMilliseconds<float>(), "ms\n");
-#endif
+std::unique_ptr<SoundDecoder> WaveSoundBuffer::Open(std::string &&data) {
+	auto decoder = std::make_unique<WaveSoundDecoder>(std::move(data));
+	if (!decoder->IsOpen())
+		return nullptr;
+	return decoder;
 }
 
 void WaveSoundBuffer::Write(const SoundBuffer &soundBuffer, const std::filesystem::path &filename) {
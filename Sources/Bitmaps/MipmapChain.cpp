@@ -0,0 +1,96 @@
+#include "MipmapChain.hpp"
+
+#include <cmath>
+
+#include "Files/BinaryStream.hpp"
+#include "Files/Files.hpp"
+
+namespace acid {
+static constexpr uint32_t MipmapChainMagic = 0x5845544D; // "MTEX"
+static constexpr uint32_t MipmapChainVersion = 1;
+
+MipmapChain::MipmapChain(const Bitmap &bitmap) :
+	size(bitmap.GetSize()),
+	bytesPerPixel(bitmap.GetBytesPerPixel()) {
+	if (!bitmap.GetData() || size.x == 0 || size.y == 0)
+		return;
+
+	// The same level count as Image::GetMipLevels.
+	CalculateOffsets(static_cast<uint32_t>(std::floor(std::log2(std::max(size.x, size.y)))) + 1);
+	std::memcpy(data.data(), bitmap.GetData().get(), bitmap.GetLength());
+
+	for (uint32_t level = 1; level < GetLevelCount(); level++) {
+		auto srcSize = GetLevelSize(level - 1);
+		auto dstSize = GetLevelSize(level);
+		auto src = data.data() + offsets[level - 1];
+		auto dst = data.data() + offsets[level];
+
+		for (uint32_t y = 0; y < dstSize.y; y++) {
+			auto y0 = std::min(2 * y, srcSize.y - 1);
+			auto y1 = std::min(2 * y + 1, srcSize.y - 1);
+
+			for (uint32_t x = 0; x < dstSize.x; x++) {
+				auto x0 = std::min(2 * x, srcSize.x - 1);
+				auto x1 = std::min(2 * x + 1, srcSize.x - 1);
+
+				for (uint32_t c = 0; c < bytesPerPixel; c++) {
+					uint32_t sum = src[(y0 * srcSize.x + x0) * bytesPerPixel + c] + src[(y0 * srcSize.x + x1) * bytesPerPixel + c] +
+						src[(y1 * srcSize.x + x0) * bytesPerPixel + c] + src[(y1 * srcSize.x + x1) * bytesPerPixel + c];
+					dst[(y * dstSize.x + x) * bytesPerPixel + c] = static_cast<uint8_t>((sum + 2) / 4);
+				}
+			}
+		}
+	}
+}
+
+MipmapChain MipmapChain::Read(const std::filesystem::path &filename) {
+	auto fileLoaded = Files::ReadView(filename);
+	if (!fileLoaded)
+		throw std::runtime_error("Mipmap chain could not be loaded: " + filename.string());
+
+	BinaryReader reader(fileLoaded->GetBytes());
+	if (reader.Read<uint32_t>() != MipmapChainMagic || reader.Read<uint32_t>() != MipmapChainVersion)
+		throw std::runtime_error("Mipmap chain has a unsupported format: " + filename.string());
+
+	MipmapChain mipmapChain;
+	mipmapChain.size = reader.Read<Vector2ui>();
+	mipmapChain.bytesPerPixel = reader.Read<uint32_t>();
+	auto levelCount = reader.Read<uint32_t>();
+	if (levelCount > 32 || static_cast<uint64_t>(mipmapChain.size.x) * mipmapChain.size.y * mipmapChain.bytesPerPixel > reader.GetRemaining())
+		throw std::runtime_error("Mipmap chain is truncated: " + filename.string());
+	mipmapChain.CalculateOffsets(levelCount);
+	reader.ReadBytes(mipmapChain.data.data(), mipmapChain.data.size());
+	return mipmapChain;
+}
+
+void MipmapChain::Write(const std::filesystem::path &filename) const {
+	BinaryWriter writer;
+	writer.Write(MipmapChainMagic);
+	writer.Write(MipmapChainVersion);
+	writer.Write(size);
+	writer.Write(bytesPerPixel);
+	writer.Write(GetLevelCount());
+	writer.WriteBytes(data.data(), data.size());
+	writer.Save(filename);
+}
+
+Vector2ui MipmapChain::GetLevelSize(uint32_t level) const {
+	return {std::max(size.x >> level, 1u), std::max(size.y >> level, 1u)};
+}
+
+Span<const uint8_t> MipmapChain::GetLevel(uint32_t level) const {
+	auto levelSize = GetLevelSize(level);
+	return {data.data() + offsets[level], static_cast<std::size_t>(levelSize.x) * levelSize.y * bytesPerPixel};
+}
+
+void MipmapChain::CalculateOffsets(uint32_t levelCount) {
+	offsets.resize(levelCount);
+	std::size_t length = 0;
+	for (uint32_t level = 0; level < levelCount; level++) {
+		offsets[level] = length;
+		auto levelSize = GetLevelSize(level);
+		length += static_cast<std::size_t>(levelSize.x) * levelSize.y * bytesPerPixel;
+	}
+	data.resize(length);
+}
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Utils/Span.hpp"
+#include "Bitmap.hpp"
+
+namespace acid {
+/**
+ * @brief A bitmap together with all of its downsampled mip levels, stored contiguously from the largest level.
+ * Mipmap chains are generated offline by AcidCooker so images don't have to blit their mip levels on load.
+ */
+class ACID_EXPORT MipmapChain {
+public:
+	/// The extension appended to a source filename to name its cooked mipmap chain.
+	inline static const std::string Extension = ".tex";
+
+	MipmapChain() = default;
+
+	/**
+	 * Creates a mipmap chain from a bitmap, each level is box filtered from the previous one.
+	 * @param bitmap The bitmap for the first level.
+	 */
+	explicit MipmapChain(const Bitmap &bitmap);
+
+	/**
+	 * Reads a mipmap chain written by {@link MipmapChain#Write}.
+	 * @param filename The file to read from.
+	 * @return The mipmap chain.
+	 */
+	static MipmapChain Read(const std::filesystem::path &filename);
+
+	/**
+	 * Writes the mipmap chain to a file on disk.
+	 * @param filename The real path to write to.
+	 */
+	void Write(const std::filesystem::path &filename) const;
+
+	/**
+	 * Gets the filename of the cooked mipmap chain for a source image.
+	 * @param filename The source image filename.
+	 * @return The cooked mipmap chain filename.
+	 */
+	static std::filesystem::path GetCookedFilename(std::filesystem::path filename) { return filename += Extension; }
+
+	/**
+	 * Gets the size of a mip level.
+	 * @param level The mip level.
+	 * @return The size in pixels.
+	 */
+	Vector2ui GetLevelSize(uint32_t level) const;
+
+	/**
+	 * Gets the pixels of a mip level.
+	 * @param level The mip level.
+	 * @return The levels pixels.
+	 */
+	Span<const uint8_t> GetLevel(uint32_t level) const;
+
+	std::size_t GetLevelOffset(uint32_t level) const { return offsets[level]; }
+	uint32_t GetLevelCount() const { return static_cast<uint32_t>(offsets.size()); }
+	const Vector2ui &GetSize() const { return size; }
+	uint32_t GetBytesPerPixel() const { return bytesPerPixel; }
+	const std::vector<uint8_t> &GetData() const { return data; }
+
+private:
+	void CalculateOffsets(uint32_t levelCount);
+
+	Vector2ui size;
+	uint32_t bytesPerPixel = 0;
+	std::vector<uint8_t> data;
+	std::vector<std::size_t> offsets;
+};
+}
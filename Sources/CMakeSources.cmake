@@ -1,29 +1,44 @@
 # All of these will be set as PUBLIC sources to Acid
 set(_temp_acid_headers
 		Animations/AnimatedMesh.hpp
+		Animations/AnimatedMeshData.hpp
+		Animations/AnimatedModel.hpp
 		Animations/Animation/Animation.hpp
 		Animations/Animation/AnimationLoader.hpp
+		Animations/Animation/AnimationPose.hpp
+		Animations/Animation/AnimationTrack.hpp
 		Animations/Animation/JointTransform.hpp
 		Animations/Animation/Keyframe.hpp
+		Animations/AnimationLayer.hpp
+		Animations/Animations.hpp
 		Animations/Animator.hpp
+		Animations/CrowdEvaluator.hpp
 		Animations/Geometry/GeometryLoader.hpp
 		Animations/Geometry/VertexAnimated.hpp
 		Animations/Skeleton/Joint.hpp
+		Animations/Skeleton/Skeleton.hpp
 		Animations/Skeleton/SkeletonLoader.hpp
 		Animations/Skin/SkinLoader.hpp
+		Animations/Skin/Skinning.hpp
 		Animations/Skin/VertexWeights.hpp
 		Audio/Audio.hpp
 		Audio/Flac/FlacSoundBuffer.hpp
+		Audio/Mixer/AudioDevice.hpp
+		Audio/Mixer/Mixer.hpp
+		Audio/Mixer/NullAudioDevice.hpp
+		Audio/Mixer/OpenAlAudioDevice.hpp
 		Audio/Mp3/Mp3SoundBuffer.hpp
 		Audio/Ogg/OggSoundBuffer.hpp
-		Audio/Opus/OpusSoundBuffer.hpp
 		Audio/Sound.hpp
 		Audio/SoundBuffer.hpp
+		Audio/SoundDecoder.hpp
+		Audio/SoundStream.hpp
 		Audio/Wave/WaveSoundBuffer.hpp
 		Bitmaps/Bitmap.hpp
 		Bitmaps/Dng/DngBitmap.hpp
 		Bitmaps/Exr/ExrBitmap.hpp
 		Bitmaps/Jpg/JpgBitmap.hpp
+		Bitmaps/MipmapChain.hpp
 		Bitmaps/Png/PngBitmap.hpp
 		Devices/Cursor.hpp
 		Devices/Joysticks.hpp
@@ -34,6 +49,8 @@ set(_temp_acid_headers
 		Engine/Engine.hpp
 		Engine/Log.hpp
 		Engine/Module.hpp
+		Files/Archive.hpp
+		Files/BinaryStream.hpp
 		Files/File.hpp
 		Files/FileObserver.hpp
 		Files/Files.hpp
@@ -128,6 +145,7 @@ set(_temp_acid_headers
 		Maths/Vector4.inl
 		Meshes/Mesh.hpp
 		Meshes/MeshesSubrender.hpp
+		Models/Binary/BinaryModel.hpp
 		Models/Gltf/GltfModel.hpp
 		Models/Model.hpp
 		Models/Obj/ObjModel.hpp
@@ -155,12 +173,15 @@ set(_temp_acid_headers
 		Network/Tcp/TcpListener.hpp
 		Network/Tcp/TcpSocket.hpp
 		Network/Udp/UdpSocket.hpp
+		Particles/BitonicSort.hpp
 		Particles/Emitters/CircleEmitter.hpp
 		Particles/Emitters/Emitter.hpp
 		Particles/Emitters/LineEmitter.hpp
 		Particles/Emitters/PointEmitter.hpp
 		Particles/Emitters/SphereEmitter.hpp
 		Particles/Particle.hpp
+		Particles/ParticleCompute.hpp
+		Particles/ParticlePool.hpp
 		Particles/Particles.hpp
 		Particles/ParticlesSubrender.hpp
 		Particles/ParticleSystem.hpp
@@ -254,6 +275,7 @@ set(_temp_acid_headers
 		Utils/Future.hpp
 		Utils/NonCopyable.hpp
 		Utils/RingBuffer.hpp
+		Utils/Span.hpp
 		Utils/StreamFactory.hpp
 		Utils/String.hpp
 		Utils/ThreadPool.hpp
@@ -264,7 +286,6 @@ set(_temp_acid_third_party_headers
 		../External/cr/cr.h
 		../External/dr_libs/dr_flac.h
 		../External/dr_libs/dr_mp3.h
-		../External/dr_libs/dr_opus.h
 		../External/dr_libs/dr_wav.h
 		../External/FastNoiseLite/FastNoiseLite.h
 		../External/libjpgd/jpgd.h
@@ -290,28 +311,42 @@ set(_temp_acid_third_party_headers
 		)
 set(_temp_acid_sources
 		Animations/AnimatedMesh.cpp
+		Animations/AnimatedMeshData.cpp
+		Animations/AnimatedModel.cpp
 		Animations/Animation/Animation.cpp
 		Animations/Animation/AnimationLoader.cpp
+		Animations/Animation/AnimationPose.cpp
+		Animations/Animation/AnimationTrack.cpp
 		Animations/Animation/JointTransform.cpp
 		Animations/Animation/Keyframe.cpp
+		Animations/AnimationLayer.cpp
+		Animations/Animations.cpp
 		Animations/Animator.cpp
+		Animations/CrowdEvaluator.cpp
 		Animations/Geometry/GeometryLoader.cpp
 		Animations/Skeleton/Joint.cpp
+		Animations/Skeleton/Skeleton.cpp
 		Animations/Skeleton/SkeletonLoader.cpp
 		Animations/Skin/SkinLoader.cpp
+		Animations/Skin/Skinning.cpp
 		Animations/Skin/VertexWeights.cpp
 		Audio/Audio.cpp
 		Audio/Flac/FlacSoundBuffer.cpp
+		Audio/Mixer/Mixer.cpp
+		Audio/Mixer/NullAudioDevice.cpp
+		Audio/Mixer/OpenAlAudioDevice.cpp
 		Audio/Mp3/Mp3SoundBuffer.cpp
 		Audio/Ogg/OggSoundBuffer.cpp
-		Audio/Opus/OpusSoundBuffer.cpp
 		Audio/Sound.cpp
 		Audio/SoundBuffer.cpp
+		Audio/SoundDecoder.cpp
+		Audio/SoundStream.cpp
 		Audio/Wave/WaveSoundBuffer.cpp
 		Bitmaps/Bitmap.cpp
 		Bitmaps/Dng/DngBitmap.cpp
 		Bitmaps/Exr/ExrBitmap.cpp
 		Bitmaps/Jpg/JpgBitmap.cpp
+		Bitmaps/MipmapChain.cpp
 		Bitmaps/Png/PngBitmap.cpp
 		Devices/Cursor.cpp
 		Devices/Joysticks.cpp
@@ -320,6 +355,7 @@ set(_temp_acid_sources
 		Devices/Windows.cpp
 		Engine/Engine.cpp
 		Engine/Log.cpp
+		Files/Archive.cpp
 		Files/File.cpp
 		Files/FileObserver.cpp
 		Files/Files.cpp
@@ -396,6 +432,7 @@ set(_temp_acid_sources
 		Maths/Vector4.cpp
 		Meshes/Mesh.cpp
 		Meshes/MeshesSubrender.cpp
+		Models/Binary/BinaryModel.cpp
 		Models/Gltf/GltfModel.cpp
 		Models/Model.cpp
 		Models/Obj/ObjModel.cpp
@@ -421,11 +458,15 @@ set(_temp_acid_sources
 		Network/Tcp/TcpListener.cpp
 		Network/Tcp/TcpSocket.cpp
 		Network/Udp/UdpSocket.cpp
+		Particles/BitonicSort.cpp
 		Particles/Emitters/CircleEmitter.cpp
+		Particles/Emitters/Emitter.cpp
 		Particles/Emitters/LineEmitter.cpp
 		Particles/Emitters/PointEmitter.cpp
 		Particles/Emitters/SphereEmitter.cpp
 		Particles/Particle.cpp
+		Particles/ParticleCompute.cpp
+		Particles/ParticlePool.cpp
 		Particles/Particles.cpp
 		Particles/ParticlesSubrender.cpp
 		Particles/ParticleSystem.cpp
@@ -501,7 +542,6 @@ set(_temp_acid_sources
 set(_temp_acid_third_party_sources
 		../External/dr_libs/dr_flac.c
 		../External/dr_libs/dr_mp3.c
-		../External/dr_libs/dr_opus.c
 		../External/dr_libs/dr_wav.c
 		../External/libjpgd/jpgd.cpp
 		../External/libspng/spng.c
@@ -11,7 +11,8 @@ Engine::Engine(std::string argv0, ModuleFilter &&moduleFilter) :
 	fpsLimit(-1.0f),
 	running(true),
 	elapsedUpdate(15.77ms),
-	elapsedRender(-1s) {
+	elapsedRender(-1s),
+	threadPool(std::max(std::thread::hardware_concurrency(), 2u) - 1) {
 	Instance = this;
 	Log::OpenLog(Time::GetDateTime("Logs/%Y%m%d%H%M%S.txt"));
 
@@ -5,6 +5,7 @@
 #include "Utils/NonCopyable.hpp"
 #include "Maths/ElapsedTime.hpp"
 #include "Maths/Time.hpp"
+#include "Utils/ThreadPool.hpp"
 #include "Module.hpp"
 #include "Log.hpp"
 #include "App.hpp"
@@ -131,6 +132,13 @@ public:
 	 */
 	uint32_t GetFps() const { return fps.value; }
 
+	/**
+	 * Gets the workers shared by the parallel loops of every system, such as particles and animations.
+	 * Long running tasks like resource loading go to their own pools, so they never hold up a frame.
+	 * @return The shared thread pool.
+	 */
+	ThreadPool &GetThreadPool() { return threadPool; }
+
 	/**
 	 * Requests the engine to stop the game-loop.
 	 */
@@ -157,5 +165,8 @@ private:
 	Delta deltaUpdate, deltaRender;
 	ElapsedTime elapsedUpdate, elapsedRender;
 	ChangePerSecond ups, fps;
+
+	// The calling thread works alongside the pool, so one less worker than cores is needed.
+	ThreadPool threadPool;
 };
 }
@@ -1,17 +1,506 @@
 #include "Log.hpp"
 
+#include <algorithm>
+#include <condition_variable>
+#include <iomanip>
+#include <limits>
+#include <thread>
+
 namespace acid {
-std::mutex Log::WriteMutex;
-std::ofstream Log::FileStream;
+std::atomic<uint32_t> Log::RateLimit = 0;
+
+#pragma pack(push, 1)
+class LogRecordHeader {
+public:
+	uint64_t sequence;
+	int64_t timestamp;
+	Log::Level level;
+	uint16_t styleSize;
+	uint16_t colourSize;
+};
+#pragma pack(pop)
+
+/**
+ * @brief A single producer single consumer ring of length prefixed records, owned by one logging thread.
+ */
+class LogBuffer {
+public:
+	explicit LogBuffer(uint32_t threadIndex) :
+		data(std::make_unique<std::byte[]>(Log::BufferSize)),
+		threadIndex(threadIndex) {
+	}
+
+	/**
+	 * Pushes a record, called only from the owning thread.
+	 * @param record The record bytes.
+	 * @param size The record size.
+	 * @return If there was space for the record.
+	 */
+	bool Push(const std::byte *record, uint32_t size) {
+		auto writeHead = head.load(std::memory_order_relaxed);
+		if (Log::BufferSize - (writeHead - tail.load(std::memory_order_acquire)) < sizeof(uint32_t) + size)
+			return false;
+
+		Copy(writeHead, &size, sizeof(uint32_t));
+		Copy(writeHead + sizeof(uint32_t), record, size);
+		head.store(writeHead + sizeof(uint32_t) + size, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * Pops all complete records, called only from the logger thread.
+	 * @param records The records to append to.
+	 */
+	void Drain(std::vector<std::vector<std::byte>> &records) {
+		auto readTail = tail.load(std::memory_order_relaxed);
+		auto readHead = head.load(std::memory_order_acquire);
+
+		while (readTail != readHead) {
+			uint32_t size;
+			CopyOut(readTail, &size, sizeof(uint32_t));
+			auto &record = records.emplace_back(size);
+			CopyOut(readTail + sizeof(uint32_t), record.data(), size);
+			readTail += sizeof(uint32_t) + size;
+		}
+
+		tail.store(readTail, std::memory_order_release);
+	}
+
+	bool Empty() const { return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire); }
+
+	// The producers token bucket, only touched by the owning thread.
+	bool TakeToken(uint32_t rateLimit) {
+		auto now = std::chrono::steady_clock::now();
+		auto elapsed = std::chrono::duration<double>(now - lastRefill).count();
+		lastRefill = now;
+		tokens = std::min<double>(rateLimit, tokens + elapsed * rateLimit);
+		if (tokens < 1.0)
+			return false;
+		tokens -= 1.0;
+		return true;
+	}
+
+	std::unique_ptr<std::byte[]> data;
+	std::atomic<uint64_t> head = 0;
+	std::atomic<uint64_t> tail = 0;
+	uint32_t threadIndex;
+	std::atomic<bool> closed = false;
+	std::atomic<uint64_t> dropped = 0;
+	std::atomic<uint64_t> rateLimited = 0;
+
+private:
+	void Copy(uint64_t position, const void *src, std::size_t size) {
+		auto offset = static_cast<std::size_t>(position % Log::BufferSize);
+		auto first = std::min(size, Log::BufferSize - offset);
+		std::memcpy(data.get() + offset, src, first);
+		std::memcpy(data.get(), static_cast<const std::byte *>(src) + first, size - first);
+	}
+
+	void CopyOut(uint64_t position, void *dst, std::size_t size) const {
+		auto offset = static_cast<std::size_t>(position % Log::BufferSize);
+		auto first = std::min(size, Log::BufferSize - offset);
+		std::memcpy(dst, data.get() + offset, first);
+		std::memcpy(static_cast<std::byte *>(dst) + first, data.get(), size - first);
+	}
+
+	double tokens = std::numeric_limits<double>::max();
+	std::chrono::steady_clock::time_point lastRefill = std::chrono::steady_clock::now();
+};
+
+/**
+ * @brief The background thread that formats records and writes them to the sinks.
+ */
+class LogWorker {
+public:
+	// Constant initialized and never destroyed, so it can be read during static destruction.
+	inline static std::atomic<bool> Alive = false;
+
+	LogWorker() :
+		thread([this] { Run(); }) {
+		Alive = true;
+	}
+
+	~LogWorker() {
+		Alive = false;
+		{
+			std::unique_lock<std::mutex> lock(wakeMutex);
+			running = false;
+		}
+		wake.notify_one();
+		thread.join();
+	}
+
+	static LogWorker &Get() {
+		static LogWorker worker;
+		return worker;
+	}
+
+	std::shared_ptr<LogBuffer> Register() {
+		std::unique_lock<std::mutex> lock(buffersMutex);
+		auto buffer = std::make_shared<LogBuffer>(nextThreadIndex++);
+		buffers.emplace_back(buffer);
+		return buffer;
+	}
+
+	uint64_t NextSequence() { return sequence.fetch_add(1, std::memory_order_relaxed); }
+	void Committed() { committed.fetch_add(1, std::memory_order_release); }
+
+	void Flush() {
+		auto target = committed.load(std::memory_order_acquire);
+		wake.notify_one();
+		while (consumed.load(std::memory_order_acquire) < target)
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+	}
+
+	Log::Stats GetStats() {
+		Log::Stats stats;
+		stats.written = consumed.load();
+		stats.dropped = retiredDropped;
+		stats.rateLimited = retiredRateLimited;
+		std::unique_lock<std::mutex> lock(buffersMutex);
+		for (const auto &buffer : buffers) {
+			stats.dropped += buffer->dropped;
+			stats.rateLimited += buffer->rateLimited;
+		}
+		return stats;
+	}
+
+	/**
+	 * Decodes a record and formats its arguments.
+	 * @param record The record bytes.
+	 * @param style The console style of the record.
+	 * @param colour The console colour of the record.
+	 * @param message The stream to format into, it is cleared first.
+	 * @return The record header.
+	 */
+	static LogRecordHeader Format(const std::vector<std::byte> &record, std::string_view &style, std::string_view &colour, std::ostringstream &message) {
+		auto header = GetHeader(record);
+		auto position = sizeof(LogRecordHeader);
+		style = {reinterpret_cast<const char *>(record.data() + position), header.styleSize};
+		position += header.styleSize;
+		colour = {reinterpret_cast<const char *>(record.data() + position), header.colourSize};
+		position += header.colourSize;
+
+		message.str({});
+		message.clear();
+		while (position < record.size()) {
+			Log::Tag tag;
+			std::memcpy(&tag, record.data() + position, sizeof(Log::Tag));
+			position += sizeof(Log::Tag);
+
+			switch (tag) {
+			case Log::Tag::Int:
+				message << Decode<int64_t>(record, position);
+				break;
+			case Log::Tag::UInt:
+				message << Decode<uint64_t>(record, position);
+				break;
+			case Log::Tag::Float:
+				message << Decode<double>(record, position);
+				break;
+			case Log::Tag::Char:
+				message << Decode<char>(record, position);
+				break;
+			case Log::Tag::String: {
+				auto size = Decode<uint32_t>(record, position);
+				message << std::string_view(reinterpret_cast<const char *>(record.data() + position), size);
+				position += size;
+				break;
+			}
+			}
+		}
+
+		return header;
+	}
+
+	void OpenLog(const std::filesystem::path &filepath) {
+		std::unique_lock<std::mutex> lock(sinkMutex);
+		if (auto parentPath = filepath.parent_path(); !parentPath.empty())
+			std::filesystem::create_directories(parentPath);
+		fileStream.open(filepath);
+	}
+
+	void OpenJsonLog(const std::filesystem::path &filepath) {
+		std::unique_lock<std::mutex> lock(sinkMutex);
+		if (auto parentPath = filepath.parent_path(); !parentPath.empty())
+			std::filesystem::create_directories(parentPath);
+		jsonStream.open(filepath);
+	}
+
+	void CloseLog() {
+		Flush();
+		std::unique_lock<std::mutex> lock(sinkMutex);
+		fileStream.close();
+	}
+
+	void CloseJsonLog() {
+		Flush();
+		std::unique_lock<std::mutex> lock(sinkMutex);
+		jsonStream.close();
+	}
+
+private:
+	class Pending {
+	public:
+		std::vector<std::byte> record;
+		uint32_t threadIndex;
+	};
+
+	void Run() {
+		std::vector<std::vector<std::byte>> records;
+		std::vector<Pending> pending;
+
+		while (true) {
+			bool stopping;
+			{
+				std::unique_lock<std::mutex> lock(wakeMutex);
+				wake.wait_for(lock, std::chrono::milliseconds(2));
+				stopping = !running;
+			}
+
+			pending.clear();
+			{
+				std::unique_lock<std::mutex> lock(buffersMutex);
+				for (auto it = buffers.begin(); it != buffers.end();) {
+					auto &buffer = **it;
+					// Closed is read before draining, so records pushed before the thread exited are never lost.
+					auto closed = buffer.closed.load(std::memory_order_acquire);
+					records.clear();
+					buffer.Drain(records);
+					for (auto &record : records)
+						pending.push_back({std::move(record), buffer.threadIndex});
+
+					if (closed) {
+						retiredDropped += buffer.dropped;
+						retiredRateLimited += buffer.rateLimited;
+						it = buffers.erase(it);
+					} else {
+						++it;
+					}
+				}
+			}
+
+			if (!pending.empty()) {
+				// Records are merged between threads in the order they were written.
+				std::sort(pending.begin(), pending.end(), [](const Pending &a, const Pending &b) {
+					return GetHeader(a.record).sequence < GetHeader(b.record).sequence;
+				});
+
+				std::unique_lock<std::mutex> lock(sinkMutex);
+				for (const auto &[record, threadIndex] : pending)
+					WriteRecord(record, threadIndex);
+				std::cout.flush();
+				fileStream.flush();
+				jsonStream.flush();
+				consumed.fetch_add(pending.size(), std::memory_order_release);
+			}
+
+			ReportDropped();
+
+			if (stopping)
+				break;
+		}
+	}
+
+	static LogRecordHeader GetHeader(const std::vector<std::byte> &record) {
+		LogRecordHeader header;
+		std::memcpy(&header, record.data(), sizeof(LogRecordHeader));
+		return header;
+	}
+
+	void WriteRecord(const std::vector<std::byte> &record, uint32_t threadIndex) {
+		std::string_view style, colour;
+		auto header = Format(record, style, colour, message);
+		auto text = message.str();
+		if (!style.empty() || !colour.empty())
+			std::cout << style << colour << text << Log::Styles::Default;
+		else
+			std::cout << text;
+
+		if (fileStream.is_open())
+			fileStream << text;
+		if (jsonStream.is_open())
+			WriteJson(header, threadIndex, text);
+	}
+
+	void WriteJson(const LogRecordHeader &header, uint32_t threadIndex, std::string_view text) {
+		static constexpr std::string_view LevelNames[] = {"out", "debug", "info", "warning", "error", "assert"};
+
+		// Messages usually end their line, the record is already a line of its own.
+		while (!text.empty() && (text.back() == '\n' || text.back() == '\r'))
+			text.remove_suffix(1);
+
+		jsonStream << R"({"time":)" << header.timestamp << R"(,"level":")" << LevelNames[static_cast<uint8_t>(header.level)] <<
+			R"(","thread":)" << threadIndex << R"(,"message":")";
+		for (auto c : text) {
+			switch (c) {
+			case '"':
+				jsonStream << "\\\"";
+				break;
+			case '\\':
+				jsonStream << "\\\\";
+				break;
+			case '\n':
+				jsonStream << "\\n";
+				break;
+			case '\t':
+				jsonStream << "\\t";
+				break;
+			default:
+				if (static_cast<uint8_t>(c) < 0x20)
+					jsonStream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int32_t>(c) << std::dec;
+				else
+					jsonStream << c;
+			}
+		}
+		jsonStream << "\"}\n";
+	}
+
+	void ReportDropped() {
+		auto now = std::chrono::steady_clock::now();
+		if (now - lastReport < std::chrono::seconds(1))
+			return;
+		lastReport = now;
+
+		auto stats = GetStats();
+		if (stats.dropped == reportedDropped && stats.rateLimited == reportedRateLimited)
+			return;
+
+		std::unique_lock<std::mutex> lock(sinkMutex);
+		std::stringstream report;
+		report << "Log dropped " << stats.dropped - reportedDropped << " records with full buffers and " << stats.rateLimited - reportedRateLimited << " rate limited records\n";
+		std::cout << Log::Colours::Yellow << report.str() << Log::Styles::Default;
+		if (fileStream.is_open())
+			fileStream << report.str();
+		reportedDropped = stats.dropped;
+		reportedRateLimited = stats.rateLimited;
+	}
+
+	template<typename T>
+	static T Decode(const std::vector<std::byte> &record, std::size_t &position) {
+		T value;
+		std::memcpy(&value, record.data() + position, sizeof(T));
+		position += sizeof(T);
+		return value;
+	}
+
+	std::vector<std::shared_ptr<LogBuffer>> buffers;
+	std::mutex buffersMutex;
+	uint32_t nextThreadIndex = 0;
+	uint64_t retiredDropped = 0;
+	uint64_t retiredRateLimited = 0;
+
+	std::atomic<uint64_t> sequence = 0;
+	std::atomic<uint64_t> committed = 0;
+	std::atomic<uint64_t> consumed = 0;
+
+	// Guards the sinks, producers never take it.
+	std::mutex sinkMutex;
+	std::ofstream fileStream;
+	std::ofstream jsonStream;
+	std::ostringstream message;
+	uint64_t reportedDropped = 0;
+	uint64_t reportedRateLimited = 0;
+	std::chrono::steady_clock::time_point lastReport;
+
+	std::mutex wakeMutex;
+	std::condition_variable wake;
+	bool running = true;
+	std::thread thread;
+};
+
+/**
+ * @brief Registers the calling threads buffer on its first record, and marks it closed when the thread exits.
+ */
+class LogThread {
+public:
+	~LogThread() {
+		if (buffer)
+			buffer->closed.store(true, std::memory_order_release);
+	}
+
+	LogBuffer *GetBuffer() {
+		if (!buffer)
+			buffer = LogWorker::Get().Register();
+		return buffer.get();
+	}
+
+	std::vector<std::byte> scratch;
+
+private:
+	std::shared_ptr<LogBuffer> buffer;
+};
+
+static thread_local LogThread ThisThread;
+
+std::vector<std::byte> &Log::BeginRecord(Level level, std::string_view style, std::string_view colour) {
+	auto &record = ThisThread.scratch;
+	record.clear();
+
+	LogRecordHeader header = {};
+	header.timestamp = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+	header.level = level;
+	header.styleSize = static_cast<uint16_t>(style.size());
+	header.colourSize = static_cast<uint16_t>(colour.size());
+	EncodeBytes(record, &header, sizeof(LogRecordHeader));
+	EncodeBytes(record, style.data(), style.size());
+	EncodeBytes(record, colour.data(), colour.size());
+	return record;
+}
+
+void Log::CommitRecord(std::vector<std::byte> &record) {
+	// The first record starts the worker.
+	static auto &worker = LogWorker::Get();
+	if (!LogWorker::Alive) {
+		// The worker was destroyed during static destruction, records are written directly to the console.
+		std::string_view style, colour;
+		std::ostringstream message;
+		LogWorker::Format(record, style, colour, message);
+		std::cout << message.str();
+		return;
+	}
+
+	auto buffer = ThisThread.GetBuffer();
+
+	LogRecordHeader header;
+	std::memcpy(&header, record.data(), sizeof(LogRecordHeader));
+	if (auto rateLimit = RateLimit.load(std::memory_order_relaxed); rateLimit != 0 && header.level < Level::Error && !buffer->TakeToken(rateLimit)) {
+		buffer->rateLimited.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	header.sequence = worker.NextSequence();
+	std::memcpy(record.data(), &header, sizeof(LogRecordHeader));
+	if (!buffer->Push(record.data(), static_cast<uint32_t>(record.size()))) {
+		buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	worker.Committed();
+}
 
 void Log::OpenLog(const std::filesystem::path &filepath) {
-	//std::unique_lock<std::mutex> lock(WriteMutex);
-	if (auto parentPath = filepath.parent_path(); !parentPath.empty())
-		std::filesystem::create_directories(parentPath);
-	FileStream.open(filepath);
+	LogWorker::Get().OpenLog(filepath);
 }
 
 void Log::CloseLog() {
-	FileStream.close();
+	LogWorker::Get().CloseLog();
+}
+
+void Log::OpenJsonLog(const std::filesystem::path &filepath) {
+	LogWorker::Get().OpenJsonLog(filepath);
+}
+
+void Log::CloseJsonLog() {
+	LogWorker::Get().CloseJsonLog();
+}
+
+void Log::Flush() {
+	if (LogWorker::Alive)
+		LogWorker::Get().Flush();
+}
+
+Log::Stats Log::GetStats() {
+	return LogWorker::Get().GetStats();
 }
 }
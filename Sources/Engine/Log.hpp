@@ -1,8 +1,11 @@
 #pragma once
 
+#include <atomic>
 #include <cassert>
-#include <sstream>
+#include <cstring>
 #include <mutex>
+#include <sstream>
+#include <vector>
 #include <filesystem>
 #include <string_view>
 #include <iostream>
@@ -13,9 +16,26 @@
 namespace acid {
 /**
  * @brief A logging class used in Acid, will write output to the standard stream and into a file.
+ * Calls encode a compact binary record into a lock free ring buffer owned by the calling thread,
+ * a background thread merges the buffers in call order, formats the records, and writes them to the sinks.
+ * When a buffer is full, or a thread exceeds the rate limit, records are dropped and counted instead of blocking.
  */
 class ACID_EXPORT Log {
 public:
+	enum class Level : uint8_t {
+		Out, Debug, Info, Warning, Error, Assert
+	};
+
+	/**
+	 * @brief Counters describing the records that have passed through the logger.
+	 */
+	class Stats {
+	public:
+		uint64_t written = 0;
+		uint64_t dropped = 0;
+		uint64_t rateLimited = 0;
+	};
+
 	class Styles {
 	public:
 		constexpr static std::string_view Default = "\033[0m";
@@ -49,6 +69,8 @@ public:
 	};
 
 	constexpr static std::string_view TimestampFormat = "%H:%M:%S";
+	/// The size in bytes of each threads record buffer.
+	constexpr static std::size_t BufferSize = 256 * 1024;
 
 	/**
 	 * Outputs a message into the console.
@@ -57,7 +79,7 @@ public:
 	 */
 	template<typename ... Args>
 	static void Out(Args ... args) {
-		Write(args...); 
+		Write(Level::Out, {}, {}, args...);
 	}
 
 	/**
@@ -69,7 +91,7 @@ public:
 	 */
 	template<typename ... Args>
 	static void Out(const std::string_view &style, const std::string_view &colour, Args ... args) {
-		Write(style, colour, args..., Styles::Default);
+		Write(Level::Out, style, colour, args...);
 	}
 
 	/**
@@ -80,7 +102,7 @@ public:
 	template<typename ... Args>
 	static void Debug(Args ... args) {
 #ifdef ACID_DEBUG
-		Out(Styles::Default, Colours::LightBlue, args...);
+		Write(Level::Debug, Styles::Default, Colours::LightBlue, args...);
 #endif
 	}
 
@@ -91,7 +113,7 @@ public:
 	 */
 	template<typename ... Args>
 	static void Info(Args ... args) {
-		Out(Styles::Default, Colours::Green, args...);
+		Write(Level::Info, Styles::Default, Colours::Green, args...);
 	}
 
 	/**
@@ -101,7 +123,7 @@ public:
 	 */
 	template<typename ... Args>
 	static void Warning(Args ... args) {
-		Out(Styles::Default, Colours::Yellow, args...);
+		Write(Level::Warning, Styles::Default, Colours::Yellow, args...);
 	}
 
 	/**
@@ -111,7 +133,7 @@ public:
 	 */
 	template<typename ... Args>
 	static void Error(Args ... args) {
-		Out(Styles::Default, Colours::Red, args...);
+		Write(Level::Error, Styles::Default, Colours::Red, args...);
 	}
 
 	/**
@@ -123,7 +145,8 @@ public:
 	template<typename ... Args>
 	static void Assert(bool expr, Args ... args) {
 		if (expr) {
-			Out(Styles::Default, Colours::Magenta, args...);
+			Write(Level::Assert, Styles::Default, Colours::Magenta, args...);
+			Flush();
 			assert(false);
 		}
 	}
@@ -131,24 +154,110 @@ public:
 	static void OpenLog(const std::filesystem::path &filepath);
 	static void CloseLog();
 
+	/**
+	 * Opens a sink that writes each record as a line of JSON, with its time, level, thread and message.
+	 * @param filepath The file to write to.
+	 */
+	static void OpenJsonLog(const std::filesystem::path &filepath);
+	static void CloseJsonLog();
+
+	/**
+	 * Blocks until every record written before this call has reached the sinks.
+	 */
+	static void Flush();
+
+	/**
+	 * Gets the counters of written and dropped records.
+	 * @return The logger counters.
+	 */
+	static Stats GetStats();
+
+	/**
+	 * Sets the amount of records each thread may write per second, errors and asserts are never rate limited.
+	 * @param recordsPerSecond The records per second, zero disables rate limiting.
+	 */
+	static void SetRateLimit(uint32_t recordsPerSecond) { RateLimit = recordsPerSecond; }
+	static uint32_t GetRateLimit() { return RateLimit; }
+
 private:
-	// TODO: Only use mutex in synced writes (where output order must be the same).
-	static std::mutex WriteMutex;
-	static std::ofstream FileStream;
+	friend class LogWorker;
+
+	enum class Tag : uint8_t {
+		Int, UInt, Float, Char, String
+	};
+
+	static std::atomic<uint32_t> RateLimit;
+
+	/**
+	 * Starts a record in the calling threads scratch buffer.
+	 * @param level The record level.
+	 * @param style The console style.
+	 * @param colour The console colour.
+	 * @return The scratch buffer to encode arguments into.
+	 */
+	static std::vector<std::byte> &BeginRecord(Level level, std::string_view style, std::string_view colour);
+	/**
+	 * Pushes the record in the scratch buffer into the calling threads ring buffer.
+	 * @param record The scratch buffer.
+	 */
+	static void CommitRecord(std::vector<std::byte> &record);
+
+	static void EncodeBytes(std::vector<std::byte> &record, const void *data, std::size_t size) {
+		auto offset = record.size();
+		record.resize(offset + size);
+		std::memcpy(record.data() + offset, data, size);
+	}
+
+	template<typename T>
+	static void EncodeValue(std::vector<std::byte> &record, Tag tag, T value) {
+		EncodeBytes(record, &tag, sizeof(Tag));
+		EncodeBytes(record, &value, sizeof(T));
+	}
+
+	static void EncodeString(std::vector<std::byte> &record, std::string_view value) {
+		auto size = static_cast<uint32_t>(value.size());
+		EncodeValue(record, Tag::String, size);
+		EncodeBytes(record, value.data(), size);
+	}
+
+	/**
+	 * Encodes a argument without formatting it where possible, other types are formatted on the calling thread.
+	 * @tparam T The argument type.
+	 * @param record The record to encode into.
+	 * @param arg The argument.
+	 */
+	template<typename T>
+	static void Encode(std::vector<std::byte> &record, const T &arg) {
+		if constexpr (std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>) {
+			EncodeValue(record, Tag::Char, static_cast<char>(arg));
+		} else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+			EncodeValue(record, Tag::Int, static_cast<int64_t>(arg));
+		} else if constexpr (std::is_integral_v<T>) {
+			EncodeValue(record, Tag::UInt, static_cast<uint64_t>(arg));
+		} else if constexpr (std::is_floating_point_v<T>) {
+			EncodeValue(record, Tag::Float, static_cast<double>(arg));
+		} else if constexpr (std::is_convertible_v<const T &, std::string_view>) {
+			EncodeString(record, std::string_view(arg));
+		} else {
+			std::ostringstream stream;
+			stream << arg;
+			EncodeString(record, stream.str());
+		}
+	}
 
 	/**
 	 * A internal method used to write values to the out stream and to a file.
 	 * @tparam Args The value types to write.
+	 * @param level The record level.
+	 * @param style The console style.
+	 * @param colour The console colour.
 	 * @param args The values to write.
 	 */
 	template<typename ... Args>
-	static void Write(Args ... args) {
-		std::unique_lock<std::mutex> lock(WriteMutex);
-		
-		((std::cout << std::forward<Args>(args)), ...);
-		if (FileStream.is_open()) {
-			((FileStream << std::forward<Args>(args)), ...);
-		}
+	static void Write(Level level, std::string_view style, std::string_view colour, Args ... args) {
+		auto &record = BeginRecord(level, style, colour);
+		(Encode(record, args), ...);
+		CommitRecord(record);
 	}
 };
 
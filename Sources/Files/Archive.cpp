@@ -0,0 +1,329 @@
+#include "Archive.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <miniz.h>
+
+#ifdef ACID_BUILD_WINDOWS
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Engine/Log.hpp"
+
+namespace acid {
+static constexpr char ArchiveMagic[4] = {'A', 'P', 'A', 'K'};
+static constexpr uint32_t ArchiveVersion = 1;
+
+#pragma pack(push, 1)
+class ArchiveHeader {
+public:
+	char magic[4];
+	uint32_t version;
+	uint32_t alignment;
+	uint32_t entryCount;
+	uint64_t indexOffset;
+};
+
+class ArchiveIndexEntry {
+public:
+	uint64_t pathHash;
+	uint64_t offset;
+	uint64_t storedSize;
+	uint64_t size;
+	uint32_t compression;
+	uint32_t blockCount;
+};
+#pragma pack(pop)
+
+/**
+ * @brief A read only memory mapping of a whole file.
+ */
+class MappedFile : NonCopyable {
+public:
+	explicit MappedFile(const std::filesystem::path &filename) {
+#ifdef ACID_BUILD_WINDOWS
+		file = CreateFileW(filename.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			throw std::runtime_error("Failed to open archive " + filename.string());
+
+		LARGE_INTEGER fileSize;
+		GetFileSizeEx(file, &fileSize);
+		size = static_cast<std::size_t>(fileSize.QuadPart);
+
+		mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mapping) {
+			CloseHandle(file);
+			throw std::runtime_error("Failed to map archive " + filename.string());
+		}
+
+		data = static_cast<const std::byte *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+		auto descriptor = open(filename.c_str(), O_RDONLY);
+		if (descriptor == -1)
+			throw std::runtime_error("Failed to open archive " + filename.string());
+
+		struct stat status = {};
+		fstat(descriptor, &status);
+		size = static_cast<std::size_t>(status.st_size);
+
+		auto address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+		// The mapping stays valid after the descriptor is closed.
+		close(descriptor);
+		if (address != MAP_FAILED)
+			data = static_cast<const std::byte *>(address);
+#endif
+		if (!data)
+			throw std::runtime_error("Failed to map archive " + filename.string());
+	}
+
+	~MappedFile() {
+#ifdef ACID_BUILD_WINDOWS
+		UnmapViewOfFile(data);
+		CloseHandle(mapping);
+		CloseHandle(file);
+#else
+		munmap(const_cast<std::byte *>(data), size);
+#endif
+	}
+
+	const std::byte *data = nullptr;
+	std::size_t size = 0;
+
+private:
+#ifdef ACID_BUILD_WINDOWS
+	HANDLE file = INVALID_HANDLE_VALUE;
+	HANDLE mapping = nullptr;
+#endif
+};
+
+/**
+ * Checks that reading a entry stays within its stored bytes, and that its blocks inflate into exactly its size.
+ * @param indexEntry The index entry, already checked to lie within the archive.
+ * @param stored The stored bytes of the entry.
+ * @return If the entry can be read.
+ */
+static bool IsEntryValid(const ArchiveIndexEntry &indexEntry, const std::byte *stored) {
+	switch (static_cast<Archive::Compression>(indexEntry.compression)) {
+	case Archive::Compression::None:
+		return indexEntry.size <= indexEntry.storedSize;
+	case Archive::Compression::Deflate: {
+		if (indexEntry.blockCount != (indexEntry.size + Archive::BlockSize - 1) / Archive::BlockSize)
+			return false;
+
+		auto tableSize = static_cast<uint64_t>(indexEntry.blockCount) * sizeof(uint32_t);
+		if (tableSize > indexEntry.storedSize)
+			return false;
+
+		auto blocksSize = tableSize;
+		for (uint32_t i = 0; i < indexEntry.blockCount; i++) {
+			uint32_t blockSize;
+			std::memcpy(&blockSize, stored + i * sizeof(uint32_t), sizeof(uint32_t));
+			blocksSize += blockSize;
+		}
+		return blocksSize <= indexEntry.storedSize;
+	}
+	default:
+		return false;
+	}
+}
+
+std::vector<std::byte> BufferPool::Acquire(std::size_t size) {
+	std::vector<std::byte> buffer;
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		if (!buffers.empty()) {
+			buffer = std::move(buffers.back());
+			buffers.pop_back();
+		}
+	}
+
+	buffer.resize(size);
+	return buffer;
+}
+
+void BufferPool::Release(std::vector<std::byte> &&buffer) {
+	std::unique_lock<std::mutex> lock(mutex);
+	buffers.emplace_back(std::move(buffer));
+}
+
+FileView::FileView(Span<const std::byte> bytes, std::shared_ptr<const void> owner) :
+	bytes(bytes),
+	owner(std::move(owner)) {
+}
+
+FileView::FileView(std::vector<std::byte> &&buffer, std::shared_ptr<BufferPool> pool) :
+	bytes(buffer),
+	buffer(std::move(buffer)),
+	pool(std::move(pool)) {
+}
+
+FileView::~FileView() {
+	if (pool)
+		pool->Release(std::move(buffer));
+}
+
+Archive::Archive(std::filesystem::path filename) :
+	filename(std::move(filename)),
+	mapped(std::make_shared<MappedFile>(this->filename)),
+	pool(std::make_shared<BufferPool>()) {
+	ArchiveHeader header;
+	if (mapped->size < sizeof(ArchiveHeader))
+		throw std::runtime_error("Archive is too small " + this->filename.string());
+	std::memcpy(&header, mapped->data, sizeof(ArchiveHeader));
+
+	if (std::memcmp(header.magic, ArchiveMagic, sizeof(ArchiveMagic)) != 0 || header.version != ArchiveVersion)
+		throw std::runtime_error("Archive has a unsupported format " + this->filename.string());
+	if (header.indexOffset > mapped->size || header.entryCount * sizeof(ArchiveIndexEntry) > mapped->size - header.indexOffset)
+		throw std::runtime_error("Archive index is truncated " + this->filename.string());
+
+	entries.reserve(header.entryCount);
+	for (uint32_t i = 0; i < header.entryCount; i++) {
+		ArchiveIndexEntry indexEntry;
+		std::memcpy(&indexEntry, mapped->data + header.indexOffset + i * sizeof(ArchiveIndexEntry), sizeof(ArchiveIndexEntry));
+		if (indexEntry.offset > mapped->size || indexEntry.storedSize > mapped->size - indexEntry.offset)
+			throw std::runtime_error("Archive entry is truncated " + this->filename.string());
+		if (!IsEntryValid(indexEntry, mapped->data + indexEntry.offset))
+			throw std::runtime_error("Archive entry is corrupt " + this->filename.string());
+
+		entries[indexEntry.pathHash] = {indexEntry.offset, indexEntry.storedSize, indexEntry.size, static_cast<Compression>(indexEntry.compression), indexEntry.blockCount};
+	}
+}
+
+bool Archive::Contains(const std::filesystem::path &path) const {
+	return entries.find(HashPath(path)) != entries.end();
+}
+
+std::optional<FileView> Archive::Read(const std::filesystem::path &path) const {
+	auto it = entries.find(HashPath(path));
+	if (it == entries.end())
+		return std::nullopt;
+
+	const auto &entry = it->second;
+	auto stored = mapped->data + entry.offset;
+
+	if (entry.compression == Compression::None)
+		return FileView(Span<const std::byte>(stored, entry.size), mapped);
+
+	// Compressed entries begin with a table of block sizes, each block inflates to BlockSize bytes except the last.
+	auto buffer = pool->Acquire(entry.size);
+	auto block = stored + entry.blockCount * sizeof(uint32_t);
+	for (uint32_t i = 0; i < entry.blockCount; i++) {
+		uint32_t blockSize;
+		std::memcpy(&blockSize, stored + i * sizeof(uint32_t), sizeof(uint32_t));
+
+		auto offset = static_cast<std::size_t>(i) * BlockSize;
+		auto expected = static_cast<mz_ulong>(std::min<uint64_t>(BlockSize, entry.size - offset));
+		auto length = expected;
+		auto status = mz_uncompress(reinterpret_cast<unsigned char *>(buffer.data() + offset), &length, reinterpret_cast<const unsigned char *>(block), blockSize);
+		if (status != MZ_OK || length != expected) {
+			Log::Error("Failed to inflate ", path, " from archive ", filename, '\n');
+			pool->Release(std::move(buffer));
+			return std::nullopt;
+		}
+
+		block += blockSize;
+	}
+
+	return FileView(std::move(buffer), pool);
+}
+
+void Archive::Write(const std::filesystem::path &filename, const std::vector<std::pair<std::string, std::filesystem::path>> &files, bool compress) {
+	std::ofstream stream(filename, std::ios::binary | std::ios::trunc);
+	if (!stream)
+		throw std::runtime_error("Failed to create archive " + filename.string());
+
+	ArchiveHeader header = {};
+	std::memcpy(header.magic, ArchiveMagic, sizeof(ArchiveMagic));
+	header.version = ArchiveVersion;
+	header.alignment = Alignment;
+	header.entryCount = static_cast<uint32_t>(files.size());
+	stream.write(reinterpret_cast<const char *>(&header), sizeof(ArchiveHeader));
+
+	auto pad = [&stream](uint64_t alignment) {
+		auto position = static_cast<uint64_t>(stream.tellp());
+		auto padding = (alignment - position % alignment) % alignment;
+		for (uint64_t i = 0; i < padding; i++)
+			stream.put(0);
+		return position + padding;
+	};
+
+	std::vector<ArchiveIndexEntry> index;
+	index.reserve(files.size());
+
+	for (const auto &[path, source] : files) {
+		std::ifstream input(source, std::ios::binary);
+		if (!input)
+			throw std::runtime_error("Failed to read " + source.string());
+		std::vector<unsigned char> data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+		ArchiveIndexEntry indexEntry = {};
+		indexEntry.pathHash = HashPath(path);
+		indexEntry.size = data.size();
+		for (const auto &other : index) {
+			if (other.pathHash == indexEntry.pathHash)
+				throw std::runtime_error("Archive path hash collision on " + path);
+		}
+
+		std::vector<unsigned char> packed;
+		if (compress && !data.empty()) {
+			auto blockCount = static_cast<uint32_t>((data.size() + BlockSize - 1) / BlockSize);
+			packed.resize(blockCount * sizeof(uint32_t));
+
+			for (uint32_t i = 0; i < blockCount; i++) {
+				auto offset = static_cast<std::size_t>(i) * BlockSize;
+				auto length = static_cast<mz_ulong>(std::min<std::size_t>(BlockSize, data.size() - offset));
+				auto blockSize = mz_compressBound(length);
+				auto blockOffset = packed.size();
+				packed.resize(blockOffset + blockSize);
+				if (mz_compress2(packed.data() + blockOffset, &blockSize, data.data() + offset, length, MZ_BEST_COMPRESSION) != MZ_OK)
+					throw std::runtime_error("Failed to compress " + source.string());
+				packed.resize(blockOffset + blockSize);
+
+				auto storedBlockSize = static_cast<uint32_t>(blockSize);
+				std::memcpy(packed.data() + i * sizeof(uint32_t), &storedBlockSize, sizeof(uint32_t));
+			}
+
+			indexEntry.blockCount = blockCount;
+		}
+
+		// Entries that do not shrink by at least an eighth are stored, since those can be viewed without copying.
+		if (packed.empty() || packed.size() > data.size() - data.size() / 8) {
+			packed = std::move(data);
+			indexEntry.compression = static_cast<uint32_t>(Compression::None);
+			indexEntry.blockCount = 0;
+		} else {
+			indexEntry.compression = static_cast<uint32_t>(Compression::Deflate);
+		}
+
+		indexEntry.offset = pad(Alignment);
+		indexEntry.storedSize = packed.size();
+		stream.write(reinterpret_cast<const char *>(packed.data()), static_cast<std::streamsize>(packed.size()));
+		index.emplace_back(indexEntry);
+	}
+
+	header.indexOffset = pad(sizeof(uint64_t));
+	stream.write(reinterpret_cast<const char *>(index.data()), static_cast<std::streamsize>(index.size() * sizeof(ArchiveIndexEntry)));
+	stream.seekp(0);
+	stream.write(reinterpret_cast<const char *>(&header), sizeof(ArchiveHeader));
+
+	if (!stream)
+		throw std::runtime_error("Failed to write archive " + filename.string());
+}
+
+uint64_t Archive::HashPath(const std::filesystem::path &path) {
+	auto pathStr = path.generic_string();
+	std::replace(pathStr.begin(), pathStr.end(), '\\', '/');
+
+	uint64_t hash = 14695981039346656037ull;
+	for (auto c : pathStr) {
+		hash ^= static_cast<uint8_t>(c);
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+}
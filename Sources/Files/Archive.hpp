@@ -0,0 +1,131 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+
+#include "Utils/NonCopyable.hpp"
+#include "Utils/Span.hpp"
+
+namespace acid {
+class MappedFile;
+
+/**
+ * @brief A pool of byte buffers reused between decompressed reads.
+ */
+class ACID_EXPORT BufferPool : NonCopyable {
+public:
+	std::vector<std::byte> Acquire(std::size_t size);
+	void Release(std::vector<std::byte> &&buffer);
+
+private:
+	std::vector<std::vector<std::byte>> buffers;
+	std::mutex mutex;
+};
+
+/**
+ * @brief The bytes of a read file, either viewing mapped archive memory directly or owning a decoded buffer.
+ */
+class ACID_EXPORT FileView : NonCopyable {
+public:
+	FileView() = default;
+	/**
+	 * Creates a view into memory kept alive by a owner.
+	 * @param bytes The viewed bytes.
+	 * @param owner The object holding the bytes.
+	 */
+	FileView(Span<const std::byte> bytes, std::shared_ptr<const void> owner);
+	/**
+	 * Creates a view that owns its bytes, the buffer will be returned to the pool when destroyed.
+	 * @param buffer The buffer holding the bytes.
+	 * @param pool The pool the buffer was acquired from.
+	 */
+	FileView(std::vector<std::byte> &&buffer, std::shared_ptr<BufferPool> pool = nullptr);
+	FileView(FileView &&other) noexcept = default;
+	~FileView();
+
+	FileView &operator=(FileView &&other) noexcept = default;
+
+	const Span<const std::byte> &GetBytes() const { return bytes; }
+	std::string_view GetString() const { return {reinterpret_cast<const char *>(bytes.data()), bytes.size()}; }
+	std::size_t GetSize() const { return bytes.size(); }
+
+private:
+	Span<const std::byte> bytes;
+	std::shared_ptr<const void> owner;
+	std::vector<std::byte> buffer;
+	std::shared_ptr<BufferPool> pool;
+};
+
+/**
+ * @brief A packed asset archive that is memory mapped for reading. Entries are indexed by the hash of their path,
+ * stored entries are returned without copying while compressed entries are inflated block by block into pooled buffers.
+ */
+class ACID_EXPORT Archive : NonCopyable {
+public:
+	enum class Compression : uint32_t {
+		None, Deflate
+	};
+
+	/// Entries start on this boundary, so that stored entries can be mapped and viewed in place.
+	static constexpr uint32_t Alignment = 64 * 1024;
+	/// The uncompressed size of each compressed block.
+	static constexpr uint32_t BlockSize = 64 * 1024;
+
+	/**
+	 * Opens and maps a archive.
+	 * @param filename The real path to the archive.
+	 */
+	explicit Archive(std::filesystem::path filename);
+
+	/**
+	 * Gets if the archive holds a entry.
+	 * @param path The path of the entry.
+	 * @return If the entry was found.
+	 */
+	bool Contains(const std::filesystem::path &path) const;
+
+	/**
+	 * Reads a entry from the archive.
+	 * @param path The path of the entry.
+	 * @return The entries bytes, or nullopt if the entry is not in this archive.
+	 */
+	std::optional<FileView> Read(const std::filesystem::path &path) const;
+
+	/**
+	 * Packs files into a new archive.
+	 * @param filename The real path to write the archive to.
+	 * @param files Pairs of entry paths and the real paths the entries are read from.
+	 * @param compress If entries are compressed, entries that do not shrink are always stored.
+	 */
+	static void Write(const std::filesystem::path &filename, const std::vector<std::pair<std::string, std::filesystem::path>> &files, bool compress = true);
+
+	/**
+	 * Hashes a entry path, separators are normalized so the same file hashes identically on all platforms.
+	 * @param path The path to hash.
+	 * @return The 64-bit FNV-1a hash of the path.
+	 */
+	static uint64_t HashPath(const std::filesystem::path &path);
+
+	const std::filesystem::path &GetFilename() const { return filename; }
+	std::size_t GetEntryCount() const { return entries.size(); }
+
+private:
+	class Entry {
+	public:
+		uint64_t offset;
+		uint64_t storedSize;
+		uint64_t size;
+		Compression compression;
+		uint32_t blockCount;
+	};
+
+	std::filesystem::path filename;
+	std::shared_ptr<MappedFile> mapped;
+	std::unordered_map<uint64_t, Entry> entries;
+	std::shared_ptr<BufferPool> pool;
+};
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "Export.hpp"
+#include "Utils/Span.hpp"
+
+namespace acid {
+/**
+ * @brief Appends trivially copyable values to a byte buffer, used to write cooked binary assets.
+ */
+class ACID_EXPORT BinaryWriter {
+public:
+	template<typename T>
+	void Write(const T &value) {
+		static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be written");
+		WriteBytes(&value, sizeof(T));
+	}
+
+	template<typename T>
+	void Write(Span<const T> values) {
+		static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be written");
+		Write(static_cast<uint64_t>(values.size()));
+		WriteBytes(values.data(), values.size_bytes());
+	}
+
+	void Write(const std::string &value) {
+		Write(static_cast<uint64_t>(value.size()));
+		WriteBytes(value.data(), value.size());
+	}
+
+	void WriteBytes(const void *data, std::size_t size) {
+		auto offset = buffer.size();
+		buffer.resize(offset + size);
+		if (size != 0)
+			std::memcpy(buffer.data() + offset, data, size);
+	}
+
+	/**
+	 * Writes the buffer to a file on disk, parent directories are created if needed.
+	 * @param filename The real path to write to.
+	 */
+	void Save(const std::filesystem::path &filename) const {
+		if (auto parentPath = filename.parent_path(); !parentPath.empty())
+			std::filesystem::create_directories(parentPath);
+
+		std::ofstream stream(filename, std::ios::binary | std::ios::trunc);
+		stream.write(reinterpret_cast<const char *>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+		if (!stream)
+			throw std::runtime_error("Failed to write " + filename.string());
+	}
+
+	const std::vector<std::byte> &GetBuffer() const { return buffer; }
+
+private:
+	std::vector<std::byte> buffer;
+};
+
+/**
+ * @brief Reads values written by a {@link BinaryWriter} back from a byte span, throws if the data is truncated.
+ */
+class ACID_EXPORT BinaryReader {
+public:
+	explicit BinaryReader(Span<const std::byte> bytes) :
+		bytes(bytes) {
+	}
+
+	template<typename T>
+	T Read() {
+		static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be read");
+		T value;
+		ReadBytes(&value, sizeof(T));
+		return value;
+	}
+
+	template<typename T>
+	void Read(std::vector<T> &values) {
+		static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be read");
+		auto count = Read<uint64_t>();
+		if (count > GetRemaining() / std::max<std::size_t>(sizeof(T), 1))
+			throw std::runtime_error("Binary data is truncated");
+		values.resize(static_cast<std::size_t>(count));
+		ReadBytes(values.data(), values.size() * sizeof(T));
+	}
+
+	std::string ReadString() {
+		auto size = Read<uint64_t>();
+		if (size > GetRemaining())
+			throw std::runtime_error("Binary data is truncated");
+		std::string value(reinterpret_cast<const char *>(bytes.data() + position), static_cast<std::size_t>(size));
+		position += static_cast<std::size_t>(size);
+		return value;
+	}
+
+	void ReadBytes(void *data, std::size_t size) {
+		if (size > GetRemaining())
+			throw std::runtime_error("Binary data is truncated");
+		if (size != 0)
+			std::memcpy(data, bytes.data() + position, size);
+		position += size;
+	}
+
+	std::size_t GetPosition() const { return position; }
+	std::size_t GetRemaining() const { return bytes.size() - position; }
+
+private:
+	Span<const std::byte> bytes;
+	std::size_t position = 0;
+};
+}
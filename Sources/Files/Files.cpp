@@ -210,7 +210,45 @@ void Files::ClearSearchPath() {
 	searchPaths.clear();
 }
 
+void Files::MountArchive(const std::filesystem::path &filename) {
+	std::unique_lock<std::shared_mutex> lock(archiveMutex);
+	for (const auto &archive : archives) {
+		if (archive->GetFilename() == filename)
+			return;
+	}
+
+	try {
+		archives.emplace(archives.begin(), std::make_unique<Archive>(filename));
+	} catch (const std::exception &e) {
+		Log::Warning("Failed to mount archive ", filename, ", ", e.what(), '\n');
+	}
+}
+
+void Files::UnmountArchive(const std::filesystem::path &filename) {
+	std::unique_lock<std::shared_mutex> lock(archiveMutex);
+	archives.erase(std::remove_if(archives.begin(), archives.end(), [&filename](const auto &archive) {
+		return archive->GetFilename() == filename;
+	}), archives.end());
+}
+
+std::optional<FileView> Files::ReadArchive(const std::filesystem::path &path) const {
+	std::shared_lock<std::shared_mutex> lock(archiveMutex);
+	for (const auto &archive : archives) {
+		if (auto view = archive->Read(path))
+			return view;
+	}
+	return std::nullopt;
+}
+
+bool Files::ExistsInArchive(const std::filesystem::path &path) const {
+	std::shared_lock<std::shared_mutex> lock(archiveMutex);
+	return std::any_of(archives.begin(), archives.end(), [&path](const auto &archive) {
+		return archive->Contains(path);
+	});
+}
+
 bool Files::ExistsInPath(const std::filesystem::path &path) {
+	if (auto files = Get(); files && files->ExistsInArchive(path)) return true;
 	if (PHYSFS_isInit() == 0) return false;
 
 	auto pathStr = path.string();
@@ -219,6 +257,11 @@ bool Files::ExistsInPath(const std::filesystem::path &path) {
 }
 
 std::optional<std::string> Files::Read(const std::filesystem::path &path) {
+	if (auto files = Get()) {
+		if (auto view = files->ReadArchive(path))
+			return std::string(view->GetString());
+	}
+
 	auto pathStr = path.string();
 	std::replace(pathStr.begin(), pathStr.end(), '\\', '/');
 	auto fsFile = PHYSFS_openRead(pathStr.c_str());
@@ -245,6 +288,30 @@ std::optional<std::string> Files::Read(const std::filesystem::path &path) {
 	return std::string(data.begin(), data.end());
 }
 
+std::optional<FileView> Files::ReadView(const std::filesystem::path &path) {
+	if (auto files = Get()) {
+		if (auto view = files->ReadArchive(path))
+			return view;
+	}
+
+	auto pathStr = path.string();
+	std::replace(pathStr.begin(), pathStr.end(), '\\', '/');
+	auto fsFile = PHYSFS_openRead(pathStr.c_str());
+
+	if (!fsFile) {
+		Log::Error("Failed to open file ", path, ", ", PHYSFS_getErrorByCode(PHYSFS_getLastErrorCode()), '\n');
+		return std::nullopt;
+	}
+
+	std::vector<std::byte> data(static_cast<std::size_t>(PHYSFS_fileLength(fsFile)));
+	PHYSFS_readBytes(fsFile, data.data(), static_cast<PHYSFS_uint64>(data.size()));
+
+	if (PHYSFS_close(fsFile) == 0)
+		Log::Error("Failed to close file ", path, ", ", PHYSFS_getErrorByCode(PHYSFS_getLastErrorCode()), '\n');
+
+	return FileView(std::move(data));
+}
+
 std::vector<unsigned char> Files::ReadBytes(const std::filesystem::path &path) {
 	IFStream file(path);
 	file >> std::noskipws;
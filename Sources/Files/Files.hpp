@@ -1,6 +1,9 @@
 #pragma once
 
+#include <shared_mutex>
+
 #include "Engine/Engine.hpp"
+#include "Archive.hpp"
 
 struct PHYSFS_File;
 
@@ -65,6 +68,18 @@ public:
 	 */
 	void ClearSearchPath();
 
+	/**
+	 * Mounts a packed archive, archive entries are searched before the search paths.
+	 * @param filename The real path to the archive.
+	 */
+	void MountArchive(const std::filesystem::path &filename);
+
+	/**
+	 * Unmounts a packed archive, views already read from the archive remain valid.
+	 * @param filename The real path to the archive.
+	 */
+	void UnmountArchive(const std::filesystem::path &filename);
+
 	/**
 	 * Gets if the path is found in one of the search paths.
 	 * @param path The path to look for.
@@ -79,6 +94,14 @@ public:
 	 */
 	static std::optional<std::string> Read(const std::filesystem::path &path);
 
+	/**
+	 * Reads a file found by real or partial path without copying when possible.
+	 * Stored archive entries are viewed in mapped memory, other files are read into a owned buffer.
+	 * @param path The path to read.
+	 * @return The bytes read from the file.
+	 */
+	static std::optional<FileView> ReadView(const std::filesystem::path &path);
+
 	/**
 	 * Reads all bytes from file found by real or partial path.
 	 * @param path The path to read.
@@ -103,6 +126,12 @@ public:
 	static std::istream &SafeGetLine(std::istream &is, std::string &t);
 
 private:
+	std::optional<FileView> ReadArchive(const std::filesystem::path &path) const;
+	bool ExistsInArchive(const std::filesystem::path &path) const;
+
 	std::vector<std::string> searchPaths;
+	// Newest mounted archives are searched first.
+	std::vector<std::unique_ptr<Archive>> archives;
+	mutable std::shared_mutex archiveMutex;
 };
 }
@@ -5,8 +5,8 @@
 #include "Graphics/Graphics.hpp"
 
 namespace acid {
-StorageBuffer::StorageBuffer(VkDeviceSize size, const void *data) :
-	Buffer(size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, data) {
+StorageBuffer::StorageBuffer(VkDeviceSize size, const void *data, VkBufferUsageFlags usage) :
+	Buffer(size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | usage, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, data) {
 }
 
 void StorageBuffer::Update(const void *newData) {
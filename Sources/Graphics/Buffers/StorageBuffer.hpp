@@ -6,7 +6,13 @@
 namespace acid {
 class ACID_EXPORT StorageBuffer : public Descriptor, public Buffer {
 public:
-	explicit StorageBuffer(VkDeviceSize size, const void *data = nullptr);
+	/**
+	 * Creates a new storage buffer.
+	 * @param size Size of the buffer in bytes.
+	 * @param data Pointer to the data copied into the buffer (optional).
+	 * @param usage Usage flags added to the storage usage, so the buffer can also be read as vertices or indirect draw arguments.
+	 */
+	explicit StorageBuffer(VkDeviceSize size, const void *data = nullptr, VkBufferUsageFlags usage = 0);
 
 	void Update(const void *newData);
 
@@ -97,6 +97,9 @@ void Graphics::Update() {
 		}
 	}
 
+	// Only counted once every swapchain has submitted, so a frame number is never ahead of the frames on the device.
+	frameNumber++;
+
 	// Purges unused command pools.
 	if (elapsedPurge.GetElapsed() != 0) {
 		for (auto it = commandPools.begin(); it != commandPools.end();) {
@@ -110,6 +113,17 @@ void Graphics::Update() {
 	}
 }
 
+bool Graphics::IsFrameComplete(uint64_t frameNumber) const {
+	if (swapchains.empty())
+		return true;
+
+	// Acquiring a image waits on the fence of the frame that last used its slot, so only the last image count frames can still be running.
+	uint64_t framesInFlight = 0;
+	for (const auto &swapchain : swapchains)
+		framesInFlight = std::max<uint64_t>(framesInFlight, swapchain->GetImageCount());
+	return frameNumber + framesInFlight < this->frameNumber;
+}
+
 std::string Graphics::StringifyResultVk(VkResult result) {
 	switch (result) {
 	case VK_SUCCESS:
@@ -57,6 +57,19 @@ public:
 	const Swapchain *GetSwapchain(std::size_t id) const { return swapchains[id].get(); }
 	void SetFramebufferResized(std::size_t id) { perSurfaceBuffers[id]->framebufferResized = true; }
 
+	/**
+	 * Gets the number the next frame submitted to every swapchain will have, used to know when a frame stops reading resources.
+	 * @return The frame number.
+	 */
+	uint64_t GetFrameNumber() const { return frameNumber; }
+
+	/**
+	 * Checks if a frame has finished on the device, so resources it read can be changed or destroyed.
+	 * @param frameNumber The number of the frame, from {@link Graphics#GetFrameNumber}.
+	 * @return If the frame has finished, or will never be submitted because there are no swapchains.
+	 */
+	bool IsFrameComplete(uint64_t frameNumber) const;
+
 private:
 	void CreatePipelineCache();
 	void ResetRenderStages();
@@ -70,6 +83,7 @@ private:
 	std::unique_ptr<Renderer> renderer;
 	std::map<std::string, const Descriptor *> attachments;
 	std::vector<std::unique_ptr<Swapchain>> swapchains;
+	uint64_t frameNumber = 0;
 
 	std::map<std::thread::id, std::shared_ptr<CommandPool>> commandPools;
 	/// Timer used to remove unused command pools.
@@ -93,6 +93,11 @@ uint32_t Image::GetMipLevels(const VkExtent3D &extent) {
 	return static_cast<uint32_t>(std::floor(std::log2(std::max(extent.width, std::max(extent.height, extent.depth)))) + 1);
 }
 
+std::size_t Image::GetTexelMemory(uint32_t components) const {
+	auto size = static_cast<std::size_t>(extent.width) * extent.height * extent.depth * components * arrayLayers;
+	return mipLevels > 1 ? size * 4 / 3 : size;
+}
+
 VkFormat Image::FindSupportedFormat(const std::vector<VkFormat> &candidates, VkImageTiling tiling, VkFormatFeatureFlags features) {
 	auto physicalDevice = Graphics::Get()->GetPhysicalDevice();
 	
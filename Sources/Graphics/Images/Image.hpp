@@ -59,6 +59,13 @@ public:
 
 	static uint32_t GetMipLevels(const VkExtent3D &extent);
 
+	/**
+	 * Approximates the device memory held by the images texels, a full mip chain adds a third to the base level.
+	 * @param components The number of bytes per texel.
+	 * @return The size in bytes.
+	 */
+	std::size_t GetTexelMemory(uint32_t components) const;
+
 	/**
 	 * Find a format in the candidates list that fits the tiling and features required.
 	 * @param candidates Formats that are tested for features, in order of preference.
@@ -92,10 +92,41 @@ Node &operator<<(Node &node, const Image2d &image) {
 	return node;
 }
 
+void Image2d::Decode() {
+	if (filename.empty())
+		return;
+
+	// A mipmap chain cooked by AcidCooker is used in place of the source.
+	if (auto cookedFilename = MipmapChain::GetCookedFilename(filename); Files::ExistsInPath(cookedFilename))
+		decodedMipmaps = std::make_unique<MipmapChain>(MipmapChain::Read(cookedFilename));
+	else
+		decodedBitmap = std::make_unique<Bitmap>(filename);
+}
+
+void Image2d::Upload() {
+	if (decodedMipmaps) {
+		LoadMipmaps(*decodedMipmaps);
+		decodedMipmaps = nullptr;
+		return;
+	}
+
+	if (!decodedBitmap)
+		return;
+
+	extent = {decodedBitmap->GetSize().x, decodedBitmap->GetSize().y, 1};
+	components = decodedBitmap->GetBytesPerPixel();
+	Load(std::move(decodedBitmap));
+}
+
 void Image2d::Load(std::unique_ptr<Bitmap> loadBitmap) {
 	if (!filename.empty() && !loadBitmap) {
+		if (auto cookedFilename = MipmapChain::GetCookedFilename(filename); Files::ExistsInPath(cookedFilename)) {
+			LoadMipmaps(MipmapChain::Read(cookedFilename));
+			return;
+		}
+
 		loadBitmap = std::make_unique<Bitmap>(filename);
-		extent = {loadBitmap->GetSize().y, loadBitmap->GetSize().y, 1};
+		extent = {loadBitmap->GetSize().x, loadBitmap->GetSize().y, 1};
 		components = loadBitmap->GetBytesPerPixel();
 	}
 		
@@ -133,4 +164,53 @@ void Image2d::Load(std::unique_ptr<Bitmap> loadBitmap) {
 		TransitionImageLayout(image, format, VK_IMAGE_LAYOUT_UNDEFINED, layout, VK_IMAGE_ASPECT_COLOR_BIT, mipLevels, 0, arrayLayers, 0);
 	}
 }
+
+void Image2d::LoadMipmaps(const MipmapChain &mipmapChain) {
+	extent = {mipmapChain.GetSize().x, mipmapChain.GetSize().y, 1};
+	components = mipmapChain.GetBytesPerPixel();
+
+	if (extent.width == 0 || extent.height == 0)
+		return;
+
+	mipLevels = mipmap ? mipmapChain.GetLevelCount() : 1;
+
+	CreateImage(image, memory, extent, format, samples, VK_IMAGE_TILING_OPTIMAL, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+		mipLevels, arrayLayers, VK_IMAGE_TYPE_2D);
+	CreateImageSampler(sampler, filter, addressMode, anisotropic, mipLevels);
+	CreateImageView(image, view, VK_IMAGE_VIEW_TYPE_2D, format, VK_IMAGE_ASPECT_COLOR_BIT, mipLevels, 0, arrayLayers, 0);
+	TransitionImageLayout(image, format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_ASPECT_COLOR_BIT, mipLevels, 0, arrayLayers, 0);
+
+	// Every level is copied from one staging buffer in a single submit, instead of blitting the levels on the GPU.
+	auto stagingSize = mipLevels < mipmapChain.GetLevelCount() ? mipmapChain.GetLevelOffset(mipLevels) : mipmapChain.GetData().size();
+	Buffer bufferStaging(stagingSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+	uint8_t *data;
+	bufferStaging.MapMemory(reinterpret_cast<void **>(&data));
+	std::memcpy(data, mipmapChain.GetData().data(), bufferStaging.GetSize());
+	bufferStaging.UnmapMemory();
+
+	std::vector<VkBufferImageCopy> bufferCopyRegions;
+	bufferCopyRegions.reserve(mipLevels);
+	for (uint32_t level = 0; level < mipLevels; level++) {
+		auto levelSize = mipmapChain.GetLevelSize(level);
+		VkBufferImageCopy region = {};
+		region.bufferOffset = mipmapChain.GetLevelOffset(level);
+		region.bufferRowLength = 0;
+		region.bufferImageHeight = 0;
+		region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		region.imageSubresource.mipLevel = level;
+		region.imageSubresource.baseArrayLayer = 0;
+		region.imageSubresource.layerCount = arrayLayers;
+		region.imageOffset = {0, 0, 0};
+		region.imageExtent = {levelSize.x, levelSize.y, 1};
+		bufferCopyRegions.emplace_back(region);
+	}
+	CommandBuffer commandBuffer;
+	vkCmdCopyBufferToImage(commandBuffer, bufferStaging.GetBuffer(), image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, static_cast<uint32_t>(bufferCopyRegions.size()),
+		bufferCopyRegions.data());
+	commandBuffer.SubmitIdle();
+
+	TransitionImageLayout(image, format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, layout, VK_IMAGE_ASPECT_COLOR_BIT, mipLevels, 0, arrayLayers, 0);
+}
 }
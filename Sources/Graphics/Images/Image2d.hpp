@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Bitmaps/Bitmap.hpp"
+#include "Bitmaps/MipmapChain.hpp"
 #include "Resources/Resource.hpp"
 #include "Image.hpp"
 
@@ -84,6 +85,7 @@ public:
 	void SetPixels(const uint8_t *pixels, uint32_t layerCount, uint32_t baseArrayLayer);
 
 	std::type_index GetTypeIndex() const override { return typeid(Image2d); }
+	std::size_t GetGpuMemoryUsage() const override { return GetTexelMemory(components); }
 
 	const std::filesystem::path &GetFilename() const { return filename; }
 	bool IsAnisotropic() const { return anisotropic; }
@@ -93,13 +95,20 @@ public:
 	friend const Node &operator>>(const Node &node, Image2d &image);
 	friend Node &operator<<(Node &node, const Image2d &image);
 
+protected:
+	void Decode() override;
+	void Upload() override;
+
 private:
 	void Load(std::unique_ptr<Bitmap> loadBitmap = nullptr);
+	void LoadMipmaps(const MipmapChain &mipmapChain);
 
 	std::filesystem::path filename;
 
 	bool anisotropic;
 	bool mipmap;
 	uint32_t components = 0;
+	std::unique_ptr<Bitmap> decodedBitmap;
+	std::unique_ptr<MipmapChain> decodedMipmaps;
 };
 }
@@ -94,6 +94,7 @@ public:
 	void SetPixels(const uint8_t *pixels, uint32_t layerCount, uint32_t baseArrayLayer);
 
 	std::type_index GetTypeIndex() const override { return typeid(ImageCube); }
+	std::size_t GetGpuMemoryUsage() const override { return GetTexelMemory(components); }
 
 	const std::filesystem::path &GetFilename() const { return filename; }
 	const std::string &GetFileSuffix() const { return fileSuffix; }
@@ -6,6 +6,7 @@
 #include <glslang/Public/ShaderLang.h>
 
 #include "Graphics/Graphics.hpp"
+#include "Files/BinaryStream.hpp"
 #include "Files/Files.hpp"
 #include "Utils/String.hpp"
 #include "Graphics/Buffers/StorageBuffer.hpp"
@@ -288,15 +289,19 @@ TBuiltInResource GetResources() {
 	return resources;
 }
 
-VkShaderModule Shader::CreateShaderModule(const std::filesystem::path &moduleName, const std::string &moduleCode, const std::string &preamble, VkShaderStageFlags moduleFlag) {
-	auto logicalDevice = Graphics::Get()->GetLogicalDevice();
-
-	stages.emplace_back(moduleName);
-
-	// Starts converting GLSL to SPIR-V.
-	auto language = GetEshLanguage(moduleFlag);
-	glslang::TProgram program;
-	glslang::TShader shader(language);
+/**
+ * Preprocesses, parses and links a shader stage.
+ * @param shader The shader to parse into.
+ * @param program The program to link into.
+ * @param language The shader stage language.
+ * @param moduleName The shader stage filename.
+ * @param moduleCode The GLSL source code.
+ * @param preamble The defines added to the start of the source.
+ * @param preprocessed The source after includes and defines have been expanded.
+ * @return If the stage was linked.
+ */
+static bool ParseProgram(glslang::TShader &shader, glslang::TProgram &program, EShLanguage language, const std::filesystem::path &moduleName, const std::string &moduleCode,
+	const std::string &preamble, std::string &preprocessed) {
 	auto resources = GetResources();
 
 	// Enable SPIR-V and Vulkan rules when parsing GLSL.
@@ -318,26 +323,101 @@ VkShaderModule Shader::CreateShaderModule(const std::filesystem::path &moduleNam
 
 	ShaderIncluder includer;
 
-	std::string str;
-
-	if (!shader.preprocess(&resources, defaultVersion, ENoProfile, false, false, messages, &str, includer)) {
+	if (!shader.preprocess(&resources, defaultVersion, ENoProfile, false, false, messages, &preprocessed, includer)) {
 		Log::Out(shader.getInfoLog(), '\n');
 		Log::Out(shader.getInfoDebugLog(), '\n');
 		Log::Error("SPRIV shader preprocess failed!\n");
+		return false;
 	}
 
 	if (!shader.parse(&resources, defaultVersion, true, messages, includer)) {
 		Log::Out(shader.getInfoLog(), '\n');
 		Log::Out(shader.getInfoDebugLog(), '\n');
 		Log::Error("SPRIV shader parse failed!\n");
+		return false;
 	}
 
 	program.addShader(&shader);
 
 	if (!program.link(messages) || !program.mapIO()) {
 		Log::Error("Error while linking shader program.\n");
+		return false;
 	}
 
+	return true;
+}
+
+static std::vector<uint32_t> GenerateSpirv(const glslang::TProgram &program, EShLanguage language) {
+	glslang::SpvOptions spvOptions;
+#ifdef ACID_DEBUG
+	spvOptions.generateDebugInfo = true;
+	spvOptions.disableOptimizer = true;
+	spvOptions.optimizeSize = false;
+#else
+	spvOptions.generateDebugInfo = false;
+	spvOptions.disableOptimizer = false;
+	spvOptions.optimizeSize = true;
+#endif
+
+	spv::SpvBuildLogger logger;
+	std::vector<uint32_t> spirv;
+	GlslangToSpv(*program.getIntermediate(language), spirv, &logger, &spvOptions);
+	return spirv;
+}
+
+static uint64_t HashSource(const std::string &source) {
+	uint64_t hash = 14695981039346656037ull;
+	for (auto c : source) {
+		hash ^= static_cast<uint8_t>(c);
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+static constexpr uint32_t CookedShaderMagic = 0x56505343; // "CSPV"
+static constexpr uint32_t CookedShaderVersion = 1;
+
+/**
+ * Reads cooked SPIR-V if it was compiled from the same preprocessed source, so included files and defines are accounted for.
+ * @param moduleName The shader stage filename.
+ * @param preprocessed The source after includes and defines have been expanded.
+ * @return The SPIR-V code, empty if there is no matching cooked code.
+ */
+static std::vector<uint32_t> ReadCookedSpirv(const std::filesystem::path &moduleName, const std::string &preprocessed) {
+	auto cookedFilename = Shader::GetCookedFilename(moduleName);
+	if (!Files::ExistsInPath(cookedFilename))
+		return {};
+
+	auto fileLoaded = Files::ReadView(cookedFilename);
+	if (!fileLoaded)
+		return {};
+
+	std::vector<uint32_t> spirv;
+	try {
+		BinaryReader reader(fileLoaded->GetBytes());
+		if (reader.Read<uint32_t>() != CookedShaderMagic || reader.Read<uint32_t>() != CookedShaderVersion || reader.Read<uint64_t>() != HashSource(preprocessed))
+			return {};
+		reader.Read(spirv);
+	} catch (const std::exception &e) {
+		Log::Warning("Cooked shader ", cookedFilename, " is invalid: ", e.what(), '\n');
+		return {};
+	}
+	return spirv;
+}
+
+VkShaderModule Shader::CreateShaderModule(const std::filesystem::path &moduleName, const std::string &moduleCode, const std::string &preamble, VkShaderStageFlags moduleFlag) {
+	auto logicalDevice = Graphics::Get()->GetLogicalDevice();
+
+	stages.emplace_back(moduleName);
+
+	// Starts converting GLSL to SPIR-V.
+	auto language = GetEshLanguage(moduleFlag);
+	glslang::TProgram program;
+	glslang::TShader shader(language);
+	std::string preprocessed;
+	// Parsing is still required when cooked code exists, since the reflection is built from the program.
+	ParseProgram(shader, program, language, moduleName, moduleCode, preamble, preprocessed);
+
 	program.buildReflection();
 	//program.dumpReflection();
 
@@ -355,20 +435,9 @@ VkShaderModule Shader::CreateShaderModule(const std::filesystem::path &moduleNam
 	for (int32_t i = 0; i < program.getNumLiveAttributes(); i++)
 		LoadAttribute(program, moduleFlag, i);
 
-	glslang::SpvOptions spvOptions;
-#ifdef ACID_DEBUG
-	spvOptions.generateDebugInfo = true;
-	spvOptions.disableOptimizer = true;
-	spvOptions.optimizeSize = false;
-#else
-	spvOptions.generateDebugInfo = false;
-	spvOptions.disableOptimizer = false;
-	spvOptions.optimizeSize = true;
-#endif
-
-	spv::SpvBuildLogger logger;
-	std::vector<uint32_t> spirv;
-	GlslangToSpv(*program.getIntermediate(static_cast<EShLanguage>(language)), spirv, &logger, &spvOptions);
+	auto spirv = ReadCookedSpirv(moduleName, preprocessed);
+	if (spirv.empty())
+		spirv = GenerateSpirv(program, language);
 
 	VkShaderModuleCreateInfo shaderModuleCreateInfo = {};
 	shaderModuleCreateInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
@@ -380,6 +449,35 @@ VkShaderModule Shader::CreateShaderModule(const std::filesystem::path &moduleNam
 	return shaderModule;
 }
 
+bool Shader::Cook(const std::filesystem::path &moduleName, const std::string &moduleCode, const std::string &preamble, VkShaderStageFlags moduleFlag,
+	const std::filesystem::path &filename) {
+	// Initialization is reference counted, so this is safe while graphics holds the process.
+	glslang::InitializeProcess();
+
+	auto language = GetEshLanguage(moduleFlag);
+	std::vector<uint32_t> spirv;
+	std::string preprocessed;
+	{
+		glslang::TProgram program;
+		glslang::TShader shader(language);
+		if (ParseProgram(shader, program, language, moduleName, moduleCode, preamble, preprocessed))
+			spirv = GenerateSpirv(program, language);
+	}
+
+	glslang::FinalizeProcess();
+
+	if (spirv.empty())
+		return false;
+
+	BinaryWriter writer;
+	writer.Write(CookedShaderMagic);
+	writer.Write(CookedShaderVersion);
+	writer.Write(HashSource(preprocessed));
+	writer.Write<uint32_t>(spirv);
+	writer.Save(filename);
+	return true;
+}
+
 void Shader::CreateReflection() {
 	std::map<VkDescriptorType, uint32_t> descriptorPoolCounts;
 
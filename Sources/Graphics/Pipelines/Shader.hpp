@@ -289,6 +289,26 @@ public:
 	VkShaderModule CreateShaderModule(const std::filesystem::path &moduleName, const std::string &moduleCode, const std::string &preamble, VkShaderStageFlags moduleFlag);
 	void CreateReflection();
 
+	/**
+	 * Compiles a shader stage to SPIR-V and writes it to a file on disk, without reflecting it or creating a module.
+	 * {@link Shader#CreateShaderModule} uses the cooked code in place of generating SPIR-V when the preprocessed source matches.
+	 * @param moduleName The shader stage filename.
+	 * @param moduleCode The GLSL source code.
+	 * @param preamble The defines added to the start of the source.
+	 * @param moduleFlag The shader stage.
+	 * @param filename The real path to write to.
+	 * @return If the stage compiled.
+	 */
+	static bool Cook(const std::filesystem::path &moduleName, const std::string &moduleCode, const std::string &preamble, VkShaderStageFlags moduleFlag,
+		const std::filesystem::path &filename);
+
+	/**
+	 * Gets the filename of the cooked SPIR-V for a shader stage.
+	 * @param filename The shader stage filename.
+	 * @return The cooked SPIR-V filename.
+	 */
+	static std::filesystem::path GetCookedFilename(std::filesystem::path filename) { return filename += ".spv"; }
+
 	const std::filesystem::path &GetName() const { return stages.back(); }
 	uint32_t GetLastDescriptorBinding() const { return lastDescriptorBinding; }
 	const std::map<std::string, Uniform> &GetUniforms() const { return uniforms; };
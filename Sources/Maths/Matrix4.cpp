@@ -283,6 +283,23 @@ Matrix4 Matrix4::TransformationMatrix(const Vector3f &translation, const Vector3
 	return result;
 }
 
+Matrix4 Matrix4::BillboardMatrix(const Matrix4 &viewMatrix, const Vector3f &position, float rotation, float scale) {
+	Matrix4 result;
+
+	auto c = std::cos(rotation) * scale;
+	auto s = std::sin(rotation) * scale;
+
+	// The rows of the views rotation transposed are its columns, the roll mixes the first two of them.
+	for (uint32_t col = 0; col < 3; col++) {
+		result[0][col] = c * viewMatrix[col][0] + s * viewMatrix[col][1];
+		result[1][col] = c * viewMatrix[col][1] - s * viewMatrix[col][0];
+		result[2][col] = scale * viewMatrix[col][2];
+	}
+
+	result[3] = Vector4f(position, 1.0f);
+	return result;
+}
+
 Matrix4 Matrix4::PerspectiveMatrix(float fov, float aspectRatio, float zNear, float zFar) {
 	Matrix4 result(0.0f);
 
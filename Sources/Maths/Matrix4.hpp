@@ -160,6 +160,17 @@ public:
 	 */
 	static Matrix4 TransformationMatrix(const Vector3f &translation, const Vector3f &rotation, const Vector3f &scale);
 
+	/**
+	 * Creates a new transformation matrix for a quad that faces the camera, built in closed form instead of chaining matrix operations.
+	 * Equal to translating by the position, taking the transposed rotation of the view, then rotating around the front axis and scaling.
+	 * @param viewMatrix The cameras view matrix.
+	 * @param position The position of the quad.
+	 * @param rotation The roll of the quad around the view direction.
+	 * @param scale How much to scale the quad.
+	 * @return The transformation matrix.
+	 */
+	static Matrix4 BillboardMatrix(const Matrix4 &viewMatrix, const Vector3f &position, float rotation, float scale);
+
 	/**
 	 * Creates a new perspective matrix.
 	 * @param fov The cameras FOV.
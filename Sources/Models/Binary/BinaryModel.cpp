@@ -0,0 +1,90 @@
+#include "BinaryModel.hpp"
+
+#include "Files/BinaryStream.hpp"
+#include "Files/Files.hpp"
+#include "Resources/Resources.hpp"
+
+namespace acid {
+static constexpr uint32_t BinaryModelMagic = 0x4853454D; // "MESH"
+static constexpr uint32_t BinaryModelVersion = 1;
+
+std::shared_ptr<BinaryModel> BinaryModel::Create(const Node &node) {
+	if (auto resource = Resources::Get()->Find<BinaryModel>(node))
+		return resource;
+
+	auto result = std::make_shared<BinaryModel>("");
+	Resources::Get()->Add(node, std::dynamic_pointer_cast<Resource>(result));
+	node >> *result;
+	result->Load();
+	return result;
+}
+
+std::shared_ptr<BinaryModel> BinaryModel::Create(const std::filesystem::path &filename) {
+	BinaryModel temp(filename, false);
+	Node node;
+	node << temp;
+	return Create(node);
+}
+
+BinaryModel::BinaryModel(std::filesystem::path filename, bool load) :
+	filename(std::move(filename)) {
+	if (load) {
+		Load();
+	}
+}
+
+void BinaryModel::Read(const std::filesystem::path &filename, std::vector<Vertex3d> &vertices, std::vector<uint32_t> &indices) {
+	auto fileLoaded = Files::ReadView(filename);
+	if (!fileLoaded)
+		throw std::runtime_error("Binary model could not be loaded: " + filename.string());
+
+	BinaryReader reader(fileLoaded->GetBytes());
+	if (reader.Read<uint32_t>() != BinaryModelMagic || reader.Read<uint32_t>() != BinaryModelVersion || reader.Read<uint32_t>() != sizeof(Vertex3d))
+		throw std::runtime_error("Binary model has a unsupported format: " + filename.string());
+
+	reader.Read(vertices);
+	reader.Read(indices);
+}
+
+void BinaryModel::Write(const std::filesystem::path &filename, const std::vector<Vertex3d> &vertices, const std::vector<uint32_t> &indices) {
+	BinaryWriter writer;
+	writer.Write(BinaryModelMagic);
+	writer.Write(BinaryModelVersion);
+	writer.Write(static_cast<uint32_t>(sizeof(Vertex3d)));
+	writer.Write<Vertex3d>(vertices);
+	writer.Write<uint32_t>(indices);
+	writer.Save(filename);
+}
+
+const Node &operator>>(const Node &node, BinaryModel &model) {
+	node["filename"].Get(model.filename);
+	return node;
+}
+
+Node &operator<<(Node &node, const BinaryModel &model) {
+	node["filename"].Set(model.filename);
+	return node;
+}
+
+void BinaryModel::Load() {
+	Decode();
+	Upload();
+}
+
+void BinaryModel::Decode() {
+	if (filename.empty()) {
+		return;
+	}
+
+	Read(filename, decodedVertices, decodedIndices);
+}
+
+void BinaryModel::Upload() {
+	if (decodedVertices.empty())
+		return;
+
+	Initialize(decodedVertices, decodedIndices);
+	decodedVertices = {};
+	decodedIndices = {};
+}
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Models/Model.hpp"
+#include "Models/Vertex3d.hpp"
+
+namespace acid {
+/**
+ * @brief Resource that represents a cooked model, the vertices and indices are stored GPU-ready and are read without conversion.
+ * Cooked models are written by AcidCooker next to their source file, and are used in place of the source by the other model loaders.
+ */
+class ACID_EXPORT BinaryModel : public Model::Registrar<BinaryModel> {
+	inline static const bool Registered = Register("binary", ".mesh");
+public:
+	/// The extension appended to a source filename to name its cooked model.
+	inline static const std::string Extension = ".mesh";
+
+	/**
+	 * Creates a new binary model, or finds one with the same values.
+	 * @param node The node to decode values from.
+	 * @return The binary model with the requested values.
+	 */
+	static std::shared_ptr<BinaryModel> Create(const Node &node);
+
+	/**
+	 * Creates a new binary model, or finds one with the same values.
+	 * @param filename The file to load the binary model from.
+	 * @return The binary model with the requested values.
+	 */
+	static std::shared_ptr<BinaryModel> Create(const std::filesystem::path &filename);
+
+	/**
+	 * Creates a new binary model.
+	 * @param filename The file to load the binary model from.
+	 * @param load If this resource will be loaded immediately, otherwise {@link BinaryModel#Load} can be called later.
+	 */
+	explicit BinaryModel(std::filesystem::path filename, bool load = true);
+
+	/**
+	 * Reads the vertices and indices from a binary model file.
+	 * @param filename The file to read from.
+	 * @param vertices The vertices to fill.
+	 * @param indices The indices to fill.
+	 */
+	static void Read(const std::filesystem::path &filename, std::vector<Vertex3d> &vertices, std::vector<uint32_t> &indices);
+
+	/**
+	 * Writes vertices and indices to a binary model file on disk.
+	 * @param filename The real path to write to.
+	 * @param vertices The model vertices.
+	 * @param indices The model indices.
+	 */
+	static void Write(const std::filesystem::path &filename, const std::vector<Vertex3d> &vertices, const std::vector<uint32_t> &indices);
+
+	/**
+	 * Gets the filename of the cooked model for a source model.
+	 * @param filename The source model filename.
+	 * @return The cooked model filename.
+	 */
+	static std::filesystem::path GetCookedFilename(std::filesystem::path filename) { return filename += Extension; }
+
+	friend const Node &operator>>(const Node &node, BinaryModel &model);
+	friend Node &operator<<(Node &node, const BinaryModel &model);
+
+protected:
+	void Decode() override;
+	void Upload() override;
+
+private:
+	void Load();
+
+	std::filesystem::path filename;
+	std::vector<Vertex3d> decodedVertices;
+	std::vector<uint32_t> decodedIndices;
+};
+}
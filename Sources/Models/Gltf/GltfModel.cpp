@@ -3,6 +3,7 @@
 #include <tiny_gltf.h>
 
 #include "Files/Files.hpp"
+#include "Models/Binary/BinaryModel.hpp"
 #include "Resources/Resources.hpp"
 #include "Models/Vertex3d.hpp"
 
@@ -43,6 +44,11 @@ Node &operator<<(Node &node, const GltfModel &model) {
 }
 
 void GltfModel::Load() {
+	Decode();
+	Upload();
+}
+
+void GltfModel::Decode() {
 	if (filename.empty()) {
 		return;
 	}
@@ -51,13 +57,23 @@ void GltfModel::Load() {
 	auto debugStart = Time::Now();
 #endif
 
+	// A model cooked by AcidCooker is used in place of the source.
+	if (auto cookedFilename = BinaryModel::GetCookedFilename(filename); Files::ExistsInPath(cookedFilename))
+		BinaryModel::Read(cookedFilename, decodedVertices, decodedIndices);
+	else
+		Read(filename, decodedVertices, decodedIndices);
+
+#ifdef ACID_DEBUG
+	Log::Out("Model ", filename, " loaded in ", (Time::Now() - debugStart).AsMilliseconds<float>(), "ms\n");
+#endif
+}
+
+void GltfModel::Read(const std::filesystem::path &filename, std::vector<Vertex3d> &vertices, std::vector<uint32_t> &indices) {
 	auto folder = filename.parent_path();
 	auto fileLoaded = Files::Read(filename);
 
-	if (!fileLoaded) {
-		Log::Error("Model could not be loaded: ", filename, '\n');
-		return;
-	}
+	if (!fileLoaded)
+		throw std::runtime_error("Model could not be loaded: " + filename.string());
 
 	tinygltf::Model gltfModel;
 	tinygltf::TinyGLTF gltfContext;
@@ -73,8 +89,8 @@ void GltfModel::Load() {
 		}
 	}
 
-	std::vector<Vertex3d> vertices;
-	std::vector<uint32_t> indices;
+	vertices.clear();
+	indices.clear();
 	std::unordered_map<Vertex3d, size_t> uniqueVertices;
 
 	//LoadTextureSamplers(gltfModel);
@@ -109,11 +125,14 @@ void GltfModel::Load() {
 	}
 
 	auto extensions = gltfModel.extensionsUsed;*/
+}
 
-#ifdef ACID_DEBUG
-	Log::Out("Model ", filename, " loaded in ", (Time::Now() - debugStart).AsMilliseconds<float>(), "ms\n");
-#endif
+void GltfModel::Upload() {
+	if (decodedVertices.empty())
+		return;
 
-	Initialize(vertices, indices);
+	Initialize(decodedVertices, decodedIndices);
+	decodedVertices = {};
+	decodedIndices = {};
 }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Models/Model.hpp"
+#include "Models/Vertex3d.hpp"
 #include "Graphics/Images/Image2d.hpp"
 
 namespace acid {
@@ -31,9 +32,21 @@ public:
 	 */
 	explicit GltfModel(std::filesystem::path filename, bool load = true);
 
+	/**
+	 * Parses the vertices and indices from a GLTF file.
+	 * @param filename The file to parse.
+	 * @param vertices The vertices to fill.
+	 * @param indices The indices to fill.
+	 */
+	static void Read(const std::filesystem::path &filename, std::vector<Vertex3d> &vertices, std::vector<uint32_t> &indices);
+
 	friend const Node &operator>>(const Node &node, GltfModel &model);
 	friend Node &operator<<(Node &node, const GltfModel &model);
 
+protected:
+	void Decode() override;
+	void Upload() override;
+
 private:
 	void Load();
 	
@@ -41,6 +54,8 @@ private:
 	//struct Skin;
 
 	std::filesystem::path filename;
+	std::vector<Vertex3d> decodedVertices;
+	std::vector<uint32_t> decodedIndices;
 
 	//std::vector<Node *> nodes;
 	//std::vector<Node *> linearNodes;
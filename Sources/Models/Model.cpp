@@ -24,6 +24,15 @@ bool Model::CmdRender(const CommandBuffer &commandBuffer, uint32_t instances) co
 	return true;
 }
 
+std::size_t Model::GetGpuMemoryUsage() const {
+	std::size_t size = 0;
+	if (vertexBuffer)
+		size += vertexBuffer->GetSize();
+	if (indexBuffer)
+		size += indexBuffer->GetSize();
+	return size;
+}
+
 std::vector<uint32_t> Model::GetIndices(std::size_t offset) const {
 	Buffer indexStaging(indexBuffer->GetSize(), VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
 		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
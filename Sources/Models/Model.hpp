@@ -80,6 +80,8 @@ public:
 			return true;
 		}
 
+		std::type_index GetTypeIndex() const override { return typeid(T); }
+
 		const Node &Load(const Node &node) override {
 			return node >> *dynamic_cast<T *>(this);
 		}
@@ -127,6 +129,7 @@ public:
 	bool CmdRender(const CommandBuffer &commandBuffer, uint32_t instances = 1) const;
 
 	std::type_index GetTypeIndex() const override { return typeid(Model); }
+	std::size_t GetGpuMemoryUsage() const override;
 
 	template<typename T>
 	std::vector<T> GetVertices(std::size_t offset = 0) const;
@@ -3,6 +3,7 @@
 #include <tiny_obj.h>
 
 #include "Files/Files.hpp"
+#include "Models/Binary/BinaryModel.hpp"
 #include "Resources/Resources.hpp"
 #include "Models/Vertex3d.hpp"
 
@@ -72,6 +73,11 @@ Node &operator<<(Node &node, const ObjModel &model) {
 }
 
 void ObjModel::Load() {
+	Decode();
+	Upload();
+}
+
+void ObjModel::Decode() {
 	if (filename.empty()) {
 		return;
 	}
@@ -80,6 +86,18 @@ void ObjModel::Load() {
 	auto debugStart = Time::Now();
 #endif
 
+	// A model cooked by AcidCooker is used in place of the source.
+	if (auto cookedFilename = BinaryModel::GetCookedFilename(filename); Files::ExistsInPath(cookedFilename))
+		BinaryModel::Read(cookedFilename, decodedVertices, decodedIndices);
+	else
+		Read(filename, decodedVertices, decodedIndices);
+
+#if defined(ACID_DEBUG)
+	Log::Out("Model ", filename, " loaded in ", (Time::Now() - debugStart).AsMilliseconds<float>(), "ms\n");
+#endif
+}
+
+void ObjModel::Read(const std::filesystem::path &filename, std::vector<Vertex3d> &vertices, std::vector<uint32_t> &indices) {
 	auto folder = filename.parent_path();
 	IFStream inStream(filename);
 	MaterialStreamReader materialReader(folder);
@@ -93,8 +111,8 @@ void ObjModel::Load() {
 		throw std::runtime_error(warn + err);
 	}
 
-	std::vector<Vertex3d> vertices;
-	std::vector<uint32_t> indices;
+	vertices.clear();
+	indices.clear();
 	std::unordered_map<Vertex3d, size_t> uniqueVertices;
 
 	for (const auto &shape : shapes) {
@@ -118,11 +136,14 @@ void ObjModel::Load() {
 			indices.emplace_back(static_cast<uint32_t>(uniqueVertices[vertex]));
 		}
 	}
+}
 
-#if defined(ACID_DEBUG)
-	Log::Out("Model ", filename, " loaded in ", (Time::Now() - debugStart).AsMilliseconds<float>(), "ms\n");
-#endif
+void ObjModel::Upload() {
+	if (decodedVertices.empty())
+		return;
 
-	Initialize(vertices, indices);
+	Initialize(decodedVertices, decodedIndices);
+	decodedVertices = {};
+	decodedIndices = {};
 }
 }
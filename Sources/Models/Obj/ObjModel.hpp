@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Models/Model.hpp"
+#include "Models/Vertex3d.hpp"
 
 namespace acid {
 /**
@@ -30,12 +31,26 @@ public:
 	 */
 	explicit ObjModel(std::filesystem::path filename, bool load = true);
 
+	/**
+	 * Parses the vertices and indices from a OBJ file.
+	 * @param filename The file to parse.
+	 * @param vertices The vertices to fill.
+	 * @param indices The indices to fill.
+	 */
+	static void Read(const std::filesystem::path &filename, std::vector<Vertex3d> &vertices, std::vector<uint32_t> &indices);
+
 	friend const Node &operator>>(const Node &node, ObjModel &model);
 	friend Node &operator<<(Node &node, const ObjModel &model);
 
+protected:
+	void Decode() override;
+	void Upload() override;
+
 private:
 	void Load();
 	
 	std::filesystem::path filename;
+	std::vector<Vertex3d> decodedVertices;
+	std::vector<uint32_t> decodedIndices;
 };
 }
@@ -0,0 +1,34 @@
+#include "BitonicSort.hpp"
+
+#include <utility>
+
+namespace acid {
+std::vector<BitonicSort::Step> BitonicSort::GetSteps(uint32_t count) {
+	// Each stage merges sorted sequences of half its size into bitonic ones of size k, then halves the compare distance down to neighbours.
+	std::vector<Step> steps;
+	for (uint32_t k = 2; k <= count; k <<= 1) {
+		for (uint32_t j = k >> 1; j > 0; j >>= 1)
+			steps.push_back({j, k});
+	}
+	return steps;
+}
+
+void BitonicSort::RunStep(Span<Vector2ui> keys, const Step &step) {
+	for (uint32_t i = 0; i < keys.size(); i++) {
+		auto l = i ^ step.j;
+		if (l <= i)
+			continue;
+
+		auto descending = (i & step.k) == 0;
+		if (descending == (keys[i].x < keys[l].x))
+			std::swap(keys[i], keys[l]);
+	}
+}
+
+uint32_t BitonicSort::NextPowerOfTwo(uint32_t value) {
+	uint32_t result = 1;
+	while (result < value)
+		result <<= 1;
+	return result;
+}
+}
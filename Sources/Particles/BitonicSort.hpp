@@ -0,0 +1,45 @@
+#pragma once
+
+#include <vector>
+
+#include "Maths/Vector2.hpp"
+#include "Utils/Span.hpp"
+
+namespace acid {
+/**
+ * @brief The steps of the bitonic sort the compute particles are depth sorted with, and a CPU reference of the compare and swap Sort.comp runs.
+ * Keys are sorted descending by their x, the y is the index of the particle the key belongs to.
+ */
+class ACID_EXPORT BitonicSort {
+public:
+	/**
+	 * @brief One compare and swap pass, every key is compared with the key j away within sequences of k keys.
+	 */
+	class Step {
+	public:
+		uint32_t j;
+		uint32_t k;
+	};
+
+	/**
+	 * Gets the passes that sort a amount of keys, in the order they are dispatched.
+	 * @param count The amount of keys, a power of two.
+	 * @return The passes.
+	 */
+	static std::vector<Step> GetSteps(uint32_t count);
+
+	/**
+	 * Runs one compare and swap pass over keys, like a dispatch of Sort.comp.
+	 * @param keys The keys, a power of two of them.
+	 * @param step The pass.
+	 */
+	static void RunStep(Span<Vector2ui> keys, const Step &step);
+
+	/**
+	 * Gets the smallest power of two at least a value.
+	 * @param value The value.
+	 * @return The power of two.
+	 */
+	static uint32_t NextPowerOfTwo(uint32_t value);
+};
+}
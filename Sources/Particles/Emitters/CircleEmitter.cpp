@@ -1,5 +1,7 @@
 #include "CircleEmitter.hpp"
 
+#include <algorithm>
+
 #include "Scenes/Entity.hpp"
 
 namespace acid {
@@ -30,6 +32,18 @@ Vector3f CircleEmitter::GeneratePosition() const {
 	return direction * distance;
 }
 
+void CircleEmitter::GeneratePositions(Span<Vector3f> positions) const {
+	// The directions are spread around the heading in the plane of the circle, from a basis worked out once for the batch.
+	Vector3f tangent, bitangent;
+	OrthonormalBasis(heading, tangent, bitangent);
+
+	for (auto &position : positions) {
+		auto theta = Maths::Random(0.0f, 1.0f) * 2.0f * Maths::PI<float>;
+		auto distance = std::max(Maths::Random(0.0f, 1.0f), Maths::Random(0.0f, 1.0f));
+		position = (tangent * std::cos(theta) + bitangent * std::sin(theta)) * (radius * distance);
+	}
+}
+
 const Node &operator>>(const Node &node, CircleEmitter &emitter) {
 	node["radius"].Get(emitter.radius);
 	node["heading"].Get(emitter.heading);
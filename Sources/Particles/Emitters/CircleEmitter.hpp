@@ -9,6 +9,7 @@ public:
 	explicit CircleEmitter(float radius = 1.0f, const Vector3f &heading = Vector3f::Up);
 
 	Vector3f GeneratePosition() const override;
+	void GeneratePositions(Span<Vector3f> positions) const override;
 
 	float GetRadius() const { return radius; }
 	void SetRadius(float radius) { this->radius = radius; }
@@ -0,0 +1,41 @@
+#include "Emitter.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Maths/Maths.hpp"
+
+namespace acid {
+void Emitter::GeneratePositions(Span<Vector3f> positions) const {
+	for (auto &position : positions)
+		position = GeneratePosition();
+}
+
+void Emitter::RandomUnitVectorsWithinCone(const Vector3f &coneDirection, float angle, Span<Vector3f> directions) {
+	// Samples are spread around +z, then taken onto the cone by the basis around its direction.
+	// Any basis does, the samples are spread evenly around the direction so a twist about it does not change their spread.
+	auto normal = coneDirection.Normalize();
+	Vector3f tangent, bitangent;
+	OrthonormalBasis(normal, tangent, bitangent);
+
+	auto cosAngle = std::cos(angle);
+
+	for (auto &direction : directions) {
+		auto theta = Maths::Random(0.0f, 1.0f) * 2.0f * Maths::PI<float>;
+		auto z = cosAngle + Maths::Random(0.0f, 1.0f) * (1.0f - cosAngle);
+		auto rootOneMinusZSquared = std::sqrt(std::max(1.0f - z * z, 0.0f));
+		auto x = rootOneMinusZSquared * std::cos(theta);
+		auto y = rootOneMinusZSquared * std::sin(theta);
+		direction = tangent * x + bitangent * y + normal * z;
+	}
+}
+
+void Emitter::OrthonormalBasis(const Vector3f &normal, Vector3f &tangent, Vector3f &bitangent) {
+	// Duff et al. 2017, Building an Orthonormal Basis, Revisited.
+	auto sign = std::copysign(1.0f, normal.z);
+	auto a = -1.0f / (sign + normal.z);
+	auto b = normal.x * normal.y * a;
+	tangent = {1.0f + sign * normal.x * normal.x * a, sign * b, -sign * normal.x};
+	bitangent = {b, sign + normal.y * normal.y * a, -normal.y};
+}
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Utils/Span.hpp"
 #include "Utils/StreamFactory.hpp"
 #include "Maths/Vector3.hpp"
 
@@ -17,6 +18,12 @@ public:
 	 */
 	virtual Vector3f GeneratePosition() const = 0;
 
+	/**
+	 * Creates the positions of a batch of new objects, emitters override this to generate them without a virtual call for each position.
+	 * @param positions The positions to write into.
+	 */
+	virtual void GeneratePositions(Span<Vector3f> positions) const;
+
 	static Vector3f RandomUnitVector() {
 		auto theta = Maths::Random(0.0f, 1.0f) * 2.0f * Maths::PI<float>;
 		auto z = Maths::Random(0.0f, 1.0f) * 2.0f - 1.0f;
@@ -25,5 +32,21 @@ public:
 		auto y = rootOneMinusZSquared * std::sin(theta);
 		return {x, y, z};
 	}
+
+	/**
+	 * Creates a batch of unit vectors spread evenly over a cone. The rotation onto the cone is worked out once for the batch.
+	 * @param coneDirection The direction of the cone.
+	 * @param angle The angle from the direction to the edge of the cone, in radians.
+	 * @param directions The unit vectors to write into.
+	 */
+	static void RandomUnitVectorsWithinCone(const Vector3f &coneDirection, float angle, Span<Vector3f> directions);
+
+	/**
+	 * Creates two unit vectors that are perpendicular to each other and to a normal.
+	 * @param normal The unit normal.
+	 * @param tangent The first perpendicular vector.
+	 * @param bitangent The second perpendicular vector.
+	 */
+	static void OrthonormalBasis(const Vector3f &normal, Vector3f &tangent, Vector3f &bitangent);
 };
 }
@@ -13,6 +13,12 @@ Vector3f LineEmitter::GeneratePosition() const {
 	return axis * length * Maths::Random(-0.5f, 0.5f);
 }
 
+void LineEmitter::GeneratePositions(Span<Vector3f> positions) const {
+	auto scaledAxis = axis * length;
+	for (auto &position : positions)
+		position = scaledAxis * Maths::Random(-0.5f, 0.5f);
+}
+
 const Node &operator>>(const Node &node, LineEmitter &emitter) {
 	node["length"].Get(emitter.length);
 	node["axis"].Get(emitter.axis);
@@ -9,6 +9,7 @@ public:
 	explicit LineEmitter(float length = 1.0f, const Vector3f &axis = Vector3f::Right);
 
 	Vector3f GeneratePosition() const override;
+	void GeneratePositions(Span<Vector3f> positions) const override;
 
 	float GetLength() const { return length; }
 	void SetLength(float length) { this->length = length; }
@@ -1,5 +1,7 @@
 ﻿#include "PointEmitter.hpp"
 
+#include <algorithm>
+
 #include "Scenes/Entity.hpp"
 
 namespace acid {
@@ -10,6 +12,10 @@ Vector3f PointEmitter::GeneratePosition() const {
 	return point;
 }
 
+void PointEmitter::GeneratePositions(Span<Vector3f> positions) const {
+	std::fill(positions.begin(), positions.end(), point);
+}
+
 const Node &operator>>(const Node &node, PointEmitter &emitter) {
 	node["point"].Get(emitter.point);
 	return node;
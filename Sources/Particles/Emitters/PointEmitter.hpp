@@ -9,6 +9,7 @@ public:
 	PointEmitter();
 
 	Vector3f GeneratePosition() const override;
+	void GeneratePositions(Span<Vector3f> positions) const override;
 
 	const Vector3f &GetPoint() const { return point; }
 	void SetPoint(const Vector3f &point) { this->point = point; }
@@ -1,5 +1,7 @@
 #include "SphereEmitter.hpp"
 
+#include <algorithm>
+
 #include "Maths/Maths.hpp"
 #include "Maths/Vector2.hpp"
 
@@ -20,6 +22,14 @@ Vector3f SphereEmitter::GeneratePosition() const {
 	return radius * distance * RandomUnitVector();
 }
 
+void SphereEmitter::GeneratePositions(Span<Vector3f> positions) const {
+	for (auto &position : positions) {
+		// The length of the point GeneratePosition picks on the unit disc is the larger of the two randoms, so it is used as it is.
+		auto distance = std::max(Maths::Random(0.0f, 1.0f), Maths::Random(0.0f, 1.0f));
+		position = radius * distance * RandomUnitVector();
+	}
+}
+
 const Node &operator>>(const Node &node, SphereEmitter &emitter) {
 	node["radius"].Get(emitter.radius);
 	return node;
@@ -0,0 +1,267 @@
+#include "ParticleCompute.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+#include "Graphics/Graphics.hpp"
+#include "BitonicSort.hpp"
+#include "ParticlePool.hpp"
+#include "ParticleType.hpp"
+
+namespace acid {
+/**
+ * @brief A particle as the compute shaders store it, a particle with no life is a free slot.
+ */
+class ComputeParticle {
+public:
+	// Zeroed rather than left with the w of one a vector defaults to, so a new particle is a free slot.
+	Vector4f positionLife = Vector4f(0.0f);
+	Vector4f velocityElapsed = Vector4f(0.0f);
+	Vector4f parameters = Vector4f(0.0f);
+};
+
+/**
+ * @brief The counters the compute passes share, the CPU resets the live count and writes the emit count before each update.
+ */
+class ComputeCounters {
+public:
+	int32_t alive;
+	int32_t dead;
+	uint32_t emitCount;
+};
+
+// The build pass writes instances as floats, so their layout has to stay packed.
+static_assert(sizeof(ParticleType::Instance) == 27 * sizeof(float), "Particle instances are written as 27 floats by Build.comp");
+
+/**
+ * Makes the writes of the last pass visible to the next one.
+ * @param commandBuffer The command buffer recording the passes.
+ * @param srcStage The stage of the last pass.
+ */
+static void ComputeBarrier(const CommandBuffer &commandBuffer, VkPipelineStageFlags srcStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT) {
+	VkMemoryBarrier memoryBarrier = {};
+	memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+	memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+	memoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+	vkCmdPipelineBarrier(commandBuffer, srcStage, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+}
+
+static std::vector<uint32_t> CreateDeadList() {
+	std::vector<uint32_t> deadList(ParticleCompute::Capacity);
+	std::iota(deadList.begin(), deadList.end(), 0);
+	return deadList;
+}
+
+ParticleCompute::Pool::Pool(const ParticleCompute &compute, const ParticleType &type) :
+	counters(sizeof(ComputeCounters)),
+	// Every slot starts free, with no life.
+	particles(sizeof(ComputeParticle) * Capacity, std::vector<ComputeParticle>(Capacity).data()),
+	deadList(sizeof(uint32_t) * Capacity, CreateDeadList().data()),
+	emitRequests(sizeof(ComputeParticle) * Capacity),
+	sortKeys(2 * sizeof(uint32_t) * Capacity),
+	emitDescriptors(compute.emitPipeline),
+	simulateDescriptors(compute.simulatePipeline),
+	sortDescriptors(compute.sortPipeline),
+	indexCount(type.GetModel()->GetIndexCount()) {
+	ComputeCounters initialCounters = {0, static_cast<int32_t>(Capacity), 0};
+	counters.Update(&initialCounters);
+	frames.emplace_back(std::make_unique<Frame>(compute, indexCount));
+}
+
+ParticleCompute::Pool::Frame::Frame(const ParticleCompute &compute, uint32_t indexCount) :
+	instances(sizeof(ParticleType::Instance) * Capacity, nullptr, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT),
+	indirect(sizeof(VkDrawIndexedIndirectCommand), nullptr, VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT),
+	buildDescriptors(compute.buildPipeline) {
+	// The build pass only writes the instance count.
+	VkDrawIndexedIndirectCommand initialIndirect = {};
+	initialIndirect.indexCount = indexCount;
+	indirect.Update(&initialIndirect);
+}
+
+bool ParticleCompute::Pool::Frame::IsFree() const {
+	// A frame that has not been submitted yet has not read anything, so it is free as well, like when updates outpace rendering.
+	auto graphics = Graphics::Get();
+	return !drawFrame || *drawFrame == graphics->GetFrameNumber() || graphics->IsFrameComplete(*drawFrame);
+}
+
+void ParticleCompute::Pool::NextFrame(const ParticleCompute &compute) {
+	auto it = std::find_if(frames.begin(), frames.end(), [](const auto &frame) {
+		return frame->IsFree();
+	});
+	if (it == frames.end())
+		it = frames.emplace(frames.end(), std::make_unique<Frame>(compute, indexCount));
+
+	frame = static_cast<std::size_t>(it - frames.begin());
+	(*it)->drawFrame = Graphics::Get()->GetFrameNumber();
+}
+
+bool ParticleCompute::Pool::IsFree() const {
+	return std::all_of(frames.begin(), frames.end(), [](const auto &frame) {
+		return frame->IsFree();
+	});
+}
+
+ParticleCompute::ParticleCompute() :
+	emitPipeline("Shaders/Particles/Emit.comp"),
+	simulatePipeline("Shaders/Particles/Simulate.comp"),
+	sortPipeline("Shaders/Particles/Sort.comp"),
+	buildPipeline("Shaders/Particles/Build.comp"),
+	simulatePush(*simulatePipeline.GetShader()->GetUniformBlock("PushObject")),
+	sortPush(*sortPipeline.GetShader()->GetUniformBlock("PushObject")),
+	buildPush(*buildPipeline.GetShader()->GetUniformBlock("PushObject")),
+	commandBuffer(false, VK_QUEUE_COMPUTE_BIT) {
+}
+
+ParticleCompute::~ParticleCompute() {
+	// Frames in flight may still be drawing from the pools, there is no later update left to destroy them in.
+	if (!pools.empty() || !retiredPools.empty())
+		Graphics::CheckVk(vkDeviceWaitIdle(*Graphics::Get()->GetLogicalDevice()));
+}
+
+void ParticleCompute::Emit(const std::shared_ptr<ParticleType> &type, const ParticlePool &pool) {
+	auto &computePool = pools[type];
+	if (!computePool)
+		computePool = std::make_unique<Pool>(*this, *type);
+
+	auto count = std::min(static_cast<uint32_t>(pool.GetSize()), Capacity - computePool->emitCount);
+	if (count == 0)
+		return;
+
+	ComputeParticle *requests;
+	computePool->emitRequests.MapMemory(reinterpret_cast<void **>(&requests));
+
+	for (uint32_t i = 0; i < count; i++) {
+		auto &request = requests[computePool->emitCount + i];
+		request.positionLife = Vector4f(pool.GetPosition(i), pool.GetLifeLength(i));
+		request.velocityElapsed = Vector4f(pool.GetVelocity(i), 0.0f);
+		request.parameters = Vector4f(pool.GetStageCycles(i), pool.GetRotation(i), pool.GetScale(i), pool.GetGravityEffect(i));
+	}
+
+	computePool->emitRequests.UnmapMemory();
+	computePool->emitCount += count;
+}
+
+void ParticleCompute::Update(float delta, const Vector3f &cameraPosition, const Matrix4 &viewMatrix) {
+	retiredPools.erase(std::remove_if(retiredPools.begin(), retiredPools.end(), [](const auto &pool) {
+		return pool->IsFree();
+	}), retiredPools.end());
+
+	// A type with nothing alive and nothing to spawn gives up its slots, like an empty pool on the CPU.
+	for (auto it = pools.begin(); it != pools.end();) {
+		if (it->second->aliveCount == 0 && it->second->emitCount == 0) {
+			retiredPools.emplace_back(std::move(it->second));
+			it = pools.erase(it);
+		} else {
+			++it;
+		}
+	}
+
+	if (pools.empty())
+		return;
+
+	commandBuffer.Begin();
+
+	for (auto &[type, pool] : pools) {
+		// The previous frames may still be drawing their instances, so this update builds into a frame none of them use.
+		pool->NextFrame(*this);
+		auto &frame = *pool->frames[pool->frame];
+
+		ComputeCounters *counters;
+		pool->counters.MapMemory(reinterpret_cast<void **>(&counters));
+		counters->alive = 0;
+		counters->emitCount = pool->emitCount;
+		pool->counters.UnmapMemory();
+
+		// The particles alive after this update are at most the ones alive before and the ones spawned, so only that many keys are sorted.
+		auto sortCount = BitonicSort::NextPowerOfTwo(std::min(pool->aliveCount + pool->emitCount, Capacity));
+
+		if (pool->emitCount != 0) {
+			pool->emitDescriptors.Push("Counters", pool->counters);
+			pool->emitDescriptors.Push("Particles", pool->particles);
+			pool->emitDescriptors.Push("DeadList", pool->deadList);
+			pool->emitDescriptors.Push("EmitRequests", pool->emitRequests);
+			pool->emitDescriptors.Update(emitPipeline);
+
+			emitPipeline.BindPipeline(commandBuffer);
+			pool->emitDescriptors.BindDescriptor(commandBuffer, emitPipeline);
+			emitPipeline.CmdRender(commandBuffer, {pool->emitCount, 1});
+		}
+
+		// Keys past the live particles are zero, so they sort after every live particle.
+		vkCmdFillBuffer(commandBuffer, pool->sortKeys.GetBuffer(), 0, 2 * sizeof(uint32_t) * sortCount, 0);
+		ComputeBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+		pool->simulateDescriptors.Push("Counters", pool->counters);
+		pool->simulateDescriptors.Push("Particles", pool->particles);
+		pool->simulateDescriptors.Push("DeadList", pool->deadList);
+		pool->simulateDescriptors.Push("SortKeys", pool->sortKeys);
+		pool->simulateDescriptors.Update(simulatePipeline);
+
+		simulatePipeline.BindPipeline(commandBuffer);
+		pool->simulateDescriptors.BindDescriptor(commandBuffer, simulatePipeline);
+		simulatePush.Push("cameraPosition", cameraPosition);
+		simulatePush.Push("delta", delta);
+		simulatePush.Push("capacity", Capacity);
+		simulatePush.BindPush(commandBuffer, simulatePipeline);
+		simulatePipeline.CmdRender(commandBuffer, {Capacity, 1});
+		ComputeBarrier(commandBuffer);
+
+		if (type->GetSortMode() == ParticleType::SortMode::BackToFront && sortCount > 1) {
+			pool->sortDescriptors.Push("SortKeys", pool->sortKeys);
+			pool->sortDescriptors.Update(sortPipeline);
+
+			sortPipeline.BindPipeline(commandBuffer);
+			pool->sortDescriptors.BindDescriptor(commandBuffer, sortPipeline);
+			sortPush.Push("count", sortCount);
+
+			for (const auto &step : BitonicSort::GetSteps(sortCount)) {
+				sortPush.Push("j", step.j);
+				sortPush.Push("k", step.k);
+				sortPush.BindPush(commandBuffer, sortPipeline);
+				sortPipeline.CmdRender(commandBuffer, {sortCount, 1});
+				ComputeBarrier(commandBuffer);
+			}
+		}
+
+		frame.buildDescriptors.Push("Counters", pool->counters);
+		frame.buildDescriptors.Push("Particles", pool->particles);
+		frame.buildDescriptors.Push("SortKeys", pool->sortKeys);
+		frame.buildDescriptors.Push("Instances", frame.instances);
+		frame.buildDescriptors.Push("Indirect", frame.indirect);
+		frame.buildDescriptors.Update(buildPipeline);
+
+		buildPipeline.BindPipeline(commandBuffer);
+		frame.buildDescriptors.BindDescriptor(commandBuffer, buildPipeline);
+		buildPush.Push("view", viewMatrix);
+		buildPush.Push("colourOffset", type->GetColourOffset());
+		buildPush.Push("atlasRows", type->GetImage() ? type->GetNumberOfRows() : 0);
+		buildPush.Push("numberOfRows", static_cast<float>(type->GetNumberOfRows()));
+		buildPush.BindPush(commandBuffer, buildPipeline);
+		buildPipeline.CmdRender(commandBuffer, {sortCount, 1});
+	}
+
+	// The live counts are read back on the host, and the instances and draw arguments are read by the particle subrender.
+	VkMemoryBarrier memoryBarrier = {};
+	memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+	memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+	memoryBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT | VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+	vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_HOST_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, 0, 1,
+		&memoryBarrier, 0, nullptr, 0, nullptr);
+
+	commandBuffer.SubmitIdle();
+
+	for (auto &[type, pool] : pools) {
+		ComputeCounters *counters;
+		pool->counters.MapMemory(reinterpret_cast<void **>(&counters));
+		pool->aliveCount = static_cast<uint32_t>(counters->alive);
+		pool->counters.UnmapMemory();
+		pool->emitCount = 0;
+	}
+}
+
+void ParticleCompute::Clear() {
+	for (auto &[type, pool] : pools)
+		retiredPools.emplace_back(std::move(pool));
+	pools.clear();
+}
+}
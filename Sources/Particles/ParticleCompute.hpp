@@ -0,0 +1,138 @@
+#pragma once
+
+#include <map>
+#include <optional>
+
+#include "Graphics/Buffers/PushHandler.hpp"
+#include "Graphics/Buffers/StorageBuffer.hpp"
+#include "Graphics/Commands/CommandBuffer.hpp"
+#include "Graphics/Descriptors/DescriptorsHandler.hpp"
+#include "Graphics/Pipelines/PipelineCompute.hpp"
+#include "Maths/Matrix4.hpp"
+#include "Maths/Vector3.hpp"
+
+namespace acid {
+class ParticlePool;
+class ParticleType;
+
+/**
+ * @brief Simulates particles with compute shaders, the CPU only uploads the particles emitted each update.
+ * Each particle type owns a fixed number of slots on the device. Spawning, integrating, killing, sorting by depth and building the instances
+ * and indirect draw arguments all run in compute passes.
+ */
+class ACID_EXPORT ParticleCompute {
+public:
+	/// The amount of particle slots of each type, a power of two so the bitonic sort needs no padding past it.
+	constexpr static uint32_t Capacity = 65536;
+
+	/**
+	 * @brief The device buffers of one particle type.
+	 */
+	class Pool {
+		friend class ParticleCompute;
+	public:
+		Pool(const ParticleCompute &compute, const ParticleType &type);
+
+		const StorageBuffer &GetInstances() const { return frames[frame]->instances; }
+		const StorageBuffer &GetIndirect() const { return frames[frame]->indirect; }
+		/**
+		 * Gets the amount of live particles, as of the last update.
+		 * @return The amount of live particles.
+		 */
+		uint32_t GetAliveCount() const { return aliveCount; }
+
+	private:
+		/**
+		 * @brief The instances and draw arguments built for a frame, the frames in flight draw from their own while the next is built.
+		 */
+		class Frame {
+		public:
+			Frame(const ParticleCompute &compute, uint32_t indexCount);
+
+			/**
+			 * Gets if no frame on the device can still be drawing from this frame.
+			 * @return If the frame can be built into again.
+			 */
+			bool IsFree() const;
+
+			StorageBuffer instances;
+			StorageBuffer indirect;
+			DescriptorsHandler buildDescriptors;
+			/// The number of the graphics frame last given these instances to draw.
+			std::optional<uint64_t> drawFrame;
+		};
+
+		/**
+		 * Picks the frame the next update builds into, adding one if every frame is still being drawn from.
+		 * @param compute The compute backend the pool belongs to.
+		 */
+		void NextFrame(const ParticleCompute &compute);
+
+		/**
+		 * Gets if no frame on the device can still be drawing from this pool, so it can be destroyed.
+		 * @return If the pool is free.
+		 */
+		bool IsFree() const;
+
+		StorageBuffer counters;
+		StorageBuffer particles;
+		StorageBuffer deadList;
+		StorageBuffer emitRequests;
+		StorageBuffer sortKeys;
+
+		// Each pass binds its own descriptor set, they are all recorded into the same command buffer.
+		DescriptorsHandler emitDescriptors;
+		DescriptorsHandler simulateDescriptors;
+		DescriptorsHandler sortDescriptors;
+
+		std::vector<std::unique_ptr<Frame>> frames;
+		std::size_t frame = 0;
+		uint32_t indexCount;
+
+		uint32_t aliveCount = 0;
+		uint32_t emitCount = 0;
+	};
+
+	using PoolsContainer = std::map<std::shared_ptr<ParticleType>, std::unique_ptr<Pool>>;
+
+	ParticleCompute();
+	~ParticleCompute();
+
+	/**
+	 * Queues the particles of a pool to be spawned on the device in the next update, particles past the free slots of the type are dropped.
+	 * @param type The particle type.
+	 * @param pool The particles to spawn, with their starting values.
+	 */
+	void Emit(const std::shared_ptr<ParticleType> &type, const ParticlePool &pool);
+
+	/**
+	 * Runs the compute passes of every particle type, and waits for them to finish.
+	 * @param delta The seconds since the last update.
+	 * @param cameraPosition The position distances to the camera are measured from.
+	 * @param viewMatrix The view matrix particles are billboarded to.
+	 */
+	void Update(float delta, const Vector3f &cameraPosition, const Matrix4 &viewMatrix);
+
+	/**
+	 * Clears all particles from the device, their buffers are kept until the frames drawing them have finished.
+	 */
+	void Clear();
+
+	const PoolsContainer &GetPools() const { return pools; }
+
+private:
+	PipelineCompute emitPipeline;
+	PipelineCompute simulatePipeline;
+	PipelineCompute sortPipeline;
+	PipelineCompute buildPipeline;
+
+	PushHandler simulatePush;
+	PushHandler sortPush;
+	PushHandler buildPush;
+
+	CommandBuffer commandBuffer;
+	PoolsContainer pools;
+	// Pools that were emptied or cleared, destroyed once no frame in flight draws from them.
+	std::vector<std::unique_ptr<Pool>> retiredPools;
+};
+}
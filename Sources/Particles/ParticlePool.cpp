@@ -0,0 +1,180 @@
+#include "ParticlePool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <numeric>
+
+#include "Utils/ThreadPool.hpp"
+
+namespace acid {
+// The kernels take restricted pointers offset to the first particle of the range, so the compiler knows the arrays never overlap and
+// can vectorize the branchless loops without runtime aliasing checks.
+static void Integrate(std::size_t count, float delta, Vector3f cameraPosition, float *__restrict px, float *__restrict py, float *__restrict pz,
+	float *__restrict vx, float *__restrict vy, float *__restrict vz, const float *__restrict life, const float *__restrict gravity,
+	float *__restrict elapsed, float *__restrict alpha, float *__restrict distance) {
+	auto gravityDelta = -10.0f * delta;
+
+	for (std::size_t i = 0; i < count; i++) {
+		vy[i] += gravityDelta * gravity[i];
+		px[i] += vx[i] * delta;
+		py[i] += vy[i] * delta;
+		pz[i] += vz[i] * delta;
+		elapsed[i] += delta;
+		// Fades out over the last second of life, particles living less than a second fade out over the first second instead.
+		alpha[i] = std::min((std::max(life[i], ParticlePool::FadeTime) - elapsed[i]) / ParticlePool::FadeTime, 1.0f);
+
+		auto dx = cameraPosition.x - px[i];
+		auto dy = cameraPosition.y - py[i];
+		auto dz = cameraPosition.z - pz[i];
+		distance[i] = dx * dx + dy * dy + dz * dz;
+	}
+}
+
+static void UpdateAtlas(std::size_t count, uint32_t atlasRows, const float *__restrict cycles, const float *__restrict life,
+	const float *__restrict elapsed, float *__restrict blend, Vector4f *__restrict offsets) {
+	// Stages are whole floats that are never negative, so truncating conversions stand in for floor and the loop needs no integer division.
+	auto rows = static_cast<float>(atlasRows);
+	auto stageCount = rows * rows;
+
+	for (std::size_t i = 0; i < count; i++) {
+		auto progression = cycles[i] * elapsed[i] / life[i] * stageCount;
+		auto stage1 = static_cast<float>(static_cast<int32_t>(progression));
+		blend[i] = progression - stage1;
+
+		// Wraps into the current cycle, the last stage of a cycle holds instead of blending into the next.
+		stage1 -= static_cast<float>(static_cast<int32_t>(stage1 / stageCount)) * stageCount;
+		auto stage2 = std::min(stage1 + 1.0f, stageCount - 1.0f);
+		auto row1 = static_cast<float>(static_cast<int32_t>(stage1 / rows));
+		auto row2 = static_cast<float>(static_cast<int32_t>(stage2 / rows));
+
+		offsets[i] = {(stage1 - row1 * rows) / rows, row1 / rows, (stage2 - row2 * rows) / rows, row2 / rows};
+	}
+}
+
+void ParticlePool::Add(const Vector3f &position, const Vector3f &velocity, float lifeLength, float stageCycles, float rotation, float scale,
+	float gravityEffect) {
+	positionX.emplace_back(position.x);
+	positionY.emplace_back(position.y);
+	positionZ.emplace_back(position.z);
+	velocityX.emplace_back(velocity.x);
+	velocityY.emplace_back(velocity.y);
+	velocityZ.emplace_back(velocity.z);
+	this->lifeLength.emplace_back(lifeLength);
+	this->stageCycles.emplace_back(stageCycles);
+	this->rotation.emplace_back(rotation);
+	this->scale.emplace_back(scale);
+	this->gravityEffect.emplace_back(gravityEffect);
+	elapsedTime.emplace_back(0.0f);
+	transparency.emplace_back(1.0f);
+	imageBlendFactor.emplace_back(0.0f);
+	imageOffsets.emplace_back();
+	distanceToCamera.emplace_back(0.0f);
+}
+
+ParticlePool::Batch ParticlePool::Append(std::size_t count) {
+	auto begin = GetSize();
+	auto grow = [begin, count](std::vector<float> &values, float value) {
+		values.resize(begin + count, value);
+		return Span<float>(values.data() + begin, count);
+	};
+
+	Batch batch;
+	batch.positionX = grow(positionX, 0.0f);
+	batch.positionY = grow(positionY, 0.0f);
+	batch.positionZ = grow(positionZ, 0.0f);
+	batch.velocityX = grow(velocityX, 0.0f);
+	batch.velocityY = grow(velocityY, 0.0f);
+	batch.velocityZ = grow(velocityZ, 0.0f);
+	batch.lifeLength = grow(lifeLength, 0.0f);
+	batch.stageCycles = grow(stageCycles, 0.0f);
+	batch.rotation = grow(rotation, 0.0f);
+	batch.scale = grow(scale, 0.0f);
+	batch.gravityEffect = grow(gravityEffect, 0.0f);
+	grow(elapsedTime, 0.0f);
+	grow(transparency, 1.0f);
+	grow(imageBlendFactor, 0.0f);
+	grow(distanceToCamera, 0.0f);
+	imageOffsets.resize(begin + count);
+	return batch;
+}
+
+void ParticlePool::Update(float delta, const Vector3f &cameraPosition, uint32_t atlasRows, ThreadPool *threadPool) {
+	auto update = [&](std::size_t begin, std::size_t end) {
+		Integrate(end - begin, delta, cameraPosition, &positionX[begin], &positionY[begin], &positionZ[begin], &velocityX[begin], &velocityY[begin],
+			&velocityZ[begin], &lifeLength[begin], &gravityEffect[begin], &elapsedTime[begin], &transparency[begin], &distanceToCamera[begin]);
+		if (atlasRows != 0)
+			UpdateAtlas(end - begin, atlasRows, &stageCycles[begin], &lifeLength[begin], &elapsedTime[begin], &imageBlendFactor[begin], &imageOffsets[begin]);
+	};
+
+	if (threadPool)
+		threadPool->ParallelFor(GetSize(), GrainSize, update);
+	else if (!IsEmpty())
+		update(0, GetSize());
+
+	for (std::size_t i = 0; i < GetSize();) {
+		if (transparency[i] > 0.0f) {
+			i++;
+			continue;
+		}
+
+		// The moved particle is checked again, it lands in the slot being looked at.
+		Remove(i);
+	}
+}
+
+void ParticlePool::SortByDistance(std::vector<uint32_t> &indices, std::vector<uint32_t> &scratch) const {
+	auto key = [this](uint32_t index) {
+		// Squared distances are never negative so their bits order like the floats do, the top half keeps the exponent and 7 bits of mantissa.
+		uint32_t bits;
+		std::memcpy(&bits, &distanceToCamera[index], sizeof(float));
+		return 0xFFFFu - (bits >> 16);
+	};
+
+	scratch.resize(indices.size());
+
+	for (uint32_t shift : {0u, 8u}) {
+		std::array<uint32_t, 257> offsets = {};
+		for (auto index : indices)
+			offsets[((key(index) >> shift) & 0xFF) + 1]++;
+		std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+		for (auto index : indices)
+			scratch[offsets[(key(index) >> shift) & 0xFF]++] = index;
+		indices.swap(scratch);
+	}
+}
+
+void ParticlePool::Remove(std::size_t index) {
+	auto swapPop = [index](auto &values) {
+		values[index] = values.back();
+		values.pop_back();
+	};
+
+	swapPop(positionX);
+	swapPop(positionY);
+	swapPop(positionZ);
+	swapPop(velocityX);
+	swapPop(velocityY);
+	swapPop(velocityZ);
+	swapPop(lifeLength);
+	swapPop(stageCycles);
+	swapPop(rotation);
+	swapPop(scale);
+	swapPop(gravityEffect);
+	swapPop(elapsedTime);
+	swapPop(transparency);
+	swapPop(imageBlendFactor);
+	swapPop(imageOffsets);
+	swapPop(distanceToCamera);
+}
+
+void ParticlePool::Clear() {
+	for (auto values : {&positionX, &positionY, &positionZ, &velocityX, &velocityY, &velocityZ, &lifeLength, &stageCycles, &rotation, &scale,
+		&gravityEffect, &elapsedTime, &transparency, &imageBlendFactor, &distanceToCamera}) {
+		values->clear();
+	}
+	imageOffsets.clear();
+}
+
+}
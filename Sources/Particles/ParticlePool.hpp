@@ -0,0 +1,121 @@
+#pragma once
+
+#include <vector>
+
+#include "Maths/Vector3.hpp"
+#include "Maths/Vector4.hpp"
+#include "Utils/Span.hpp"
+
+namespace acid {
+class ThreadPool;
+
+/**
+ * @brief The live particles of one type, stored as a structure of arrays so the update kernel runs over plain float arrays.
+ * Dead particles are removed by moving the last particle into their slot, so the order of particles is not kept.
+ */
+class ACID_EXPORT ParticlePool {
+public:
+	/// The seconds a particle takes to fade out at the end of its life.
+	constexpr static float FadeTime = 1.0f;
+	/// The amount of particles in each chunk of a parallel update.
+	constexpr static std::size_t GrainSize = 16384;
+
+	/**
+	 * @brief The starting values of a batch of particles appended to the pool, written straight into the pools arrays.
+	 * The spans are invalidated when the pool next grows.
+	 */
+	class Batch {
+	public:
+		Span<float> positionX, positionY, positionZ;
+		Span<float> velocityX, velocityY, velocityZ;
+		Span<float> lifeLength;
+		Span<float> stageCycles;
+		Span<float> rotation;
+		Span<float> scale;
+		Span<float> gravityEffect;
+	};
+
+	/**
+	 * Adds a particle to the end of the pool.
+	 * @param position The particles initial position.
+	 * @param velocity The particles initial velocity.
+	 * @param lifeLength The particles life length.
+	 * @param stageCycles The amount of times atlas stages will be shown.
+	 * @param rotation The particles rotation.
+	 * @param scale The particles scale.
+	 * @param gravityEffect The particles gravity effect.
+	 */
+	void Add(const Vector3f &position, const Vector3f &velocity, float lifeLength, float stageCycles, float rotation, float scale, float gravityEffect);
+
+	/**
+	 * Adds a batch of particles to the end of the pool, their starting values are left for the caller to write.
+	 * @param count The amount of particles to add.
+	 * @return The starting values of the added particles.
+	 */
+	Batch Append(std::size_t count);
+
+	/**
+	 * Integrates, ages and fades every particle, then removes the particles that have faded out.
+	 * @param delta The seconds since the last update.
+	 * @param cameraPosition The position distances to the camera are measured from.
+	 * @param atlasRows The amount of rows in the types image atlas, zero skips atlas offsets.
+	 * @param threadPool The pool large updates are split across, or null to update on the calling thread.
+	 */
+	void Update(float delta, const Vector3f &cameraPosition, uint32_t atlasRows, ThreadPool *threadPool = nullptr);
+
+	/**
+	 * Removes a particle by moving the last particle into its slot.
+	 * @param index The index of the particle.
+	 */
+	void Remove(std::size_t index);
+	void Clear();
+
+	/**
+	 * Sorts particle indices by distance to the camera, furthest first. Distances are quantized to 16-bit keys and ordered with a two pass radix sort,
+	 * so the cost grows linearly with the amount of indices. Particles with equal keys keep their relative order.
+	 * @param indices The indices of the particles to sort, usually only the particles that passed culling.
+	 * @param scratch Storage the sort ping pongs through, kept by the caller so it is reused between sorts.
+	 */
+	void SortByDistance(std::vector<uint32_t> &indices, std::vector<uint32_t> &scratch) const;
+
+	std::size_t GetSize() const { return positionX.size(); }
+	bool IsEmpty() const { return positionX.empty(); }
+
+	Vector3f GetPosition(std::size_t index) const { return {positionX[index], positionY[index], positionZ[index]}; }
+	Vector3f GetVelocity(std::size_t index) const { return {velocityX[index], velocityY[index], velocityZ[index]}; }
+	float GetLifeLength(std::size_t index) const { return lifeLength[index]; }
+	float GetStageCycles(std::size_t index) const { return stageCycles[index]; }
+	float GetRotation(std::size_t index) const { return rotation[index]; }
+	float GetScale(std::size_t index) const { return scale[index]; }
+	float GetGravityEffect(std::size_t index) const { return gravityEffect[index]; }
+	float GetElapsedTime(std::size_t index) const { return elapsedTime[index]; }
+	float GetTransparency(std::size_t index) const { return transparency[index]; }
+	float GetImageBlendFactor(std::size_t index) const { return imageBlendFactor[index]; }
+	/**
+	 * Gets the offsets of the two atlas stages a particle blends between.
+	 * @param index The index of the particle.
+	 * @return The first offset in x and y, and the second in z and w.
+	 */
+	const Vector4f &GetImageOffsets(std::size_t index) const { return imageOffsets[index]; }
+	/**
+	 * Gets the squared distance from a particle to the camera, as of the last update.
+	 * @param index The index of the particle.
+	 * @return The squared distance.
+	 */
+	float GetDistanceToCamera(std::size_t index) const { return distanceToCamera[index]; }
+
+private:
+	std::vector<float> positionX, positionY, positionZ;
+	std::vector<float> velocityX, velocityY, velocityZ;
+	std::vector<float> lifeLength;
+	std::vector<float> stageCycles;
+	std::vector<float> rotation;
+	std::vector<float> scale;
+	std::vector<float> gravityEffect;
+	std::vector<float> elapsedTime;
+	std::vector<float> transparency;
+	std::vector<float> imageBlendFactor;
+	std::vector<Vector4f> imageOffsets;
+	std::vector<float> distanceToCamera;
+};
+}
@@ -1,5 +1,7 @@
 #include "ParticleSystem.hpp"
 
+#include <algorithm>
+
 #include "Maths/Maths.hpp"
 #include "Maths/Transform.hpp"
 #include "Scenes/Entity.hpp"
@@ -26,11 +28,23 @@ void ParticleSystem::Update() {
 
 	elapsedEmit.SetInterval(Time::Seconds(1.0f / pps));
 
-	if (auto elapsed = elapsedEmit.GetElapsed(); elapsed && !emitters.empty()) {
-		for (uint32_t i = 0; i < elapsed; i++) {
-			auto emitterIndex = static_cast<uint32_t>(Maths::Random(0.0f, static_cast<float>(emitters.size())));
-			Scenes::Get()->GetScene()->GetSystem<Particles>()->AddParticle(EmitParticle(emitters[emitterIndex].get()));
-		}
+	auto elapsed = elapsedEmit.GetElapsed();
+	if (elapsed == 0 || emitters.empty())
+		return;
+
+	Vector3f offset;
+	if (auto transform = GetEntity()->GetComponent<Transform>())
+		offset = transform->GetPosition();
+
+	// Particles are counted out to their types first, so each type is looked up and grown once for the whole batch.
+	typeCounts.assign(types.size(), 0);
+	for (uint32_t i = 0; i < elapsed; i++)
+		typeCounts[std::min(static_cast<std::size_t>(Maths::Random(0.0f, static_cast<float>(types.size()))), types.size() - 1)]++;
+
+	auto particles = Scenes::Get()->GetScene()->GetSystem<Particles>();
+	for (std::size_t i = 0; i < types.size(); i++) {
+		if (typeCounts[i] != 0)
+			Emit(particles->GetPool(types[i]), *types[i], typeCounts[i], offset);
 	}
 }
 
@@ -57,28 +71,9 @@ void ParticleSystem::AddEmitter(std::unique_ptr<Emitter> &&emitter) {
 }
 
 Vector3f ParticleSystem::RandomUnitVectorWithinCone(const Vector3f &coneDirection, float angle) const {
-	auto cosAngle = std::cos(angle);
-	auto theta = Maths::Random(0.0f, 1.0f) * 2.0f * Maths::PI<float>;
-	auto z = (cosAngle + Maths::Random(0.0f, 1.0f)) * (1.0f - cosAngle);
-	auto rootOneMinusZSquared = std::sqrt(1.0f - z * z);
-	auto x = rootOneMinusZSquared * std::cos(theta);
-	auto y = rootOneMinusZSquared * std::sin(theta);
-
-	Vector4f direction(x, y, z, 1.0f);
-
-	if (coneDirection.x != 0.0f || coneDirection.y != 0.0f || (coneDirection.z != 1.0f && coneDirection.z != -1.0f)) {
-		auto rotateAxis = coneDirection.Cross(Vector3f::Front);
-		rotateAxis.Normalize();
-		auto rotateAngle = std::acos(coneDirection.Dot(Vector3f::Front));
-
-		Matrix4 rotationMatrix;
-		rotationMatrix = rotationMatrix.Rotate(-rotateAngle, rotateAxis);
-		direction = rotationMatrix.Transform(direction);
-	} else if (coneDirection.z == -1.0f) {
-		direction.z *= -1.0f;
-	}
-
-	return {direction};
+	Vector3f direction;
+	Emitter::RandomUnitVectorsWithinCone(coneDirection, angle, {&direction, 1});
+	return direction;
 }
 
 void ParticleSystem::SetPps(float pps) {
@@ -90,28 +85,39 @@ void ParticleSystem::SetDirection(const Vector3f &direction, float deviation) {
 	directionDeviation = deviation * Maths::PI<float>;
 }
 
-Particle ParticleSystem::EmitParticle(const Emitter *emitter) {
-	auto spawnPos = emitter->GeneratePosition();
-
-	if (auto transform = GetEntity()->GetComponent<Transform>())
-		spawnPos += transform->GetPosition();
+void ParticleSystem::Emit(ParticlePool &pool, const ParticleType &type, uint32_t count, const Vector3f &offset) {
+	// Each emitter generates all of its positions in one call.
+	emitterCounts.assign(emitters.size(), 0);
+	for (uint32_t i = 0; i < count; i++)
+		emitterCounts[std::min(static_cast<std::size_t>(Maths::Random(0.0f, static_cast<float>(emitters.size()))), emitters.size() - 1)]++;
 
-	Vector3f velocity;
+	positions.resize(count);
+	for (std::size_t i = 0, first = 0; i < emitters.size(); first += emitterCounts[i], i++)
+		emitters[i]->GeneratePositions({positions.data() + first, emitterCounts[i]});
 
+	directions.resize(count);
 	if (direction != Vector3f::Zero) {
-		velocity = RandomUnitVectorWithinCone(direction, directionDeviation);
+		Emitter::RandomUnitVectorsWithinCone(direction, directionDeviation, directions);
 	} else {
-		velocity = GenerateRandomUnitVector();
+		for (auto &unitVector : directions)
+			unitVector = Emitter::RandomUnitVector();
 	}
 
-	velocity = velocity.Normalize();
-	velocity *= GenerateValue(averageSpeed, speedDeviation);
-
-	auto emitType = types.at(static_cast<uint32_t>(std::floor(Maths::Random(0.0f, static_cast<float>(types.size())))));
-	auto scale = GenerateValue(emitType->GetScale(), scaleDeviation);
-	auto lifeLength = GenerateValue(emitType->GetLifeLength(), lifeDeviation);
-	auto stageCycles = GenerateValue(emitType->GetStageCycles(), stageDeviation);
-	return {emitType, spawnPos, velocity, lifeLength, stageCycles, GenerateRotation(), scale, gravityEffect};
+	auto batch = pool.Append(count);
+	for (uint32_t i = 0; i < count; i++) {
+		auto velocity = directions[i] * GenerateValue(averageSpeed, speedDeviation);
+		batch.positionX[i] = positions[i].x + offset.x;
+		batch.positionY[i] = positions[i].y + offset.y;
+		batch.positionZ[i] = positions[i].z + offset.z;
+		batch.velocityX[i] = velocity.x;
+		batch.velocityY[i] = velocity.y;
+		batch.velocityZ[i] = velocity.z;
+		batch.lifeLength[i] = GenerateValue(type.GetLifeLength(), lifeDeviation);
+		batch.stageCycles[i] = GenerateValue(type.GetStageCycles(), stageDeviation);
+		batch.rotation[i] = GenerateRotation();
+		batch.scale[i] = GenerateValue(type.GetScale(), scaleDeviation);
+		batch.gravityEffect[i] = gravityEffect;
+	}
 }
 
 float ParticleSystem::GenerateValue(float average, float errorPercent) {
@@ -126,15 +132,6 @@ float ParticleSystem::GenerateRotation() const {
 	return 0.0f;
 }
 
-Vector3f ParticleSystem::GenerateRandomUnitVector() const {
-	auto theta = Maths::Random(0.0f, 1.0f) * 2.0f * Maths::PI<float>;
-	auto z = Maths::Random(0.0f, 1.0f) * 2.0f - 1.0f;
-	auto rootOneMinusZSquared = std::sqrt(1.0f - z * z);
-	auto x = rootOneMinusZSquared * std::cos(theta);
-	auto y = rootOneMinusZSquared * std::sin(theta);
-	return {x, y, z};
-}
-
 const Node &operator>>(const Node &node, ParticleSystem &particleSystem) {
 	node["types"].Get(particleSystem.types);
 	node["emitters"].Get(particleSystem.emitters);
@@ -5,6 +5,7 @@
 #include "Scenes/Component.hpp"
 #include "Emitters/Emitter.hpp"
 #include "Particle.hpp"
+#include "ParticlePool.hpp"
 #include "ParticleType.hpp"
 
 namespace acid {
@@ -66,10 +67,16 @@ public:
 	friend Node &operator<<(Node &node, const ParticleSystem &particleSystem);
 
 private:
-	Particle EmitParticle(const Emitter *emitter);
+	/**
+	 * Emits a batch of particles of one type straight into its pool.
+	 * @param pool The pool of the particle type.
+	 * @param type The particle type.
+	 * @param count The amount of particles to emit.
+	 * @param offset The position the emitters are placed at.
+	 */
+	void Emit(ParticlePool &pool, const ParticleType &type, uint32_t count, const Vector3f &offset);
 	static float GenerateValue(float average, float errorPercent);
 	float GenerateRotation() const;
-	Vector3f GenerateRandomUnitVector() const;
 
 	std::vector<std::shared_ptr<ParticleType>> types;
 	std::vector<std::unique_ptr<Emitter>> emitters;
@@ -87,5 +94,11 @@ private:
 	float scaleDeviation = 0.0f;
 
 	ElapsedTime elapsedEmit;
+
+	// Storage reused between emissions for the particles counted to each type and emitter, and their positions and directions.
+	std::vector<uint32_t> typeCounts;
+	std::vector<uint32_t> emitterCounts;
+	std::vector<Vector3f> positions;
+	std::vector<Vector3f> directions;
 };
 }
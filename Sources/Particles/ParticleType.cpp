@@ -1,14 +1,18 @@
 #include "ParticleType.hpp"
 
+#include "Graphics/Graphics.hpp"
 #include "Resources/Resources.hpp"
 #include "Maths/Maths.hpp"
 #include "Models/Shapes/RectangleModel.hpp"
 #include "Scenes/Scenes.hpp"
-#include "Particle.hpp"
+#include "Utils/ThreadPool.hpp"
+#include "ParticlePool.hpp"
 
 namespace acid {
-static const uint32_t MAX_INSTANCES = 1024;
-//static const uint32_t INSTANCE_STEPS = 128;
+static const uint32_t INSTANCE_STEPS = 128;
+// The amount of updates in a row the instance capacity has to be twice what is needed before it shrinks.
+static const uint32_t INSTANCE_SHRINK_DELAY = 300;
+static const std::size_t INSTANCE_GRAIN_SIZE = 4096;
 static const float FRUSTUM_BUFFER = 1.4f;
 
 std::shared_ptr<ParticleType> ParticleType::Create(const Node &node) {
@@ -23,15 +27,15 @@ std::shared_ptr<ParticleType> ParticleType::Create(const Node &node) {
 }
 
 std::shared_ptr<ParticleType> ParticleType::Create(const std::shared_ptr<Image2d> &image, uint32_t numberOfRows, const Colour &colourOffset, float lifeLength,
-	float stageCycles, float scale) {
-	ParticleType temp(image, numberOfRows, colourOffset, lifeLength, stageCycles, scale);
+	float stageCycles, float scale, SortMode sortMode) {
+	ParticleType temp(image, numberOfRows, colourOffset, lifeLength, stageCycles, scale, sortMode);
 	Node node;
 	node << temp;
 	return Create(node);
 }
 
 ParticleType::ParticleType(std::shared_ptr<Image2d> image, uint32_t numberOfRows, const Colour &colourOffset, float lifeLength, float stageCycles,
-	float scale) :
+	float scale, SortMode sortMode) :
 	image(std::move(image)),
 	model(RectangleModel::Create(-0.5f, 0.5f)),
 	numberOfRows(numberOfRows),
@@ -39,51 +43,58 @@ ParticleType::ParticleType(std::shared_ptr<Image2d> image, uint32_t numberOfRows
 	lifeLength(lifeLength),
 	stageCycles(stageCycles),
 	scale(scale),
-	instanceBuffer(sizeof(Instance) * MAX_INSTANCES) {
+	sortMode(sortMode),
+	maxInstances(INSTANCE_STEPS),
+	instanceBuffer(std::make_unique<InstanceBuffer>(sizeof(Instance) * maxInstances)) {
 }
 
-void ParticleType::Update(const std::vector<Particle> &particles) {
-	// Calculates a max instance count over the time of the type. TODO: Allow decreasing max using a timer and average count over the delay.
-	//uint32_t instances = INSTANCE_STEPS * static_cast<uint32_t>(std::ceil(static_cast<float>(particles.size()) / static_cast<float>(INSTANCE_STEPS)));
-	//maxInstances = std::max(maxInstances, instances);
-	maxInstances = MAX_INSTANCES;
-	this->instances = 0;
+void ParticleType::Update(const ParticlePool &pool, ThreadPool *threadPool) {
+	instances = 0;
 
-	if (particles.empty())
+	auto camera = Scenes::Get()->GetScene()->GetCamera();
+	if (pool.IsEmpty() || !camera)
 		return;
 
-	Instance *instances;
-	instanceBuffer.MapMemory(reinterpret_cast<void **>(&instances));
+	// Camera values are read once, every instance is built from them.
+	auto &viewMatrix = camera->GetViewMatrix();
+	auto &frustum = camera->GetViewFrustum();
 
-	for (const auto &particle : particles) {
-		if (this->instances >= maxInstances)
-			break;
+	// Culls before sorting, so only the particles that will be drawn are sorted.
+	drawOrder.clear();
+	for (uint32_t index = 0; index < pool.GetSize(); index++) {
+		if (frustum.SphereInFrustum(pool.GetPosition(index), FRUSTUM_BUFFER * pool.GetScale(index)))
+			drawOrder.emplace_back(index);
+	}
 
-		if (!Scenes::Get()->GetScene()->GetCamera()->GetViewFrustum().SphereInFrustum(particle.GetPosition(), FRUSTUM_BUFFER * particle.GetScale())) {
-			continue;
-		}
+	if (sortMode == SortMode::BackToFront)
+		pool.SortByDistance(drawOrder, sortScratch);
 
-		auto viewMatrix = Scenes::Get()->GetScene()->GetCamera()->GetViewMatrix();
-		auto instance = &instances[this->instances];
-		instance->modelMatrix = Matrix4().Translate(particle.GetPosition());
+	ReserveInstances(static_cast<uint32_t>(drawOrder.size()));
+	instances = static_cast<uint32_t>(drawOrder.size());
+	if (instances == 0)
+		return;
 
-		for (uint32_t row = 0; row < 3; row++) {
-			for (uint32_t col = 0; col < 3; col++) {
-				instance->modelMatrix[row][col] = viewMatrix[col][row];
-			}
+	Instance *instanceData;
+	instanceBuffer->MapMemory(reinterpret_cast<void **>(&instanceData));
+
+	// Each chunk writes its own range of the mapped buffer.
+	auto write = [&](std::size_t begin, std::size_t end) {
+		for (auto i = begin; i < end; i++) {
+			auto index = drawOrder[i];
+			auto &instance = instanceData[i];
+			instance.modelMatrix = Matrix4::BillboardMatrix(viewMatrix, pool.GetPosition(index), pool.GetRotation(index), pool.GetScale(index));
+			instance.colourOffset = colourOffset;
+			instance.offsets = pool.GetImageOffsets(index);
+			instance.blend = {pool.GetImageBlendFactor(index), pool.GetTransparency(index), static_cast<float>(numberOfRows)};
 		}
+	};
 
-		instance->modelMatrix = instance->modelMatrix.Rotate(particle.GetRotation(), Vector3f::Front);
-		instance->modelMatrix = instance->modelMatrix.Scale(Vector3f(particle.GetScale()));
-		// TODO: Multiply MVP by View and Projection (And run update every frame?)
+	if (threadPool)
+		threadPool->ParallelFor(instances, INSTANCE_GRAIN_SIZE, write);
+	else
+		write(0, instances);
 
-		instance->colourOffset = particle.GetParticleType()->colourOffset;
-		instance->offsets = {particle.imageOffset1, particle.imageOffset2};
-		instance->blend = {particle.imageBlendFactor, particle.transparency, static_cast<float>(particle.particleType->numberOfRows)};
-		instances++;
-	}
-
-	instanceBuffer.UnmapMemory();
+	instanceBuffer->UnmapMemory();
 }
 
 bool ParticleType::CmdRender(const CommandBuffer &commandBuffer, const PipelineGraphics &pipeline, UniformHandler &uniformScene) {
@@ -99,7 +110,7 @@ bool ParticleType::CmdRender(const CommandBuffer &commandBuffer, const PipelineG
 	// Draws the instanced objects.
 	descriptorSet.BindDescriptor(commandBuffer, pipeline);
 
-	VkBuffer vertexBuffers[2] = {model->GetVertexBuffer()->GetBuffer(), instanceBuffer.GetBuffer()};
+	VkBuffer vertexBuffers[2] = {model->GetVertexBuffer()->GetBuffer(), instanceBuffer->GetBuffer()};
 	VkDeviceSize offsets[2] = {0, 0};
 	vkCmdBindVertexBuffers(commandBuffer, 0, 2, vertexBuffers, offsets);
 	vkCmdBindIndexBuffer(commandBuffer, model->GetIndexBuffer()->GetBuffer(), 0, model->GetIndexType());
@@ -107,6 +118,55 @@ bool ParticleType::CmdRender(const CommandBuffer &commandBuffer, const PipelineG
 	return true;
 }
 
+bool ParticleType::CmdRenderIndirect(const CommandBuffer &commandBuffer, const PipelineGraphics &pipeline, UniformHandler &uniformScene,
+	const Buffer &instances, const Buffer &indirect) {
+	// Updates descriptors.
+	descriptorSet.Push("UniformScene", uniformScene);
+	descriptorSet.Push("samplerColour", image);
+
+	if (!descriptorSet.Update(pipeline))
+		return false;
+
+	// Draws the instanced objects, a draw of no instances is skipped by the device.
+	descriptorSet.BindDescriptor(commandBuffer, pipeline);
+
+	VkBuffer vertexBuffers[2] = {model->GetVertexBuffer()->GetBuffer(), instances.GetBuffer()};
+	VkDeviceSize offsets[2] = {0, 0};
+	vkCmdBindVertexBuffers(commandBuffer, 0, 2, vertexBuffers, offsets);
+	vkCmdBindIndexBuffer(commandBuffer, model->GetIndexBuffer()->GetBuffer(), 0, model->GetIndexType());
+	vkCmdDrawIndexedIndirect(commandBuffer, indirect.GetBuffer(), 0, 1, sizeof(VkDrawIndexedIndirectCommand));
+	return true;
+}
+
+void ParticleType::ReserveInstances(uint32_t count) {
+	auto graphics = Graphics::Get();
+	retiredInstanceBuffers.erase(std::remove_if(retiredInstanceBuffers.begin(), retiredInstanceBuffers.end(), [graphics](const auto &retired) {
+		return graphics->IsFrameComplete(retired.first);
+	}), retiredInstanceBuffers.end());
+
+	auto required = INSTANCE_STEPS * std::max((count + INSTANCE_STEPS - 1) / INSTANCE_STEPS, 1u);
+
+	if (required > maxInstances) {
+		maxInstances = required;
+	} else if (required * 2 <= maxInstances) {
+		// Shrinks to the most that was needed while underused, so a count that swings back and forth does not reallocate every time.
+		peakInstances = std::max(peakInstances, required);
+		if (++underusedUpdates < INSTANCE_SHRINK_DELAY)
+			return;
+		maxInstances = peakInstances;
+	} else {
+		underusedUpdates = 0;
+		peakInstances = 0;
+		return;
+	}
+
+	underusedUpdates = 0;
+	peakInstances = 0;
+	// Frames in flight may still be drawing from the old buffer.
+	retiredInstanceBuffers.emplace_back(graphics->GetFrameNumber(), std::move(instanceBuffer));
+	instanceBuffer = std::make_unique<InstanceBuffer>(sizeof(Instance) * maxInstances);
+}
+
 const Node &operator>>(const Node &node, ParticleType &particleType) {
 	node["image"].Get(particleType.image);
 	node["numberOfRows"].Get(particleType.numberOfRows);
@@ -114,6 +174,7 @@ const Node &operator>>(const Node &node, ParticleType &particleType) {
 	node["lifeLength"].Get(particleType.lifeLength);
 	node["stageCycles"].Get(particleType.stageCycles);
 	node["scale"].Get(particleType.scale);
+	node["sortMode"].Get(particleType.sortMode);
 	return node;
 }
 
@@ -124,6 +185,7 @@ Node &operator<<(Node &node, const ParticleType &particleType) {
 	node["lifeLength"].Set(particleType.lifeLength);
 	node["stageCycles"].Set(particleType.stageCycles);
 	node["scale"].Set(particleType.scale);
+	node["sortMode"].Set(particleType.sortMode);
 	return node;
 }
 }
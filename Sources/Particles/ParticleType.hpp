@@ -12,13 +12,24 @@
 #include "Resources/Resource.hpp"
 
 namespace acid {
-class Particle;
+class ParticlePool;
+class ThreadPool;
 
 /**
  * @brief Resource that represents a particle type.
  */
 class ACID_EXPORT ParticleType : public Resource {
 public:
+	/**
+	 * @brief The order particles of a type are drawn in.
+	 */
+	enum class SortMode {
+		/// Drawn in pool order, for blending that does not depend on order such as additive particles.
+		None,
+		/// Visible particles are drawn furthest from the camera first, for alpha blended particles.
+		BackToFront
+	};
+
 	class Instance {
 	public:
 		static Shader::VertexInput GetVertexInput(uint32_t baseBinding = 0) {
@@ -58,10 +69,11 @@ public:
 	 * @param lifeLength The averaged life length for the particle.
 	 * @param stageCycles The amount of times stages will be shown.
 	 * @param scale The averaged scale for the particle.
+	 * @param sortMode The order particles are drawn in.
 	 * @return The particle type with the requested values.
 	 */
 	static std::shared_ptr<ParticleType> Create(const std::shared_ptr<Image2d> &image, uint32_t numberOfRows = 1, const Colour &colourOffset = Colour::Black,
-		float lifeLength = 10.0f, float stageCycles = 1.0f, float scale = 1.0f);
+		float lifeLength = 10.0f, float stageCycles = 1.0f, float scale = 1.0f, SortMode sortMode = SortMode::BackToFront);
 
 	/**
 	 * Creates a new particle type.
@@ -71,16 +83,36 @@ public:
 	 * @param lifeLength The averaged life length for the particle.
 	 * @param stageCycles The amount of times stages will be shown.
 	 * @param scale The averaged scale for the particle.
+	 * @param sortMode The order particles are drawn in.
 	 */
 	explicit ParticleType(std::shared_ptr<Image2d> image, uint32_t numberOfRows = 1, const Colour &colourOffset = Colour::Black, float lifeLength = 10.0f,
-		float stageCycles = 1.0f, float scale = 1.0f);
+		float stageCycles = 1.0f, float scale = 1.0f, SortMode sortMode = SortMode::BackToFront);
 
-	void Update(const std::vector<Particle> &particles);
+	/**
+	 * Writes the visible particles of a pool into the instance buffer, in the order given by the sort mode.
+	 * @param pool The particles of this type.
+	 * @param threadPool The pool instance writes are split across, or null to write on the calling thread.
+	 */
+	void Update(const ParticlePool &pool, ThreadPool *threadPool = nullptr);
 
 	bool CmdRender(const CommandBuffer &commandBuffer, const PipelineGraphics &pipeline, UniformHandler &uniformScene);
 
+	/**
+	 * Draws instances built on the device, the amount drawn is read from the indirect draw arguments.
+	 * @param commandBuffer The command buffer to record into.
+	 * @param pipeline The particle pipeline.
+	 * @param uniformScene The scene uniforms.
+	 * @param instances The buffer of instances.
+	 * @param indirect The buffer holding one indexed indirect draw command.
+	 * @return If the draw was recorded.
+	 */
+	bool CmdRenderIndirect(const CommandBuffer &commandBuffer, const PipelineGraphics &pipeline, UniformHandler &uniformScene, const Buffer &instances,
+		const Buffer &indirect);
+
 	std::type_index GetTypeIndex() const override { return typeid(ParticleType); }
 
+	const std::shared_ptr<Model> &GetModel() const { return model; }
+
 	const std::shared_ptr<Image2d> &GetImage() const { return image; }
 	void SetImage(const std::shared_ptr<Image2d> &image) { this->image = image; }
 
@@ -99,10 +131,19 @@ public:
 	float GetScale() const { return scale; }
 	void SetScale(float scale) { this->scale = scale; }
 
+	SortMode GetSortMode() const { return sortMode; }
+	void SetSortMode(SortMode sortMode) { this->sortMode = sortMode; }
+
 	friend const Node &operator>>(const Node &node, ParticleType &particleType);
 	friend Node &operator<<(Node &node, const ParticleType &particleType);
 
 private:
+	/**
+	 * Grows the instance buffer in steps to fit a amount of instances, it shrinks only after being oversized for a while.
+	 * @param count The amount of instances to fit.
+	 */
+	void ReserveInstances(uint32_t count);
+
 	std::shared_ptr<Image2d> image;
 	std::shared_ptr<Model> model;
 	uint32_t numberOfRows;
@@ -110,11 +151,19 @@ private:
 	float lifeLength;
 	float stageCycles;
 	float scale;
+	SortMode sortMode;
 
-	uint32_t maxInstances = 0;
+	uint32_t maxInstances;
 	uint32_t instances = 0;
+	uint32_t peakInstances = 0;
+	uint32_t underusedUpdates = 0;
+	// Indices of the visible particles in the order they are drawn, kept between updates so their storage is reused.
+	std::vector<uint32_t> drawOrder;
+	std::vector<uint32_t> sortScratch;
 
 	DescriptorsHandler descriptorSet;
-	InstanceBuffer instanceBuffer;
+	std::unique_ptr<InstanceBuffer> instanceBuffer;
+	// Replaced instance buffers with the number of the frame they were replaced before, kept until that frame has finished drawing.
+	std::vector<std::pair<uint64_t, std::unique_ptr<InstanceBuffer>>> retiredInstanceBuffers;
 };
 }
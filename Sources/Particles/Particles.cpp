@@ -1,59 +1,68 @@
 #include "Particles.hpp"
 
 #include "Scenes/Scenes.hpp"
+#include "ParticleCompute.hpp"
 
 namespace acid {
 Particles::Particles() {
 }
 
+Particles::~Particles() = default;
+
 void Particles::Update() {
 	if (Scenes::Get()->GetScene()->IsPaused()) return;
 
-	for (auto it = particles.begin(); it != particles.end();) {
-		for (auto it1 = (*it).second.begin(); it1 != (*it).second.end();) {
-			(*it1).Update();
-
-			if (!(*it1).IsAlive()) {
-				it1 = (*it).second.erase(it1);
-				continue;
-			}
+	// Values shared by every particle are read once per update.
+	auto delta = Engine::Get()->GetDelta().AsSeconds();
+	auto camera = Scenes::Get()->GetScene()->GetCamera();
+	Vector3f cameraPosition;
+	if (camera)
+		cameraPosition = camera->GetPosition();
 
-			++it1;
+	if (compute) {
+		// Particles emitted since the last update are handed to the device, the pools are kept so their storage is reused.
+		for (auto &[type, pool] : particles) {
+			if (!pool.IsEmpty())
+				compute->Emit(type, pool);
+			pool.Clear();
 		}
 
-		if (it->second.empty()) {
+		compute->Update(delta, cameraPosition, camera ? camera->GetViewMatrix() : Matrix4());
+		return;
+	}
+
+	auto &threadPool = Engine::Get()->GetThreadPool();
+	for (auto it = particles.begin(); it != particles.end();) {
+		auto &[type, pool] = *it;
+		pool.Update(delta, cameraPosition, type->GetImage() ? type->GetNumberOfRows() : 0, &threadPool);
+
+		if (pool.IsEmpty()) {
 			it = particles.erase(it);
 			continue;
 		}
 
-		std::sort((*it).second.begin(), (*it).second.end());
-		(*it).first->Update((*it).second);
+		type->Update(pool, &threadPool);
 		++it;
 	}
 }
 
 void Particles::AddParticle(Particle &&particle) {
-	auto it = particles.find(particle.GetParticleType());
-
-	if (it == particles.end()) {
-		particles.emplace(particle.GetParticleType(), std::vector<Particle>());
-		it = particles.find(particle.GetParticleType());
-	}
-
-	(*it).second.emplace_back(std::move(particle));
+	auto &pool = particles[particle.GetParticleType()];
+	pool.Add(particle.GetPosition(), particle.GetVelocity(), particle.GetLifeLength(), particle.GetStageCycles(), particle.GetRotation(),
+		particle.GetScale(), particle.GetGravityEffect());
 }
 
-/*void Particles::RemoveParticle(const Particle &particle) {
-	auto it = particles.find(particle.GetParticleType());
-
-	if (it != particles.end()) {
-		it->second.erase(std::remove_if(it->second.begin(), it->second.end(), [particle](const auto &p) {
-			return p == particle;
-		}), it->second.end());
-	}
-}*/
-
 void Particles::Clear() {
 	particles.clear();
+	if (compute)
+		compute->Clear();
+}
+
+void Particles::SetBackend(Backend backend) {
+	if (GetBackend() == backend)
+		return;
+
+	Clear();
+	compute = backend == Backend::Compute ? std::make_unique<ParticleCompute>() : nullptr;
 }
 }
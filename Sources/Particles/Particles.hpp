@@ -2,21 +2,41 @@
 
 #include "Scenes/System.hpp"
 #include "Particle.hpp"
+#include "ParticlePool.hpp"
 
 namespace acid {
+class ParticleCompute;
+
 /**
- * @brief A manager that manages particles.
+ * @brief A manager that manages particles, each particle type owns a pool of its live particles.
  */
 class ACID_EXPORT Particles : public System {
 public:
-	using ParticlesContainer = std::map<std::shared_ptr<ParticleType>, std::vector<Particle>>;
+	using ParticlesContainer = std::map<std::shared_ptr<ParticleType>, ParticlePool>;
+
+	/**
+	 * @brief Where particles are simulated.
+	 */
+	enum class Backend {
+		/// Simulated in the pools and uploaded as instances every update, the reference for the compute backend.
+		Cpu,
+		/// Simulated in compute shaders, the pools only hold the particles emitted since the last update.
+		Compute
+	};
 
 	Particles();
+	~Particles();
 
 	void Update() override;
 
 	void AddParticle(Particle &&particle);
-	//void RemoveParticle(const Particle &particle);
+
+	/**
+	 * Gets the pool of a particle type, creating it if there is none, used to add particles in batches.
+	 * @param type The particle type.
+	 * @return The particle types pool.
+	 */
+	ParticlePool &GetPool(const std::shared_ptr<ParticleType> &type) { return particles[type]; }
 
 	/**
 	 * Clears all particles from the scene.
@@ -24,12 +44,26 @@ public:
 	void Clear();
 
 	/**
-	 * Gets a list of all particles.
+	 * Gets the particle pools of every type.
 	 * @return All particles.
 	 */
 	const ParticlesContainer &GetParticles() const { return particles; }
 
+	Backend GetBackend() const { return compute ? Backend::Compute : Backend::Cpu; }
+	/**
+	 * Sets where particles are simulated, the particles of the last backend are cleared.
+	 * @param backend The backend.
+	 */
+	void SetBackend(Backend backend);
+
+	/**
+	 * Gets the particles simulated on the device.
+	 * @return The compute backend, or null when simulating on the CPU.
+	 */
+	const ParticleCompute *GetCompute() const { return compute.get(); }
+
 private:
 	ParticlesContainer particles;
+	std::unique_ptr<ParticleCompute> compute;
 };
 }
@@ -2,6 +2,7 @@
 
 #include "Scenes/Scenes.hpp"
 #include "Models/Vertex3d.hpp"
+#include "ParticleCompute.hpp"
 #include "Particles.hpp"
 
 namespace acid {
@@ -22,9 +23,16 @@ void ParticlesSubrender::Render(const CommandBuffer &commandBuffer) {
 
 	pipeline.BindPipeline(commandBuffer);
 
-	auto &particles = Scenes::Get()->GetScene()->GetSystem<Particles>()->GetParticles();
+	auto particles = Scenes::Get()->GetScene()->GetSystem<Particles>();
 
-	for (auto &[type, typeParticles] : particles)
+	// Instances built by the compute backend are drawn with the counts it wrote on the device.
+	if (auto compute = particles->GetCompute()) {
+		for (auto &[type, pool] : compute->GetPools())
+			type->CmdRenderIndirect(commandBuffer, pipeline, uniformScene, pool->GetInstances(), pool->GetIndirect());
+		return;
+	}
+
+	for (auto &[type, typeParticles] : particles->GetParticles())
 		type->CmdRender(commandBuffer, pipeline, uniformScene);
 }
 }
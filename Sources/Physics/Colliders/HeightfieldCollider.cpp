@@ -22,6 +22,16 @@ void HeightfieldCollider::SetHeightfield(int32_t heightStickWidth, int32_t heigh
 	if (!heightfieldData) return;
 
 	shape = std::make_unique<btHeightfieldTerrainShape>(heightStickWidth, heightStickLength, heightfieldData, 1.0f, minHeight, maxHeight, 1, PHY_FLOAT, flipQuadEdges);
+	heights = nullptr;
+}
+
+void HeightfieldCollider::SetHeightfield(int32_t heightStickWidth, int32_t heightStickLength, std::shared_ptr<const float> heights, float minHeight,
+	float maxHeight, bool flipQuadEdges) {
+	if (!heights) return;
+
+	// The old shape is destroyed before the heights it reads are released.
+	shape = std::make_unique<btHeightfieldTerrainShape>(heightStickWidth, heightStickLength, heights.get(), 1.0f, minHeight, maxHeight, 1, PHY_FLOAT, flipQuadEdges);
+	this->heights = std::move(heights);
 }
 
 const Node &operator>>(const Node &node, HeightfieldCollider &collider) {
@@ -17,10 +17,24 @@ public:
 	void SetHeightfield(int32_t heightStickWidth, int32_t heightStickLength, const void *heightfieldData, float minHeight, float maxHeight,
 		bool flipQuadEdges);
 
+	/**
+	 * Sets the heightfield from float heights shared with the collider, the heights are kept alive for as long as the shape reads them.
+	 * Bullet centers the shape between the min and max height, so the collider sits (minHeight + maxHeight) / 2 above its body.
+	 * @param heightStickWidth The amount of heights along the x axis.
+	 * @param heightStickLength The amount of heights along the z axis.
+	 * @param heights The heights, indexed by z * heightStickWidth + x.
+	 * @param minHeight The lowest height.
+	 * @param maxHeight The highest height.
+	 * @param flipQuadEdges If the triangles of each quad are split along the other diagonal.
+	 */
+	void SetHeightfield(int32_t heightStickWidth, int32_t heightStickLength, std::shared_ptr<const float> heights, float minHeight, float maxHeight,
+		bool flipQuadEdges);
+
 	friend const Node &operator>>(const Node &node, HeightfieldCollider &collider);
 	friend Node &operator<<(Node &node, const HeightfieldCollider &collider);
 
 private:
 	std::unique_ptr<btHeightfieldTerrainShape> shape;
+	std::shared_ptr<const float> heights;
 };
 }
@@ -2,9 +2,17 @@
 
 #include <BulletCollision/CollisionShapes/btCompoundShape.h>
 #include <BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
+#include "Scenes/Scenes.hpp"
 #include "Colliders/Collider.hpp"
+#include "Physics.hpp"
 
 namespace acid {
+static Physics *GetPhysics() {
+	if (!Scenes::Get() || !Scenes::Get()->GetScene())
+		return nullptr;
+	return Scenes::Get()->GetScene()->GetSystem<Physics>();
+}
+
 CollisionObject::CollisionObject(std::vector<std::unique_ptr<Collider>> &&colliders, float mass, float friction, const Vector3f &linearFactor, const Vector3f &angularFactor) :
 	colliders(std::move(colliders)),
 	mass(mass),
@@ -21,6 +29,8 @@ CollisionObject::CollisionObject(std::vector<std::unique_ptr<Collider>> &&collid
 }
 
 CollisionObject::~CollisionObject() {
+	if (forcePhysics)
+		forcePhysics->RemoveForceObject(this);
 }
 
 Collider *CollisionObject::AddCollider(std::unique_ptr<Collider> &&collider) {
@@ -40,9 +50,31 @@ void CollisionObject::RemoveCollider(Collider *collider) {
 }
 
 Force *CollisionObject::AddForce(std::unique_ptr<Force> &&force) {
+	// Only objects with forces are visited by the physics systems force pass.
+	if (!forcePhysics) {
+		forcePhysics = GetPhysics();
+		if (forcePhysics)
+			forcePhysics->AddForceObject(this);
+	}
+
 	return forces.emplace_back(std::move(force)).get();
 }
 
+bool CollisionObject::ApplyForces(const Time &delta) {
+	for (auto it = forces.begin(); it != forces.end();) {
+		(*it)->Update(delta);
+
+		if ((*it)->IsExpired()) {
+			it = forces.erase(it);
+			continue;
+		}
+
+		++it;
+	}
+
+	return !forces.empty();
+}
+
 void CollisionObject::SetChildTransform(Collider *child, const Transform &transform) {
 	auto compoundShape = dynamic_cast<btCompoundShape *>(shape.get());
 	if (!compoundShape)
@@ -10,11 +10,13 @@ class btCollisionObject;
 
 namespace acid {
 class Frustum;
+class Physics;
 
 /**
  * @brief Represents a object in a scene effected by physics.
  */
 class ACID_EXPORT CollisionObject : public virtual rocket::trackable, NonCopyable {
+	friend class Physics;
 public:
 	/**
 	 * Creates a new collision object.
@@ -38,6 +40,11 @@ public:
 	Collider *AddCollider(std::unique_ptr<Collider> &&collider);
 	void RemoveCollider(Collider *collider);
 
+	/**
+	 * Adds a force, forces are applied by the physics system in one pass before each step.
+	 * @param force The force.
+	 * @return The force.
+	 */
 	Force *AddForce(std::unique_ptr<Force> &&force);
 	virtual void ClearForces() = 0;
 
@@ -93,6 +100,14 @@ public:
 protected:
 	virtual void RecalculateMass() = 0;
 
+	/**
+	 * Applies the forces on this object for a update, and removes the forces that have expired.
+	 * @param delta The time since the last update.
+	 * Objects that can't apply forces still age them, so timed forces expire.
+	 * @return If any forces remain.
+	 */
+	virtual bool ApplyForces(const Time &delta);
+
 	void CreateShape(bool forceSingle = false);
 
 	std::vector<std::unique_ptr<Collider>> colliders;
@@ -110,6 +125,8 @@ protected:
 	btCollisionObject *body = nullptr;
 
 	std::vector<std::unique_ptr<Force>> forces;
+	// The physics system whose force pass this object is in, kept so it leaves the same system after a scene switch.
+	Physics *forcePhysics = nullptr;
 
 	rocket::signal<void(CollisionObject *)> onCollision;
 	rocket::signal<void(CollisionObject *)> onSeparation;
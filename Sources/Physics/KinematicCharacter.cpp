@@ -47,7 +47,8 @@ void KinematicCharacter::Start() {
 	if (mass != 0.0f)
 		shape->calculateLocalInertia(mass, localInertia);
 
-	auto worldTransform = Collider::Convert(*GetEntity()->GetComponent<Transform>());
+	transform = GetEntity()->GetComponent<Transform>();
+	auto worldTransform = Collider::Convert(*transform);
 
 	ghostObject = std::make_unique<btPairCachingGhostObject>();
 	ghostObject->setWorldTransform(worldTransform);
@@ -73,12 +74,12 @@ void KinematicCharacter::Start() {
 }
 
 void KinematicCharacter::Update() {
-	if (shape.get() != body->getCollisionShape())
-		body->setCollisionShape(shape.get());
-
-	auto &transform = *GetEntity()->GetComponent<Transform>();
-	auto worldTransform = ghostObject->getWorldTransform();
-	transform = Collider::Convert(worldTransform, transform.GetScale());
+	// The ghost object is moved by the controller action, so it has no motion state to write the transform.
+	const auto &worldTransform = ghostObject->getWorldTransform();
+	float yaw, pitch, roll;
+	worldTransform.getBasis().getEulerYPR(yaw, pitch, roll);
+	transform->SetLocalPosition(Collider::Convert(worldTransform.getOrigin()));
+	transform->SetLocalRotation({pitch, yaw, roll});
 
 	linearVelocity = Collider::Convert(controller->getLinearVelocity());
 	angularVelocity = Collider::Convert(controller->getAngularVelocity());
@@ -95,7 +96,7 @@ bool KinematicCharacter::InFrustum(const Frustum &frustum) {
 }
 
 void KinematicCharacter::ClearForces() {
-	//controller->clearForces();
+	forces.clear();
 }
 
 void KinematicCharacter::SetMass(float mass) {
@@ -74,5 +74,6 @@ private:
 
 	std::unique_ptr<btPairCachingGhostObject> ghostObject;
 	std::unique_ptr<btKinematicCharacterController> controller;
+	Transform *transform = nullptr;
 };
 }
@@ -1,44 +1,448 @@
 #include "Physics.hpp"
 
-#include <iterator>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
 
 #include <BulletCollision/BroadphaseCollision/btBroadphaseInterface.h>
 #include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
 #include <BulletCollision/CollisionDispatch/btCollisionDispatcher.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
 #include <BulletCollision/CollisionDispatch/btCollisionObject.h>
+#include <BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
+#include <BulletCollision/NarrowPhaseCollision/btPersistentManifold.h>
 #include <BulletCollision/CollisionShapes/btCollisionShape.h>
+#include <BulletCollision/CollisionShapes/btConvexShape.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
 #include <BulletDynamics/Dynamics/btRigidBody.h>
 #include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolver.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
 #include <BulletSoftBody/btSoftBodyRigidBodyCollisionConfiguration.h>
 #include <BulletSoftBody/btSoftRigidDynamicsWorld.h>
+#include <LinearMath/btThreads.h>
 #include "Engine/Engine.hpp"
+#include "Files/BinaryStream.hpp"
 #include "Physics/Colliders/Collider.hpp"
 #include "Physics/CollisionObject.hpp"
+#include "Utils/ThreadPool.hpp"
 
 namespace acid {
-Physics::Physics() :
-	collisionConfiguration(std::make_unique<btSoftBodyRigidBodyCollisionConfiguration>()),
+/**
+ * @brief Runs Bullets parallel loops on its own thread pool, the calling thread works on the loop alongside the pool.
+ * Physics can run without an engine, like in the physics benchmark, so the engines shared pool is not used.
+ */
+class PhysicsTaskScheduler : public btITaskScheduler {
+public:
+	explicit PhysicsTaskScheduler(int maxThreadCount) :
+		btITaskScheduler("Acid"),
+		maxThreadCount(maxThreadCount),
+		threadCount(maxThreadCount) {
+		setNumThreads(maxThreadCount);
+	}
+
+	/**
+	 * Gets the scheduler shared by all physics systems, Bullet only supports a single scheduler at a time.
+	 * @return The task scheduler.
+	 */
+	static PhysicsTaskScheduler &Get() {
+		// Bullet assigns every thread that enters a parallel loop a index below BT_MAX_THREAD_COUNT.
+		static PhysicsTaskScheduler scheduler(std::clamp<int>(std::thread::hardware_concurrency(), 1, BT_MAX_THREAD_COUNT));
+		return scheduler;
+	}
+
+	int getMaxNumThreads() const override { return maxThreadCount; }
+	int getNumThreads() const override { return threadCount; }
+	void setNumThreads(int numThreads) override {
+		threadCount = std::clamp(numThreads, 1, maxThreadCount);
+		if (threadPool && threadPool->GetWorkers().size() == static_cast<std::size_t>(threadCount - 1))
+			return;
+
+		// Bullet numbers every thread that enters it and sizes its per thread manifolds and solvers by the thread count, so only the
+		// calling thread and the workers of this pool may run loops. The old workers are joined before the numbering starts over.
+		threadPool = std::make_unique<ThreadPool>(threadCount - 1);
+		btResetThreadIndexCounter();
+	}
+
+	void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody &body) override {
+		Run(iBegin, iEnd, grainSize, [&body](int begin, int end, int) {
+			body.forLoop(begin, end);
+		});
+	}
+
+	btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody &body) override {
+		std::array<btScalar, BT_MAX_THREAD_COUNT> sums = {};
+		Run(iBegin, iEnd, grainSize, [&body, &sums](int begin, int end, int worker) {
+			sums[worker] += body.sumLoop(begin, end);
+		});
+		return std::accumulate(sums.begin(), sums.end(), btScalar(0));
+	}
+
+private:
+	/**
+	 * Splits a range into chunks that the calling thread and the pool workers take in turn.
+	 * @tparam Body The loop body type, called with a chunk range and the index of the worker running it.
+	 */
+	template<typename Body>
+	void Run(int iBegin, int iEnd, int grainSize, const Body &body) {
+		grainSize = std::max(grainSize, 1);
+		auto chunkCount = (iEnd - iBegin + grainSize - 1) / grainSize;
+		auto workerCount = std::min(threadCount, chunkCount);
+
+		// Loops started from inside a loop run in place, the pool could otherwise be waiting on itself.
+		if (workerCount <= 1 || Running) {
+			if (iBegin < iEnd)
+				body(iBegin, iEnd, 0);
+			return;
+		}
+
+		class State {
+		public:
+			std::atomic<int> nextChunk = 0;
+			std::atomic<int> finishedChunks = 0;
+			std::mutex mutex;
+			std::condition_variable finished;
+		};
+
+		// Workers may still be finishing an earlier loop, so they may start late. They then find every chunk taken and only touch the
+		// shared state, the calling thread runs whatever chunks are left and never waits on a worker that has not started.
+		auto state = std::make_shared<State>();
+		auto work = [state, iBegin, iEnd, grainSize, chunkCount, &body](int worker) {
+			Running = true;
+			for (int chunk; (chunk = state->nextChunk++) < chunkCount;) {
+				auto begin = iBegin + chunk * grainSize;
+				body(begin, std::min(begin + grainSize, iEnd), worker);
+
+				if (++state->finishedChunks == chunkCount) {
+					std::unique_lock<std::mutex> lock(state->mutex);
+					state->finished.notify_all();
+				}
+			}
+			Running = false;
+		};
+
+		for (int worker = 1; worker < workerCount; worker++)
+			threadPool->Enqueue(work, worker);
+		work(0);
+
+		std::unique_lock<std::mutex> lock(state->mutex);
+		state->finished.wait(lock, [&state, chunkCount]() {
+			return state->finishedChunks == chunkCount;
+		});
+	}
+
+	inline static thread_local bool Running = false;
+
+	int maxThreadCount;
+	int threadCount;
+	std::unique_ptr<ThreadPool> threadPool;
+};
+
+/**
+ * Runs a function for each index on Bullets task scheduler, Bullet runs the loop in place when it is not thread safe.
+ * @tparam Function The function type, called with each index.
+ * @param count The amount of indices.
+ * @param function The function.
+ */
+template<typename Function>
+static void ParallelFor(std::size_t count, const Function &function) {
+	class Body : public btIParallelForBody {
+	public:
+		explicit Body(const Function &function) : function(function) {}
+
+		void forLoop(int iBegin, int iEnd) const override {
+			for (auto i = iBegin; i < iEnd; i++)
+				function(static_cast<std::size_t>(i));
+		}
+
+	private:
+		const Function &function;
+	};
+
+	// Without a multithreaded world no scheduler is set, and Bullet would call through a null scheduler.
+	if (!btGetTaskScheduler()) {
+		Body(function).forLoop(0, static_cast<int>(count));
+		return;
+	}
+
+	btParallelFor(0, static_cast<int>(count), 64, Body(function));
+}
+
+static CollisionObject *GetCollisionObject(const btCollisionObject *object) {
+	return object ? static_cast<CollisionObject *>(object->getUserPointer()) : nullptr;
+}
+
+/**
+ * @brief Writes every hit along a ray into a fixed slice, keeping the closest hits once the slice is full.
+ */
+class RayHitsResultCallback : public btCollisionWorld::RayResultCallback {
+public:
+	RayHitsResultCallback(const RayQuery &query, Span<Raycast> hits) :
+		query(query),
+		hits(hits) {
+		m_collisionFilterGroup = query.filterGroup;
+		m_collisionFilterMask = query.filterMask;
+	}
+
+	btScalar addSingleResult(btCollisionWorld::LocalRayResult &rayResult, bool normalInWorldSpace) override {
+		m_collisionObject = rayResult.m_collisionObject;
+
+		auto slot = count;
+		if (count < hits.size()) {
+			count++;
+		} else {
+			auto farthest = std::max_element(hits.begin(), hits.end(), [](const Raycast &a, const Raycast &b) {
+				return a.GetFraction() < b.GetFraction();
+			});
+			if (farthest == hits.end() || farthest->GetFraction() <= rayResult.m_hitFraction)
+				return m_closestHitFraction;
+			slot = static_cast<uint32_t>(farthest - hits.begin());
+		}
+
+		auto normal = normalInWorldSpace ? rayResult.m_hitNormalLocal :
+			rayResult.m_collisionObject->getWorldTransform().getBasis() * rayResult.m_hitNormalLocal;
+		auto point = query.start + (query.end - query.start) * rayResult.m_hitFraction;
+		hits[slot] = Raycast(true, point, GetCollisionObject(rayResult.m_collisionObject), Collider::Convert(normal), rayResult.m_hitFraction);
+		// The closest hit fraction is left at 1, so the ray continues through every object.
+		return m_closestHitFraction;
+	}
+
+	const RayQuery &query;
+	Span<Raycast> hits;
+	uint32_t count = 0;
+};
+
+/**
+ * @brief Writes each object touching a query object once into a fixed slice.
+ */
+class OverlapResultCallback : public btCollisionWorld::ContactResultCallback {
+public:
+	OverlapResultCallback(const OverlapQuery &query, const btCollisionObject *queryObject, Span<CollisionObject *> objects) :
+		queryObject(queryObject),
+		objects(objects) {
+		m_collisionFilterGroup = query.filterGroup;
+		m_collisionFilterMask = query.filterMask;
+	}
+
+	btScalar addSingleResult(btManifoldPoint &cp, const btCollisionObjectWrapper *colObj0Wrap, int partId0, int index0,
+		const btCollisionObjectWrapper *colObj1Wrap, int partId1, int index1) override {
+		auto other = colObj0Wrap->getCollisionObject() == queryObject ? colObj1Wrap->getCollisionObject() : colObj0Wrap->getCollisionObject();
+		auto object = GetCollisionObject(other);
+		auto end = objects.begin() + count;
+		if (count < objects.size() && std::find(objects.begin(), end, object) == end)
+			objects[count++] = object;
+		return 0.0f;
+	}
+
+	const btCollisionObject *queryObject;
+	Span<CollisionObject *> objects;
+	uint32_t count = 0;
+};
+
+static constexpr uint32_t SnapshotVersion = 1;
+
+/**
+ * @brief The state of a collision object that changes as the world is stepped.
+ */
+class ObjectState {
+public:
+	int32_t internalType = 0;
+	int32_t activationState = 0;
+	btScalar deactivationTime = 0.0f;
+	btScalar hitFraction = 1.0f;
+	btTransform worldTransform;
+	btTransform interpolationWorldTransform;
+	btVector3 interpolationLinearVelocity;
+	btVector3 interpolationAngularVelocity;
+	btVector3 linearVelocity;
+	btVector3 angularVelocity;
+};
+
+/// Identifies a manifold by the world indices of its objects, lowest first, and the child shapes of its first contact.
+using ManifoldKey = std::array<int32_t, 4>;
+
+/**
+ * @brief The contacts cached in a manifold, with points relative to the lowest indexed object.
+ */
+class ManifoldState {
+public:
+	ManifoldKey key;
+	std::vector<btManifoldPoint> contacts;
+};
+
+static void WriteVector(BinaryWriter &writer, const btVector3 &vector) {
+	writer.Write(vector.x());
+	writer.Write(vector.y());
+	writer.Write(vector.z());
+}
+
+static btVector3 ReadVector(BinaryReader &reader) {
+	auto x = reader.Read<btScalar>();
+	auto y = reader.Read<btScalar>();
+	auto z = reader.Read<btScalar>();
+	return {x, y, z};
+}
+
+static void WriteTransform(BinaryWriter &writer, const btTransform &transform) {
+	for (int i = 0; i < 3; i++)
+		WriteVector(writer, transform.getBasis()[i]);
+	WriteVector(writer, transform.getOrigin());
+}
+
+static btTransform ReadTransform(BinaryReader &reader) {
+	btTransform transform;
+	for (int i = 0; i < 3; i++)
+		transform.getBasis()[i] = ReadVector(reader);
+	transform.setOrigin(ReadVector(reader));
+	return transform;
+}
+
+static void WriteObjectState(BinaryWriter &writer, const btCollisionObject *object) {
+	writer.Write<int32_t>(object->getInternalType());
+	writer.Write<int32_t>(object->getActivationState());
+	writer.Write(object->getDeactivationTime());
+	writer.Write(object->getHitFraction());
+	WriteTransform(writer, object->getWorldTransform());
+	WriteTransform(writer, object->getInterpolationWorldTransform());
+	WriteVector(writer, object->getInterpolationLinearVelocity());
+	WriteVector(writer, object->getInterpolationAngularVelocity());
+
+	auto body = btRigidBody::upcast(object);
+	WriteVector(writer, body ? body->getLinearVelocity() : btVector3(0.0f, 0.0f, 0.0f));
+	WriteVector(writer, body ? body->getAngularVelocity() : btVector3(0.0f, 0.0f, 0.0f));
+}
+
+static ObjectState ReadObjectState(BinaryReader &reader) {
+	ObjectState state;
+	state.internalType = reader.Read<int32_t>();
+	state.activationState = reader.Read<int32_t>();
+	state.deactivationTime = reader.Read<btScalar>();
+	state.hitFraction = reader.Read<btScalar>();
+	state.worldTransform = ReadTransform(reader);
+	state.interpolationWorldTransform = ReadTransform(reader);
+	state.interpolationLinearVelocity = ReadVector(reader);
+	state.interpolationAngularVelocity = ReadVector(reader);
+	state.linearVelocity = ReadVector(reader);
+	state.angularVelocity = ReadVector(reader);
+	return state;
+}
+
+static void WriteContact(BinaryWriter &writer, const btManifoldPoint &point) {
+	WriteVector(writer, point.m_localPointA);
+	WriteVector(writer, point.m_localPointB);
+	WriteVector(writer, point.m_positionWorldOnA);
+	WriteVector(writer, point.m_positionWorldOnB);
+	WriteVector(writer, point.m_normalWorldOnB);
+	WriteVector(writer, point.m_lateralFrictionDir1);
+	WriteVector(writer, point.m_lateralFrictionDir2);
+	for (auto value : {point.m_distance1, point.m_combinedFriction, point.m_combinedRollingFriction, point.m_combinedSpinningFriction,
+		point.m_combinedRestitution, point.m_appliedImpulse, point.m_prevRHS, point.m_appliedImpulseLateral1, point.m_appliedImpulseLateral2,
+		point.m_contactMotion1, point.m_contactMotion2, point.m_contactCFM, point.m_contactERP, point.m_frictionCFM}) {
+		writer.Write(value);
+	}
+	for (auto value : {point.m_partId0, point.m_partId1, point.m_index0, point.m_index1, point.m_contactPointFlags, point.m_lifeTime})
+		writer.Write<int32_t>(value);
+}
+
+static btManifoldPoint ReadContact(BinaryReader &reader) {
+	btManifoldPoint point;
+	point.m_localPointA = ReadVector(reader);
+	point.m_localPointB = ReadVector(reader);
+	point.m_positionWorldOnA = ReadVector(reader);
+	point.m_positionWorldOnB = ReadVector(reader);
+	point.m_normalWorldOnB = ReadVector(reader);
+	point.m_lateralFrictionDir1 = ReadVector(reader);
+	point.m_lateralFrictionDir2 = ReadVector(reader);
+	for (auto value : {&point.m_distance1, &point.m_combinedFriction, &point.m_combinedRollingFriction, &point.m_combinedSpinningFriction,
+		&point.m_combinedRestitution, &point.m_appliedImpulse, &point.m_prevRHS, &point.m_appliedImpulseLateral1, &point.m_appliedImpulseLateral2,
+		&point.m_contactMotion1, &point.m_contactMotion2, &point.m_contactCFM, &point.m_contactERP, &point.m_frictionCFM}) {
+		*value = reader.Read<btScalar>();
+	}
+	for (auto value : {&point.m_partId0, &point.m_partId1, &point.m_index0, &point.m_index1, &point.m_contactPointFlags, &point.m_lifeTime})
+		*value = reader.Read<int32_t>();
+	return point;
+}
+
+/**
+ * Swaps which object of a contact is A and which is B, the contact stays the same physically.
+ * @param point The contact to swap.
+ */
+static void SwapContact(btManifoldPoint &point) {
+	std::swap(point.m_localPointA, point.m_localPointB);
+	std::swap(point.m_positionWorldOnA, point.m_positionWorldOnB);
+	std::swap(point.m_partId0, point.m_partId1);
+	std::swap(point.m_index0, point.m_index1);
+	point.m_normalWorldOnB = -point.m_normalWorldOnB;
+	point.m_lateralFrictionDir1 = -point.m_lateralFrictionDir1;
+	point.m_lateralFrictionDir2 = -point.m_lateralFrictionDir2;
+}
+
+static bool IsManifoldSwapped(const btPersistentManifold *manifold) {
+	return manifold->getBody1()->getWorldArrayIndex() < manifold->getBody0()->getWorldArrayIndex();
+}
+
+static ManifoldKey GetManifoldKey(const btPersistentManifold *manifold) {
+	ManifoldKey key = {manifold->getBody0()->getWorldArrayIndex(), manifold->getBody1()->getWorldArrayIndex(), 0, 0};
+	if (manifold->getNumContacts() > 0) {
+		key[2] = manifold->getContactPoint(0).m_index0;
+		key[3] = manifold->getContactPoint(0).m_index1;
+	}
+	if (IsManifoldSwapped(manifold)) {
+		std::swap(key[0], key[1]);
+		std::swap(key[2], key[3]);
+	}
+	return key;
+}
+
+Physics::Physics(const PhysicsSettings &settings) :
+	settings(settings),
 	broadphase(std::make_unique<btDbvtBroadphase>()),
-	dispatcher(std::make_unique<btCollisionDispatcher>(collisionConfiguration.get())),
-	solver(std::make_unique<btSequentialImpulseConstraintSolver>()),
-	dynamicsWorld(std::make_unique<btSoftRigidDynamicsWorld>(dispatcher.get(), broadphase.get(), solver.get(), collisionConfiguration.get())),
 	gravity(0.0f, -9.81f, 0.0f),
 	airDensity(1.2f) {
+	if (settings.softBodies) {
+		collisionConfiguration = std::make_unique<btSoftBodyRigidBodyCollisionConfiguration>();
+		dispatcher = std::make_unique<btCollisionDispatcher>(collisionConfiguration.get());
+		solver = std::make_unique<btSequentialImpulseConstraintSolver>();
+		dynamicsWorld = std::make_unique<btSoftRigidDynamicsWorld>(dispatcher.get(), broadphase.get(), solver.get(), collisionConfiguration.get());
+	} else if (settings.threadCount > 1) {
+		auto &scheduler = PhysicsTaskScheduler::Get();
+		scheduler.setNumThreads(static_cast<int>(settings.threadCount));
+		btSetTaskScheduler(&scheduler);
+
+		// Islands are solved in parallel by the pool, and large islands are solved by the parallel solver.
+		collisionConfiguration = std::make_unique<btDefaultCollisionConfiguration>();
+		dispatcher = std::make_unique<btCollisionDispatcherMt>(collisionConfiguration.get());
+		solverPool = std::make_unique<btConstraintSolverPoolMt>(scheduler.getNumThreads());
+		solver = std::make_unique<btSequentialImpulseConstraintSolverMt>();
+		dynamicsWorld = std::make_unique<btDiscreteDynamicsWorldMt>(dispatcher.get(), broadphase.get(), solverPool.get(), solver.get(), collisionConfiguration.get());
+	} else {
+		collisionConfiguration = std::make_unique<btDefaultCollisionConfiguration>();
+		dispatcher = std::make_unique<btCollisionDispatcher>(collisionConfiguration.get());
+		solver = std::make_unique<btSequentialImpulseConstraintSolver>();
+		dynamicsWorld = std::make_unique<btDiscreteDynamicsWorld>(dispatcher.get(), broadphase.get(), solver.get(), collisionConfiguration.get());
+	}
+
 	dynamicsWorld->setGravity(Collider::Convert(gravity));
 	dynamicsWorld->getDispatchInfo().m_enableSPU = true;
 	dynamicsWorld->getSolverInfo().m_minimumSolverBatchSize = 128;
 	dynamicsWorld->getSolverInfo().m_globalCfm = 0.00001f;
 
-	auto softDynamicsWorld = static_cast<btSoftRigidDynamicsWorld *>(dynamicsWorld.get());
-	softDynamicsWorld->getWorldInfo().water_density = 0.0f;
-	softDynamicsWorld->getWorldInfo().water_offset = 0.0f;
-	softDynamicsWorld->getWorldInfo().water_normal = btVector3(0.0f, 0.0f, 0.0f);
-	softDynamicsWorld->getWorldInfo().m_gravity.setValue(0.0f, -9.81f, 0.0f);
-	softDynamicsWorld->getWorldInfo().air_density = airDensity;
-	softDynamicsWorld->getWorldInfo().m_sparsesdf.Initialize();
+	if (settings.softBodies) {
+		auto softDynamicsWorld = static_cast<btSoftRigidDynamicsWorld *>(dynamicsWorld.get());
+		softDynamicsWorld->getWorldInfo().water_density = 0.0f;
+		softDynamicsWorld->getWorldInfo().water_offset = 0.0f;
+		softDynamicsWorld->getWorldInfo().water_normal = btVector3(0.0f, 0.0f, 0.0f);
+		softDynamicsWorld->getWorldInfo().m_gravity.setValue(0.0f, -9.81f, 0.0f);
+		softDynamicsWorld->getWorldInfo().air_density = airDensity;
+		softDynamicsWorld->getWorldInfo().m_sparsesdf.Initialize();
+	}
 }
 
 Physics::~Physics() {
+	for (auto object : forceObjects)
+		object->forcePhysics = nullptr;
+
 	for (int32_t i = dynamicsWorld->getNumCollisionObjects() - 1; i >= 0; i--) {
 		auto obj = dynamicsWorld->getCollisionObjectArray()[i];
 		auto body = btRigidBody::upcast(obj);
@@ -50,10 +454,28 @@ Physics::~Physics() {
 
 		dynamicsWorld->removeCollisionObject(obj);
 	}
+
+	// The scheduler outlives the world, but Bullet should not run loops on it once no world sized for its threads is left.
+	if (solverPool && btGetTaskScheduler() == &PhysicsTaskScheduler::Get())
+		btSetTaskScheduler(nullptr);
 }
 
 void Physics::Update() {
-	dynamicsWorld->stepSimulation(Engine::Get()->GetDelta().AsSeconds());
+	auto delta = Engine::Get()->GetDelta();
+
+	for (std::size_t i = 0; i < forceObjects.size();) {
+		if (forceObjects[i]->ApplyForces(delta)) {
+			i++;
+			continue;
+		}
+
+		// The object registers again on its next force.
+		forceObjects[i]->forcePhysics = nullptr;
+		forceObjects[i] = forceObjects.back();
+		forceObjects.pop_back();
+	}
+
+	dynamicsWorld->stepSimulation(delta.AsSeconds());
 	CheckForCollisionEvents();
 }
 
@@ -67,73 +489,361 @@ Raycast Physics::Raytest(const Vector3f &start, const Vector3f &end) const {
 		result.m_collisionObject ? static_cast<CollisionObject *>(result.m_collisionObject->getUserPointer()) : nullptr);
 }
 
+void Physics::Raytest(Span<const RayQuery> queries, Span<Raycast> results) const {
+	assert(results.size() >= queries.size() && "Raycast results are smaller than the queries");
+
+	auto world = dynamicsWorld->getCollisionWorld();
+	ParallelFor(queries.size(), [&](std::size_t i) {
+		auto &query = queries[i];
+		auto startBt = Collider::Convert(query.start);
+		auto endBt = Collider::Convert(query.end);
+		btCollisionWorld::ClosestRayResultCallback result(startBt, endBt);
+		result.m_collisionFilterGroup = query.filterGroup;
+		result.m_collisionFilterMask = query.filterMask;
+		world->rayTest(startBt, endBt, result);
+
+		results[i] = Raycast(result.hasHit(), Collider::Convert(result.m_hitPointWorld), GetCollisionObject(result.m_collisionObject),
+			Collider::Convert(result.m_hitNormalWorld), result.m_closestHitFraction);
+	});
+}
+
+void Physics::RaytestAll(Span<const RayQuery> queries, Span<Raycast> hits, Span<uint32_t> hitCounts) const {
+	assert(hitCounts.size() >= queries.size() && "Raycast hit counts are smaller than the queries");
+	if (queries.empty())
+		return;
+
+	auto world = dynamicsWorld->getCollisionWorld();
+	auto maxHits = hits.size() / queries.size();
+	ParallelFor(queries.size(), [&](std::size_t i) {
+		auto &query = queries[i];
+		auto slice = hits.subspan(i * maxHits, maxHits);
+		RayHitsResultCallback result(query, slice);
+		world->rayTest(Collider::Convert(query.start), Collider::Convert(query.end), result);
+
+		std::sort(slice.begin(), slice.begin() + result.count, [](const Raycast &a, const Raycast &b) {
+			return a.GetFraction() < b.GetFraction();
+		});
+		hitCounts[i] = result.count;
+	});
+}
+
+void Physics::SweepTest(Span<const SweepQuery> queries, Span<Raycast> results) const {
+	assert(results.size() >= queries.size() && "Sweep results are smaller than the queries");
+
+	auto world = dynamicsWorld->getCollisionWorld();
+	ParallelFor(queries.size(), [&](std::size_t i) {
+		auto &query = queries[i];
+		auto shape = query.collider ? query.collider->GetCollisionShape() : nullptr;
+		if (!shape || !shape->isConvex()) {
+			results[i] = {};
+			return;
+		}
+
+		auto rotation = Collider::Convert(query.rotation);
+		btTransform from(rotation, Collider::Convert(query.start));
+		btTransform to(rotation, Collider::Convert(query.end));
+		btCollisionWorld::ClosestConvexResultCallback result(from.getOrigin(), to.getOrigin());
+		result.m_collisionFilterGroup = query.filterGroup;
+		result.m_collisionFilterMask = query.filterMask;
+		world->convexSweepTest(static_cast<const btConvexShape *>(shape), from, to, result);
+
+		results[i] = Raycast(result.hasHit(), Collider::Convert(result.m_hitPointWorld), GetCollisionObject(result.m_hitCollisionObject),
+			Collider::Convert(result.m_hitNormalWorld), result.m_closestHitFraction);
+	});
+}
+
+void Physics::OverlapTest(Span<const OverlapQuery> queries, Span<CollisionObject *> objects, Span<uint32_t> objectCounts) const {
+	assert(objectCounts.size() >= queries.size() && "Overlap object counts are smaller than the queries");
+	if (queries.empty())
+		return;
+
+	auto world = dynamicsWorld->getCollisionWorld();
+	auto maxObjects = objects.size() / queries.size();
+	ParallelFor(queries.size(), [&](std::size_t i) {
+		auto &query = queries[i];
+		auto shape = query.collider ? query.collider->GetCollisionShape() : nullptr;
+		if (!shape) {
+			objectCounts[i] = 0;
+			return;
+		}
+
+		// The query object lives on the stack and is never added to the world.
+		btCollisionObject queryObject;
+		queryObject.setCollisionShape(shape);
+		queryObject.setWorldTransform(btTransform(Collider::Convert(query.rotation), Collider::Convert(query.position)));
+
+		OverlapResultCallback result(query, &queryObject, objects.subspan(i * maxObjects, maxObjects));
+		world->contactTest(&queryObject, result);
+		objectCounts[i] = result.count;
+	});
+}
+
 void Physics::SetGravity(const Vector3f &gravity) {
 	this->gravity = gravity;
 	dynamicsWorld->setGravity(Collider::Convert(gravity));
+	if (settings.softBodies)
+		static_cast<btSoftRigidDynamicsWorld *>(dynamicsWorld.get())->getWorldInfo().m_gravity = Collider::Convert(gravity);
 }
 
 void Physics::SetAirDensity(float airDensity) {
 	this->airDensity = airDensity;
+	if (!settings.softBodies)
+		return;
+
 	auto softDynamicsWorld = static_cast<btSoftRigidDynamicsWorld *>(dynamicsWorld.get());
 	softDynamicsWorld->getWorldInfo().air_density = airDensity;
 	softDynamicsWorld->getWorldInfo().m_sparsesdf.Initialize();
 }
 
+std::vector<std::byte> Physics::Snapshot() const {
+	if (settings.softBodies)
+		throw std::runtime_error("Physics snapshots do not support soft body worlds");
+
+	BinaryWriter writer;
+	writer.Write(SnapshotVersion);
+
+	auto &objects = dynamicsWorld->getCollisionObjectArray();
+	writer.Write(static_cast<uint32_t>(objects.size()));
+	for (int32_t i = 0; i < objects.size(); i++)
+		WriteObjectState(writer, objects[i]);
+
+	// Manifolds are written in key order, so equal worlds give equal bytes whatever order their manifolds were created in.
+	std::vector<std::pair<ManifoldKey, const btPersistentManifold *>> manifolds;
+	for (int32_t i = 0; i < dispatcher->getNumManifolds(); i++) {
+		auto manifold = dispatcher->getManifoldByIndexInternal(i);
+		if (manifold->getNumContacts() > 0)
+			manifolds.emplace_back(GetManifoldKey(manifold), manifold);
+	}
+	std::sort(manifolds.begin(), manifolds.end(), [](const auto &a, const auto &b) {
+		return a.first < b.first;
+	});
+
+	writer.Write(static_cast<uint32_t>(manifolds.size()));
+	for (const auto &[key, manifold] : manifolds) {
+		writer.Write(key);
+		writer.Write(static_cast<uint32_t>(manifold->getNumContacts()));
+		for (int32_t i = 0; i < manifold->getNumContacts(); i++) {
+			auto point = manifold->getContactPoint(i);
+			if (IsManifoldSwapped(manifold))
+				SwapContact(point);
+			WriteContact(writer, point);
+		}
+	}
+
+	return writer.GetBuffer();
+}
+
+void Physics::Restore(Span<const std::byte> snapshot) {
+	if (settings.softBodies)
+		throw std::runtime_error("Physics snapshots do not support soft body worlds");
+
+	// The whole snapshot is read before the world is touched, so a bad snapshot leaves the world as it was.
+	BinaryReader reader(snapshot);
+	if (reader.Read<uint32_t>() != SnapshotVersion)
+		throw std::runtime_error("Physics snapshot has a unsupported version");
+
+	auto &objects = dynamicsWorld->getCollisionObjectArray();
+	auto objectCount = reader.Read<uint32_t>();
+	if (objectCount != static_cast<uint32_t>(objects.size()))
+		throw std::runtime_error("Physics snapshot does not match the world");
+
+	std::vector<ObjectState> objectStates(objectCount);
+	for (uint32_t i = 0; i < objectCount; i++) {
+		objectStates[i] = ReadObjectState(reader);
+		if (objectStates[i].internalType != objects[i]->getInternalType())
+			throw std::runtime_error("Physics snapshot does not match the world");
+	}
+
+	auto manifoldCount = reader.Read<uint32_t>();
+	if (manifoldCount > reader.GetRemaining())
+		throw std::runtime_error("Binary data is truncated");
+
+	std::vector<ManifoldState> manifoldStates(manifoldCount);
+	for (auto &manifoldState : manifoldStates) {
+		manifoldState.key = reader.Read<ManifoldKey>();
+		auto contactCount = reader.Read<uint32_t>();
+		if (contactCount > static_cast<uint32_t>(MANIFOLD_CACHE_SIZE))
+			throw std::runtime_error("Physics snapshot has a invalid manifold");
+
+		manifoldState.contacts.reserve(contactCount);
+		for (uint32_t i = 0; i < contactCount; i++)
+			manifoldState.contacts.emplace_back(ReadContact(reader));
+	}
+
+	// Objects are removed and added back in order so the broadphase tree, pairs, and manifolds are rebuilt from scratch.
+	class Membership {
+	public:
+		btCollisionObject *object;
+		int group;
+		int mask;
+		btVector3 gravity;
+	};
+
+	std::vector<Membership> memberships;
+	memberships.reserve(objectCount);
+	for (int32_t i = 0; i < objects.size(); i++) {
+		auto object = objects[i];
+		auto body = btRigidBody::upcast(object);
+		auto handle = object->getBroadphaseHandle();
+		memberships.push_back({object, handle->m_collisionFilterGroup, handle->m_collisionFilterMask, body ? body->getGravity() : btVector3(0.0f, 0.0f, 0.0f)});
+	}
+
+	for (int32_t i = objects.size() - 1; i >= 0; i--)
+		dynamicsWorld->removeCollisionObject(objects[i]);
+	broadphase->resetPool(dispatcher.get());
+	solver->reset();
+	if (solverPool)
+		solverPool->reset();
+
+	for (uint32_t i = 0; i < objectCount; i++) {
+		auto &[object, group, mask, gravity] = memberships[i];
+		auto &state = objectStates[i];
+
+		// Transforms are set before the object is added, so its broadphase proxy starts at the restored bounds.
+		if (auto body = btRigidBody::upcast(object)) {
+			body->setCenterOfMassTransform(state.worldTransform);
+			body->setLinearVelocity(state.linearVelocity);
+			body->setAngularVelocity(state.angularVelocity);
+			body->clearForces();
+			dynamicsWorld->addRigidBody(body, group, mask);
+			// Added bodies take the gravity of the world.
+			body->setGravity(gravity);
+		} else {
+			object->setWorldTransform(state.worldTransform);
+			dynamicsWorld->addCollisionObject(object, group, mask);
+		}
+
+		object->setInterpolationWorldTransform(state.interpolationWorldTransform);
+		object->setInterpolationLinearVelocity(state.interpolationLinearVelocity);
+		object->setInterpolationAngularVelocity(state.interpolationAngularVelocity);
+		object->setHitFraction(state.hitFraction);
+		object->forceActivationState(state.activationState);
+		object->setDeactivationTime(state.deactivationTime);
+	}
+
+	// Finds the pairs and creates their manifolds, then replaces the contacts found with the cached contacts from the snapshot.
+	dynamicsWorld->performDiscreteCollisionDetection();
+
+	std::vector<std::pair<ManifoldKey, btPersistentManifold *>> manifolds;
+	for (int32_t i = 0; i < dispatcher->getNumManifolds(); i++) {
+		auto manifold = dispatcher->getManifoldByIndexInternal(i);
+		manifolds.emplace_back(GetManifoldKey(manifold), manifold);
+	}
+	std::sort(manifolds.begin(), manifolds.end(), [](const auto &a, const auto &b) {
+		return a.first < b.first;
+	});
+
+	std::vector<bool> restored(manifolds.size());
+	for (const auto &manifoldState : manifoldStates) {
+		// Prefers the manifold between the same child shapes, otherwise any manifold between the same objects.
+		ManifoldKey pairKey = {manifoldState.key[0], manifoldState.key[1], std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::min()};
+		auto first = std::lower_bound(manifolds.begin(), manifolds.end(), pairKey, [](const auto &a, const ManifoldKey &b) {
+			return a.first < b;
+		});
+		auto last = std::find_if(first, manifolds.end(), [&pairKey](const auto &a) {
+			return a.first[0] != pairKey[0] || a.first[1] != pairKey[1];
+		});
+		auto isFree = [&](const auto &a) {
+			return !restored[&a - manifolds.data()];
+		};
+		auto match = std::find_if(first, last, [&](const auto &a) {
+			return isFree(a) && a.first == manifoldState.key;
+		});
+		if (match == last)
+			match = std::find_if(first, last, isFree);
+		if (match == last)
+			continue;
+
+		restored[match - manifolds.begin()] = true;
+		auto manifold = match->second;
+		manifold->clearManifold();
+		for (auto point : manifoldState.contacts) {
+			if (IsManifoldSwapped(manifold))
+				SwapContact(point);
+			// The contacts were valid when captured, predictive contacts may be further apart than the breaking threshold.
+			manifold->addManifoldPoint(point, true);
+		}
+	}
+
+	for (std::size_t i = 0; i < manifolds.size(); i++) {
+		if (!restored[i])
+			manifolds[i].second->clearManifold();
+	}
+
+	for (const auto &membership : memberships) {
+		auto body = btRigidBody::upcast(membership.object);
+		if (body && body->getMotionState())
+			body->getMotionState()->setWorldTransform(body->getWorldTransform());
+	}
+}
+
+void Physics::Resimulate(uint32_t stepCount, const Time &timeStep, const std::function<void(uint32_t)> &onStep) {
+	for (uint32_t step = 0; step < stepCount; step++) {
+		if (onStep)
+			onStep(step);
+		// Without substeps each call advances exactly one step, the time left over between updates is not used.
+		dynamicsWorld->stepSimulation(timeStep.AsSeconds(), 0);
+	}
+}
+
+void Physics::AddForceObject(CollisionObject *object) {
+	forceObjects.emplace_back(object);
+}
+
+void Physics::RemoveForceObject(CollisionObject *object) {
+	object->forcePhysics = nullptr;
+	forceObjects.erase(std::remove(forceObjects.begin(), forceObjects.end(), object), forceObjects.end());
+}
+
 void Physics::CheckForCollisionEvents() {
-	// Keep a list of the collision pairs found during the current update.
-	CollisionPairs pairsThisUpdate;
+	pairsThisUpdate.clear();
+	collisionEvents.clear();
 
-	// Iterate through all of the manifolds in the dispatcher.
 	for (int32_t i = 0; i < dispatcher->getNumManifolds(); ++i) {
-		// Get the manifold.
 		auto manifold = dispatcher->getManifoldByIndexInternal(i);
 
-		// Ignore manifolds that have no contact points..
+		// Ignore manifolds that have no contact points.
 		if (manifold->getNumContacts() == 0)
 			continue;
 
-		// Get the two rigid bodies involved in the collision.
+		// Always create the pair in a predictable order (use the pointer value).
 		auto body0 = manifold->getBody0();
 		auto body1 = manifold->getBody1();
+		pairsThisUpdate.emplace_back(std::min(body0, body1), std::max(body0, body1));
+	}
 
-		// Always create the pair in a predictable order (use the pointer value..).
-		const auto swapped = body0 > body1;
-		const auto sortedBodyA = swapped ? body1 : body0;
-		const auto sortedBodyB = swapped ? body0 : body1;
-
-		// Create the pair.
-		auto thisPair = std::make_pair(sortedBodyA, sortedBodyB);
+	// Objects may share more than one manifold.
+	std::sort(pairsThisUpdate.begin(), pairsThisUpdate.end());
+	pairsThisUpdate.erase(std::unique(pairsThisUpdate.begin(), pairsThisUpdate.end()), pairsThisUpdate.end());
 
-		// Insert the pair into the current list.
-		pairsThisUpdate.insert(thisPair);
+	auto addEvent = [this](CollisionEvent::Type type, const CollisionPair &pair) {
+		collisionEvents.push_back({type, static_cast<CollisionObject *>(pair.first->getUserPointer()), static_cast<CollisionObject *>(pair.second->getUserPointer())});
+	};
 
-		// If this pair doesn't exist in the list from the previous update, it is a new pair and we must send a collision event.
-		if (pairsLastUpdate.find(thisPair) == pairsLastUpdate.end()) {
-			// Gets the user pointer (entity).
-			auto collisionObjectA = static_cast<CollisionObject *>(sortedBodyA->getUserPointer());
-			auto collisionObjectB = static_cast<CollisionObject *>(sortedBodyB->getUserPointer());
+	// Merges both sorted lists, pairs only in this update entered, pairs in both stayed, and pairs only in the last update exited.
+	auto last = pairsLastUpdate.begin();
+	for (const auto &pair : pairsThisUpdate) {
+		for (; last != pairsLastUpdate.end() && *last < pair; ++last)
+			addEvent(CollisionEvent::Type::Exit, *last);
 
-			collisionObjectA->OnCollision()(collisionObjectB);
+		if (last != pairsLastUpdate.end() && *last == pair) {
+			addEvent(CollisionEvent::Type::Stay, pair);
+			++last;
+		} else {
+			addEvent(CollisionEvent::Type::Enter, pair);
 		}
 	}
+	for (; last != pairsLastUpdate.end(); ++last)
+		addEvent(CollisionEvent::Type::Exit, *last);
 
-	// Creates another list for pairs that were removed this update.
-	CollisionPairs removedPairs;
-
-	// This handy function gets the difference between two sets. It takes the difference between collision pairs from the last update,
-	// and this update and pushes them into the removed pairs list.
-	std::set_difference(pairsLastUpdate.begin(), pairsLastUpdate.end(), pairsThisUpdate.begin(), pairsThisUpdate.end(), std::inserter(removedPairs, removedPairs.begin()));
+	std::swap(pairsThisUpdate, pairsLastUpdate);
 
-	// Iterate through all of the removed pairs sending separation events for them.
-	for (const auto &[removedObject0, removedObject1] : removedPairs) {
-		// Gets the user pointer (entity).
-		auto collisionObjectA = static_cast<CollisionObject *>(removedObject0->getUserPointer());
-		auto collisionObjectB = static_cast<CollisionObject *>(removedObject1->getUserPointer());
-
-		collisionObjectA->OnSeparation()(collisionObjectB);
+	// Signals are called once the batch is complete, so listeners see a consistent set of events.
+	for (const auto &event : collisionEvents) {
+		if (event.type == CollisionEvent::Type::Enter)
+			event.objectA->OnCollision()(event.objectB);
+		else if (event.type == CollisionEvent::Type::Exit)
+			event.objectA->OnSeparation()(event.objectB);
 	}
-
-	// In the next iteration we'll want to compare against the pairs we found in this iteration.
-	pairsLastUpdate = pairsThisUpdate;
 }
 }
@@ -1,71 +1,232 @@
 #pragma once
 
-#include <set>
+#include <functional>
 #include <memory>
+#include <vector>
+#include <thread>
 
+#include "Maths/Quaternion.hpp"
+#include "Maths/Time.hpp"
 #include "Maths/Vector3.hpp"
 #include "Scenes/System.hpp"
+#include "Utils/Span.hpp"
 
 class btCollisionObject;
 class btCollisionConfiguration;
 class btBroadphaseInterface;
 class btCollisionDispatcher;
 class btConstraintSolver;
+class btConstraintSolverPoolMt;
 class btDiscreteDynamicsWorld;
 
 namespace acid {
 class Entity;
 class CollisionObject;
+class Collider;
 
 using CollisionPair = std::pair<const btCollisionObject *, const btCollisionObject *>;
-using CollisionPairs = std::set<CollisionPair>;
+
+/**
+ * @brief A change in contact between two collision objects found during a physics update.
+ */
+class ACID_EXPORT CollisionEvent {
+public:
+	enum class Type : uint8_t {
+		/// The objects started touching this update.
+		Enter,
+		/// The objects were touching last update and still are.
+		Stay,
+		/// The objects stopped touching this update.
+		Exit
+	};
+
+	Type type;
+	CollisionObject *objectA;
+	CollisionObject *objectB;
+};
 
 class ACID_EXPORT Raycast {
 public:
-	Raycast(bool hasHit, const Vector3f &pointWorld, CollisionObject *collisionObject) :
+	Raycast() = default;
+	Raycast(bool hasHit, const Vector3f &pointWorld, CollisionObject *collisionObject, const Vector3f &normalWorld = {}, float fraction = 1.0f) :
 		hasHit(hasHit),
 		pointWorld(pointWorld),
+		normalWorld(normalWorld),
+		fraction(fraction),
 		collisionObject(collisionObject) {
 	}
 
 	bool HasHit() const { return hasHit; }
 	const Vector3f &GetPointWorld() const { return pointWorld; }
+	const Vector3f &GetNormalWorld() const { return normalWorld; }
+	/**
+	 * Gets how far along the ray or sweep the hit is, from 0 at the start to 1 at the end.
+	 * @return The hit fraction.
+	 */
+	float GetFraction() const { return fraction; }
 	CollisionObject *GetCollisionObject() const { return collisionObject; }
 
 private:
-	bool hasHit;
+	bool hasHit = false;
 	Vector3f pointWorld;
-	CollisionObject *collisionObject;
+	Vector3f normalWorld;
+	float fraction = 1.0f;
+	CollisionObject *collisionObject = nullptr;
+};
+
+/**
+ * @brief A ray tested by {@link Physics::Raytest} or {@link Physics::RaytestAll}.
+ * Objects are only hit if their group is in the filter mask and the filter group is in their mask.
+ */
+class ACID_EXPORT RayQuery {
+public:
+	Vector3f start;
+	Vector3f end;
+	int32_t filterGroup = 1;
+	int32_t filterMask = -1;
+};
+
+/**
+ * @brief A convex collider swept between two points by {@link Physics::SweepTest}.
+ */
+class ACID_EXPORT SweepQuery {
+public:
+	const Collider *collider = nullptr;
+	Vector3f start;
+	Vector3f end;
+	Quaternion rotation;
+	int32_t filterGroup = 1;
+	int32_t filterMask = -1;
+};
+
+/**
+ * @brief A collider placed in the world by {@link Physics::OverlapTest}.
+ */
+class ACID_EXPORT OverlapQuery {
+public:
+	const Collider *collider = nullptr;
+	Vector3f position;
+	Quaternion rotation;
+	int32_t filterGroup = 1;
+	int32_t filterMask = -1;
+};
+
+/**
+ * @brief Options used to choose the dynamics world a {@link Physics} system builds.
+ */
+class ACID_EXPORT PhysicsSettings {
+public:
+	/// The amount of threads used to step the world, a single thread builds a sequential world.
+	uint32_t threadCount = std::thread::hardware_concurrency();
+	/// If the world simulates soft bodies, soft body worlds are always stepped on a single thread.
+	bool softBodies = false;
 };
 
 class ACID_EXPORT Physics : public System {
 public:
-	Physics();
+	explicit Physics(const PhysicsSettings &settings = {});
 	~Physics();
 
 	void Update() override;
 
 	Raycast Raytest(const Vector3f &start, const Vector3f &end) const;
 
+	/**
+	 * Finds the closest hit along each ray. Batched queries are split across the physics task scheduler,
+	 * they read the world left by the last update so must not run while it is stepped or modified.
+	 * @param queries The rays to test.
+	 * @param results The closest hit of each ray, at least as long as the queries.
+	 */
+	void Raytest(Span<const RayQuery> queries, Span<Raycast> results) const;
+
+	/**
+	 * Finds every hit along each ray. Each ray owns a equal slice of the hits span,
+	 * when a ray hits more objects than fit in its slice the closest hits are kept.
+	 * @param queries The rays to test.
+	 * @param hits The hits of each ray, sorted from the start of the ray.
+	 * @param hitCounts The amount of hits written into each rays slice, at least as long as the queries.
+	 */
+	void RaytestAll(Span<const RayQuery> queries, Span<Raycast> hits, Span<uint32_t> hitCounts) const;
+
+	/**
+	 * Finds the closest hit of each swept collider, colliders that are not convex never hit.
+	 * @param queries The sweeps to test.
+	 * @param results The closest hit of each sweep, at least as long as the queries.
+	 */
+	void SweepTest(Span<const SweepQuery> queries, Span<Raycast> results) const;
+
+	/**
+	 * Finds the objects touching each placed collider. Each query owns a equal slice of the objects span.
+	 * @param queries The overlaps to test.
+	 * @param objects The objects touching each collider.
+	 * @param objectCounts The amount of objects written into each queries slice, at least as long as the queries.
+	 */
+	void OverlapTest(Span<const OverlapQuery> queries, Span<CollisionObject *> objects, Span<uint32_t> objectCounts) const;
+
 	const Vector3f &GetGravity() const { return gravity; }
 	void SetGravity(const Vector3f &gravity);
 
 	float GetAirDensity() const { return airDensity; }
 	void SetAirDensity(float airDensity);
 
+	/**
+	 * Captures the transforms, velocities and activation of every object in the world, and the contacts cached between them.
+	 * Forces applied since the last step are treated as inputs and are not captured.
+	 * @return The snapshot, equal worlds give equal bytes.
+	 */
+	std::vector<std::byte> Snapshot() const;
+
+	/**
+	 * Restores a snapshot taken from this world, the world must hold the same objects in the same order.
+	 * The broadphase and contact caches are rebuilt from scratch, so stepping after a restore does not depend on
+	 * what the world did before it. Constraint warm starting is not captured, soft body worlds are not supported.
+	 * @param snapshot The snapshot to restore.
+	 */
+	void Restore(Span<const std::byte> snapshot);
+
+	/**
+	 * Steps the world a amount of fixed steps at once, used to replay inputs after a restore.
+	 * Given the same snapshot, inputs and time step a sequential world replays to a bitwise identical state.
+	 * Collision events and object forces are not updated while re-simulating.
+	 * @param stepCount The amount of steps.
+	 * @param timeStep The time each step advances.
+	 * @param onStep Called before each step with the index of the step, used to apply the inputs of that step.
+	 */
+	void Resimulate(uint32_t stepCount, const Time &timeStep, const std::function<void(uint32_t)> &onStep = {});
+
 	btBroadphaseInterface *GetBroadphase() { return broadphase.get(); }
 
 	btDiscreteDynamicsWorld *GetDynamicsWorld() { return dynamicsWorld.get(); }
 
+	/**
+	 * Gets the collision events found in the last update, ordered by pair, the list is rebuilt every update.
+	 * @return The collision events.
+	 */
+	const std::vector<CollisionEvent> &GetCollisionEvents() const { return collisionEvents; }
+
+	const PhysicsSettings &GetSettings() const { return settings; }
+	bool IsMultithreaded() const { return solverPool != nullptr; }
+
 private:
+	friend class CollisionObject;
+
+	void AddForceObject(CollisionObject *object);
+	void RemoveForceObject(CollisionObject *object);
 	void CheckForCollisionEvents();
 
+	PhysicsSettings settings;
 	std::unique_ptr<btCollisionConfiguration> collisionConfiguration;
 	std::unique_ptr<btBroadphaseInterface> broadphase;
 	std::unique_ptr<btCollisionDispatcher> dispatcher;
 	std::unique_ptr<btConstraintSolver> solver;
+	std::unique_ptr<btConstraintSolverPoolMt> solverPool;
 	std::unique_ptr<btDiscreteDynamicsWorld> dynamicsWorld;
-	CollisionPairs pairsLastUpdate;
+	// Sorted pairs touching in the current and last update, swapped every update so their storage is reused.
+	std::vector<CollisionPair> pairsThisUpdate;
+	std::vector<CollisionPair> pairsLastUpdate;
+	std::vector<CollisionEvent> collisionEvents;
+	// Objects that have forces to apply, objects leave once their forces have expired.
+	std::vector<CollisionObject *> forceObjects;
 
 	Vector3f gravity;
 	float airDensity;
@@ -4,7 +4,7 @@
 #include <BulletCollision/CollisionShapes/btCompoundShape.h>
 #include <BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
 #include <BulletDynamics/Dynamics/btRigidBody.h>
-#include <LinearMath/btDefaultMotionState.h>
+#include <LinearMath/btMotionState.h>
 #include "Maths/Transform.hpp"
 #include "Scenes/Entity.hpp"
 #include "Scenes/Scenes.hpp"
@@ -12,6 +12,39 @@
 #include "Physics.hpp"
 
 namespace acid {
+/**
+ * @brief Writes a bodies simulated transform and velocities into its rigidbody, Bullet only calls this for active bodies.
+ */
+class RigidbodyMotionState : public btMotionState {
+public:
+	explicit RigidbodyMotionState(Rigidbody *rigidbody) :
+		rigidbody(rigidbody) {
+	}
+
+	void getWorldTransform(btTransform &worldTrans) const override {
+		worldTrans = Collider::Convert(*rigidbody->transform);
+	}
+
+	void setWorldTransform(const btTransform &worldTrans) override {
+		auto &transform = *rigidbody->transform;
+		float yaw, pitch, roll;
+		worldTrans.getBasis().getEulerYPR(yaw, pitch, roll);
+		transform.SetLocalPosition(Collider::Convert(worldTrans.getOrigin()));
+		transform.SetLocalRotation({pitch, yaw, roll});
+
+		if (transform.GetLocalScale() != rigidbody->scale) {
+			rigidbody->scale = transform.GetLocalScale();
+			rigidbody->shape->setLocalScaling(Collider::Convert(rigidbody->scale));
+		}
+
+		rigidbody->linearVelocity = Collider::Convert(rigidbody->rigidBody->getLinearVelocity());
+		rigidbody->angularVelocity = Collider::Convert(rigidbody->rigidBody->getAngularVelocity());
+	}
+
+private:
+	Rigidbody *rigidbody;
+};
+
 Rigidbody::Rigidbody(std::unique_ptr<Collider> &&collider, float mass, float friction, const Vector3f &linearFactor, const Vector3f &angularFactor) :
 	CollisionObject({}, mass, friction, linearFactor, angularFactor) {
 	AddCollider(std::move(collider));
@@ -40,10 +73,13 @@ void Rigidbody::Start() {
 	if (mass != 0.0f)
 		shape->calculateLocalInertia(mass, localInertia);
 
-	auto worldTransform = Collider::Convert(*GetEntity()->GetComponent<Transform>());
+	transform = GetEntity()->GetComponent<Transform>();
+	scale = transform->GetLocalScale();
+	shape->setLocalScaling(Collider::Convert(scale));
+	auto worldTransform = Collider::Convert(*transform);
 
-	// Using motionstate is recommended, it provides interpolation capabilities, and only synchronizes 'active' objects.
-	auto motionState = new btDefaultMotionState(worldTransform);
+	// The motion state provides interpolation, and is only synchronized for active bodies.
+	auto motionState = new RigidbodyMotionState(this);
 	btRigidBody::btRigidBodyConstructionInfo cInfo(mass, motionState, shape.get(), localInertia);
 
 	rigidBody = std::make_unique<btRigidBody>(cInfo);
@@ -63,35 +99,6 @@ void Rigidbody::Start() {
 	RecalculateMass();
 }
 
-void Rigidbody::Update() {
-	if (shape.get() != body->getCollisionShape())
-		body->setCollisionShape(shape.get());
-
-	auto delta = Engine::Get()->GetDelta();
-
-	for (auto it = forces.begin(); it != forces.end();) {
-		(*it)->Update(delta);
-		rigidBody->applyForce(Collider::Convert((*it)->GetForce()), Collider::Convert((*it)->GetPosition()));
-
-		if ((*it)->IsExpired()) {
-			it = forces.erase(it);
-			continue;
-		}
-
-		++it;
-	}
-
-	auto &transform = *GetEntity()->GetComponent<Transform>();
-	btTransform motionTransform;
-	rigidBody->getMotionState()->getWorldTransform(motionTransform);
-	transform = Collider::Convert(motionTransform, transform.GetScale());
-
-	shape->setLocalScaling(Collider::Convert(transform.GetScale()));
-	//rigidBody->getMotionState()->setWorldTransform(Collider::Convert(transform));
-	linearVelocity = Collider::Convert(rigidBody->getLinearVelocity());
-	angularVelocity = Collider::Convert(rigidBody->getAngularVelocity());
-}
-
 bool Rigidbody::InFrustum(const Frustum &frustum) {
 	btVector3 min;
 	btVector3 max;
@@ -103,6 +110,8 @@ bool Rigidbody::InFrustum(const Frustum &frustum) {
 }
 
 void Rigidbody::ClearForces() {
+	// The physics system drops the object from its force pass on the next update.
+	forces.clear();
 	if (rigidBody)
 		rigidBody->clearForces();
 }
@@ -169,6 +178,25 @@ Node &operator<<(Node &node, const Rigidbody &rigidbody) {
 	return node;
 }
 
+bool Rigidbody::ApplyForces(const Time &delta) {
+	if (!rigidBody)
+		return !forces.empty();
+
+	for (auto it = forces.begin(); it != forces.end();) {
+		(*it)->Update(delta);
+		rigidBody->applyForce(Collider::Convert((*it)->GetForce()), Collider::Convert((*it)->GetPosition()));
+
+		if ((*it)->IsExpired()) {
+			it = forces.erase(it);
+			continue;
+		}
+
+		++it;
+	}
+
+	return !forces.empty();
+}
+
 void Rigidbody::RecalculateMass() {
 	if (!rigidBody) return;
 
@@ -4,15 +4,16 @@
 #include "Scenes/Component.hpp"
 #include "CollisionObject.hpp"
 
-struct btDefaultMotionState;
 class btRigidBody;
 
 namespace acid {
 /**
  * @brief Represents a object in a scene effected by physics.
+ * The entities transform is written by Bullet when the body moves, so sleeping bodies cost nothing per frame.
  */
 class ACID_EXPORT Rigidbody : public Component::Registrar<Rigidbody>, public CollisionObject {
 	inline static const bool Registered = Register("rigidbody");
+	friend class RigidbodyMotionState;
 public:
 	/**
 	 * Creates a new rigidbody.
@@ -27,7 +28,6 @@ public:
 	~Rigidbody();
 
 	void Start() override;
-	void Update() override;
 
 	bool InFrustum(const Frustum &frustum) override;
 	void ClearForces() override;
@@ -43,8 +43,11 @@ public:
 
 protected:
 	void RecalculateMass() override;
+	bool ApplyForces(const Time &delta) override;
 
 private:
 	std::unique_ptr<btRigidBody> rigidBody;
+	Transform *transform = nullptr;
+	Vector3f scale;
 };
 }
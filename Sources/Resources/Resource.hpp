@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <typeindex>
 
 #include "Utils/NonCopyable.hpp"
@@ -10,16 +11,57 @@ namespace acid {
  * @brief A managed resource object. Implementations contain Create functions that can take a node object or pass parameters to the constructor.
  */
 class ACID_EXPORT Resource : NonCopyable {
+	friend class Resources;
 public:
 	Resource() = default;
 	virtual ~Resource() = default;
 
 	virtual std::type_index GetTypeIndex() const = 0;
-	
+
+	/**
+	 * Gets the amount of host memory held by this resource, used for cache budgets.
+	 * @return The size in bytes.
+	 */
+	virtual std::size_t GetCpuMemoryUsage() const { return 0; }
+
+	/**
+	 * Gets the amount of device memory held by this resource, used for cache budgets.
+	 * @return The size in bytes.
+	 */
+	virtual std::size_t GetGpuMemoryUsage() const { return 0; }
+
+	/**
+	 * Gets if the resource has finished loading, resources from {@link Resources#LoadAsync} are empty placeholders until then.
+	 * @return If the resource is loaded.
+	 */
+	bool IsLoaded() const { return loaded; }
+
+	/**
+	 * Gets if loading the resource failed, a failed resource is still loaded but holds no data.
+	 * @return If the resource failed to load.
+	 */
+	bool IsFailed() const { return failed; }
+
 	/*template<typename T>
 	friend auto operator>>(const Node &node, std::shared_ptr<T> &object) -> std::enable_if_t<std::is_base_of_v<Resource, T>, const Node &> {
 		object = T::Create(node);
 		return node;
 	}*/
+
+protected:
+	/**
+	 * Reads and decodes the resource data, called from a resource worker thread when loaded asynchronously.
+	 * No device objects may be created and no state read by the main thread may be written here.
+	 */
+	virtual void Decode() {}
+
+	/**
+	 * Uploads the decoded data to the device, called on the main thread in the resource transfer step.
+	 */
+	virtual void Upload() {}
+
+private:
+	std::atomic<bool> loaded = true;
+	std::atomic<bool> failed = false;
 };
 }
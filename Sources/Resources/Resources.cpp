@@ -1,58 +1,256 @@
 #include "Resources.hpp"
 
+#include <algorithm>
+
+#include "Maths/Maths.hpp"
+
 namespace acid {
+/**
+ * Hashes a node into a canonical key, object properties are combined independent of their order.
+ * @param node The node to hash.
+ * @return The nodes hash.
+ */
+static std::size_t HashNode(const Node &node) {
+	std::size_t seed = 0;
+	Maths::HashCombine(seed, node.GetValue());
+
+	std::size_t unordered = 0;
+	for (const auto &[name, property] : node.GetProperties()) {
+		auto propertyHash = HashNode(property);
+		if (node.GetType() == NodeType::Array) {
+			Maths::HashCombine(seed, propertyHash);
+		} else {
+			Maths::HashCombine(propertyHash, name);
+			unordered += propertyHash;
+		}
+	}
+
+	Maths::HashCombine(seed, unordered);
+	return seed;
+}
+
+/**
+ * Compares two nodes in their canonical form, object properties may appear in any order.
+ * @param left The first node.
+ * @param right The second node.
+ * @return If the nodes hold the same values.
+ */
+static bool CanonicalEqual(const Node &left, const Node &right) {
+	if (left.GetValue() != right.GetValue() || left.GetProperties().size() != right.GetProperties().size())
+		return false;
+
+	if (left.GetType() == NodeType::Array) {
+		return std::equal(left.GetProperties().begin(), left.GetProperties().end(), right.GetProperties().begin(), [](const auto &a, const auto &b) {
+			return CanonicalEqual(a.second, b.second);
+		});
+	}
+
+	for (const auto &[name, property] : left.GetProperties()) {
+		auto it = std::find_if(right.GetProperties().begin(), right.GetProperties().end(), [&name = name](const auto &p) {
+			return p.first == name;
+		});
+		if (it == right.GetProperties().end() || !CanonicalEqual(property, it->second))
+			return false;
+	}
+
+	return true;
+}
+
 Resources::Resources() :
 	elapsedPurge(5s) {
 }
 
 void Resources::Update() {
+	std::unique_lock<std::recursive_mutex> lock(mutex);
+
+	// Transfer step, decoded resources are uploaded on the main thread.
+	std::vector<std::shared_ptr<Resource>> ready;
+	{
+		std::unique_lock<std::mutex> uploadLock(uploadMutex);
+		ready.swap(uploads);
+	}
+	for (const auto &resource : ready) {
+		if (!resource->failed)
+			resource->Upload();
+		resource->loaded = true;
+		unmeasured.emplace_back(resource);
+	}
+
+	// Runs after the transfer step, so resources whose dependencies were uploaded just now start decoding in the same update.
+	UpdateWaiting();
+
+	for (const auto &weak : unmeasured) {
+		auto resource = weak.lock();
+		if (!resource)
+			continue;
+		if (auto it = owners.find(resource.get()); it != owners.end())
+			Measure(caches[resource->GetTypeIndex()], *it->second);
+	}
+	unmeasured.clear();
+
 	if (elapsedPurge.GetElapsed() != 0) {
-		for (auto it = resources.begin(); it != resources.end();) {
-			for (auto it1 = it->second.begin(); it1 != it->second.end();) {
-				if ((*it1).second.use_count() <= 1) {
-					it1 = it->second.erase(it1);
-					continue;
-				}
-
-				++it1;
-			}
-
-			if (it->second.empty()) {
-				it = resources.erase(it);
-				continue;
-			}
-			
-			++it;
-		}
+		for (auto &[typeIndex, cache] : caches)
+			Evict(cache);
 	}
 }
 
-std::shared_ptr<Resource> Resources::Find(const std::type_index &typeIndex, const Node &node) const {
-	if (resources.find(typeIndex) == resources.end())
-		return nullptr;
+std::shared_ptr<Resource> Resources::Find(const std::type_index &typeIndex, const Node &node) {
+	std::unique_lock<std::recursive_mutex> lock(mutex);
+	// The first lookup of a type creates its cache, so that miss is counted as well.
+	auto &cache = caches[typeIndex];
+	auto [begin, end] = cache.index.equal_range(HashNode(node));
+	for (auto match = begin; match != end; ++match) {
+		if (!CanonicalEqual(match->second->node, node))
+			continue;
 
-	for (const auto &[key, resource] : resources.at(typeIndex)) {
-		if (key == node)
-			return resource;
+		// Moves the entry to the front of the use list, the list iterator stays valid.
+		cache.entries.splice(cache.entries.begin(), cache.entries, match->second);
+		cache.stats.hits++;
+		return match->second->resource;
 	}
 
+	cache.stats.misses++;
 	return nullptr;
 }
 
 void Resources::Add(const Node &node, const std::shared_ptr<Resource> &resource) {
-	if (Find(resource->GetTypeIndex(), node))
+	std::unique_lock<std::recursive_mutex> lock(mutex);
+	if (owners.find(resource.get()) != owners.end())
 		return;
 
-	resources[resource->GetTypeIndex()].emplace(node, resource);
+	auto typeIndex = resource->GetTypeIndex();
+	auto hash = HashNode(node);
+	auto &cache = caches[typeIndex];
+
+	auto [begin, end] = cache.index.equal_range(hash);
+	for (auto match = begin; match != end; ++match) {
+		if (CanonicalEqual(match->second->node, node))
+			return;
+	}
+
+	auto entry = cache.entries.emplace(cache.entries.begin(), Entry{node, hash, resource});
+	cache.index.emplace(hash, entry);
+	cache.stats.count++;
+	owners.emplace(resource.get(), entry);
+	unmeasured.emplace_back(resource);
 }
 
 void Resources::Remove(const std::shared_ptr<Resource> &resource) {
-	auto &resources = this->resources[resource->GetTypeIndex()];
-	for (auto it = resources.begin(); it != resources.end(); ++it) { // TODO: Clean remove.
-		if ((*it).second == resource)
-			resources.erase(it);
+	std::unique_lock<std::recursive_mutex> lock(mutex);
+	auto it = owners.find(resource.get());
+	if (it == owners.end())
+		return;
+
+	Erase(caches[resource->GetTypeIndex()], it->second);
+}
+
+ResourceStats Resources::GetStats(const std::type_index &typeIndex) const {
+	std::unique_lock<std::recursive_mutex> lock(mutex);
+	if (auto it = caches.find(typeIndex); it != caches.end())
+		return it->second.stats;
+	return {};
+}
+
+ResourceStats Resources::GetStats() const {
+	std::unique_lock<std::recursive_mutex> lock(mutex);
+	ResourceStats stats;
+	for (const auto &[typeIndex, cache] : caches)
+		stats += cache.stats;
+	return stats;
+}
+
+void Resources::SetBudget(const std::type_index &typeIndex, std::size_t budget) {
+	std::unique_lock<std::recursive_mutex> lock(mutex);
+	auto &cache = caches[typeIndex];
+	cache.budget = budget;
+	Evict(cache);
+}
+
+void Resources::Enqueue(const Node &node, const std::shared_ptr<Resource> &resource, const std::vector<std::shared_ptr<Resource>> &dependencies) {
+	resource->loaded = false;
+	resource->failed = false;
+	Add(node, resource);
+
+	// Dependencies already exist, so a resource can never wait on itself or on a resource waiting on it.
+	waiting.emplace_back(Waiting{resource, dependencies});
+	UpdateWaiting();
+}
+
+void Resources::Decode(const std::shared_ptr<Resource> &resource) {
+	// The task holds a reference so the resource can't be evicted while decoding.
+	threadPool.Enqueue([this, resource] {
+		try {
+			resource->Decode();
+		} catch (const std::exception &e) {
+			Log::Error("Resource could not be decoded: ", e.what(), '\n');
+			// Still goes through the transfer step, so the resource is marked loaded and nothing waits on it forever.
+			resource->failed = true;
+		}
+
+		std::unique_lock<std::mutex> lock(uploadMutex);
+		uploads.emplace_back(resource);
+	});
+}
+
+void Resources::UpdateWaiting() {
+	for (auto it = waiting.begin(); it != waiting.end();) {
+		const auto &dependencies = it->dependencies;
+		if (std::any_of(dependencies.begin(), dependencies.end(), [](const auto &dependency) { return dependency->IsFailed(); })) {
+			Log::Error("Resource could not be loaded, a dependency failed to load\n");
+			it->resource->failed = true;
+			it->resource->loaded = true;
+		} else if (std::all_of(dependencies.begin(), dependencies.end(), [](const auto &dependency) { return dependency->IsLoaded(); })) {
+			Decode(it->resource);
+		} else {
+			++it;
+			continue;
+		}
+
+		it = waiting.erase(it);
 	}
-	if (resources.empty())
-		this->resources.erase(resource->GetTypeIndex());
+}
+
+void Resources::Measure(Cache &cache, Entry &entry) {
+	cache.stats.cpuBytes -= entry.cpuBytes;
+	cache.stats.gpuBytes -= entry.gpuBytes;
+	entry.cpuBytes = entry.resource->GetCpuMemoryUsage();
+	entry.gpuBytes = entry.resource->GetGpuMemoryUsage();
+	cache.stats.cpuBytes += entry.cpuBytes;
+	cache.stats.gpuBytes += entry.gpuBytes;
+}
+
+void Resources::Evict(Cache &cache) {
+	auto budget = cache.budget.value_or(defaultBudget);
+
+	// Walks from the least recently used entry, only resources held by nothing but the cache can be evicted.
+	for (auto it = cache.entries.end(); it != cache.entries.begin();) {
+		if (budget != 0 && cache.stats.cpuBytes + cache.stats.gpuBytes <= budget)
+			break;
+
+		--it;
+		if (it->resource.use_count() > 1)
+			continue;
+
+		auto next = std::next(it);
+		Erase(cache, it);
+		cache.stats.evictions++;
+		it = next;
+	}
+}
+
+void Resources::Erase(Cache &cache, std::list<Entry>::iterator it) {
+	auto [begin, end] = cache.index.equal_range(it->hash);
+	for (auto match = begin; match != end; ++match) {
+		if (match->second == it) {
+			cache.index.erase(match);
+			break;
+		}
+	}
+
+	cache.stats.count--;
+	cache.stats.cpuBytes -= it->cpuBytes;
+	cache.stats.gpuBytes -= it->gpuBytes;
+	owners.erase(it->resource.get());
+	cache.entries.erase(it);
 }
 }
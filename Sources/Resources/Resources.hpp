@@ -1,5 +1,8 @@
 #pragma once
 
+#include <list>
+#include <mutex>
+#include <optional>
 #include <unordered_map>
 
 #include "Engine/Engine.hpp"
@@ -9,9 +12,34 @@
 #include "Resource.hpp"
 
 namespace acid {
+/**
+ * @brief Counters describing the state of a resource cache, used for telemetry.
+ */
+class ACID_EXPORT ResourceStats {
+public:
+	ResourceStats &operator+=(const ResourceStats &rhs) {
+		hits += rhs.hits;
+		misses += rhs.misses;
+		evictions += rhs.evictions;
+		count += rhs.count;
+		cpuBytes += rhs.cpuBytes;
+		gpuBytes += rhs.gpuBytes;
+		return *this;
+	}
+
+	std::size_t hits = 0;
+	std::size_t misses = 0;
+	std::size_t evictions = 0;
+	std::size_t count = 0;
+	std::size_t cpuBytes = 0;
+	std::size_t gpuBytes = 0;
+};
+
 /**
  * @brief Module used for managing resources. Resources are held alive as long as they are in use,
- * a existing resource is queried by node value.
+ * a existing resource is queried by node value. Each resource type is kept in a hashed cache ordered by use,
+ * resources no longer in use are evicted least recently used first once the types memory budget is exceeded.
+ * Resources may be loaded asynchronously, decoding happens on the resource thread pool and uploading in the modules update.
  */
 class ACID_EXPORT Resources : public Module::Registrar<Resources> {
 	inline static const bool Registered = Register(Stage::Post, Requires<Files>());
@@ -20,24 +48,67 @@ public:
 
 	void Update() override;
 
-	std::shared_ptr<Resource> Find(const std::type_index &typeIndex, const Node &node) const;
+	std::shared_ptr<Resource> Find(const std::type_index &typeIndex, const Node &node);
 
 	template<typename T>
-	std::shared_ptr<T> Find(const Node &node) const {
-		if (resources.find(typeid(T)) == resources.end())
-			return nullptr;
-		
-		for (const auto &[key, resource] : resources.at(typeid(T))) {
-			if (key == node)
-				return std::dynamic_pointer_cast<T>(resource);
-		}
-		
-		return nullptr;
+	std::shared_ptr<T> Find(const Node &node) {
+		return std::dynamic_pointer_cast<T>(Find(typeid(T), node));
 	}
-	
+
+	/**
+	 * Loads a resource asynchronously, or finds one with the same values. The returned resource is an empty placeholder
+	 * until {@link Resource#IsLoaded}, concurrent requests for the same node share the same resource.
+	 * Decoding starts once every dependency has loaded, if a dependency fails the resource fails without being decoded.
+	 * @tparam T The resource type, it must be constructible from an empty filename.
+	 * @param node The node to decode values from.
+	 * @param dependencies The resources that have to be loaded before this resource is decoded.
+	 * @return The resource with the requested values.
+	 */
+	template<typename T>
+	std::shared_ptr<T> LoadAsync(const Node &node, const std::vector<std::shared_ptr<Resource>> &dependencies = {}) {
+		std::unique_lock<std::recursive_mutex> lock(mutex);
+		if (auto resource = Find<T>(node))
+			return resource;
+
+		auto result = std::make_shared<T>("");
+		node >> *result;
+		Enqueue(node, result, dependencies);
+		return result;
+	}
+
 	void Add(const Node &node, const std::shared_ptr<Resource> &resource);
 	void Remove(const std::shared_ptr<Resource> &resource);
 
+	/**
+	 * Gets the cache counters for a resource type.
+	 * @param typeIndex The resource type.
+	 * @return The resource types counters.
+	 */
+	ResourceStats GetStats(const std::type_index &typeIndex) const;
+
+	template<typename T>
+	ResourceStats GetStats() const { return GetStats(typeid(T)); }
+
+	/**
+	 * Gets the cache counters summed over all resource types.
+	 * @return The combined counters.
+	 */
+	ResourceStats GetStats() const;
+
+	/**
+	 * Sets the amount of CPU and GPU memory unused resources of a type may hold before being evicted.
+	 * A budget of zero evicts resources as soon as they are no longer in use.
+	 * @param typeIndex The resource type.
+	 * @param budget The budget in bytes.
+	 */
+	void SetBudget(const std::type_index &typeIndex, std::size_t budget);
+
+	template<typename T>
+	void SetBudget(std::size_t budget) { SetBudget(typeid(T), budget); }
+
+	std::size_t GetDefaultBudget() const { return defaultBudget; }
+	void SetDefaultBudget(std::size_t defaultBudget) { this->defaultBudget = defaultBudget; }
+
 	/**
 	 * Gets the resource loader thread pool.
 	 * @return The resource loader thread pool.
@@ -45,8 +116,51 @@ public:
 	ThreadPool &GetThreadPool() { return threadPool; }
 
 private:
-	std::unordered_map<std::type_index, std::map<Node, std::shared_ptr<Resource>>> resources;
+	class Entry {
+	public:
+		Node node;
+		std::size_t hash;
+		std::shared_ptr<Resource> resource;
+		std::size_t cpuBytes = 0;
+		std::size_t gpuBytes = 0;
+	};
+
+	class Cache {
+	public:
+		// Most recently used entries are at the front.
+		std::list<Entry> entries;
+		std::unordered_multimap<std::size_t, std::list<Entry>::iterator> index;
+		std::optional<std::size_t> budget;
+		ResourceStats stats;
+	};
+
+	class Waiting {
+	public:
+		std::shared_ptr<Resource> resource;
+		std::vector<std::shared_ptr<Resource>> dependencies;
+	};
+
+	void Enqueue(const Node &node, const std::shared_ptr<Resource> &resource, const std::vector<std::shared_ptr<Resource>> &dependencies);
+	void Decode(const std::shared_ptr<Resource> &resource);
+	void UpdateWaiting();
+	void Measure(Cache &cache, Entry &entry);
+	void Evict(Cache &cache);
+	void Erase(Cache &cache, std::list<Entry>::iterator it);
+
+	std::unordered_map<std::type_index, Cache> caches;
+	std::unordered_map<const Resource *, std::list<Entry>::iterator> owners;
+	// Resources added since the last update, their memory is measured once loaded.
+	std::vector<std::weak_ptr<Resource>> unmeasured;
+	std::size_t defaultBudget = 0;
 	ElapsedTime elapsedPurge;
+	// Guards the caches, resources may be created from worker threads.
+	mutable std::recursive_mutex mutex;
+
+	// Resources waiting on their dependencies before they are decoded.
+	std::vector<Waiting> waiting;
+	// Decoded resources waiting for the transfer step.
+	std::vector<std::shared_ptr<Resource>> uploads;
+	std::mutex uploadMutex;
 
 	ThreadPool threadPool;
 };
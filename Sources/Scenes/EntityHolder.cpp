@@ -8,14 +8,15 @@ EntityHolder::EntityHolder() {
 }
 
 void EntityHolder::Update() {
-	for (auto it = objects.begin(); it != objects.end();) {
-		if ((*it)->IsRemoved()) {
-			it = objects.erase(it);
+	// Components may create entities while they update, indexing keeps the loop valid when that grows the container.
+	for (std::size_t i = 0; i < objects.size();) {
+		if (objects[i]->IsRemoved()) {
+			objects.erase(objects.begin() + i);
 			continue;
 		}
 
-		(*it)->Update();
-		++it;
+		objects[i]->Update();
+		i++;
 	}
 }
 
@@ -32,10 +32,20 @@ EntityPrefab::EntityPrefab(std::filesystem::path filename, bool load) :
 }
 
 void EntityPrefab::Load() {
+	Decode();
+	Upload();
+}
+
+void EntityPrefab::Decode() {
 	if (filename.empty()) return;
 
-	file = std::make_unique<File>(filename, std::make_unique<Json>());
-	file->Load();
+	decodedFile = std::make_unique<File>(filename, std::make_unique<Json>());
+	decodedFile->Load();
+}
+
+void EntityPrefab::Upload() {
+	if (decodedFile)
+		file = std::move(decodedFile);
 }
 
 void EntityPrefab::Write(NodeFormat::Format format) const {
@@ -43,6 +53,10 @@ void EntityPrefab::Write(NodeFormat::Format format) const {
 }
 
 const EntityPrefab &operator>>(const EntityPrefab &entityPrefab, Entity &entity) {
+	// Prefabs loaded asynchronously have no file until uploaded.
+	if (!entityPrefab.file)
+		return entityPrefab;
+
 	for (const auto &[propertyName, property] : entityPrefab.GetParent().GetProperties()) {
 		if (propertyName.empty()) {
 			continue;
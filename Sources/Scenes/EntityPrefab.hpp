@@ -46,8 +46,13 @@ public:
 	friend const Node &operator>>(const Node &node, EntityPrefab &entityPrefab);
 	friend Node &operator<<(Node &node, const EntityPrefab &entityPrefab);
 
+protected:
+	void Decode() override;
+	void Upload() override;
+
 private:
 	std::filesystem::path filename;
 	std::unique_ptr<File> file;
+	std::unique_ptr<File> decodedFile;
 };
 }
@@ -1,52 +1,222 @@
 #include "Timers.hpp"
 
 namespace acid {
-Timers::Timers() {
+void Timer::Destroy() {
+	if (owner)
+		owner->Destroy(this);
+	else
+		destroyed = true;
+}
+
+Timers::Timers() :
+	start(Time::Now()) {
 	std::unique_lock<std::mutex> lock(mutex);
 	worker = std::thread(std::bind(&Timers::ThreadRun, this));
 }
 
 Timers::~Timers() {
-	stop = true;
+	{
+		// Set under the lock, so the worker is either waiting and gets the notify, or has not checked the predicate yet.
+		std::unique_lock<std::mutex> lock(mutex);
+		stop = true;
+	}
 
 	condition.notify_all();
 	worker.join();
 }
 
 void Timers::Update() {
+	std::vector<Timer *> due;
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		if (mainDue.empty())
+			return;
+		due.swap(mainDue);
+	}
+
+	for (auto timer : due) {
+		if (!timer->destroyed)
+			timer->onTick();
+	}
+
+	std::unique_lock<std::mutex> lock(mutex);
+	for (auto timer : due)
+		Finish(timer);
+	condition.notify_all();
+}
+
+std::size_t Timers::GetTimerCount() {
+	std::unique_lock<std::mutex> lock(mutex);
+	return timers.size();
+}
+
+Timer *Timers::Add(std::unique_ptr<Timer> &&timer) {
+	std::unique_lock<std::mutex> lock(mutex);
+	auto instance = timer.get();
+	instance->owner = this;
+	instance->index = timers.size();
+	timers.emplace_back(std::move(timer));
+	// The current tick has already been dispatched.
+	Schedule(instance, std::max(GetTick(instance->next), currentTick + 1));
+	condition.notify_all();
+	return instance;
+}
+
+void Timers::Destroy(Timer *timer) {
+	std::unique_lock<std::mutex> lock(mutex);
+	timer->destroyed = true;
+	// Timers being dispatched are freed once their dispatch finishes.
+	if (timer->slot) {
+		Unlink(timer);
+		Free(timer);
+	}
 }
 
 void Timers::ThreadRun() {
 	std::unique_lock<std::mutex> lock(mutex);
+	std::vector<Timer *> due;
 
 	while (!stop) {
-		if (timers.empty()) {
+		// The last tick that has fully elapsed.
+		auto nowTick = static_cast<uint64_t>(std::max<int64_t>((Time::Now() - start).AsMicroseconds<int64_t>(), 0) / TickDuration.AsMicroseconds<int64_t>());
+		if (scheduled == 0) {
+			// Nothing to cascade, the wheel can jump straight to the present.
+			currentTick = std::max(currentTick, nowTick);
 			condition.wait(lock);
-		} else {
-			std::sort(timers.begin(), timers.end(), [](const auto &a, const auto &b) {
-				return a->next < b->next;
-			});
-
-			auto &instance = timers.front();
-			auto time = Time::Now();
-
-			if (time >= instance->next) {
-				//Log::Error("Timer variation: ", (time - instance->next).AsMilliseconds<float>(), "ms\n");
-				lock.unlock();
-				instance->onTick();
-				lock.lock();
-
-				instance->next += instance->interval;
-
-				if (instance->repeat) {
-					if (--*instance->repeat == 0)
-						timers.erase(std::remove(timers.begin(), timers.end(), instance), timers.end());
-				}
-			} else {
-				std::chrono::microseconds timePoint(instance->next - time);
-				condition.wait_for(lock, timePoint);
+			continue;
+		}
+
+		while (currentTick < nowTick && due.empty())
+			Advance(due);
+
+		if (due.empty()) {
+			auto wakeTime = start + Time::Microseconds(static_cast<int64_t>(GetWakeTick()) * TickDuration.AsMicroseconds<int64_t>());
+			condition.wait_for(lock, std::chrono::microseconds((wakeTime - Time::Now()).AsMicroseconds<int64_t>()));
+			continue;
+		}
+
+		// All timers due on this tick are dispatched together without the lock held.
+		std::size_t mainCount = 0;
+		for (auto timer : due) {
+			if (timer->dispatch == Timer::Dispatch::Main) {
+				mainDue.emplace_back(timer);
+				mainCount++;
 			}
 		}
+
+		lock.unlock();
+		for (auto timer : due) {
+			if (timer->dispatch == Timer::Dispatch::Worker && !timer->destroyed)
+				timer->onTick();
+		}
+		lock.lock();
+
+		for (auto timer : due) {
+			if (timer->dispatch == Timer::Dispatch::Worker)
+				Finish(timer);
+		}
+		due.clear();
 	}
 }
+
+void Timers::Schedule(Timer *timer, uint64_t tick) {
+	auto delta = tick - currentTick;
+	uint32_t level = 0;
+	while (level + 1 < WheelLevels && delta >= uint64_t(1) << (WheelBits * (level + 1)))
+		level++;
+
+	// Timers beyond the last level are parked in its furthest slot, and placed again when that slot cascades.
+	auto maxDelta = (uint64_t(1) << (WheelBits * WheelLevels)) - 1;
+	if (delta > maxDelta)
+		tick = currentTick + maxDelta;
+
+	auto &head = wheel[level][(tick >> (WheelBits * level)) & (WheelSize - 1)];
+	timer->slot = &head;
+	timer->slotPrev = nullptr;
+	timer->slotNext = head;
+	if (head)
+		head->slotPrev = timer;
+	head = timer;
+	scheduled++;
+}
+
+void Timers::Unlink(Timer *timer) {
+	if (timer->slotPrev)
+		timer->slotPrev->slotNext = timer->slotNext;
+	else
+		*timer->slot = timer->slotNext;
+	if (timer->slotNext)
+		timer->slotNext->slotPrev = timer->slotPrev;
+
+	timer->slot = nullptr;
+	timer->slotPrev = nullptr;
+	timer->slotNext = nullptr;
+	scheduled--;
+}
+
+void Timers::Advance(std::vector<Timer *> &due) {
+	currentTick++;
+
+	// Higher levels cascade first, since they may fill the lower level slots reached on this tick.
+	for (auto level = WheelLevels - 1; level > 0; level--) {
+		if ((currentTick & ((uint64_t(1) << (WheelBits * level)) - 1)) != 0)
+			continue;
+
+		auto &head = wheel[level][(currentTick >> (WheelBits * level)) & (WheelSize - 1)];
+		auto timer = head;
+		head = nullptr;
+		while (timer) {
+			auto slotNext = timer->slotNext;
+			scheduled--;
+			Schedule(timer, std::max(GetTick(timer->next), currentTick));
+			timer = slotNext;
+		}
+	}
+
+	auto &head = wheel[0][currentTick & (WheelSize - 1)];
+	for (auto timer = head; timer; timer = timer->slotNext) {
+		timer->slot = nullptr;
+		scheduled--;
+		due.emplace_back(timer);
+	}
+	head = nullptr;
+}
+
+void Timers::Finish(Timer *timer) {
+	if (timer->destroyed || (timer->repeat && --*timer->repeat == 0)) {
+		Free(timer);
+		return;
+	}
+
+	timer->next += timer->interval;
+	Schedule(timer, std::max(GetTick(timer->next), currentTick + 1));
+}
+
+void Timers::Free(Timer *timer) {
+	// Swaps the timer with the last one so removal is constant time.
+	auto index = timer->index;
+	if (index != timers.size() - 1) {
+		std::swap(timers[index], timers.back());
+		timers[index]->index = index;
+	}
+	timers.pop_back();
+}
+
+uint64_t Timers::GetTick(const Time &time) const {
+	auto elapsed = (time - start).AsMicroseconds<int64_t>();
+	if (elapsed <= 0)
+		return 0;
+	// Rounds up, so a timer is never dispatched before it is due.
+	auto tickDuration = TickDuration.AsMicroseconds<int64_t>();
+	return static_cast<uint64_t>((elapsed + tickDuration - 1) / tickDuration);
+}
+
+uint64_t Timers::GetWakeTick() const {
+	for (uint64_t tick = currentTick + 1; tick <= (currentTick | (WheelSize - 1)); tick++) {
+		if (wheel[0][tick & (WheelSize - 1)])
+			return tick;
+	}
+
+	return (currentTick | (WheelSize - 1)) + 1;
+}
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <mutex>
@@ -11,95 +12,156 @@
 #include "Maths/Time.hpp"
 
 namespace acid {
+class Timers;
+
 class ACID_EXPORT Timer {
 	friend class Timers;
 public:
-	Timer(const Time &interval, const std::optional<uint32_t> &repeat) :
+	/**
+	 * @brief The thread a timers callbacks are called on.
+	 */
+	enum class Dispatch : uint8_t {
+		/// On the timers thread, as soon as the timer is due.
+		Worker,
+		/// On the main thread, during the {@link Module::Stage::Pre} update after the timer is due.
+		Main
+	};
+
+	Timer(const Time &interval, const std::optional<uint32_t> &repeat, Dispatch dispatch = Dispatch::Worker) :
 		interval(interval),
 		next(Time::Now() + interval),
-		repeat(repeat) {
+		repeat(repeat),
+		dispatch(dispatch) {
 	}
 
 	const Time &GetInterval() const { return interval; }
 	const std::optional<uint32_t> &GetRepeat() const { return repeat; }
+	Dispatch GetDispatch() const { return dispatch; }
 	bool IsDestroyed() const { return destroyed; }
-	void Destroy() { destroyed = true; }
+	/**
+	 * Cancels the timer, it will not tick again and is freed by the timers module.
+	 */
+	void Destroy();
 	rocket::signal<void()> &OnTick() { return onTick; };
 
 private:
 	Time interval;
 	Time next;
 	std::optional<uint32_t> repeat;
-	bool destroyed = false;
+	Dispatch dispatch;
+	std::atomic<bool> destroyed = false;
 	rocket::signal<void()> onTick;
+
+	Timers *owner = nullptr;
+	std::size_t index = 0;
+	// The wheel slot list this timer is linked into, null while the timer is being dispatched.
+	Timer **slot = nullptr;
+	Timer *slotPrev = nullptr;
+	Timer *slotNext = nullptr;
 };
 
 /**
- * @brief Module used for timed events.
+ * @brief Module used for timed events. Timers are kept in a hierarchical timing wheel,
+ * so adding and destroying timers is constant time, and all timers due in the same tick are dispatched together.
  */
 class ACID_EXPORT Timers : public Module::Registrar<Timers> {
-	inline static const bool Registered = Register(Stage::Post);
+	inline static const bool Registered = Register(Stage::Pre);
+	friend class Timer;
 public:
+	/// The resolution of the wheel, timers never tick early but may tick up to this late.
+	static constexpr Time TickDuration = 1ms;
+	static constexpr uint32_t WheelBits = 8;
+	static constexpr uint32_t WheelSize = 1 << WheelBits;
+	static constexpr uint32_t WheelLevels = 4;
+
 	Timers();
 	~Timers();
 
 	void Update() override;
 
 	template<class Instance>
-	Timer *Once(Instance *object, std::function<void()> &&function, const Time &delay) {
-		std::unique_lock<std::mutex> lock(mutex);
-		auto &instance = timers.emplace_back(std::make_unique<Timer>(delay, 1));
+	Timer *Once(Instance *object, std::function<void()> &&function, const Time &delay, Timer::Dispatch dispatch = Timer::Dispatch::Worker) {
+		auto instance = std::make_unique<Timer>(delay, 1, dispatch);
 		instance->onTick.connect(object, std::move(function));
-		condition.notify_all();
-		return instance.get();
+		return Add(std::move(instance));
 	}
 
 	template<class Instance>
-	Timer *Every(Instance *object, std::function<void()> &&function, const Time &interval) {
-		std::unique_lock<std::mutex> lock(mutex);
-		auto &instance = timers.emplace_back(std::make_unique<Timer>(interval, std::nullopt));
+	Timer *Every(Instance *object, std::function<void()> &&function, const Time &interval, Timer::Dispatch dispatch = Timer::Dispatch::Worker) {
+		auto instance = std::make_unique<Timer>(interval, std::nullopt, dispatch);
 		instance->onTick.connect(object, std::move(function));
-		condition.notify_all();
-		return instance.get();
+		return Add(std::move(instance));
 	}
 
 	template<class Instance>
-	Timer *Repeat(Instance *object, std::function<void()> &&function, const Time &interval, uint32_t repeat) {
-		std::unique_lock<std::mutex> lock(mutex);
-		auto &instance = timers.emplace_back(std::make_unique<Timer>(interval, repeat));
+	Timer *Repeat(Instance *object, std::function<void()> &&function, const Time &interval, uint32_t repeat, Timer::Dispatch dispatch = Timer::Dispatch::Worker) {
+		auto instance = std::make_unique<Timer>(interval, repeat, dispatch);
 		instance->onTick.connect(object, std::move(function));
-		condition.notify_all();
-		return instance.get();
+		return Add(std::move(instance));
 	}
 
-	Timer *Once(std::function<void()> &&function, const Time &delay) {
-		std::unique_lock<std::mutex> lock(mutex);
-		auto &instance = timers.emplace_back(std::make_unique<Timer>(delay, 1));
+	Timer *Once(std::function<void()> &&function, const Time &delay, Timer::Dispatch dispatch = Timer::Dispatch::Worker) {
+		auto instance = std::make_unique<Timer>(delay, 1, dispatch);
 		instance->onTick.connect(std::move(function));
-		condition.notify_all();
-		return instance.get();
+		return Add(std::move(instance));
 	}
 
-	Timer *Every(std::function<void()> &&function, const Time &interval) {
-		std::unique_lock<std::mutex> lock(mutex);
-		auto &instance = timers.emplace_back(std::make_unique<Timer>(interval, std::nullopt));
+	Timer *Every(std::function<void()> &&function, const Time &interval, Timer::Dispatch dispatch = Timer::Dispatch::Worker) {
+		auto instance = std::make_unique<Timer>(interval, std::nullopt, dispatch);
 		instance->onTick.connect(std::move(function));
-		condition.notify_all();
-		return instance.get();
+		return Add(std::move(instance));
 	}
 
-	Timer *Repeat(std::function<void()> &&function, const Time &interval, uint32_t repeat) {
-		std::unique_lock<std::mutex> lock(mutex);
-		auto &instance = timers.emplace_back(std::make_unique<Timer>(interval, repeat));
+	Timer *Repeat(std::function<void()> &&function, const Time &interval, uint32_t repeat, Timer::Dispatch dispatch = Timer::Dispatch::Worker) {
+		auto instance = std::make_unique<Timer>(interval, repeat, dispatch);
 		instance->onTick.connect(std::move(function));
-		condition.notify_all();
-		return instance.get();
+		return Add(std::move(instance));
 	}
 
+	/**
+	 * Gets the amount of timers that have not finished or been destroyed.
+	 * @return The amount of live timers.
+	 */
+	std::size_t GetTimerCount();
+
 private:
+	Timer *Add(std::unique_ptr<Timer> &&timer);
+	void Destroy(Timer *timer);
+
 	void ThreadRun();
 
+	/**
+	 * Links a timer into the wheel slot for its next tick.
+	 * @param timer The timer to schedule.
+	 * @param tick The tick the timer is due on, at least the current tick.
+	 */
+	void Schedule(Timer *timer, uint64_t tick);
+	void Unlink(Timer *timer);
+	/**
+	 * Advances the wheel by one tick, cascading higher levels and collecting the timers due on the tick.
+	 * @param due The list to append due timers to.
+	 */
+	void Advance(std::vector<Timer *> &due);
+	/**
+	 * Reschedules a timer after it has been dispatched, or frees it when it has finished or was destroyed.
+	 * @param timer The dispatched timer.
+	 */
+	void Finish(Timer *timer);
+	void Free(Timer *timer);
+	uint64_t GetTick(const Time &time) const;
+	/**
+	 * Finds the tick the timers thread next needs to wake on, either the next occupied slot or the next cascade.
+	 * @return The tick to wake on.
+	 */
+	uint64_t GetWakeTick() const;
+
 	std::vector<std::unique_ptr<Timer>> timers;
+	std::array<std::array<Timer *, WheelSize>, WheelLevels> wheel = {};
+	std::size_t scheduled = 0;
+	Time start;
+	uint64_t currentTick = 0;
+
+	std::vector<Timer *> mainDue;
 
 	std::atomic_bool stop = false;
 	std::thread worker;
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace acid {
+/**
+ * @brief A non-owning view over a contiguous sequence of objects, a subset of C++20 std::span.
+ * @tparam T The type of the viewed elements.
+ */
+template<typename T>
+class Span {
+public:
+	using element_type = T;
+	using value_type = std::remove_cv_t<T>;
+	using pointer = T *;
+	using reference = T &;
+	using iterator = T *;
+
+	constexpr Span() noexcept = default;
+	constexpr Span(T *data, std::size_t size) noexcept :
+		ptr(data),
+		count(size) {
+	}
+	constexpr Span(T *first, T *last) noexcept :
+		ptr(first),
+		count(static_cast<std::size_t>(last - first)) {
+	}
+	template<std::size_t N>
+	constexpr Span(T (&array)[N]) noexcept :
+		ptr(array),
+		count(N) {
+	}
+	template<typename K, typename = std::enable_if_t<std::is_convertible_v<K *, T *>>>
+	Span(std::vector<K> &vector) noexcept :
+		ptr(vector.data()),
+		count(vector.size()) {
+	}
+	template<typename K, typename = std::enable_if_t<std::is_convertible_v<const K *, T *>>>
+	Span(const std::vector<K> &vector) noexcept :
+		ptr(vector.data()),
+		count(vector.size()) {
+	}
+	template<typename K, typename = std::enable_if_t<std::is_convertible_v<K *, T *>>>
+	constexpr Span(const Span<K> &other) noexcept :
+		ptr(other.data()),
+		count(other.size()) {
+	}
+
+	constexpr T *data() const noexcept { return ptr; }
+	constexpr std::size_t size() const noexcept { return count; }
+	constexpr std::size_t size_bytes() const noexcept { return count * sizeof(T); }
+	constexpr bool empty() const noexcept { return count == 0; }
+
+	constexpr iterator begin() const noexcept { return ptr; }
+	constexpr iterator end() const noexcept { return ptr + count; }
+
+	constexpr T &front() const { return ptr[0]; }
+	constexpr T &back() const { return ptr[count - 1]; }
+	constexpr T &operator[](std::size_t index) const { return ptr[index]; }
+
+	constexpr Span first(std::size_t n) const { return {ptr, n}; }
+	constexpr Span last(std::size_t n) const { return {ptr + count - n, n}; }
+	constexpr Span subspan(std::size_t offset, std::size_t n) const { return {ptr + offset, n}; }
+	constexpr Span subspan(std::size_t offset) const { return {ptr + offset, count - offset}; }
+
+private:
+	T *ptr = nullptr;
+	std::size_t count = 0;
+};
+
+/**
+ * Views the bytes of a span of trivially copyable objects.
+ * @tparam T The type of the viewed elements.
+ * @param span The span to view.
+ * @return The viewed bytes.
+ */
+template<typename T>
+Span<const std::byte> AsBytes(Span<T> span) noexcept {
+	return {reinterpret_cast<const std::byte *>(span.data()), span.size_bytes()};
+}
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <thread>
 #include <vector>
 #include <functional>
@@ -21,6 +23,17 @@ public:
 	template<typename F, typename... Args>
 	auto Enqueue(F &&f, Args &&... args);
 
+	/**
+	 * Splits a range into chunks that the workers and the calling thread take in turn, returns once every chunk has run.
+	 * Workers busy with other tasks join late or not at all, the calling thread runs any chunks left over.
+	 * @tparam Function The function type, called with the begin and end index of each chunk.
+	 * @param count The amount of indices.
+	 * @param grainSize The amount of indices in each chunk.
+	 * @param function The function.
+	 */
+	template<typename Function>
+	void ParallelFor(std::size_t count, std::size_t grainSize, const Function &function);
+
 	void Wait();
 
 	const std::vector<std::thread> &GetWorkers() const { return workers; }
@@ -55,4 +68,61 @@ auto ThreadPool::Enqueue(F &&f, Args &&... args) {
 	condition.notify_one();
 	return result;
 }
+
+template<typename Function>
+void ThreadPool::ParallelFor(std::size_t count, std::size_t grainSize, const Function &function) {
+	grainSize = std::max<std::size_t>(grainSize, 1);
+	auto chunkCount = (count + grainSize - 1) / grainSize;
+
+	if (chunkCount <= 1 || workers.empty()) {
+		if (count != 0)
+			function(0, count);
+		return;
+	}
+
+	class State {
+	public:
+		std::atomic<std::size_t> nextChunk = 0;
+		std::atomic<std::size_t> finishedChunks = 0;
+		std::mutex mutex;
+		std::condition_variable finished;
+	};
+
+	// Workers that start after the last chunk was taken only touch the shared state, so the function is never called once this returns.
+	auto state = std::make_shared<State>();
+	auto work = [state, chunkCount, count, grainSize, &function]() {
+		for (std::size_t chunk; (chunk = state->nextChunk++) < chunkCount;) {
+			auto begin = chunk * grainSize;
+			function(begin, std::min(begin + grainSize, count));
+
+			if (++state->finishedChunks == chunkCount) {
+				std::unique_lock<std::mutex> lock(state->mutex);
+				state->finished.notify_all();
+			}
+		}
+	};
+
+	auto helperCount = std::min(workers.size(), chunkCount - 1);
+	{
+		std::unique_lock<std::mutex> lock(queueMutex);
+
+		if (stop)
+			throw std::runtime_error("ParallelFor called on a stopped ThreadPool");
+
+		for (std::size_t i = 0; i < helperCount; i++)
+			tasks.emplace(work);
+	}
+
+	if (helperCount == 1)
+		condition.notify_one();
+	else
+		condition.notify_all();
+
+	work();
+
+	std::unique_lock<std::mutex> lock(state->mutex);
+	state->finished.wait(lock, [&state, chunkCount]() {
+		return state->finishedChunks == chunkCount;
+	});
+}
 }
@@ -0,0 +1,218 @@
+#include "Cooker.hpp"
+
+#include <array>
+#include <fstream>
+#include <iomanip>
+#include <set>
+
+#include <Animations/AnimatedMesh.hpp>
+#include <Animations/AnimatedMeshData.hpp>
+#include <Bitmaps/MipmapChain.hpp>
+#include <Engine/Log.hpp>
+#include <Files/File.hpp>
+#include <Files/Files.hpp>
+#include <Files/Json/Json.hpp>
+#include <Graphics/Pipelines/Shader.hpp>
+#include <Models/Binary/BinaryModel.hpp>
+#include <Models/Gltf/GltfModel.hpp>
+#include <Models/Obj/ObjModel.hpp>
+#include <Utils/String.hpp>
+#include <Utils/ThreadPool.hpp>
+
+namespace test {
+// Bumped when a converter changes, so every file is cooked again.
+static constexpr uint64_t CookerVersion = 1;
+static const std::string ManifestFilename = ".cooked.json";
+
+Cooker::Cooker(std::filesystem::path input, std::filesystem::path output, bool force) :
+	input(std::move(input)),
+	output(std::move(output)),
+	force(force) {
+	if (!force && std::filesystem::exists(this->output / ManifestFilename)) {
+		File manifestFile(this->output / ManifestFilename, std::make_unique<Json>());
+		manifestFile.Load();
+		manifest = std::move(manifestFile.GetNode());
+	}
+}
+
+bool Cooker::Run() {
+	auto debugStart = Time::Now();
+
+	std::vector<std::string> paths;
+	for (auto &file : std::filesystem::recursive_directory_iterator(input)) {
+		if (!file.is_regular_file()) continue;
+		paths.emplace_back(std::filesystem::relative(file.path(), input).generic_string());
+	}
+	std::sort(paths.begin(), paths.end());
+
+	// Shaders are also cooked again when any include changes.
+	auto shaderSeed = CookerVersion;
+	for (const auto &path : paths) {
+		if (std::filesystem::path(path).extension() == ".glsl")
+			shaderSeed = HashFile(input / path, shaderSeed);
+	}
+
+	ThreadPool threadPool;
+	std::vector<std::future<Result>> futures;
+	futures.reserve(paths.size());
+
+	for (const auto &path : paths) {
+		futures.emplace_back(threadPool.Enqueue([this, path, shaderSeed] {
+			auto seed = GetAction(path) == Action::Shader ? shaderSeed : CookerVersion;
+			return Cook(path, HashFile(input / path, seed));
+		}));
+	}
+
+	Node nextManifest;
+	std::size_t cookedCount = 0, failedCount = 0;
+	std::set<std::string> outputs;
+
+	for (auto &future : futures) {
+		auto result = future.get();
+		if (result.failed) {
+			failedCount++;
+			continue;
+		}
+		if (result.cooked)
+			cookedCount++;
+
+		auto entry = nextManifest["files"][result.path];
+		entry["hash"].Set(result.hash);
+		entry["outputs"].Set(result.outputs);
+		outputs.insert(result.outputs.begin(), result.outputs.end());
+	}
+
+	// Removes outputs of sources that were deleted or are no longer converted.
+	if (manifest.HasProperty("files")) {
+		for (const auto &[path, entry] : manifest["files"]->GetProperties()) {
+			for (const auto &previousOutput : entry["outputs"].Get<std::vector<std::string>>()) {
+				if (outputs.find(previousOutput) == outputs.end())
+					std::filesystem::remove(output / previousOutput);
+			}
+		}
+	}
+
+	File manifestFile(output / ManifestFilename, std::make_unique<Json>(), std::move(nextManifest));
+	manifestFile.Write(NodeFormat::Beautified);
+
+	Log::Out("Cooked ", cookedCount, " of ", paths.size(), " files from ", input, " into ", output, " in ",
+		(Time::Now() - debugStart).AsMilliseconds<float>(), "ms", failedCount != 0 ? ", failures: " + String::To(failedCount) : "", '\n');
+	return failedCount == 0;
+}
+
+Cooker::Action Cooker::GetAction(const std::filesystem::path &path) {
+	auto extension = String::Lowercase(path.extension().string());
+	if (extension == ".obj" || extension == ".gltf" || extension == ".glb")
+		return Action::Model;
+	if (extension == ".dae")
+		return Action::AnimatedMesh;
+	if (extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".tga" || extension == ".bmp")
+		return Action::Image;
+	if (extension == ".vert" || extension == ".frag" || extension == ".comp" || extension == ".geom" || extension == ".tesc" || extension == ".tese")
+		return Action::Shader;
+	return Action::Copy;
+}
+
+uint64_t Cooker::HashFile(const std::filesystem::path &filename, uint64_t seed) {
+	std::ifstream stream(filename, std::ios::binary);
+	std::array<char, 64 * 1024> buffer;
+
+	// 64-bit FNV-1a, seeded so the converter version is part of the key.
+	uint64_t hash = 14695981039346656037ull ^ seed;
+	while (stream) {
+		stream.read(buffer.data(), buffer.size());
+		for (std::streamsize i = 0; i < stream.gcount(); i++) {
+			hash ^= static_cast<uint8_t>(buffer[i]);
+			hash *= 1099511628211ull;
+		}
+	}
+	return hash;
+}
+
+std::string Cooker::ToHex(uint64_t value) {
+	std::stringstream stream;
+	stream << std::hex << std::setw(16) << std::setfill('0') << value;
+	return stream.str();
+}
+
+Cooker::Result Cooker::Cook(const std::string &path, uint64_t hash) const {
+	Result result;
+	result.path = path;
+	result.hash = ToHex(hash);
+
+	if (!force && manifest.HasProperty("files") && manifest["files"]->HasProperty(path)) {
+		auto entry = manifest["files"][path];
+		result.outputs = entry["outputs"].Get<std::vector<std::string>>();
+		auto upToDate = entry["hash"].Get<std::string>() == result.hash && std::all_of(result.outputs.begin(), result.outputs.end(), [this](const auto &cooked) {
+			return std::filesystem::exists(output / cooked);
+		});
+		if (upToDate)
+			return result;
+	}
+
+	try {
+		result.outputs = Convert(path, GetAction(path));
+		result.cooked = true;
+	} catch (const std::exception &e) {
+		Log::Error("Failed to cook ", path, ": ", e.what(), '\n');
+		result.failed = true;
+	}
+	return result;
+}
+
+std::vector<std::string> Cooker::Convert(const std::string &path, Action action) const {
+	auto copy = [this, &path] {
+		std::filesystem::create_directories((output / path).parent_path());
+		std::filesystem::copy_file(input / path, output / path, std::filesystem::copy_options::overwrite_existing);
+		return path;
+	};
+
+	switch (action) {
+	case Action::Model: {
+		std::vector<Vertex3d> vertices;
+		std::vector<uint32_t> indices;
+		if (std::filesystem::path(path).extension() == ".obj")
+			ObjModel::Read(path, vertices, indices);
+		else
+			GltfModel::Read(path, vertices, indices);
+
+		auto cookedFilename = BinaryModel::GetCookedFilename(path);
+		BinaryModel::Write(output / cookedFilename, vertices, indices);
+		return {cookedFilename.generic_string()};
+	}
+	case Action::AnimatedMesh: {
+		// Only skinned COLLADA files can be loaded by animated meshes.
+		auto source = Files::Read(path);
+		if (!source || source->find("<library_controllers") == std::string::npos)
+			return {copy()};
+
+		auto cookedFilename = AnimatedMeshData::GetCookedFilename(path);
+		AnimatedMeshData::LoadCollada(path, AnimatedMesh::MaxWeights).Write(output / cookedFilename);
+		return {cookedFilename.generic_string()};
+	}
+	case Action::Image: {
+		Bitmap bitmap(path);
+		if (!bitmap.GetData())
+			throw std::runtime_error("Image could not be decoded");
+
+		// The source is kept, since cube maps, window icons and direct bitmap loads still read it.
+		auto cookedFilename = MipmapChain::GetCookedFilename(path);
+		MipmapChain(bitmap).Write(output / cookedFilename);
+		return {copy(), cookedFilename.generic_string()};
+	}
+	case Action::Shader: {
+		// The source is kept, since pipelines still parse it to build their reflection.
+		auto source = Files::Read(path);
+		if (!source)
+			throw std::runtime_error("Shader could not be read");
+
+		auto cookedFilename = Shader::GetCookedFilename(path);
+		if (!Shader::Cook(path, *source, "", Shader::GetShaderStage(path), output / cookedFilename))
+			throw std::runtime_error("Shader could not be compiled");
+		return {copy(), cookedFilename.generic_string()};
+	}
+	default:
+		return {copy()};
+	}
+}
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <filesystem>
+
+#include <Files/Node.hpp>
+
+using namespace acid;
+
+namespace test {
+/**
+ * @brief Converts a resources tree into a cooked tree the engine loads without runtime conversion.
+ * Models become binary vertex and index buffers, COLLADA files become binary skinned meshes, images become mipmap chains,
+ * and shaders are precompiled to SPIR-V. Files are cooked in parallel, and only when their content hash changed since the last run.
+ */
+class Cooker {
+public:
+	/**
+	 * Creates a new cooker.
+	 * @param input The resources directory, it must be mounted as the only search path.
+	 * @param output The directory to write the cooked tree to.
+	 * @param force If every file is cooked, ignoring the previous content hashes.
+	 */
+	Cooker(std::filesystem::path input, std::filesystem::path output, bool force);
+
+	/**
+	 * Cooks the resources tree.
+	 * @return If every file was cooked.
+	 */
+	bool Run();
+
+private:
+	enum class Action {
+		Copy, Model, AnimatedMesh, Image, Shader
+	};
+
+	class Result {
+	public:
+		std::string path;
+		std::string hash;
+		std::vector<std::string> outputs;
+		bool cooked = false;
+		bool failed = false;
+	};
+
+	static Action GetAction(const std::filesystem::path &path);
+	static uint64_t HashFile(const std::filesystem::path &filename, uint64_t seed);
+	static std::string ToHex(uint64_t value);
+
+	Result Cook(const std::string &path, uint64_t hash) const;
+	std::vector<std::string> Convert(const std::string &path, Action action) const;
+
+	std::filesystem::path input;
+	std::filesystem::path output;
+	bool force;
+
+	// The content hashes and outputs of the last run, by source path.
+	Node manifest;
+};
+}
@@ -0,0 +1,36 @@
+#include <Engine/Engine.hpp>
+#include <Files/Files.hpp>
+#include "Config.hpp"
+#include "Cooker.hpp"
+
+using namespace acid;
+
+int main(int argc, char **argv) {
+	// Usage: AcidCooker [resources directory] [output directory] [--force]
+	std::filesystem::path input = ACID_RESOURCES_DEV;
+	std::filesystem::path output = std::filesystem::current_path() / "Cooked";
+	auto force = false;
+
+	std::vector<std::string> positional;
+	for (int i = 1; i < argc; i++) {
+		std::string argument(argv[i]);
+		if (argument == "--force")
+			force = true;
+		else
+			positional.emplace_back(argument);
+	}
+	if (positional.size() > 0)
+		input = positional[0];
+	if (positional.size() > 1)
+		output = positional[1];
+
+	// Only the files module is needed, converters read sources through the search path.
+	ModuleFilter moduleFilter;
+	moduleFilter.ExcludeAll().Include<Files>();
+	Engine engine(argv[0], std::move(moduleFilter));
+	Files::Get()->ClearSearchPath();
+	Files::Get()->AddSearchPath(input.string());
+
+	test::Cooker cooker(input, output, force);
+	return cooker.Run() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,45 @@
+#include <Files/Archive.hpp>
+#include <Engine/Log.hpp>
+#include "Config.hpp"
+
+using namespace acid;
+
+int main(int argc, char **argv) {
+	// Usage: AcidPacker [resources directory] [archive] [--store]
+	std::filesystem::path input = ACID_RESOURCES_DEV;
+	std::filesystem::path output = std::filesystem::current_path() / "data.pack";
+	auto compress = true;
+
+	std::vector<std::string> positional;
+	for (int i = 1; i < argc; i++) {
+		std::string argument(argv[i]);
+		if (argument == "--store")
+			compress = false;
+		else
+			positional.emplace_back(argument);
+	}
+	if (positional.size() > 0)
+		input = positional[0];
+	if (positional.size() > 1)
+		output = positional[1];
+
+	std::vector<std::pair<std::string, std::filesystem::path>> files;
+	for (auto &file : std::filesystem::recursive_directory_iterator(input)) {
+		if (!file.is_regular_file()) continue;
+		files.emplace_back(std::filesystem::relative(file.path(), input).generic_string(), file.path());
+	}
+
+	// Sorted so archives built from the same tree are identical.
+	std::sort(files.begin(), files.end());
+
+	try {
+		Archive::Write(output, files, compress);
+	} catch (const std::exception &e) {
+		Log::Error(e.what(), '\n');
+		return EXIT_FAILURE;
+	}
+
+	Archive archive(output);
+	Log::Out("Packed ", archive.GetEntryCount(), " files from ", input, " into ", output, '\n');
+	return EXIT_SUCCESS;
+}
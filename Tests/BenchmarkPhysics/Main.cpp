@@ -0,0 +1,77 @@
+#include <cmath>
+
+#include <BulletCollision/CollisionShapes/btBoxShape.h>
+#include <BulletCollision/CollisionShapes/btStaticPlaneShape.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
+#include <BulletDynamics/Dynamics/btRigidBody.h>
+#include <Engine/Log.hpp>
+#include <Physics/Physics.hpp>
+
+using namespace acid;
+
+int main(int argc, char **argv) {
+	// Usage: BenchmarkPhysics [stacks] [stack height] [steps]
+	uint32_t stackCount = argc > 1 ? std::stoul(argv[1]) : 100;
+	uint32_t stackHeight = argc > 2 ? std::stoul(argv[2]) : 100;
+	uint32_t stepCount = argc > 3 ? std::stoul(argv[3]) : 300;
+	constexpr float timeStep = 1.0f / 60.0f;
+
+	Log::Out("Stepping ", stackCount * stackHeight, " stacked rigidbodies for ", stepCount, " steps\n");
+
+	std::vector<uint32_t> threadCounts;
+	for (uint32_t threadCount = 1; threadCount < std::thread::hardware_concurrency(); threadCount *= 2)
+		threadCounts.emplace_back(threadCount);
+	threadCounts.emplace_back(std::max(std::thread::hardware_concurrency(), 1u));
+
+	float baseline = 0.0f;
+	for (auto threadCount : threadCounts) {
+		btBoxShape boxShape(btVector3(0.5f, 0.5f, 0.5f));
+		btStaticPlaneShape groundShape(btVector3(0.0f, 1.0f, 0.0f), 0.0f);
+		btVector3 boxInertia;
+		boxShape.calculateLocalInertia(1.0f, boxInertia);
+
+		// Bodies are declared before the world, the physics system removes them from the world when destroyed.
+		std::vector<std::unique_ptr<btRigidBody>> bodies;
+		bodies.reserve(stackCount * stackHeight + 1);
+
+		PhysicsSettings settings;
+		settings.threadCount = threadCount;
+		Physics physics(settings);
+		auto world = physics.GetDynamicsWorld();
+
+		auto &ground = bodies.emplace_back(std::make_unique<btRigidBody>(0.0f, nullptr, &groundShape));
+		world->addRigidBody(ground.get());
+
+		// Stacks are laid out in a square grid with a gap between them, so each stack is its own island.
+		auto gridSize = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(stackCount))));
+		for (uint32_t stack = 0; stack < stackCount; stack++) {
+			auto x = static_cast<float>(stack % gridSize) * 2.0f;
+			auto z = static_cast<float>(stack / gridSize) * 2.0f;
+
+			for (uint32_t level = 0; level < stackHeight; level++) {
+				btRigidBody::btRigidBodyConstructionInfo info(1.0f, nullptr, &boxShape, boxInertia);
+				info.m_startWorldTransform.setOrigin(btVector3(x, 0.5f + static_cast<float>(level), z));
+				auto &body = bodies.emplace_back(std::make_unique<btRigidBody>(info));
+				// Settled stacks would otherwise fall asleep and stop being simulated.
+				body->setActivationState(DISABLE_DEACTIVATION);
+				world->addRigidBody(body.get());
+			}
+		}
+
+		// Warms up the pair cache and solver pools before timing.
+		for (uint32_t i = 0; i < 10; i++)
+			world->stepSimulation(timeStep, 0);
+
+		auto start = Time::Now();
+		for (uint32_t i = 0; i < stepCount; i++)
+			world->stepSimulation(timeStep, 0);
+		auto msPerStep = (Time::Now() - start).AsMilliseconds<float>() / static_cast<float>(stepCount);
+
+		if (threadCount == threadCounts.front())
+			baseline = msPerStep;
+		Log::Out(threadCount, " threads", physics.IsMultithreaded() ? "" : " (sequential world)", ": ", msPerStep, "ms per step, ",
+			baseline / msPerStep, "x speedup\n");
+	}
+
+	return EXIT_SUCCESS;
+}
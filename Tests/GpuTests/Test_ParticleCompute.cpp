@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include <Devices/Windows.hpp>
+#include <Engine/Engine.hpp>
+#include <Files/Files.hpp>
+#include <Graphics/Graphics.hpp>
+#include <Particles/ParticleCompute.hpp>
+#include <Particles/ParticlePool.hpp>
+#include <Particles/ParticleType.hpp>
+#include <Resources/Resources.hpp>
+
+using namespace acid;
+
+// Only the modules the compute passes need, no window is added so nothing is ever presented.
+static ModuleFilter CreateFilter() {
+	ModuleFilter filter;
+	filter.ExcludeAll().Include<Files>().Include<Resources>().Include<Windows>().Include<Graphics>();
+	return filter;
+}
+
+class ParticleComputeTest : public ::testing::Test {
+protected:
+	Engine engine{"GpuTests", CreateFilter()};
+};
+
+TEST_F(ParticleComputeTest, matchesCpuPool) {
+	const float delta = 1.0f / 60.0f;
+	const uint32_t steps = 90;
+	const Vector3f cameraPosition(0.0f, 2.0f, -10.0f);
+
+	auto type = ParticleType::Create(nullptr, 1, Colour::Black, 1.0f, 1.0f, 1.0f, ParticleType::SortMode::BackToFront);
+
+	// Lives fall halfway between steps, so rounding in either elapsed time can not move a particles death to another step.
+	ParticlePool cpuPool;
+	for (uint32_t i = 0; i < 1000; i++) {
+		auto t = static_cast<float>(i);
+		Vector3f position(std::sin(t) * 5.0f, static_cast<float>(i % 7), std::cos(t) * 5.0f);
+		Vector3f velocity(static_cast<float>(i % 5) - 2.0f, 4.0f, static_cast<float>(i % 3) - 1.0f);
+		auto lifeLength = (static_cast<float>(i % 120) + 0.5f) * delta;
+		cpuPool.Add(position, velocity, lifeLength, 1.0f, 0.0f, 1.0f, static_cast<float>(i % 2));
+	}
+
+	ParticleCompute compute;
+	compute.Emit(type, cpuPool);
+
+	for (uint32_t step = 0; step < steps; step++) {
+		cpuPool.Update(delta, cameraPosition, 0);
+		compute.Update(delta, cameraPosition, Matrix4());
+	}
+
+	ASSERT_FALSE(cpuPool.IsEmpty());
+	ASSERT_EQ(compute.GetPools().size(), 1u);
+	auto &pool = *compute.GetPools().begin()->second;
+	ASSERT_EQ(pool.GetAliveCount(), cpuPool.GetSize());
+
+	std::vector<Vector3f> cpuPositions;
+	for (std::size_t i = 0; i < cpuPool.GetSize(); i++)
+		cpuPositions.emplace_back(cpuPool.GetPosition(i));
+
+	// The instances are in draw order, their translation row is the particles position.
+	std::vector<Vector3f> gpuPositions;
+	ParticleType::Instance *instances;
+	pool.GetInstances().MapMemory(reinterpret_cast<void **>(&instances));
+	for (uint32_t i = 0; i < pool.GetAliveCount(); i++)
+		gpuPositions.emplace_back(instances[i].modelMatrix.rows[3]);
+	pool.GetInstances().UnmapMemory();
+
+	// Both sides integrate the same way, but each ends up in its own order, so positions are matched by nearest.
+	for (const auto &position : gpuPositions) {
+		auto nearest = std::min_element(cpuPositions.begin(), cpuPositions.end(), [&](const auto &a, const auto &b) {
+			return a.DistanceSquared(position) < b.DistanceSquared(position);
+		});
+		ASSERT_NE(nearest, cpuPositions.end());
+		EXPECT_LT(nearest->Distance(position), 1e-3f);
+		cpuPositions.erase(nearest);
+	}
+
+	EXPECT_TRUE(cpuPositions.empty());
+}
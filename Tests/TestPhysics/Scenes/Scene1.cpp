@@ -1,6 +1,7 @@
 #include "Scene1.hpp"
 
 #include <Animations/AnimatedMesh.hpp>
+#include <Animations/Animations.hpp>
 #include <Audio/Sound.hpp>
 #include <Files/File.hpp>
 #include <Files/File.hpp>
@@ -40,6 +41,7 @@
 #include "Behaviours/Rotate.hpp"
 #include "Terrain/TerrainMaterial.hpp"
 #include "Terrain/Terrain.hpp"
+#include "Terrain/TerrainStreamer.hpp"
 #include "World/World.hpp"
 #include "FpsCamera.hpp"
 
@@ -51,6 +53,7 @@ Scene1::Scene1() :
 	AddSystem<World>();
 	AddSystem<Physics>();
 	AddSystem<Particles>();
+	AddSystem<Animations>();
 	AddSystem<Gizmos>();
 	
 	//uiStartLogo.SetTransform({UiMargins::All});
@@ -182,13 +185,12 @@ void Scene1::Start() {
 		std::make_unique<TerrainMaterial>(Image2d::Create("Objects/Terrain/Grass.png"), Image2d::Create("Objects/Terrain/Rocks.png")));
 	terrain->AddComponent<ShadowRender>();
 
-	//auto terrain = CreateEntity();
-	//terrain->AddComponent<Transform>();
-	//terrain->AddComponent<Mesh>(nullptr,
-	//	std::make_unique<TerrainMaterial>(Image2d::Create("Objects/Terrain/Grass.png"), Image2d::Create("Objects/Terrain/Rocks.png")));
-	//terrain->AddComponent<Terrain>(150.0f, 2.0f);
-	//terrain->AddComponent<Rigidbody>(std::make_unique<HeightfieldCollider>(), 0.0f, 0.7f);
-	//terrain->AddComponent<ShadowRender>();
+	// Tiles are streamed in around the camera, and take their textures from the streamers material.
+	auto terrainStreamer = CreateEntity();
+	terrainStreamer->AddComponent<Transform>(Vector3f(0.0f, -30.0f, 0.0f));
+	terrainStreamer->AddComponent<Mesh>(nullptr,
+		std::make_unique<TerrainMaterial>(Image2d::Create("Objects/Terrain/Grass.png"), Image2d::Create("Objects/Terrain/Rocks.png")));
+	terrainStreamer->AddComponent<TerrainStreamer>(65, 2.0f, 400.0f, 500.0f, 150.0f);
 
 #ifdef ACID_DEBUG
 	EntityPrefab prefabTerrain("Prefabs/Terrain.json");
@@ -0,0 +1,36 @@
+#include "HeightmapPool.hpp"
+
+namespace test {
+HeightmapPool::Heightmap HeightmapPool::Acquire(std::size_t size) {
+	std::unique_ptr<std::vector<float>> heights;
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		if (!freeHeights.empty()) {
+			heights = std::move(freeHeights.back());
+			freeHeights.pop_back();
+		}
+	}
+
+	if (!heights)
+		heights = std::make_unique<std::vector<float>>();
+	heights->resize(size);
+
+	// Heightmaps released after the pool is destroyed are deleted instead.
+	return Heightmap(heights.release(), [pool = weak_from_this()](std::vector<float> *heights) {
+		if (auto locked = pool.lock())
+			locked->Release(heights);
+		else
+			delete heights;
+	});
+}
+
+std::size_t HeightmapPool::GetFreeCount() const {
+	std::unique_lock<std::mutex> lock(mutex);
+	return freeHeights.size();
+}
+
+void HeightmapPool::Release(std::vector<float> *heights) {
+	std::unique_lock<std::mutex> lock(mutex);
+	freeHeights.emplace_back(heights);
+}
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace test {
+/**
+ * @brief Recycles height buffers between terrain tiles, a heightmap returns to the pool once the last tile and collider reading it let go.
+ */
+class HeightmapPool : public std::enable_shared_from_this<HeightmapPool> {
+public:
+	using Heightmap = std::shared_ptr<std::vector<float>>;
+
+	/**
+	 * Takes a heightmap from the pool, or allocates one if the pool is empty. Safe to call from any thread.
+	 * @param size The amount of heights.
+	 * @return The heightmap, its heights are left as they were.
+	 */
+	Heightmap Acquire(std::size_t size);
+
+	std::size_t GetFreeCount() const;
+
+private:
+	void Release(std::vector<float> *heights);
+
+	std::vector<std::unique_ptr<std::vector<float>>> freeHeights;
+	mutable std::mutex mutex;
+};
+}
@@ -0,0 +1,220 @@
+#include "TerrainStreamer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+
+#include <Maths/Transform.hpp>
+#include <Meshes/Mesh.hpp>
+#include <Physics/Colliders/HeightfieldCollider.hpp>
+#include <Physics/Rigidbody.hpp>
+#include <Resources/Resources.hpp>
+#include <Scenes/Camera.hpp>
+#include <Scenes/Entity.hpp>
+#include <Scenes/Scenes.hpp>
+#include <Shadows/ShadowRender.hpp>
+#include "MeshTerrain.hpp"
+#include "TerrainMaterial.hpp"
+
+namespace test {
+TerrainStreamer::TerrainStreamer(uint32_t tileResolution, float squareSize, float loadRadius, float unloadRadius, float lodDistance) :
+	noise(25653345),
+	heightmapPool(std::make_shared<HeightmapPool>()),
+	tileResolution(tileResolution),
+	squareSize(squareSize),
+	loadRadius(loadRadius),
+	unloadRadius(std::max(unloadRadius, loadRadius)),
+	lodDistance(lodDistance) {
+	noise.SetFrequency(0.01f);
+	noise.SetNoiseType(FastNoiseLite::NoiseType_Perlin);
+	noise.SetFractalType(FastNoiseLite::FractalType_FBm);
+	noise.SetFractalOctaves(5);
+	noise.SetFractalLacunarity(2.0f);
+	noise.SetFractalGain(0.5f);
+
+	// Sampling noise does not change it, so the copy can be read from any worker.
+	tileSource = [noise = noise](const Vector2f &origin, float squareSize, uint32_t resolution, Span<float> heights) {
+		for (uint32_t z = 0; z < resolution; z++) {
+			for (uint32_t x = 0; x < resolution; x++)
+				heights[z * resolution + x] = 16.0f * noise.GetNoise(origin.x + x * squareSize, origin.y + z * squareSize);
+		}
+	};
+}
+
+void TerrainStreamer::Start() {
+	if (tileResolution < 3 || ((tileResolution - 1) & (tileResolution - 2)) != 0) {
+		Log::Error("Terrain tile resolution must be one more than a power of two!\n");
+		tileResolution = 65;
+	}
+}
+
+void TerrainStreamer::Update() {
+	Vector3f origin;
+	if (auto transform = GetEntity()->GetComponent<Transform>())
+		origin = transform->GetPosition();
+
+	auto camera = Scenes::Get()->GetScene()->GetCamera();
+	if (!camera)
+		return;
+
+	Vector2f focus(camera->GetPosition().x - origin.x, camera->GetPosition().z - origin.z);
+	auto grid = GetGrid();
+	uint32_t loadingCount = 0;
+	// Tiles that were created, removed or changed level of detail, their neighbours may have to stitch their edges differently.
+	std::vector<TileCoord> changed;
+
+	for (auto it = tiles.begin(); it != tiles.end();) {
+		auto &[coord, tile] = *it;
+		auto distance = grid.GetTileDistance(coord, focus);
+
+		if (tile.loading.valid()) {
+			if (tile.loading.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+				loadingCount++;
+				++it;
+				continue;
+			}
+
+			// Tiles that were passed while loading are dropped, their heights go straight back to the pool.
+			tile.heights = tile.loading.get();
+			if (distance > unloadRadius) {
+				it = tiles.erase(it);
+				continue;
+			}
+
+			tile.lod = grid.GetLod(distance);
+			CreateTileEntity(coord, tile);
+			changed.emplace_back(coord);
+		}
+
+		if (distance > unloadRadius) {
+			tile.entity->SetRemoved(true);
+			changed.emplace_back(coord);
+			it = tiles.erase(it);
+			continue;
+		}
+
+		if (auto lod = grid.GetLod(distance); lod != tile.lod) {
+			tile.lod = lod;
+			changed.emplace_back(coord);
+		}
+
+		++it;
+	}
+
+	std::set<TileCoord> rebuild;
+	for (const auto &coord : changed) {
+		rebuild.emplace(coord);
+		for (auto edge : {TileGrid::Edge::NegativeX, TileGrid::Edge::PositiveX, TileGrid::Edge::NegativeZ, TileGrid::Edge::PositiveZ})
+			rebuild.emplace(TileGrid::GetNeighbour(coord, edge));
+	}
+
+	for (const auto &coord : rebuild) {
+		if (auto it = tiles.find(coord); it != tiles.end() && it->second.mesh)
+			it->second.mesh->SetModel(CreateTileModel(coord, it->second));
+	}
+
+	// Missing tiles inside the load radius are requested nearest first, a few at a time so the pool stays free for other resources.
+	for (const auto &coord : grid.GetTilesInRadius(focus, loadRadius)) {
+		if (loadingCount >= maxLoading)
+			break;
+		if (tiles.find(coord) != tiles.end())
+			continue;
+
+		LoadTile(coord, tiles[coord]);
+		loadingCount++;
+	}
+}
+
+const Node &operator>>(const Node &node, TerrainStreamer &terrainStreamer) {
+	node["tileResolution"].Get(terrainStreamer.tileResolution);
+	node["squareSize"].Get(terrainStreamer.squareSize);
+	node["loadRadius"].Get(terrainStreamer.loadRadius);
+	node["unloadRadius"].Get(terrainStreamer.unloadRadius);
+	node["lodDistance"].Get(terrainStreamer.lodDistance);
+	node["maxLoading"].Get(terrainStreamer.maxLoading);
+	return node;
+}
+
+Node &operator<<(Node &node, const TerrainStreamer &terrainStreamer) {
+	node["tileResolution"].Set(terrainStreamer.tileResolution);
+	node["squareSize"].Set(terrainStreamer.squareSize);
+	node["loadRadius"].Set(terrainStreamer.loadRadius);
+	node["unloadRadius"].Set(terrainStreamer.unloadRadius);
+	node["lodDistance"].Set(terrainStreamer.lodDistance);
+	node["maxLoading"].Set(terrainStreamer.maxLoading);
+	return node;
+}
+
+void TerrainStreamer::LoadTile(const TileCoord &coord, Tile &tile) {
+	auto resolution = tileResolution;
+	auto tileSize = GetTileSize();
+	Vector2f tileOrigin(coord.first * tileSize - 0.5f * tileSize, coord.second * tileSize - 0.5f * tileSize);
+
+	tile.loading = Resources::Get()->GetThreadPool().Enqueue([source = tileSource, pool = heightmapPool, tileOrigin, squareSize = squareSize, resolution]() {
+		TileHeights tileHeights;
+		tileHeights.heights = pool->Acquire(resolution * resolution);
+		source(tileOrigin, squareSize, resolution, *tileHeights.heights);
+
+		auto [minHeight, maxHeight] = std::minmax_element(tileHeights.heights->begin(), tileHeights.heights->end());
+		tileHeights.minHeight = *minHeight;
+		tileHeights.maxHeight = *maxHeight;
+		return tileHeights;
+	});
+}
+
+void TerrainStreamer::CreateTileEntity(const TileCoord &coord, Tile &tile) {
+	Vector3f origin;
+	if (auto transform = GetEntity()->GetComponent<Transform>())
+		origin = transform->GetPosition();
+
+	// Bullet centers heightfields between their lowest and highest height, so the tile entity sits at that center.
+	auto center = 0.5f * (tile.heights.minHeight + tile.heights.maxHeight);
+	auto tileSize = GetTileSize();
+	auto resolution = static_cast<int32_t>(tileResolution);
+
+	tile.entity = Scenes::Get()->GetScene()->CreateEntity();
+	tile.entity->AddComponent<Transform>(origin + Vector3f(coord.first * tileSize, center, coord.second * tileSize), Vector3f(),
+		Vector3f(squareSize, 1.0f, squareSize));
+	// The model is built once the tiles neighbours are known, at the end of the update.
+	tile.mesh = tile.entity->AddComponent<Mesh>(nullptr, CreateTileMaterial());
+
+	// The collider shares the pooled heights, they are returned once the tile and its collider are gone.
+	auto collider = std::make_unique<HeightfieldCollider>();
+	collider->SetHeightfield(resolution, resolution, std::shared_ptr<const float>(tile.heights.heights, tile.heights.heights->data()),
+		tile.heights.minHeight, tile.heights.maxHeight, true);
+	tile.entity->AddComponent<Rigidbody>(std::move(collider), 0.0f, 0.7f);
+	tile.entity->AddComponent<ShadowRender>();
+}
+
+std::shared_ptr<Model> TerrainStreamer::CreateTileModel(const TileCoord &coord, const Tile &tile) const {
+	// Neighbours without a mesh yet are treated as matching, the tile is rebuilt once they have one.
+	std::array<uint32_t, 4> neighbourLods;
+	for (auto edge : {TileGrid::Edge::NegativeX, TileGrid::Edge::PositiveX, TileGrid::Edge::NegativeZ, TileGrid::Edge::PositiveZ}) {
+		auto it = tiles.find(TileGrid::GetNeighbour(coord, edge));
+		neighbourLods[static_cast<std::size_t>(edge)] = it != tiles.end() && it->second.mesh ? it->second.lod : tile.lod;
+	}
+
+	// Meshes are built around the tile center in units of squares, the tile entity scales them to world size.
+	auto grid = GetGrid();
+	auto step = 1u << tile.lod;
+	auto vertexCount = grid.GetVertexCount(tile.lod);
+	auto center = 0.5f * (tile.heights.minHeight + tile.heights.maxHeight);
+
+	auto heightmap = grid.SampleHeights(*tile.heights.heights, tile.lod, neighbourLods);
+	for (auto &height : heightmap)
+		height -= center;
+
+	auto sideLength = static_cast<float>(tileResolution - 1);
+	return std::make_shared<MeshTerrain>(heightmap, sideLength, 2.0f * static_cast<float>(step), vertexCount, 0.08f * sideLength * squareSize);
+}
+
+std::unique_ptr<Material> TerrainStreamer::CreateTileMaterial() const {
+	// Tiles use the textures of the streamers own terrain material when it has one.
+	if (auto mesh = GetEntity()->GetComponent<Mesh>()) {
+		if (auto material = dynamic_cast<const TerrainMaterial *>(mesh->GetMaterial()))
+			return std::make_unique<TerrainMaterial>(material->GetImageR(), material->GetImageG());
+	}
+
+	return std::make_unique<TerrainMaterial>();
+}
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <functional>
+#include <future>
+#include <map>
+
+#include <FastNoiseLite.h>
+
+#include <Maths/Vector2.hpp>
+#include <Scenes/Component.hpp>
+#include <Utils/Span.hpp>
+#include "HeightmapPool.hpp"
+#include "TileGrid.hpp"
+
+namespace acid {
+class Entity;
+class Material;
+class Mesh;
+class Model;
+}
+
+using namespace acid;
+
+namespace test {
+/**
+ * @brief Streams a terrain as a grid of fixed size tiles around the camera. Tiles inside the load radius have their heights
+ * generated or loaded on the resource thread pool, then get their own mesh and heightfield collider. Meshes of further tiles
+ * use fewer vertices, with their edges stitched to coarser neighbours, and tiles beyond the unload radius are removed with their heights
+ * returned to the pool.
+ */
+class TerrainStreamer : public Component::Registrar<TerrainStreamer> {
+	inline static const bool Registered = Register("terrainStreamer");
+public:
+	/**
+	 * Fills the heights of a tile, called on a worker thread.
+	 * The origin is the position of the first height relative to the streamer, heights are indexed by z * resolution + x.
+	 */
+	using TileSource = std::function<void(const Vector2f &origin, float squareSize, uint32_t resolution, Span<float> heights)>;
+
+	/**
+	 * Creates a new terrain streamer.
+	 * @param tileResolution The amount of heights along each side of a tile, one more than a power of two.
+	 * @param squareSize The distance between heights.
+	 * @param loadRadius The distance from the camera that tiles are loaded within.
+	 * @param unloadRadius The distance from the camera that tiles are removed beyond, larger than the load radius.
+	 * @param lodDistance The distance between each halving of a tiles mesh resolution.
+	 */
+	explicit TerrainStreamer(uint32_t tileResolution = 65, float squareSize = 2.0f, float loadRadius = 400.0f, float unloadRadius = 500.0f,
+		float lodDistance = 150.0f);
+
+	void Start() override;
+	void Update() override;
+
+	friend const Node &operator>>(const Node &node, TerrainStreamer &terrainStreamer);
+	friend Node &operator<<(Node &node, const TerrainStreamer &terrainStreamer);
+
+	const TileSource &GetTileSource() const { return tileSource; }
+	/**
+	 * Sets where tile heights come from, only tiles loaded after this call use the new source.
+	 * @param tileSource The tile source.
+	 */
+	void SetTileSource(TileSource tileSource) { this->tileSource = std::move(tileSource); }
+
+	const std::shared_ptr<HeightmapPool> &GetHeightmapPool() const { return heightmapPool; }
+	void SetHeightmapPool(std::shared_ptr<HeightmapPool> heightmapPool) { this->heightmapPool = std::move(heightmapPool); }
+
+	uint32_t GetMaxLoading() const { return maxLoading; }
+	void SetMaxLoading(uint32_t maxLoading) { this->maxLoading = maxLoading; }
+
+	std::size_t GetTileCount() const { return tiles.size(); }
+	float GetTileSize() const { return GetGrid().GetTileSize(); }
+	TileGrid GetGrid() const { return {tileResolution, squareSize, lodDistance}; }
+
+private:
+	using TileCoord = TileGrid::Coord;
+
+	class TileHeights {
+	public:
+		HeightmapPool::Heightmap heights;
+		float minHeight = 0.0f;
+		float maxHeight = 0.0f;
+	};
+
+	class Tile {
+	public:
+		std::future<TileHeights> loading;
+		TileHeights heights;
+		Entity *entity = nullptr;
+		Mesh *mesh = nullptr;
+		uint32_t lod = 0;
+	};
+
+	void LoadTile(const TileCoord &coord, Tile &tile);
+	void CreateTileEntity(const TileCoord &coord, Tile &tile);
+	std::shared_ptr<Model> CreateTileModel(const TileCoord &coord, const Tile &tile) const;
+	std::unique_ptr<Material> CreateTileMaterial() const;
+
+	FastNoiseLite noise;
+	TileSource tileSource;
+	std::shared_ptr<HeightmapPool> heightmapPool;
+	std::map<TileCoord, Tile> tiles;
+
+	uint32_t tileResolution;
+	float squareSize;
+	float loadRadius;
+	float unloadRadius;
+	float lodDistance;
+	uint32_t maxLoading = 4;
+};
+}
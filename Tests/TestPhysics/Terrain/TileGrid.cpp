@@ -0,0 +1,110 @@
+#include "TileGrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace test {
+TileGrid::TileGrid(uint32_t tileResolution, float squareSize, float lodDistance) :
+	tileResolution(tileResolution),
+	squareSize(squareSize),
+	lodDistance(lodDistance) {
+}
+
+float TileGrid::GetTileDistance(const Coord &coord, const Vector2f &focus) const {
+	auto tileSize = GetTileSize();
+	auto halfSize = 0.5f * tileSize;
+	auto dx = std::max(std::abs(focus.x - coord.first * tileSize) - halfSize, 0.0f);
+	auto dz = std::max(std::abs(focus.y - coord.second * tileSize) - halfSize, 0.0f);
+	return std::sqrt(dx * dx + dz * dz);
+}
+
+uint32_t TileGrid::GetLod(float distance) const {
+	if (lodDistance <= 0.0f)
+		return 0;
+	return std::min(static_cast<uint32_t>(distance / lodDistance), GetMaxLod());
+}
+
+uint32_t TileGrid::GetMaxLod() const {
+	uint32_t maxLod = 0;
+	while ((2u << maxLod) < tileResolution - 1)
+		maxLod++;
+	return maxLod;
+}
+
+std::vector<TileGrid::Coord> TileGrid::GetTilesInRadius(const Vector2f &focus, float radius) const {
+	auto tileSize = GetTileSize();
+	auto minX = static_cast<int32_t>(std::floor((focus.x - radius) / tileSize));
+	auto maxX = static_cast<int32_t>(std::ceil((focus.x + radius) / tileSize));
+	auto minZ = static_cast<int32_t>(std::floor((focus.y - radius) / tileSize));
+	auto maxZ = static_cast<int32_t>(std::ceil((focus.y + radius) / tileSize));
+
+	std::vector<std::pair<float, Coord>> inRadius;
+	for (auto z = minZ; z <= maxZ; z++) {
+		for (auto x = minX; x <= maxX; x++) {
+			Coord coord(x, z);
+			if (auto distance = GetTileDistance(coord, focus); distance <= radius)
+				inRadius.emplace_back(distance, coord);
+		}
+	}
+
+	std::sort(inRadius.begin(), inRadius.end());
+
+	std::vector<Coord> coords;
+	coords.reserve(inRadius.size());
+	for (const auto &[distance, coord] : inRadius)
+		coords.emplace_back(coord);
+	return coords;
+}
+
+std::vector<float> TileGrid::SampleHeights(const std::vector<float> &heights, uint32_t lod, const std::array<uint32_t, 4> &neighbourLods) const {
+	auto step = 1u << lod;
+	auto vertexCount = GetVertexCount(lod);
+
+	std::vector<float> sampled(vertexCount * vertexCount);
+	for (uint32_t z = 0; z < vertexCount; z++) {
+		for (uint32_t x = 0; x < vertexCount; x++)
+			sampled[z * vertexCount + x] = heights[z * step * tileResolution + x * step];
+	}
+
+	// A coarser neighbour only has vertices every few of ours along the shared edge, ours in between are moved onto its edge.
+	// Both tiles hold the same heights along that edge, so interpolating them gives exactly the line the neighbour draws.
+	auto stitch = [&](Edge edge, auto getIndex, auto getHeight) {
+		auto neighbourStep = 1u << std::min(neighbourLods[static_cast<std::size_t>(edge)], GetMaxLod());
+		if (neighbourStep <= step)
+			return;
+
+		for (uint32_t i = 0; i < vertexCount; i++) {
+			auto position = i * step;
+			auto start = position / neighbourStep * neighbourStep;
+			if (start == position)
+				continue;
+
+			auto factor = static_cast<float>(position - start) / static_cast<float>(neighbourStep);
+			sampled[getIndex(i)] = (1.0f - factor) * getHeight(start) + factor * getHeight(start + neighbourStep);
+		}
+	};
+
+	auto last = vertexCount - 1;
+	auto lastHeight = tileResolution - 1;
+	stitch(Edge::NegativeX, [&](uint32_t i) { return i * vertexCount; }, [&](uint32_t p) { return heights[p * tileResolution]; });
+	stitch(Edge::PositiveX, [&](uint32_t i) { return i * vertexCount + last; }, [&](uint32_t p) { return heights[p * tileResolution + lastHeight]; });
+	stitch(Edge::NegativeZ, [&](uint32_t i) { return i; }, [&](uint32_t p) { return heights[p]; });
+	stitch(Edge::PositiveZ, [&](uint32_t i) { return last * vertexCount + i; }, [&](uint32_t p) { return heights[lastHeight * tileResolution + p]; });
+	return sampled;
+}
+
+TileGrid::Coord TileGrid::GetNeighbour(const Coord &coord, Edge edge) {
+	switch (edge) {
+	case Edge::NegativeX:
+		return {coord.first - 1, coord.second};
+	case Edge::PositiveX:
+		return {coord.first + 1, coord.second};
+	case Edge::NegativeZ:
+		return {coord.first, coord.second - 1};
+	case Edge::PositiveZ:
+		return {coord.first, coord.second + 1};
+	}
+
+	return coord;
+}
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include <Maths/Vector2.hpp>
+
+using namespace acid;
+
+namespace test {
+/**
+ * @brief The layout of a grid of square terrain tiles centered on their coordinates, picks which tiles to load and how finely to mesh them.
+ */
+class TileGrid {
+public:
+	using Coord = std::pair<int32_t, int32_t>;
+
+	/// The neighbours of a tile, in the order their levels of detail are passed to {@link TileGrid#SampleHeights}.
+	enum class Edge {
+		NegativeX, PositiveX, NegativeZ, PositiveZ
+	};
+
+	/**
+	 * Creates a new tile grid.
+	 * @param tileResolution The amount of heights along each side of a tile, one more than a power of two.
+	 * @param squareSize The distance between heights.
+	 * @param lodDistance The distance between each halving of a tiles mesh resolution.
+	 */
+	TileGrid(uint32_t tileResolution, float squareSize, float lodDistance);
+
+	/**
+	 * Gets the distance from a point to the nearest point of a tile.
+	 * @param coord The tile coordinate.
+	 * @param focus The point, on the grids plane.
+	 * @return The distance, zero inside the tile.
+	 */
+	float GetTileDistance(const Coord &coord, const Vector2f &focus) const;
+
+	/**
+	 * Gets the level of detail of a tile at a distance, each level halves the vertices along a side.
+	 * @param distance The distance to the tile.
+	 * @return The level of detail, no more than {@link TileGrid#GetMaxLod}.
+	 */
+	uint32_t GetLod(float distance) const;
+
+	/**
+	 * Gets the coarsest level of detail, with two quads across the tile.
+	 * @return The coarsest level of detail.
+	 */
+	uint32_t GetMaxLod() const;
+
+	/**
+	 * Gets every tile with a point within a radius, nearest first.
+	 * @param focus The point, on the grids plane.
+	 * @param radius The radius.
+	 * @return The tile coordinates.
+	 */
+	std::vector<Coord> GetTilesInRadius(const Vector2f &focus, float radius) const;
+
+	/**
+	 * Samples the mesh heights of a tile at a level of detail. Edge heights next to a coarser neighbour are moved onto the
+	 * neighbours edge, so the two meshes meet without cracks.
+	 * @param heights The tiles heights, indexed by z * resolution + x.
+	 * @param lod The level of detail of the tile.
+	 * @param neighbourLods The levels of detail of the neighbours, indexed by {@link TileGrid#Edge}.
+	 * @return The heights of the mesh vertices, indexed by z * vertex count + x.
+	 */
+	std::vector<float> SampleHeights(const std::vector<float> &heights, uint32_t lod, const std::array<uint32_t, 4> &neighbourLods) const;
+
+	static Coord GetNeighbour(const Coord &coord, Edge edge);
+
+	float GetTileSize() const { return static_cast<float>(tileResolution - 1) * squareSize; }
+	uint32_t GetVertexCount(uint32_t lod) const { return (tileResolution - 1) / (1u << lod) + 1; }
+
+private:
+	uint32_t tileResolution;
+	float squareSize;
+	float lodDistance;
+};
+}
@@ -0,0 +1,326 @@
+#include <gtest/gtest.h>
+
+#include <Animations/CrowdEvaluator.hpp>
+#include <Utils/ThreadPool.hpp>
+
+using namespace acid;
+
+namespace {
+Joint CreateArm() {
+	Joint shoulder(0, "shoulder", Matrix4().Translate({0.0f, 1.0f, 0.0f}));
+	Joint elbow(2, "elbow", Matrix4().Translate({0.0f, 1.0f, 0.0f}));
+	elbow.AddChild(Joint(1, "wrist", Matrix4().Translate({1.0f, 0.0f, 0.0f})));
+	shoulder.AddChild(elbow);
+	shoulder.CalculateInverseBindTransform({});
+	return shoulder;
+}
+
+std::vector<Keyframe> CreateWave(float amplitude = 1.0f) {
+	std::vector<Keyframe> keyframes;
+	for (auto [time, angle] : {std::pair(0.0f, 0.0f), std::pair(1.0f, 1.2f * amplitude), std::pair(2.0f, -0.4f * amplitude)}) {
+		Keyframe keyframe(Time::Seconds(time), {});
+		keyframe.AddJointTransform("shoulder", Matrix4().Translate({0.0f, 1.0f, 0.0f}).Rotate(angle, Vector3f::Up));
+		keyframe.AddJointTransform("elbow", Matrix4().Translate({0.0f, 1.0f, time}).Rotate(-angle, Vector3f::Right));
+		keyframe.AddJointTransform("wrist", Matrix4().Translate({1.0f, 0.0f, 0.0f}));
+		keyframes.emplace_back(keyframe);
+	}
+	return keyframes;
+}
+
+// The recursive evaluation over name keyed poses the animator used to do.
+void ReferencePose(const std::vector<Keyframe> &keyframes, float time, const Joint &joint, const Matrix4 &parentTransform, std::vector<Matrix4> &jointMatrices) {
+	std::size_t next = 0;
+	while (next < keyframes.size() && keyframes[next].GetTimeStamp().AsSeconds() <= time)
+		next++;
+	auto &previousFrame = keyframes[next - 1], &nextFrame = keyframes[next];
+	auto progression = (time - previousFrame.GetTimeStamp().AsSeconds()) / (nextFrame.GetTimeStamp() - previousFrame.GetTimeStamp()).AsSeconds();
+
+	auto localTransform = JointTransform::Interpolate(previousFrame.GetPose().at(joint.GetName()), nextFrame.GetPose().at(joint.GetName()), progression);
+	auto currentTransform = parentTransform * localTransform.GetLocalTransform();
+	for (const auto &child : joint.GetChildren())
+		ReferencePose(keyframes, time, child, currentTransform, jointMatrices);
+	jointMatrices[joint.GetIndex()] = currentTransform * joint.GetInverseBindTransform();
+}
+
+void ExpectMatricesNear(const std::vector<Matrix4> &actual, const std::vector<Matrix4> &expected, float error) {
+	ASSERT_EQ(actual.size(), expected.size());
+	for (uint32_t i = 0; i < expected.size(); i++) {
+		for (uint32_t row = 0; row < 4; row++) {
+			for (uint32_t col = 0; col < 4; col++)
+				EXPECT_NEAR(actual[i][row][col], expected[i][row][col], error) << "joint " << i;
+		}
+	}
+}
+}
+
+TEST(Skeleton, flattensParentsFirst) {
+	Skeleton skeleton(CreateArm());
+	ASSERT_EQ(skeleton.GetJointCount(), 3u);
+	EXPECT_EQ(skeleton.GetParents(), (std::vector<int32_t>{-1, 0, 1}));
+	EXPECT_EQ(skeleton.GetMatrixIndices(), (std::vector<uint32_t>{0, 2, 1}));
+	EXPECT_EQ(skeleton.FindJoint("wrist"), 2u);
+	EXPECT_FALSE(skeleton.FindJoint("knee"));
+}
+
+TEST(Animator, matchesRecursivePose) {
+	auto arm = CreateArm();
+	auto keyframes = CreateWave();
+	Skeleton skeleton(arm);
+	Animation animation(Time::Seconds(2.0f), keyframes, skeleton);
+
+	Animator animator;
+	animator.DoAnimation(&animation);
+	std::vector<Matrix4> jointMatrices(4);
+
+	for (auto time : {0.25f, 1.0f, 1.6f}) {
+		animator.SetAnimationTime(Time::Seconds(time));
+		animator.CalculateCurrentAnimationPose(skeleton, jointMatrices);
+
+		std::vector<Matrix4> expected(4);
+		ReferencePose(keyframes, time, arm, {}, expected);
+
+		for (uint32_t i = 0; i < expected.size(); i++) {
+			for (uint32_t row = 0; row < 4; row++) {
+				for (uint32_t col = 0; col < 4; col++)
+					EXPECT_NEAR(jointMatrices[i][row][col], expected[i][row][col], 1e-5f) << "time " << time << " joint " << i;
+			}
+		}
+	}
+}
+
+TEST(Animator, loopsAnimationTime) {
+	Skeleton skeleton(CreateArm());
+	Animation animation(Time::Seconds(2.0f), CreateWave(), skeleton);
+
+	Animator animator;
+	animator.DoAnimation(&animation);
+	std::vector<Matrix4> jointMatrices(3);
+	animator.Update(Time::Seconds(1.5f), skeleton, jointMatrices);
+	animator.Update(Time::Seconds(1.5f), skeleton, jointMatrices);
+	EXPECT_NEAR(animator.GetAnimationTime().AsSeconds(), 1.0f, 1e-5f);
+}
+
+TEST(Animator, zeroLengthAnimationTime) {
+	Skeleton skeleton(CreateArm());
+	Animation animation(Time(), CreateWave(), skeleton);
+
+	Animator animator;
+	animator.DoAnimation(&animation);
+	std::vector<Matrix4> jointMatrices(3);
+	animator.Update(Time::Seconds(0.5f), skeleton, jointMatrices);
+	EXPECT_EQ(animator.GetAnimationTime(), Time());
+}
+
+TEST(AnimationTrack, packedQuaternionRoundTrip) {
+	for (const auto &rotation : {Quaternion(), Quaternion(Vector3f(0.3f, -2.2f, 1.1f)), Quaternion(Vector3f(3.0f, 0.1f, -0.5f)), -Quaternion(Vector3f(-1.0f, 0.4f, 2.9f))}) {
+		auto unpacked = PackedQuaternion(rotation).Unpack();
+		EXPECT_NEAR(std::abs(unpacked.Dot(rotation)), 1.0f, 1e-6f);
+	}
+}
+
+TEST(AnimationTrack, cursorMatchesSearch) {
+	std::vector<float> times;
+	std::vector<Vector3f> positions;
+	std::vector<Quaternion> rotations;
+	for (uint32_t i = 0; i < 50; i++) {
+		times.emplace_back(0.1f * static_cast<float>(i));
+		positions.emplace_back(std::sin(0.3f * static_cast<float>(i)), static_cast<float>(i), 0.0f);
+		rotations.emplace_back(Vector3f(0.1f * static_cast<float>(i), 0.0f, 0.0f));
+	}
+	AnimationTrack track(times, positions, rotations);
+
+	// Plays forward, then seeks backwards and past the ends.
+	AnimationTrack::Cursor cursor;
+	for (auto time : {0.0f, 0.05f, 0.12f, 0.31f, 0.33f, 2.7f, 0.4f, -1.0f, 4.85f, 9.0f, 1.0f}) {
+		auto expected = track.Sample(time);
+		auto actual = track.Sample(time, cursor);
+		EXPECT_EQ(actual.GetPosition(), expected.GetPosition()) << "time " << time;
+		EXPECT_EQ(actual.GetRotation(), expected.GetRotation()) << "time " << time;
+	}
+}
+
+TEST(AnimationTrack, emptyChannelKeepsBindTransform) {
+	Node node;
+	node["positionTimes"].Set(std::vector<float>{0.0f, 1.0f});
+	node["positions"].Set(std::vector<Vector3f>{{0.0f, 0.0f, 0.0f}, {2.0f, 0.0f, 0.0f}});
+	AnimationTrack track;
+	node >> track;
+
+	// The track moves the joint but has no rotation keys.
+	JointTransform bindTransform({0.0f, 1.0f, 0.0f}, Quaternion(Vector3f(0.0f, 0.5f, 0.0f)));
+	auto sampled = track.Sample(0.5f, bindTransform);
+	EXPECT_EQ(sampled.GetPosition(), Vector3f(1.0f, 0.0f, 0.0f));
+	EXPECT_EQ(sampled.GetRotation(), bindTransform.GetRotation());
+
+	EXPECT_EQ(track.Sample(0.5f).GetRotation(), Quaternion());
+}
+
+TEST(AnimationTrack, compressWithinError) {
+	std::vector<float> times;
+	std::vector<Vector3f> positions;
+	std::vector<Quaternion> rotations;
+	for (uint32_t i = 0; i <= 100; i++) {
+		auto time = 0.01f * static_cast<float>(i);
+		times.emplace_back(time);
+		// The position moves in a straight line, so only its end keys are needed, the rotation curves and keeps more keys.
+		positions.emplace_back(2.0f * time, 1.0f, -time);
+		rotations.emplace_back(Vector3f(std::sin(6.0f * time), 0.5f * time * time, 0.0f));
+	}
+
+	AnimationTrack original(times, positions, rotations);
+	auto compressed = original;
+	compressed.Compress(0.001f, 0.002f);
+
+	EXPECT_EQ(compressed.GetPositionTimes().size(), 2u);
+	EXPECT_LT(compressed.GetRotationTimes().size(), times.size() / 2);
+	EXPECT_TRUE(compressed.IsPacked());
+	EXPECT_LT(compressed.GetMemorySize(), original.GetMemorySize() / 4);
+
+	for (uint32_t i = 0; i <= 1000; i++) {
+		auto time = 0.001f * static_cast<float>(i);
+		auto expected = original.Sample(time);
+		auto actual = compressed.Sample(time);
+		EXPECT_LE(actual.GetPosition().Distance(expected.GetPosition()), 0.001f);
+		EXPECT_NEAR(std::abs(actual.GetRotation().Dot(expected.GetRotation())), 1.0f, 1e-5f);
+	}
+}
+
+TEST(AnimationPose, blendsAlongShorterPath) {
+	Quaternion a(Vector3f(0.2f, 1.0f, 0.0f)), b(Vector3f(-0.6f, 0.1f, 0.9f));
+	AnimationPose pose(3), other(3);
+	for (uint32_t i = 0; i < 3; i++) {
+		pose.SetJoint(i, {{0.0f, 1.0f, 2.0f}, a});
+		// The negated rotation is the same rotation, blending must not take the long way around to it.
+		other.SetJoint(i, {{2.0f, -1.0f, 0.0f}, i == 1 ? -b : b});
+	}
+
+	std::vector<float> weights = {0.0f, 0.5f, 1.0f};
+	pose.Blend(other, weights);
+
+	EXPECT_EQ(pose.GetJoint(0).GetPosition(), Vector3f(0.0f, 1.0f, 2.0f));
+	EXPECT_NEAR(std::abs(pose.GetJoint(0).GetRotation().Dot(a)), 1.0f, 1e-6f);
+	EXPECT_EQ(pose.GetJoint(1).GetPosition(), Vector3f(1.0f, 0.0f, 1.0f));
+	// Normalized linear interpolation meets slerp halfway.
+	EXPECT_NEAR(std::abs(pose.GetJoint(1).GetRotation().Dot(a.Slerp(b, 0.5f))), 1.0f, 1e-6f);
+	EXPECT_NEAR(std::abs(pose.GetJoint(2).GetRotation().Dot(b)), 1.0f, 1e-6f);
+}
+
+TEST(AnimationPose, addsDifferenceFromReference) {
+	Quaternion base(Vector3f(0.4f, -0.3f, 1.2f)), reference(Vector3f(0.1f, 0.7f, 0.0f)), additive(Vector3f(0.5f, 0.2f, -0.3f));
+	AnimationPose pose(3), difference(3), referencePose(3);
+	for (uint32_t i = 0; i < 3; i++) {
+		// The first joint's base pose is the reference, so adding the full difference gives the additive pose.
+		pose.SetJoint(i, {{1.0f, 0.0f, 0.0f}, i == 0 ? reference : base});
+		difference.SetJoint(i, {{3.0f, 2.0f, 0.0f}, additive});
+		referencePose.SetJoint(i, {{1.0f, 1.0f, 0.0f}, reference});
+	}
+
+	difference.Subtract(referencePose);
+	std::vector<float> weights = {1.0f, 1.0f, 0.0f};
+	pose.Add(difference, weights);
+
+	EXPECT_EQ(pose.GetJoint(0).GetPosition(), Vector3f(3.0f, 1.0f, 0.0f));
+	EXPECT_NEAR(std::abs(pose.GetJoint(0).GetRotation().Dot(additive)), 1.0f, 1e-6f);
+	auto expected = base * Quaternion(-reference.x, -reference.y, -reference.z, reference.w) * additive;
+	EXPECT_NEAR(std::abs(pose.GetJoint(1).GetRotation().Dot(expected)), 1.0f, 1e-6f);
+	EXPECT_NEAR(std::abs(pose.GetJoint(2).GetRotation().Dot(base)), 1.0f, 1e-6f);
+}
+
+TEST(Animator, crossFadesAnimations) {
+	Skeleton skeleton(CreateArm());
+	Animation wave(Time::Seconds(2.0f), CreateWave(), skeleton);
+	Animation reversed(Time::Seconds(2.0f), CreateWave(-1.0f), skeleton);
+
+	Animator animator;
+	animator.DoAnimation(&wave);
+	animator.IncreaseAnimationTime(Time::Seconds(0.25f));
+	animator.DoAnimation(&reversed, Time::Seconds(1.0f));
+	animator.IncreaseAnimationTime(Time::Seconds(0.5f));
+	EXPECT_TRUE(animator.GetLayers().front().IsFading());
+	EXPECT_FALSE(animator.IsPlayingSingleAnimation());
+
+	std::vector<Matrix4> jointMatrices(3);
+	animator.CalculateCurrentAnimationPose(skeleton, jointMatrices);
+
+	std::vector<AnimationTrack::Cursor> cursors;
+	AnimationPose pose, reversedPose;
+	wave.Sample(0.75f, skeleton, cursors, pose);
+	reversed.Sample(0.5f, skeleton, cursors, reversedPose);
+	pose.Blend(reversedPose, std::vector<float>(3, 0.5f));
+	std::vector<Matrix4> modelTransforms, expected(3);
+	skeleton.CalculateJointMatrices(pose, modelTransforms, expected);
+	ExpectMatricesNear(jointMatrices, expected, 1e-5f);
+
+	// Once faded, only the new animation plays.
+	animator.IncreaseAnimationTime(Time::Seconds(0.6f));
+	EXPECT_TRUE(animator.IsPlayingSingleAnimation());
+	animator.CalculateCurrentAnimationPose(skeleton, jointMatrices);
+	reversed.Sample(1.1f, skeleton, cursors, reversedPose);
+	skeleton.CalculateJointMatrices(reversedPose, modelTransforms, expected);
+	ExpectMatricesNear(jointMatrices, expected, 1e-5f);
+}
+
+TEST(Animator, masksLayers) {
+	Skeleton skeleton(CreateArm());
+	Animation wave(Time::Seconds(2.0f), CreateWave(), skeleton);
+	Animation reversed(Time::Seconds(2.0f), CreateWave(-1.0f), skeleton);
+
+	auto mask = AnimationLayer::CreateMask(skeleton, *skeleton.FindJoint("elbow"));
+	EXPECT_EQ(mask, (std::vector<float>{0.0f, 1.0f, 1.0f}));
+
+	Animator animator;
+	animator.DoAnimation(&wave);
+	auto &layer = animator.AddLayer();
+	layer.SetMask(mask);
+	layer.Play(&reversed);
+	animator.SetAnimationTime(Time::Seconds(0.5f));
+	layer.SetTime(Time::Seconds(0.5f));
+
+	std::vector<Matrix4> jointMatrices(3);
+	animator.CalculateCurrentAnimationPose(skeleton, jointMatrices);
+
+	// The shoulder follows the base layer, the elbow and wrist below it follow the masked layer.
+	std::vector<AnimationTrack::Cursor> cursors;
+	AnimationPose pose, reversedPose;
+	wave.Sample(0.5f, skeleton, cursors, pose);
+	reversed.Sample(0.5f, skeleton, cursors, reversedPose);
+	pose.SetJoint(1, reversedPose.GetJoint(1));
+	pose.SetJoint(2, reversedPose.GetJoint(2));
+	std::vector<Matrix4> modelTransforms, expected(3);
+	skeleton.CalculateJointMatrices(pose, modelTransforms, expected);
+	ExpectMatricesNear(jointMatrices, expected, 1e-5f);
+}
+
+TEST(CrowdEvaluator, sharesIdenticalPoses) {
+	Skeleton skeleton(CreateArm());
+	Animation wave(Time::Seconds(2.0f), CreateWave(), skeleton);
+	Animation reversed(Time::Seconds(2.0f), CreateWave(-1.0f), skeleton);
+
+	std::vector<Animator> animators(64);
+	std::vector<std::vector<Matrix4>> jointMatrices(animators.size(), std::vector<Matrix4>(3));
+	std::vector<CrowdEvaluator::Instance> instances;
+
+	for (uint32_t i = 0; i < animators.size(); i++) {
+		animators[i].DoAnimation(&wave);
+		if (i % 2 == 1)
+			animators[i].SetAnimationTime(Time::Seconds(0.5f));
+		// Animators with more than one layer calculate their own pose.
+		if (i % 4 == 3)
+			animators[i].AddLayer(AnimationLayer::Mode::Additive, 0.5f).Play(&reversed);
+		instances.push_back({&animators[i], &skeleton, jointMatrices[i]});
+	}
+
+	auto references = animators;
+	ThreadPool threadPool(3);
+	CrowdEvaluator evaluator;
+	evaluator.Evaluate(Time::Seconds(0.1f), instances, &threadPool);
+
+	// 32 animators at 0.1 seconds and 16 at 0.6 seconds share one pose each.
+	EXPECT_EQ(evaluator.GetSharedCount(), 46u);
+
+	for (uint32_t i = 0; i < animators.size(); i++) {
+		std::vector<Matrix4> expected(3);
+		references[i].Update(Time::Seconds(0.1f), skeleton, expected);
+		EXPECT_EQ(jointMatrices[i], expected) << "animator " << i;
+	}
+}
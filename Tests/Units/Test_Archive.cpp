@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include <Files/Archive.hpp>
+
+static std::filesystem::path WriteFile(const std::filesystem::path &path, const std::string &data) {
+	std::ofstream stream(path, std::ios::binary);
+	stream << data;
+	return path;
+}
+
+TEST(Archive, writeRead) {
+	auto directory = std::filesystem::temp_directory_path() / "AcidArchiveTest";
+	std::filesystem::create_directories(directory);
+
+	// Repetitive data spanning several blocks compresses, a short string is stored as is.
+	std::string repeated;
+	for (uint32_t i = 0; i < 20000; i++)
+		repeated += "block " + std::to_string(i % 100) + '\n';
+	std::string small = "tiny";
+
+	acid::Archive::Write(directory / "test.pack", {
+		{"Models/Repeated.txt", WriteFile(directory / "Repeated.txt", repeated)},
+		{"Small.txt", WriteFile(directory / "Small.txt", small)}
+	});
+
+	{
+		acid::Archive archive(directory / "test.pack");
+		EXPECT_EQ(archive.GetEntryCount(), 2);
+		EXPECT_TRUE(archive.Contains("Models\\Repeated.txt"));
+		EXPECT_FALSE(archive.Contains("Missing.txt"));
+		EXPECT_FALSE(archive.Read("Missing.txt"));
+
+		auto repeatedView = archive.Read("Models/Repeated.txt");
+		ASSERT_TRUE(repeatedView);
+		EXPECT_EQ(repeatedView->GetString(), repeated);
+
+		auto smallView = archive.Read("Small.txt");
+		ASSERT_TRUE(smallView);
+		EXPECT_EQ(smallView->GetString(), small);
+		// Stored entries are viewed in place, entry offsets are aligned so views start on a page.
+		EXPECT_EQ(reinterpret_cast<uintptr_t>(smallView->GetBytes().data()) % 4096, 0);
+	}
+
+	std::filesystem::remove_all(directory);
+}
+
+TEST(Archive, rejectsCorruptBlockTable) {
+	auto directory = std::filesystem::temp_directory_path() / "AcidArchiveCorruptTest";
+	std::filesystem::create_directories(directory);
+
+	std::string repeated;
+	for (uint32_t i = 0; i < 20000; i++)
+		repeated += "block " + std::to_string(i % 100) + '\n';
+	auto filename = directory / "test.pack";
+
+	// The header is 24 bytes with the index offset last, each index entry is 40 bytes with the block count last.
+	auto patch = [&](auto getOffset, uint32_t value) {
+		acid::Archive::Write(filename, {{"Repeated.txt", WriteFile(directory / "Repeated.txt", repeated)}});
+		std::fstream stream(filename, std::ios::binary | std::ios::in | std::ios::out);
+		uint64_t indexOffset, entryOffset;
+		stream.seekg(16);
+		stream.read(reinterpret_cast<char *>(&indexOffset), sizeof(indexOffset));
+		stream.seekg(indexOffset + 8);
+		stream.read(reinterpret_cast<char *>(&entryOffset), sizeof(entryOffset));
+		stream.seekp(getOffset(indexOffset, entryOffset));
+		stream.write(reinterpret_cast<const char *>(&value), sizeof(value));
+	};
+
+	patch([](uint64_t indexOffset, uint64_t) { return indexOffset + 36; }, 1000);
+	EXPECT_THROW(acid::Archive archive(filename), std::runtime_error);
+
+	// The first block claims more bytes than the entry stores.
+	patch([](uint64_t, uint64_t entryOffset) { return entryOffset; }, 0x7FFFFFFF);
+	EXPECT_THROW(acid::Archive archive(filename), std::runtime_error);
+
+	patch([](uint64_t, uint64_t entryOffset) { return entryOffset; }, 1);
+	acid::Archive archive(filename);
+	EXPECT_FALSE(archive.Read("Repeated.txt"));
+
+	std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+#include <Particles/BitonicSort.hpp>
+
+TEST(BitonicSort, stepSchedule) {
+	EXPECT_TRUE(acid::BitonicSort::GetSteps(1).empty());
+
+	// Every stage k halves j from k / 2 down to one.
+	std::vector<std::pair<uint32_t, uint32_t>> expected = {{1, 2}, {2, 4}, {1, 4}, {4, 8}, {2, 8}, {1, 8}};
+	auto steps = acid::BitonicSort::GetSteps(8);
+	ASSERT_EQ(steps.size(), expected.size());
+	for (std::size_t i = 0; i < steps.size(); i++) {
+		EXPECT_EQ(steps[i].j, expected[i].first);
+		EXPECT_EQ(steps[i].k, expected[i].second);
+	}
+
+	// log2(n) * (log2(n) + 1) / 2 passes.
+	EXPECT_EQ(acid::BitonicSort::GetSteps(65536).size(), 136u);
+}
+
+TEST(BitonicSort, nextPowerOfTwo) {
+	EXPECT_EQ(acid::BitonicSort::NextPowerOfTwo(0), 1u);
+	EXPECT_EQ(acid::BitonicSort::NextPowerOfTwo(1), 1u);
+	EXPECT_EQ(acid::BitonicSort::NextPowerOfTwo(3), 4u);
+	EXPECT_EQ(acid::BitonicSort::NextPowerOfTwo(1024), 1024u);
+	EXPECT_EQ(acid::BitonicSort::NextPowerOfTwo(1025), 2048u);
+}
+
+TEST(BitonicSort, sortsDescendingWithPaddingLast) {
+	std::mt19937 random(1234);
+
+	for (uint32_t liveCount : {1u, 2u, 5u, 64u, 100u, 1000u}) {
+		// Live keys are offset by one like Simulate.comp writes them, so the zeroed padding sorts after every live key.
+		auto count = acid::BitonicSort::NextPowerOfTwo(liveCount);
+		std::vector<acid::Vector2ui> keys(count, acid::Vector2ui(0, 0));
+		for (uint32_t i = 0; i < liveCount; i++)
+			keys[i] = {1 + random() % 50, i};
+
+		auto expected = keys;
+		for (const auto &step : acid::BitonicSort::GetSteps(count))
+			acid::BitonicSort::RunStep(keys, step);
+
+		for (std::size_t i = 1; i < keys.size(); i++)
+			EXPECT_GE(keys[i - 1].x, keys[i].x) << "at " << i << " of " << count;
+
+		// Keys are only moved, every particle index is still there once.
+		auto byIndex = [](const acid::Vector2ui &a, const acid::Vector2ui &b) {
+			return a.y < b.y || (a.y == b.y && a.x < b.x);
+		};
+		std::sort(keys.begin(), keys.end(), byIndex);
+		std::sort(expected.begin(), expected.end(), byIndex);
+		EXPECT_EQ(keys, expected);
+	}
+}
@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+
+#include <Particles/Emitters/Emitter.hpp>
+#include <Particles/Emitters/SphereEmitter.hpp>
+
+using namespace acid;
+
+TEST(Emitter, orthonormalBasis) {
+	for (auto normal : {Vector3f::Up, Vector3f::Front, -Vector3f::Front, Vector3f(1.0f, 2.0f, -3.0f).Normalize()}) {
+		Vector3f tangent, bitangent;
+		Emitter::OrthonormalBasis(normal, tangent, bitangent);
+		EXPECT_NEAR(tangent.Length(), 1.0f, 1e-5f);
+		EXPECT_NEAR(bitangent.Length(), 1.0f, 1e-5f);
+		EXPECT_NEAR(tangent.Dot(normal), 0.0f, 1e-5f);
+		EXPECT_NEAR(bitangent.Dot(normal), 0.0f, 1e-5f);
+		EXPECT_NEAR(tangent.Dot(bitangent), 0.0f, 1e-5f);
+	}
+}
+
+TEST(Emitter, unitVectorsWithinCone) {
+	auto coneDirection = Vector3f(0.0f, -1.0f, 1.0f).Normalize();
+	auto angle = 0.3f;
+	std::vector<Vector3f> directions(1000);
+	Emitter::RandomUnitVectorsWithinCone(coneDirection, angle, directions);
+
+	Vector3f mean;
+	for (const auto &direction : directions) {
+		EXPECT_NEAR(direction.Length(), 1.0f, 1e-5f);
+		EXPECT_GE(direction.Dot(coneDirection), std::cos(angle) - 1e-5f);
+		mean += direction;
+	}
+
+	// Spread evenly around the cone, the samples average out along its direction.
+	EXPECT_GT(mean.Normalize().Dot(coneDirection), 0.999f);
+}
+
+TEST(Emitter, spherePositionsWithinRadius) {
+	SphereEmitter emitter(2.0f);
+	std::vector<Vector3f> positions(1000);
+	emitter.GeneratePositions(positions);
+
+	for (const auto &position : positions)
+		EXPECT_LE(position.Length(), 2.0f + 1e-5f);
+}
@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <Engine/Log.hpp>
+
+using namespace acid;
+
+TEST(Log, flushOrdersThreads) {
+	auto filename = std::filesystem::temp_directory_path() / "Acid_Test_Log.jsonl";
+	Log::OpenJsonLog(filename);
+
+	Log::Out("first ", 1, ' ', 2.5f, ' ', std::string("string"), '\n');
+	std::thread([] {
+		Log::Out("second ", -3, '\n');
+	}).join();
+	Log::Out("third \"quoted\"\n");
+	Log::Flush();
+	Log::CloseJsonLog();
+
+	std::ifstream stream(filename);
+	std::vector<std::string> lines;
+	for (std::string line; std::getline(stream, line);)
+		lines.emplace_back(line);
+
+	ASSERT_EQ(lines.size(), 3);
+	EXPECT_NE(lines[0].find(R"("message":"first 1 2.5 string")"), std::string::npos);
+	EXPECT_NE(lines[1].find(R"("message":"second -3")"), std::string::npos);
+	EXPECT_NE(lines[2].find(R"("message":"third \"quoted\"")"), std::string::npos);
+	std::filesystem::remove(filename);
+}
+
+TEST(Log, rateLimit) {
+	auto stats = Log::GetStats();
+
+	Log::SetRateLimit(10);
+	for (int32_t i = 0; i < 100; i++)
+		Log::Info("limited ", i, '\n');
+	Log::Error("never limited\n");
+	Log::SetRateLimit(0);
+	Log::Flush();
+
+	auto limited = Log::GetStats();
+	EXPECT_GE(limited.rateLimited - stats.rateLimited, 80);
+	EXPECT_LE(limited.written - stats.written, 20);
+}
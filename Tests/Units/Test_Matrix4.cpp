@@ -0,0 +1,23 @@
+#include <gtest/gtest.h>
+
+#include <Maths/Matrix4.hpp>
+
+using namespace acid;
+
+TEST(Matrix4, billboardMatchesChainedOperations) {
+	auto viewMatrix = Matrix4::ViewMatrix({3.0f, -2.0f, 7.5f}, {0.4f, -1.3f, 0.2f});
+	Vector3f position(-4.0f, 12.0f, 0.5f);
+
+	auto expected = Matrix4().Translate(position);
+	for (uint32_t row = 0; row < 3; row++) {
+		for (uint32_t col = 0; col < 3; col++)
+			expected[row][col] = viewMatrix[col][row];
+	}
+	expected = expected.Rotate(2.1f, Vector3f::Front).Scale(Vector3f(1.7f));
+
+	auto actual = Matrix4::BillboardMatrix(viewMatrix, position, 2.1f, 1.7f);
+	for (uint32_t row = 0; row < 4; row++) {
+		for (uint32_t col = 0; col < 4; col++)
+			EXPECT_NEAR(actual[row][col], expected[row][col], 1e-5f);
+	}
+}
@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+
+#include <Bitmaps/MipmapChain.hpp>
+#include <Files/BinaryStream.hpp>
+
+using namespace acid;
+
+TEST(MipmapChain, boxFilterLevels) {
+	Bitmap bitmap({4, 2}, 1);
+	uint8_t pixels[] = {
+		0, 4, 8, 12,
+		4, 8, 12, 16
+	};
+	std::memcpy(bitmap.GetData().get(), pixels, sizeof(pixels));
+
+	MipmapChain mipmapChain(bitmap);
+	ASSERT_EQ(mipmapChain.GetLevelCount(), 3u);
+	EXPECT_EQ(mipmapChain.GetLevelSize(1), Vector2ui(2, 1));
+	EXPECT_EQ(mipmapChain.GetLevelSize(2), Vector2ui(1, 1));
+	EXPECT_EQ(mipmapChain.GetData().size(), 8u + 2u + 1u);
+
+	auto level1 = mipmapChain.GetLevel(1);
+	EXPECT_EQ(level1[0], 4);
+	EXPECT_EQ(level1[1], 12);
+	EXPECT_EQ(mipmapChain.GetLevel(2)[0], 8);
+}
+
+TEST(BinaryStream, roundTrip) {
+	std::vector<uint32_t> values = {1, 2, 3};
+
+	BinaryWriter writer;
+	writer.Write(42.0f);
+	writer.Write(std::string("name"));
+	writer.Write<uint32_t>(values);
+
+	BinaryReader reader(writer.GetBuffer());
+	EXPECT_EQ(reader.Read<float>(), 42.0f);
+	EXPECT_EQ(reader.ReadString(), "name");
+	std::vector<uint32_t> readValues;
+	reader.Read(readValues);
+	EXPECT_EQ(readValues, values);
+	EXPECT_EQ(reader.GetRemaining(), 0u);
+	EXPECT_THROW(reader.Read<uint32_t>(), std::runtime_error);
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <Audio/Mixer/Mixer.hpp>
+#include <Audio/Mixer/NullAudioDevice.hpp>
+
+static std::shared_ptr<const std::vector<int16_t>> Constant(int16_t value, std::size_t frames) {
+	return std::make_shared<const std::vector<int16_t>>(frames, value);
+}
+
+static acid::Mixer::VoiceId Play(acid::Mixer &mixer, std::shared_ptr<const std::vector<int16_t>> samples) {
+	auto id = mixer.CreateVoice();
+	auto &voice = mixer.GetVoice(id);
+	voice.samples = std::move(samples);
+	voice.spatial = false;
+	voice.state = acid::Mixer::Voice::State::Playing;
+	return id;
+}
+
+TEST(Mixer, sumsVoices) {
+	acid::Mixer mixer(48000, 8);
+	Play(mixer, Constant(8192, 1000));
+	Play(mixer, Constant(4096, 1000));
+
+	std::vector<float> output(2 * 256);
+	mixer.Mix(output);
+	for (auto sample : output)
+		EXPECT_FLOAT_EQ(sample, 0.375f);
+	EXPECT_EQ(mixer.GetRealVoiceCount(), 2);
+}
+
+TEST(Mixer, countsVoicesInUse) {
+	acid::Mixer mixer(48000, 8);
+	EXPECT_EQ(mixer.GetVoiceCount(), 0);
+
+	auto first = mixer.CreateVoice();
+	auto second = mixer.CreateVoice();
+	EXPECT_EQ(mixer.GetVoiceCount(), 2);
+
+	// Destroyed ids are reused, so the count follows the voices in use rather than the ones ever created.
+	mixer.DestroyVoice(first);
+	EXPECT_EQ(mixer.GetVoiceCount(), 1);
+	EXPECT_EQ(mixer.CreateVoice(), first);
+	EXPECT_EQ(mixer.GetVoiceCount(), 2);
+
+	mixer.DestroyVoice(first);
+	mixer.DestroyVoice(second);
+	EXPECT_EQ(mixer.GetVoiceCount(), 0);
+}
+
+TEST(Mixer, stopsAtEnd) {
+	acid::Mixer mixer(48000, 8);
+	auto id = Play(mixer, Constant(8192, 100));
+
+	std::vector<float> output(2 * 256);
+	mixer.Mix(output);
+	EXPECT_FLOAT_EQ(output[2 * 99], 0.25f);
+	EXPECT_FLOAT_EQ(output[2 * 100], 0.0f);
+	EXPECT_EQ(mixer.GetVoice(id).state, acid::Mixer::Voice::State::Stopped);
+}
+
+TEST(Mixer, resamplesByPitch) {
+	acid::Mixer mixer(48000, 8);
+	std::vector<int16_t> ramp(1000);
+	for (std::size_t i = 0; i < ramp.size(); i++)
+		ramp[i] = static_cast<int16_t>(i * 8);
+	auto id = Play(mixer, std::make_shared<const std::vector<int16_t>>(ramp));
+	mixer.GetVoice(id).pitch = 0.5f;
+
+	std::vector<float> output(2 * 64);
+	mixer.Mix(output);
+	for (std::size_t i = 0; i < 64; i++)
+		EXPECT_NEAR(output[2 * i], i * 4.0f / 32768.0f, 1e-6f);
+}
+
+TEST(Mixer, attenuatesByDistance) {
+	acid::Mixer mixer(48000, 8);
+	auto id = Play(mixer, Constant(16384, 1000));
+	auto &voice = mixer.GetVoice(id);
+	voice.spatial = true;
+	voice.position = {0.0f, 0.0f, -4.0f};
+	mixer.SetListener({}, {0.0f, 0.0f, -1.0f}, acid::Vector3f::Up);
+
+	std::vector<float> output(2 * 64);
+	mixer.Mix(output);
+	// Gain 1/4 by distance, split equally between both channels by constant power panning.
+	EXPECT_NEAR(output[0], 0.5f * 0.25f * std::sqrt(0.5f), 1e-5f);
+	EXPECT_NEAR(output[1], output[0], 1e-6f);
+}
+
+TEST(Mixer, limitsRealVoices) {
+	acid::Mixer mixer(48000, 2);
+	auto quiet = Play(mixer, Constant(8192, 48000));
+	Play(mixer, Constant(8192, 48000));
+	Play(mixer, Constant(8192, 48000));
+	mixer.GetVoice(quiet).gain = 0.5f;
+
+	std::vector<float> output(2 * 256);
+	mixer.Mix(output);
+	EXPECT_EQ(mixer.GetRealVoiceCount(), 2);
+	EXPECT_EQ(mixer.GetVirtualVoiceCount(), 1);
+	EXPECT_FLOAT_EQ(output[0], 0.5f);
+
+	// A higher priority wins over a louder voice, one voice fades in as the other fades out over the next mix.
+	mixer.GetVoice(quiet).priority = 1;
+	mixer.Mix(output);
+	EXPECT_EQ(mixer.GetRealVoiceCount(), 2);
+	EXPECT_FLOAT_EQ(output[0], 0.5f);
+	EXPECT_NEAR(output[2 * 255], 0.125f + 0.25f, 0.002f);
+	mixer.Mix(output);
+	EXPECT_FLOAT_EQ(output[0], 0.125f + 0.25f);
+}
+
+TEST(Mixer, mixesToNullDevice) {
+	acid::Mixer mixer(48000, 8);
+	acid::NullAudioDevice device(48000, 512);
+	Play(mixer, Constant(16384, 48000));
+
+	std::vector<float> output(2 * device.GetWritableFrames());
+	mixer.Mix(output);
+	device.Write(output);
+	EXPECT_EQ(device.GetFramesWritten(), 512);
+	EXPECT_FLOAT_EQ(device.GetPeak(), 0.5f);
+}
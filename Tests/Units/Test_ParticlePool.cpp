@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <Particles/ParticlePool.hpp>
+#include <Utils/ThreadPool.hpp>
+
+using namespace acid;
+
+TEST(ParticlePool, integrateAndKill) {
+	ParticlePool pool;
+	pool.Add({0.0f, 10.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, 0.5f, 1.0f, 0.0f, 1.0f, 1.0f);
+	pool.Add({0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 2.0f}, 10.0f, 1.0f, 0.0f, 1.0f, 0.0f);
+	pool.Add({5.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, 10.0f, 1.0f, 0.0f, 1.0f, 0.0f);
+
+	// The first particle is already fading, and fades out completely after one second.
+	pool.Update(0.5f, {0.0f, 0.0f, 0.0f}, 0);
+	ASSERT_EQ(pool.GetSize(), 3u);
+	EXPECT_FLOAT_EQ(pool.GetVelocity(0).y, -5.0f);
+	EXPECT_FLOAT_EQ(pool.GetPosition(0).x, 0.5f);
+	EXPECT_FLOAT_EQ(pool.GetPosition(0).y, 7.5f);
+	EXPECT_FLOAT_EQ(pool.GetTransparency(0), 0.5f);
+	EXPECT_FLOAT_EQ(pool.GetPosition(1).z, 1.0f);
+	EXPECT_FLOAT_EQ(pool.GetDistanceToCamera(2), 25.0f);
+
+	// The last particle moves into the slot of the dead one.
+	pool.Update(0.5f, {0.0f, 0.0f, 0.0f}, 0);
+	ASSERT_EQ(pool.GetSize(), 2u);
+	EXPECT_FLOAT_EQ(pool.GetPosition(0).x, 5.0f);
+	EXPECT_FLOAT_EQ(pool.GetPosition(1).z, 2.0f);
+	EXPECT_FLOAT_EQ(pool.GetElapsedTime(0), 1.0f);
+}
+
+TEST(ParticlePool, atlasOffsets) {
+	ParticlePool pool;
+	pool.Add({}, {}, 4.0f, 1.0f, 0.0f, 1.0f, 0.0f);
+
+	// Two rows give four stages over the life of the particle, half way through it blends from the third stage into the fourth.
+	pool.Update(2.0f, {}, 2);
+	EXPECT_FLOAT_EQ(pool.GetImageBlendFactor(0), 0.0f);
+	EXPECT_EQ(pool.GetImageOffsets(0), Vector4f(0.0f, 0.5f, 0.5f, 0.5f));
+
+	pool.Update(1.5f, {}, 2);
+	EXPECT_FLOAT_EQ(pool.GetImageBlendFactor(0), 0.5f);
+	EXPECT_EQ(pool.GetImageOffsets(0), Vector4f(0.5f, 0.5f, 0.5f, 0.5f));
+}
+
+TEST(ParticlePool, parallelMatchesSerial) {
+	ThreadPool threadPool(3);
+	ParticlePool serial, parallel;
+
+	for (uint32_t i = 0; i < 100000; i++) {
+		auto value = static_cast<float>(i % 1000);
+		for (auto pool : {&serial, &parallel})
+			pool->Add({value, 0.0f, -value}, {0.0f, 0.01f * value, 1.0f}, 1.0f + 0.01f * value, 1.0f, 0.0f, 1.0f, 1.0f);
+	}
+
+	for (uint32_t step = 0; step < 60; step++) {
+		serial.Update(1.0f / 30.0f, {1.0f, 2.0f, 3.0f}, 4);
+		parallel.Update(1.0f / 30.0f, {1.0f, 2.0f, 3.0f}, 4, &threadPool);
+	}
+
+	ASSERT_EQ(serial.GetSize(), parallel.GetSize());
+	EXPECT_LT(serial.GetSize(), 100000u);
+	for (std::size_t i = 0; i < serial.GetSize(); i++) {
+		ASSERT_EQ(serial.GetPosition(i), parallel.GetPosition(i));
+		ASSERT_EQ(serial.GetImageOffsets(i), parallel.GetImageOffsets(i));
+		ASSERT_EQ(serial.GetDistanceToCamera(i), parallel.GetDistanceToCamera(i));
+	}
+}
+
+TEST(ParticlePool, sortByDistance) {
+	ParticlePool pool;
+	for (auto z : {3.0f, 40.0f, 1.0f, 700.0f, 40.0f, 0.0f})
+		pool.Add({0.0f, 0.0f, z}, {}, 10.0f, 1.0f, 0.0f, 1.0f, 0.0f);
+	pool.Update(0.0f, {}, 0);
+
+	// Only the given indices are sorted, equal distances keep the order they were given in.
+	std::vector<uint32_t> indices = {0, 1, 2, 4, 5}, scratch;
+	pool.SortByDistance(indices, scratch);
+	EXPECT_EQ(indices, (std::vector<uint32_t>{1, 4, 0, 2, 5}));
+
+	indices = {5, 3, 4, 1};
+	pool.SortByDistance(indices, scratch);
+	EXPECT_EQ(indices, (std::vector<uint32_t>{3, 4, 1, 5}));
+}
+
+TEST(ParticlePool, appendBatch) {
+	ParticlePool pool;
+	pool.Add({0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, 10.0f, 1.0f, 0.0f, 1.0f, 0.0f);
+
+	auto batch = pool.Append(3);
+	ASSERT_EQ(batch.positionX.size(), 3u);
+	for (std::size_t i = 0; i < 3; i++) {
+		batch.positionX[i] = static_cast<float>(i + 1);
+		batch.lifeLength[i] = 10.0f;
+		batch.velocityZ[i] = 1.0f;
+	}
+
+	ASSERT_EQ(pool.GetSize(), 4u);
+	EXPECT_FLOAT_EQ(pool.GetPosition(3).x, 3.0f);
+	EXPECT_FLOAT_EQ(pool.GetTransparency(2), 1.0f);
+
+	pool.Update(1.0f, {0.0f, 0.0f, 0.0f}, 0);
+	ASSERT_EQ(pool.GetSize(), 4u);
+	EXPECT_FLOAT_EQ(pool.GetPosition(1).z, 1.0f);
+	EXPECT_FLOAT_EQ(pool.GetElapsedTime(1), 1.0f);
+}
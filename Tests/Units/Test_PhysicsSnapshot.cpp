@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include <BulletCollision/CollisionShapes/btBoxShape.h>
+#include <BulletCollision/CollisionShapes/btStaticPlaneShape.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
+#include <BulletDynamics/Dynamics/btRigidBody.h>
+#include <Physics/Physics.hpp>
+
+using namespace acid;
+
+TEST(PhysicsSnapshot, restoreAndReplay) {
+	const auto timeStep = Time::Seconds(1.0f / 60.0f);
+
+	btBoxShape boxShape(btVector3(0.5f, 0.5f, 0.5f));
+	btStaticPlaneShape groundShape(btVector3(0.0f, 1.0f, 0.0f), 0.0f);
+	btVector3 boxInertia;
+	boxShape.calculateLocalInertia(1.0f, boxInertia);
+
+	// Bodies are declared before the world, the physics system removes them from the world when destroyed.
+	std::vector<std::unique_ptr<btRigidBody>> bodies;
+
+	PhysicsSettings settings;
+	settings.threadCount = 1;
+	Physics physics(settings);
+	auto world = physics.GetDynamicsWorld();
+
+	auto addBody = [&](btRigidBody::btRigidBodyConstructionInfo info, const btVector3 &position) {
+		info.m_startWorldTransform.setOrigin(position);
+		auto &body = bodies.emplace_back(std::make_unique<btRigidBody>(info));
+		world->addRigidBody(body.get());
+		return body.get();
+	};
+
+	addBody({0.0f, nullptr, &groundShape}, {0.0f, 0.0f, 0.0f});
+	for (int x = 0; x < 3; x++) {
+		for (int y = 0; y < 4; y++)
+			addBody({1.0f, nullptr, &boxShape, boxInertia}, {1.5f * x, 0.5f + 1.01f * y, 0.0f});
+	}
+
+	// A box thrown into the stacks keeps contacts appearing and breaking throughout the replay.
+	auto thrown = addBody({1.0f, nullptr, &boxShape, boxInertia}, {-4.0f, 2.0f, 0.0f});
+	thrown->setLinearVelocity(btVector3(10.0f, 1.0f, 0.5f));
+
+	auto input = [thrown](uint32_t step) {
+		if (step == 10)
+			thrown->applyCentralImpulse(btVector3(0.0f, 4.0f, -2.0f));
+	};
+
+	physics.Resimulate(30, timeStep);
+	auto start = physics.Snapshot();
+
+	physics.Restore(start);
+	EXPECT_EQ(physics.Snapshot(), start);
+
+	physics.Resimulate(60, timeStep, input);
+	auto replay = physics.Snapshot();
+	EXPECT_NE(replay, start);
+
+	// Stepping further changes the broadphase and contact caches, the restore must leave no trace of them.
+	physics.Resimulate(17, timeStep);
+	physics.Restore(start);
+	physics.Resimulate(60, timeStep, input);
+	EXPECT_EQ(physics.Snapshot(), replay);
+}
+
+TEST(PhysicsSnapshot, rejectsOtherWorlds) {
+	btBoxShape boxShape(btVector3(0.5f, 0.5f, 0.5f));
+	btRigidBody body(1.0f, nullptr, &boxShape);
+
+	PhysicsSettings settings;
+	settings.threadCount = 1;
+	Physics physics(settings);
+	auto empty = physics.Snapshot();
+
+	physics.GetDynamicsWorld()->addRigidBody(&body);
+	EXPECT_THROW(physics.Restore(empty), std::runtime_error);
+	EXPECT_THROW(physics.Restore(Span<const std::byte>(empty.data(), 2)), std::runtime_error);
+	EXPECT_EQ(physics.GetDynamicsWorld()->getNumCollisionObjects(), 1);
+}
@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+
+#include <Resources/Resources.hpp>
+
+class TestResource : public acid::Resource {
+public:
+	explicit TestResource(std::size_t size) : size(size) {}
+
+	std::type_index GetTypeIndex() const override { return typeid(TestResource); }
+	std::size_t GetCpuMemoryUsage() const override { return size; }
+
+	std::size_t size;
+};
+
+class TestAsyncResource : public acid::Resource {
+public:
+	explicit TestAsyncResource(std::string filename) : filename(std::move(filename)) {}
+
+	std::type_index GetTypeIndex() const override { return typeid(TestAsyncResource); }
+
+	friend const acid::Node &operator>>(const acid::Node &node, TestAsyncResource &resource) {
+		node["filename"].Get(resource.filename);
+		return node;
+	}
+
+	std::string filename;
+	std::thread::id decodeThread, uploadThread;
+	// The order decodes and uploads happened in across every test resource.
+	uint32_t decodeOrder = 0, uploadOrder = 0;
+
+protected:
+	void Decode() override {
+		if (filename == "missing.png")
+			throw std::runtime_error("missing file");
+		decodeThread = std::this_thread::get_id();
+		decodeOrder = ++Sequence;
+	}
+	void Upload() override {
+		uploadThread = std::this_thread::get_id();
+		uploadOrder = ++Sequence;
+	}
+
+private:
+	inline static std::atomic<uint32_t> Sequence = 0;
+};
+
+static acid::Node MakeKey(const std::string &filename, int32_t size) {
+	acid::Node node;
+	node["filename"].Set(filename);
+	node["size"].Set(size);
+	return node;
+}
+
+TEST(Resources, findCanonicalKey) {
+	acid::Resources resources;
+
+	auto resource = std::make_shared<TestResource>(16);
+	resources.Add(MakeKey("a.png", 4), resource);
+
+	// Object properties may appear in any order.
+	acid::Node reordered;
+	reordered["size"].Set(4);
+	reordered["filename"].Set("a.png");
+
+	EXPECT_EQ(resources.Find<TestResource>(reordered), resource);
+	EXPECT_EQ(resources.Find<TestResource>(MakeKey("a.png", 5)), nullptr);
+
+	auto stats = resources.GetStats<TestResource>();
+	EXPECT_EQ(stats.hits, 1);
+	EXPECT_EQ(stats.misses, 1);
+	EXPECT_EQ(stats.count, 1);
+}
+
+TEST(Resources, countFirstMiss) {
+	acid::Resources resources;
+
+	// No resource of the type has been added, so there is no cache for it yet.
+	EXPECT_EQ(resources.Find<TestResource>(MakeKey("a.png", 4)), nullptr);
+
+	auto stats = resources.GetStats<TestResource>();
+	EXPECT_EQ(stats.hits, 0);
+	EXPECT_EQ(stats.misses, 1);
+	EXPECT_EQ(stats.count, 0);
+}
+
+TEST(Resources, evictLeastRecentlyUsed) {
+	acid::Resources resources;
+
+	auto first = std::make_shared<TestResource>(60);
+	auto second = std::make_shared<TestResource>(60);
+	resources.Add(MakeKey("a.png", 0), first);
+	resources.Add(MakeKey("b.png", 0), second);
+	resources.Update();
+	EXPECT_EQ(resources.GetStats<TestResource>().cpuBytes, 120);
+
+	// Touching the first resource makes the second the least recently used.
+	EXPECT_EQ(resources.Find<TestResource>(MakeKey("a.png", 0)), first);
+	first = nullptr;
+	second = nullptr;
+	resources.SetBudget<TestResource>(100);
+
+	EXPECT_NE(resources.Find<TestResource>(MakeKey("a.png", 0)), nullptr);
+	EXPECT_EQ(resources.Find<TestResource>(MakeKey("b.png", 0)), nullptr);
+
+	auto stats = resources.GetStats<TestResource>();
+	EXPECT_EQ(stats.evictions, 1);
+	EXPECT_EQ(stats.cpuBytes, 60);
+}
+
+TEST(Resources, removeInUse) {
+	acid::Resources resources;
+
+	auto resource = std::make_shared<TestResource>(8);
+	resources.Add(MakeKey("a.png", 0), resource);
+	resources.Add(MakeKey("b.png", 0), std::make_shared<TestResource>(8));
+	resources.Remove(resource);
+
+	EXPECT_EQ(resources.Find<TestResource>(MakeKey("a.png", 0)), nullptr);
+	EXPECT_NE(resources.Find<TestResource>(MakeKey("b.png", 0)), nullptr);
+	EXPECT_EQ(resources.GetStats<TestResource>().count, 1);
+}
+
+TEST(Resources, loadAsync) {
+	acid::Resources resources;
+
+	auto resource = resources.LoadAsync<TestAsyncResource>(MakeKey("a.png", 0));
+	EXPECT_EQ(resource->filename, "a.png");
+	EXPECT_EQ(resources.LoadAsync<TestAsyncResource>(MakeKey("a.png", 0)), resource);
+
+	for (uint32_t i = 0; i < 1000 && !resource->IsLoaded(); i++) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		resources.Update();
+	}
+
+	EXPECT_TRUE(resource->IsLoaded());
+	EXPECT_NE(resource->decodeThread, std::this_thread::get_id());
+	EXPECT_EQ(resource->uploadThread, std::this_thread::get_id());
+}
+
+static void UpdateUntilLoaded(acid::Resources &resources, const acid::Resource &resource) {
+	for (uint32_t i = 0; i < 1000 && !resource.IsLoaded(); i++) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		resources.Update();
+	}
+}
+
+TEST(Resources, loadAsyncFailure) {
+	acid::Resources resources;
+
+	auto resource = resources.LoadAsync<TestAsyncResource>(MakeKey("missing.png", 0));
+	UpdateUntilLoaded(resources, *resource);
+
+	EXPECT_TRUE(resource->IsLoaded());
+	EXPECT_TRUE(resource->IsFailed());
+	EXPECT_EQ(resource->uploadThread, std::thread::id());
+}
+
+TEST(Resources, loadAsyncDependencies) {
+	acid::Resources resources;
+
+	auto dependency = resources.LoadAsync<TestAsyncResource>(MakeKey("a.png", 1));
+	auto resource = resources.LoadAsync<TestAsyncResource>(MakeKey("b.png", 1), {dependency});
+	UpdateUntilLoaded(resources, *resource);
+
+	ASSERT_TRUE(resource->IsLoaded());
+	EXPECT_FALSE(resource->IsFailed());
+	EXPECT_LT(dependency->uploadOrder, resource->decodeOrder);
+
+	// A failed dependency fails the resources waiting on it.
+	auto missing = resources.LoadAsync<TestAsyncResource>(MakeKey("missing.png", 1));
+	auto dependent = resources.LoadAsync<TestAsyncResource>(MakeKey("c.png", 1), {missing});
+	UpdateUntilLoaded(resources, *dependent);
+
+	EXPECT_TRUE(dependent->IsLoaded());
+	EXPECT_TRUE(dependent->IsFailed());
+	EXPECT_EQ(dependent->decodeThread, std::thread::id());
+}
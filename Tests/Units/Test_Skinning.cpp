@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include <Animations/Geometry/VertexAnimated.hpp>
+#include <Animations/Skin/Skinning.hpp>
+#include <Utils/ThreadPool.hpp>
+
+using namespace acid;
+
+namespace {
+std::vector<Matrix4> CreatePose() {
+	return {
+		Matrix4().Translate({0.0f, 1.0f, 0.0f}).Rotate(0.7f, Vector3f::Up),
+		Matrix4().Translate({2.0f, -1.0f, 0.5f}).Rotate(-1.9f, Vector3f(1.0f, 1.0f, 0.0f).Normalize()),
+		Matrix4().Rotate(2.8f, Vector3f::Right),
+		Matrix4().Translate({-3.0f, 0.0f, 4.0f})
+	};
+}
+
+std::vector<VertexAnimated> CreateVertices(uint32_t count) {
+	std::vector<VertexAnimated> vertices;
+	uint32_t seed = 7;
+	auto random = [&seed]() {
+		seed = seed * 1664525u + 1013904223u;
+		return static_cast<float>(seed >> 8) / static_cast<float>(1u << 24);
+	};
+
+	for (uint32_t i = 0; i < count; i++) {
+		Vector3f weights(random(), random(), random());
+		weights /= weights.x + weights.y + weights.z;
+		vertices.emplace_back(Vector3f(random(), random(), random()) * 4.0f - 2.0f, Vector2f(), Vector3f(random(), random(), random()).Normalize(),
+			Vector3ui(i % 4, (i / 4) % 4, (i / 16) % 4), weights);
+	}
+	return vertices;
+}
+}
+
+TEST(Skinning, linearMatchesShader) {
+	auto pose = CreatePose();
+	auto vertices = CreateVertices(10000);
+	Skinning skinning(vertices);
+
+	std::vector<Vector3f> positions(vertices.size()), normals(vertices.size());
+	ThreadPool threadPool(3);
+	skinning.Skin(pose, positions, normals, Skinning::Method::Linear, &threadPool);
+
+	for (std::size_t i = 0; i < vertices.size(); i++) {
+		Vector4f position, normal;
+		for (uint32_t k = 0; k < 3; k++) {
+			position += pose[vertices[i].jointId[k]].Transform(Vector4f(vertices[i].position, 1.0f)) * vertices[i].vertexWeight[k];
+			normal += pose[vertices[i].jointId[k]].Transform(Vector4f(vertices[i].normal, 0.0f)) * vertices[i].vertexWeight[k];
+		}
+
+		EXPECT_LE(positions[i].Distance(Vector3f(position)), 1e-4f) << "vertex " << i;
+		EXPECT_LE(normals[i].Distance(Vector3f(normal)), 1e-4f) << "vertex " << i;
+	}
+}
+
+TEST(Skinning, dualQuaternionKeepsVolume) {
+	auto pose = CreatePose();
+	auto vertices = CreateVertices(64);
+	// Vertices moved by one joint are moved rigidly by both methods.
+	for (auto &vertex : vertices)
+		vertex.vertexWeight = {1.0f, 0.0f, 0.0f};
+	// A vertex halfway between a joint and the same joint twisted half a turn collapses onto the axis with linear blending.
+	vertices.emplace_back(Vector3f(0.0f, 1.0f, 0.0f), Vector2f(), Vector3f(0.0f, 0.0f, 1.0f), Vector3ui(3, 2, 0), Vector3f(0.5f, 0.5f, 0.0f));
+	pose[2] = Matrix4().Translate({-3.0f, 0.0f, 4.0f}).Rotate(Maths::Radians(180.0f), Vector3f::Right);
+
+	Skinning skinning(vertices);
+	std::vector<Vector3f> linearPositions(vertices.size()), positions(vertices.size()), normals(vertices.size());
+	skinning.Skin(pose, linearPositions);
+	skinning.Skin(pose, positions, normals, Skinning::Method::DualQuaternion);
+
+	for (std::size_t i = 0; i + 1 < vertices.size(); i++) {
+		EXPECT_LE(positions[i].Distance(linearPositions[i]), 1e-4f) << "vertex " << i;
+		EXPECT_NEAR(normals[i].Length(), 1.0f, 1e-4f) << "vertex " << i;
+	}
+
+	EXPECT_NEAR(linearPositions.back().Distance(Vector3f(-3.0f, 0.0f, 4.0f)), 0.0f, 1e-4f);
+	EXPECT_NEAR(positions.back().Distance(Vector3f(-3.0f, 0.0f, 4.0f)), 1.0f, 1e-4f);
+}
+
+TEST(Skinning, boundsContainSkinnedVertices) {
+	auto pose = CreatePose();
+	auto vertices = CreateVertices(2000);
+	Skinning skinning(vertices);
+
+	std::vector<Vector3f> positions(vertices.size());
+	skinning.Skin(pose, positions);
+	Vector3f minExtents, maxExtents;
+	skinning.CalculateBounds(pose, minExtents, maxExtents);
+
+	Vector3f skinnedMin = Vector3f::Infinity, skinnedMax = -Vector3f::Infinity;
+	for (const auto &position : positions) {
+		skinnedMin = skinnedMin.Min(position);
+		skinnedMax = skinnedMax.Max(position);
+	}
+
+	for (uint32_t axis = 0; axis < 3; axis++) {
+		EXPECT_LE(minExtents[axis], skinnedMin[axis] + 1e-4f);
+		EXPECT_GE(maxExtents[axis], skinnedMax[axis] - 1e-4f);
+		// The joint boxes are loose, but not looser than their sum.
+		EXPECT_LT(maxExtents[axis] - minExtents[axis], 4.0f * (skinnedMax[axis] - skinnedMin[axis]));
+	}
+}
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include <Audio/SoundBuffer.hpp>
+
+class SoundCache : public ::testing::Test {
+protected:
+	void SetUp() override {
+		std::filesystem::create_directories(directory);
+	}
+
+	void TearDown() override {
+		std::filesystem::remove_all(directory);
+	}
+
+	std::filesystem::path directory = std::filesystem::temp_directory_path() / "AcidSoundCacheTest";
+	std::filesystem::path filename = directory / "0123456789abcdef.pcm";
+	std::vector<int16_t> samples = {0, 1, -1, 32767, -32768, 1234, -4321, 7};
+};
+
+TEST_F(SoundCache, roundTrip) {
+	acid::SoundBuffer::WriteCachedSamples(filename, 0x0123456789abcdef, 4096, samples, 2, 44100);
+
+	std::vector<int16_t> read;
+	uint32_t channels = 0, sampleRate = 0;
+	ASSERT_TRUE(acid::SoundBuffer::ReadCachedSamples(filename, 0x0123456789abcdef, 4096, read, channels, sampleRate));
+	EXPECT_EQ(read, samples);
+	EXPECT_EQ(channels, 2u);
+	EXPECT_EQ(sampleRate, 44100u);
+
+	// Only the cached file is left behind, the temporary file it was written through is moved over it.
+	EXPECT_EQ(std::distance(std::filesystem::directory_iterator(directory), std::filesystem::directory_iterator()), 1);
+}
+
+TEST_F(SoundCache, rejectsMissingFile) {
+	std::vector<int16_t> read;
+	uint32_t channels = 0, sampleRate = 0;
+	EXPECT_FALSE(acid::SoundBuffer::ReadCachedSamples(filename, 1, 1, read, channels, sampleRate));
+}
+
+TEST_F(SoundCache, rejectsOtherSoundFile) {
+	acid::SoundBuffer::WriteCachedSamples(filename, 0x0123456789abcdef, 4096, samples, 2, 44100);
+
+	std::vector<int16_t> read;
+	uint32_t channels = 0, sampleRate = 0;
+	EXPECT_FALSE(acid::SoundBuffer::ReadCachedSamples(filename, 0x0123456789abcdee, 4096, read, channels, sampleRate));
+	// The same hash from a file of a different size is a collision.
+	EXPECT_FALSE(acid::SoundBuffer::ReadCachedSamples(filename, 0x0123456789abcdef, 4097, read, channels, sampleRate));
+}
+
+TEST_F(SoundCache, rejectsStaleVersion) {
+	acid::SoundBuffer::WriteCachedSamples(filename, 0x0123456789abcdef, 4096, samples, 2, 44100);
+
+	// The version follows the 4 byte magic, a cache written by another version is decoded again.
+	{
+		std::fstream stream(filename, std::ios::binary | std::ios::in | std::ios::out);
+		stream.seekp(4);
+		uint32_t version = 0;
+		stream.write(reinterpret_cast<const char *>(&version), sizeof(version));
+	}
+
+	std::vector<int16_t> read;
+	uint32_t channels = 0, sampleRate = 0;
+	EXPECT_FALSE(acid::SoundBuffer::ReadCachedSamples(filename, 0x0123456789abcdef, 4096, read, channels, sampleRate));
+}
+
+TEST_F(SoundCache, rejectsTruncatedFile) {
+	acid::SoundBuffer::WriteCachedSamples(filename, 0x0123456789abcdef, 4096, samples, 2, 44100);
+	std::filesystem::resize_file(filename, std::filesystem::file_size(filename) - 3);
+
+	std::vector<int16_t> read;
+	uint32_t channels = 0, sampleRate = 0;
+	EXPECT_FALSE(acid::SoundBuffer::ReadCachedSamples(filename, 0x0123456789abcdef, 4096, read, channels, sampleRate));
+
+	// Cut inside the header.
+	std::filesystem::resize_file(filename, 10);
+	EXPECT_FALSE(acid::SoundBuffer::ReadCachedSamples(filename, 0x0123456789abcdef, 4096, read, channels, sampleRate));
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <Audio/SoundStream.hpp>
+
+// Decodes a stereo ramp where both samples of a frame hold the index of the frame.
+class RampDecoder : public acid::SoundDecoder {
+public:
+	explicit RampDecoder(uint64_t length) {
+		channels = 2;
+		sampleRate = 48000;
+		frameCount = length;
+	}
+
+	uint64_t Read(int16_t *samples, uint64_t frames) override {
+		frames = std::min(frames, frameCount - position);
+		for (uint64_t i = 0; i < frames; i++, position++)
+			samples[2 * i] = samples[2 * i + 1] = static_cast<int16_t>(position);
+		return frames;
+	}
+
+	bool Seek(uint64_t frame) override {
+		position = std::min(frame, frameCount);
+		return true;
+	}
+
+private:
+	uint64_t position = 0;
+};
+
+static std::vector<int16_t> Drain(acid::SoundStream &stream, std::size_t maxSamples) {
+	std::vector<int16_t> result, chunk;
+	while (result.size() < maxSamples) {
+		stream.Fill();
+		if (!stream.Pop(chunk))
+			break;
+		result.insert(result.end(), chunk.begin(), chunk.end());
+	}
+	return result;
+}
+
+TEST(SoundStream, streamsEveryFrame) {
+	acid::SoundStream stream(std::make_unique<RampDecoder>(1000), 64, 3);
+
+	auto samples = Drain(stream, 100000);
+	ASSERT_EQ(samples.size(), 2000);
+	for (std::size_t i = 0; i < samples.size(); i++)
+		EXPECT_EQ(samples[i], static_cast<int16_t>(i / 2));
+
+	EXPECT_TRUE(stream.IsEnded());
+	EXPECT_FALSE(stream.NeedsFill());
+}
+
+TEST(SoundStream, loopsWithoutGap) {
+	acid::SoundStream stream(std::make_unique<RampDecoder>(100), 64, 3);
+	stream.SetLooping(true);
+
+	auto samples = Drain(stream, 2 * 350);
+	ASSERT_GE(samples.size(), 2 * 350);
+	for (std::size_t i = 0; i < 350; i++)
+		EXPECT_EQ(samples[2 * i], static_cast<int16_t>(i % 100));
+	EXPECT_FALSE(stream.IsEnded());
+}
+
+TEST(SoundStream, seekDropsQueuedChunks) {
+	acid::SoundStream stream(std::make_unique<RampDecoder>(1000), 64, 3);
+	stream.Fill();
+	EXPECT_FALSE(stream.NeedsFill());
+
+	stream.Seek(500);
+	EXPECT_TRUE(stream.NeedsFill());
+
+	std::vector<int16_t> chunk;
+	EXPECT_FALSE(stream.Pop(chunk));
+	stream.Fill(1);
+	ASSERT_TRUE(stream.Pop(chunk));
+	EXPECT_EQ(chunk.size(), 2 * 64);
+	EXPECT_EQ(chunk.front(), 500);
+}
+
+TEST(SoundStream, readAllKnownLength) {
+	RampDecoder decoder(1000);
+	auto samples = decoder.ReadAll();
+	ASSERT_EQ(samples.size(), 2000);
+	EXPECT_EQ(samples.back(), 999);
+}
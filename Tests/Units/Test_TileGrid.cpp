@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include <Terrain/TileGrid.hpp>
+
+TEST(TileGrid, tileDistance) {
+	// Tiles of 64 units centered on multiples of 64.
+	test::TileGrid grid(33, 2.0f, 100.0f);
+	EXPECT_FLOAT_EQ(grid.GetTileSize(), 64.0f);
+
+	EXPECT_FLOAT_EQ(grid.GetTileDistance({0, 0}, {10.0f, -20.0f}), 0.0f);
+	EXPECT_FLOAT_EQ(grid.GetTileDistance({1, 0}, {0.0f, 0.0f}), 32.0f);
+	EXPECT_FLOAT_EQ(grid.GetTileDistance({-2, 0}, {0.0f, 0.0f}), 96.0f);
+	EXPECT_FLOAT_EQ(grid.GetTileDistance({1, 1}, {0.0f, 0.0f}), std::sqrt(2.0f * 32.0f * 32.0f));
+}
+
+TEST(TileGrid, lodSelection) {
+	test::TileGrid grid(33, 2.0f, 100.0f);
+	// 32 quads across a tile, the coarsest level leaves two.
+	EXPECT_EQ(grid.GetMaxLod(), 4u);
+	EXPECT_EQ(grid.GetVertexCount(0), 33u);
+	EXPECT_EQ(grid.GetVertexCount(4), 3u);
+
+	EXPECT_EQ(grid.GetLod(0.0f), 0u);
+	EXPECT_EQ(grid.GetLod(99.0f), 0u);
+	EXPECT_EQ(grid.GetLod(100.0f), 1u);
+	EXPECT_EQ(grid.GetLod(350.0f), 3u);
+	EXPECT_EQ(grid.GetLod(10000.0f), 4u);
+
+	test::TileGrid noLod(33, 2.0f, 0.0f);
+	EXPECT_EQ(noLod.GetLod(10000.0f), 0u);
+}
+
+TEST(TileGrid, tilesInRadiusNearestFirst) {
+	test::TileGrid grid(33, 2.0f, 100.0f);
+	auto coords = grid.GetTilesInRadius({0.0f, 0.0f}, 40.0f);
+
+	// The center tile, its four edge neighbours at 32, and the corners are past 40.
+	ASSERT_EQ(coords.size(), 5u);
+	EXPECT_EQ(coords.front(), test::TileGrid::Coord(0, 0));
+	for (std::size_t i = 1; i < coords.size(); i++)
+		EXPECT_FLOAT_EQ(grid.GetTileDistance(coords[i], {0.0f, 0.0f}), 32.0f);
+
+	auto further = grid.GetTilesInRadius({0.0f, 0.0f}, 200.0f);
+	for (std::size_t i = 1; i < further.size(); i++)
+		EXPECT_LE(grid.GetTileDistance(further[i - 1], {0.0f, 0.0f}), grid.GetTileDistance(further[i], {0.0f, 0.0f}));
+}
+
+TEST(TileGrid, stitchesToCoarserNeighbour) {
+	const uint32_t resolution = 9;
+	test::TileGrid grid(resolution, 1.0f, 10.0f);
+
+	std::vector<float> heights(resolution * resolution);
+	for (uint32_t i = 0; i < heights.size(); i++)
+		heights[i] = static_cast<float>((i * 7919) % 13);
+
+	// Matching neighbours sample every height unchanged.
+	auto matching = grid.SampleHeights(heights, 0, {0, 0, 0, 0});
+	EXPECT_EQ(matching, heights);
+
+	// A neighbour two levels coarser on the negative x edge only has vertices every four heights.
+	auto stitched = grid.SampleHeights(heights, 0, {2, 0, 0, 0});
+	for (uint32_t z = 0; z < resolution; z++) {
+		auto start = z / 4 * 4;
+		auto end = std::min(start + 4, resolution - 1);
+		auto factor = static_cast<float>(z - start) / 4.0f;
+		auto expected = (1.0f - factor) * heights[start * resolution] + factor * heights[end * resolution];
+		EXPECT_FLOAT_EQ(stitched[z * resolution], expected);
+
+		// Inner vertices are left alone.
+		EXPECT_EQ(stitched[z * resolution + 1], heights[z * resolution + 1]);
+	}
+
+	// The other edges keep their heights, finer neighbours stitch to this tile instead.
+	for (uint32_t x = 0; x < resolution; x++)
+		EXPECT_EQ(stitched[x * resolution + resolution - 1], heights[x * resolution + resolution - 1]);
+
+	auto coarse = grid.SampleHeights(heights, 1, {0, 0, 0, 0});
+	ASSERT_EQ(coarse.size(), 25u);
+	EXPECT_EQ(coarse[1], heights[2]);
+	EXPECT_EQ(coarse[4 * 5 + 4], heights[resolution * resolution - 1]);
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <Timers/Timers.hpp>
+
+using namespace std::chrono_literals;
+
+/**
+ * Waits until a condition holds, or gives up after a second.
+ * @param condition The condition to wait for.
+ * @param update Called between checks, used to run the main thread dispatch.
+ */
+template<typename Condition>
+static void WaitFor(Condition &&condition, const std::function<void()> &update = {}) {
+	for (uint32_t i = 0; i < 1000 && !condition(); i++) {
+		std::this_thread::sleep_for(1ms);
+		if (update)
+			update();
+	}
+}
+
+TEST(Timers, cascadesFromHigherLevels) {
+	acid::Timers timers;
+	std::atomic<bool> early = false;
+	std::atomic<uint32_t> fired = 0;
+
+	// Further out than the first wheel level, the timer is placed in the second and cascades down before firing.
+	acid::Time delay = std::chrono::milliseconds(acid::Timers::WheelSize + 50);
+	auto due = acid::Time::Now() + delay;
+	timers.Once([&] {
+		early = acid::Time::Now() < due;
+		fired++;
+	}, delay);
+
+	WaitFor([&] { return fired != 0; });
+	EXPECT_EQ(fired, 1);
+	EXPECT_FALSE(early);
+}
+
+TEST(Timers, cancelBeforeFire) {
+	acid::Timers timers;
+	std::atomic<uint32_t> fired = 0;
+
+	auto timer = timers.Once([&] { fired++; }, 20ms);
+	EXPECT_EQ(timers.GetTimerCount(), 1);
+	timer->Destroy();
+	EXPECT_EQ(timers.GetTimerCount(), 0);
+
+	std::this_thread::sleep_for(50ms);
+	EXPECT_EQ(fired, 0);
+}
+
+TEST(Timers, repeatCount) {
+	acid::Timers timers;
+	std::atomic<uint32_t> fired = 0;
+
+	timers.Repeat([&] { fired++; }, 5ms, 3);
+
+	WaitFor([&] { return timers.GetTimerCount() == 0; });
+	EXPECT_EQ(timers.GetTimerCount(), 0);
+	std::this_thread::sleep_for(20ms);
+	EXPECT_EQ(fired, 3);
+}
+
+TEST(Timers, dispatchMain) {
+	acid::Timers timers;
+	std::atomic<uint32_t> fired = 0;
+	std::thread::id thread;
+
+	timers.Once([&] {
+		thread = std::this_thread::get_id();
+		fired++;
+	}, 5ms, acid::Timer::Dispatch::Main);
+
+	// Without the main thread update the timer is held once due.
+	std::this_thread::sleep_for(20ms);
+	EXPECT_EQ(fired, 0);
+
+	timers.Update();
+	EXPECT_EQ(fired, 1);
+	EXPECT_EQ(thread, std::this_thread::get_id());
+	EXPECT_EQ(timers.GetTimerCount(), 0);
+}